@@ -148,6 +148,10 @@ void BackendCommandTarget::getAllCommands(Array<CommandID>& commands)
 		MenuToolsRemoveAllSampleMaps,
 		MenuToolsUnloadAllAudioFiles,
 		MenuToolsRecordOneSecond,
+		MenuToolsDumpStreamingStatistics,
+		MenuToolsEnableCpuProfiler,
+		MenuToolsShowCpuProfile,
+		MenuToolsExportCpuProfile,
 		MenuToolsEnableDebugLogging,
 		MenuToolsImportArchivedSamples,
 		MenuToolsCreateRSAKeys,
@@ -451,6 +455,18 @@ void BackendCommandTarget::getCommandInfo(CommandID commandID, ApplicationComman
 	case MenuToolsRecordOneSecond:
 		setCommandTarget(result, "Record one second audio file", true, false, 'X', false);
 		break;
+	case MenuToolsDumpStreamingStatistics:
+		setCommandTarget(result, "Dump streaming statistics", true, false, 'X', false);
+		break;
+	case MenuToolsEnableCpuProfiler:
+		setCommandTarget(result, "Enable CPU profiler", true, bpe->owner->getCpuProfiler().isEnabled(), 'X', false);
+		break;
+	case MenuToolsShowCpuProfile:
+		setCommandTarget(result, "Show CPU profile", true, false, 'X', false);
+		break;
+	case MenuToolsExportCpuProfile:
+		setCommandTarget(result, "Export CPU profile as Chrome trace", true, false, 'X', false);
+		break;
 	case MenuToolsCreateRSAKeys:
 		setCommandTarget(result, "Create RSA Key pair", true, false, 'X', false);
 		break;
@@ -609,6 +625,10 @@ bool BackendCommandTarget::perform(const InvocationInfo &info)
 	case MenuToolsCheckAllSampleMaps:	Actions::checkAllSamplemaps(bpe); return true;
 	case MenuToolsImportArchivedSamples: Actions::importArchivedSamples(bpe); return true;
 	case MenuToolsRecordOneSecond:		bpe->owner->getDebugLogger().startRecording(); return true;
+	case MenuToolsDumpStreamingStatistics: Actions::dumpStreamingStatistics(bpe); return true;
+	case MenuToolsEnableCpuProfiler:	bpe->owner->getCpuProfiler().setEnabled(!bpe->owner->getCpuProfiler().isEnabled()); updateCommands(); return true;
+	case MenuToolsShowCpuProfile:		Actions::showCpuProfile(bpe); return true;
+	case MenuToolsExportCpuProfile:		Actions::exportCpuProfile(bpe); return true;
 	case MenuToolsEnableDebugLogging:	bpe->owner->getDebugLogger().toggleLogging(), updateCommands(); return true;
     case MenuViewFullscreen:            Actions::toggleFullscreen(bpe); updateCommands(); return true;
 	case MenuViewBack:					bpe->mainEditor->getViewUndoManager()->undo(); updateCommands(); return true;
@@ -838,6 +858,12 @@ PopupMenu BackendCommandTarget::getMenuForIndex(int topLevelMenuIndex, const Str
 		ADD_DESKTOP_ONLY(MenuToolsRemoveAllSampleMaps);
 		ADD_DESKTOP_ONLY(MenuToolsUnloadAllAudioFiles);
 		ADD_DESKTOP_ONLY(MenuToolsRecordOneSecond);
+		ADD_DESKTOP_ONLY(MenuToolsDumpStreamingStatistics);
+		p.addSeparator();
+		p.addSectionHeader("CPU Profiler");
+		ADD_DESKTOP_ONLY(MenuToolsEnableCpuProfiler);
+		ADD_DESKTOP_ONLY(MenuToolsShowCpuProfile);
+		ADD_DESKTOP_ONLY(MenuToolsExportCpuProfile);
 		p.addSeparator();
 		p.addSectionHeader("License Management");
 		ADD_DESKTOP_ONLY(MenuToolsCreateDummyLicenseFile);
@@ -2299,6 +2325,41 @@ void BackendCommandTarget::Actions::unloadAllAudioFiles(BackendRootWindow * bpe)
 	}
 }
 
+void BackendCommandTarget::Actions::dumpStreamingStatistics(BackendRootWindow * bpe)
+{
+	FileChooser fc("Save streaming statistics", File::getSpecialLocation(File::userDesktopDirectory), "*.json", true);
+
+	if (fc.browseForFileToSave(true))
+	{
+		auto& sm = bpe->getBackendProcessor()->getSampleManager();
+
+		if (!sm.dumpStreamingStatistics(fc.getResult(), true))
+			PresetHandler::showMessageWindow("Error", "The statistics file can't be written", PresetHandler::IconType::Error);
+	}
+}
+
+void BackendCommandTarget::Actions::showCpuProfile(BackendRootWindow * bpe)
+{
+	auto& profiler = bpe->getBackendProcessor()->getCpuProfiler();
+
+	if (!profiler.isEnabled())
+		debugToConsole(bpe->getMainSynthChain(), "The CPU profiler is not enabled");
+
+	debugToConsole(bpe->getMainSynthChain(), "CPU profile:\n" + profiler.createProfileReport());
+}
+
+void BackendCommandTarget::Actions::exportCpuProfile(BackendRootWindow * bpe)
+{
+	FileChooser fc("Save CPU profile", File::getSpecialLocation(File::userDesktopDirectory), "*.json", true);
+
+	if (fc.browseForFileToSave(true))
+	{
+		auto r = bpe->getBackendProcessor()->getCpuProfiler().exportAsChromeTrace(fc.getResult());
+
+		if (r.failed())
+			PresetHandler::showMessageWindow("Error", r.getErrorMessage(), PresetHandler::IconType::Error);
+	}
+}
 
 void BackendCommandTarget::Actions::createUIDataFromDesktop(BackendRootWindow * bpe)
 {
@@ -188,6 +188,10 @@ public:
 		MenuToolsEnableAutoSaving,
 		MenuToolsEnableDebugLogging,
 		MenuToolsRecordOneSecond,
+		MenuToolsDumpStreamingStatistics,
+		MenuToolsEnableCpuProfiler,
+		MenuToolsShowCpuProfile,
+		MenuToolsExportCpuProfile,
 		MenuToolsDeviceSimulatorOffset,
 		MenuHelpShowAboutPage = 0x70000,
         MenuHelpCheckVersion,
@@ -343,6 +347,9 @@ public:
 		static void importArchivedSamples(BackendRootWindow * bpe);
 		static void checkCyclicReferences(BackendRootWindow * bpe);
 		static void unloadAllAudioFiles(BackendRootWindow * bpe);
+		static void dumpStreamingStatistics(BackendRootWindow * bpe);
+		static void showCpuProfile(BackendRootWindow * bpe);
+		static void exportCpuProfile(BackendRootWindow * bpe);
 		static void createUIDataFromDesktop(BackendRootWindow * bpe);
 
 		static String createWindowsInstallerTemplate(MainController* mc, bool includeAAX);
@@ -0,0 +1,955 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#include "AppConfig.h"
+
+#if HI_RUN_UNIT_TESTS
+
+#include  "JuceHeader.h"
+
+namespace hise { using namespace juce;
+
+/** A BackendProcessor that renders without an audio device.
+*
+*	Use this for the tests that need a MainController. It renders on the thread that runs the test, and the blocks
+*	between the calls to render() are filled with silence until the module tree is ready to play.
+*/
+class UnitTestProcessor
+{
+public:
+
+	UnitTestProcessor(double sampleRate = 44100.0, int blockSize_ = 512) :
+		blockSize(blockSize_),
+		bp(new BackendProcessor(nullptr, nullptr))
+	{
+		bp->setNonRealtime(true);
+		bp->prepareToPlay(sampleRate, blockSize);
+	}
+
+	MainController* getMainController() noexcept { return bp; }
+
+	int getBlockSize() const noexcept { return blockSize; }
+
+	/** Adds a synth to the master chain and waits until it can play. */
+	template <class SynthType> SynthType* addSynth(const String& id)
+	{
+		auto synth = new SynthType(bp.get(), id, NUM_POLYPHONIC_VOICES);
+
+		bp->getMainSynthChain()->getHandler()->add(synth, nullptr);
+
+		waitUntilReady();
+
+		return synth;
+	}
+
+	/** Renders one block with the given MIDI messages. */
+	void render(AudioSampleBuffer& buffer, MidiBuffer& midi)
+	{
+		buffer.clear();
+		bp->processBlock(buffer, midi);
+	}
+
+	/** Renders the given amount of blocks. The note is started at the beginning of the first block and stopped at the end. */
+	void playNote(int noteNumber, int numBlocks)
+	{
+		AudioSampleBuffer buffer(2, blockSize);
+		MidiBuffer midi;
+
+		for (int i = 0; i < numBlocks; i++)
+		{
+			midi.clear();
+
+			if (i == 0)
+				midi.addEvent(MidiMessage::noteOn(1, noteNumber, (uint8)100), 0);
+
+			if (i == numBlocks - 1)
+				midi.addEvent(MidiMessage::noteOff(1, noteNumber), blockSize - 1);
+
+			render(buffer, midi);
+		}
+	}
+
+	/** Renders the given amount of blocks and returns the output.
+	*
+	*	The function is called before every block with the block index and an empty MIDI buffer for the events of the block.
+	*/
+	AudioSampleBuffer renderBlocks(int numBlocks, const std::function<void(int, MidiBuffer&)>& addEvents)
+	{
+		AudioSampleBuffer output(2, numBlocks * blockSize);
+		AudioSampleBuffer buffer(2, blockSize);
+		MidiBuffer midi;
+
+		for (int i = 0; i < numBlocks; i++)
+		{
+			midi.clear();
+			addEvents(i, midi);
+
+			render(buffer, midi);
+
+			for (int c = 0; c < 2; c++)
+				output.copyFrom(c, i * blockSize, buffer, c, 0, blockSize);
+		}
+
+		return output;
+	}
+
+	/** Renders silent blocks until the voice killing and the sample preloading have finished. */
+	bool waitUntilReady(double timeoutSeconds = 10.0)
+	{
+		AudioSampleBuffer buffer(2, blockSize);
+
+		return OfflineBenchmark::waitUntilReady(bp, buffer, timeoutSeconds);
+	}
+
+private:
+
+	const int blockSize;
+
+	ScopedPointer<BackendProcessor> bp;
+};
+
+/** Returns the largest difference between the samples of the two buffers. */
+static float getMaxDifference(const AudioSampleBuffer& expected, const AudioSampleBuffer& actual)
+{
+	jassert(expected.getNumChannels() == actual.getNumChannels() && expected.getNumSamples() == actual.getNumSamples());
+
+	float maxDifference = 0.0f;
+
+	for (int c = 0; c < expected.getNumChannels(); c++)
+	{
+		for (int i = 0; i < expected.getNumSamples(); i++)
+			maxDifference = jmax(maxDifference, std::abs(expected.getSample(c, i) - actual.getSample(c, i)));
+	}
+
+	return maxDifference;
+}
+
+/** Expects that no sample of the two buffers differs more than the tolerance. */
+static void expectBuffersAreEqual(UnitTest& test, const AudioSampleBuffer& expected, const AudioSampleBuffer& actual, float tolerance, const String& message)
+{
+	const float maxDifference = getMaxDifference(expected, actual);
+
+	test.expect(maxDifference <= tolerance, message + ": max difference " + String(maxDifference));
+}
+
+
+/** Tests the global memory budget for the preload buffers (see MainController::SampleManager::MemoryGovernor). */
+class MemoryGovernorTest : public UnitTest
+{
+public:
+
+	MemoryGovernorTest() :
+		UnitTest("Testing the preload memory governor")
+	{}
+
+	void runTest() override
+	{
+		sampleFolder = File::getSpecialLocation(File::tempDirectory).getChildFile("MemoryGovernorTest");
+		sampleFolder.createDirectory();
+
+		createSampleFiles();
+
+		testBudget();
+		testShrinking();
+
+		sampleFolder.deleteRecursively();
+	}
+
+private:
+
+	enum
+	{
+		NumSounds = 8,
+		FirstNote = 60,
+		SampleLength = 44100
+	};
+
+	using Governor = MainController::SampleManager::MemoryGovernor;
+
+	void createSampleFiles()
+	{
+		beginTest("Writing the sample files");
+
+		Random r(42);
+		AudioSampleBuffer noise(1, SampleLength);
+
+		for (int i = 0; i < SampleLength; i++)
+			noise.setSample(0, i, r.nextFloat() * 2.0f - 1.0f);
+
+		WavAudioFormat wav;
+
+		for (int i = 0; i < NumSounds; i++)
+		{
+			auto f = getSampleFile(i);
+			f.deleteFile();
+
+			ScopedPointer<AudioFormatWriter> writer = wav.createWriterFor(f.createOutputStream(), 44100.0, 1, 16, StringPairArray(), 0);
+
+			expect(writer != nullptr, "Can't write " + f.getFullPathName());
+
+			if (writer != nullptr)
+				writer->writeFromAudioSampleBuffer(noise, 0, SampleLength);
+		}
+	}
+
+	File getSampleFile(int index) const
+	{
+		return sampleFolder.getChildFile("Sample" + String(index) + ".wav");
+	}
+
+	/** Maps every sample to a single key starting at FirstNote. */
+	ValueTree createSampleMap() const
+	{
+		ValueTree v("samplemap");
+
+		v.setProperty("ID", "GovernorTest", nullptr);
+		v.setProperty("SaveMode", SampleMap::Undefined, nullptr);
+
+		for (int i = 0; i < NumSounds; i++)
+		{
+			ValueTree s("sample");
+
+			s.setProperty(ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::ID), i, nullptr);
+			s.setProperty(ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::FileName), getSampleFile(i).getFullPathName(), nullptr);
+			s.setProperty(ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::RootNote), FirstNote + i, nullptr);
+			s.setProperty(ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::KeyLow), FirstNote + i, nullptr);
+			s.setProperty(ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::KeyHigh), FirstNote + i, nullptr);
+			s.setProperty(ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::VeloLow), 0, nullptr);
+			s.setProperty(ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::VeloHigh), 127, nullptr);
+
+			v.addChild(s, -1, nullptr);
+		}
+
+		return v;
+	}
+
+	ModulatorSampler* createSampler(UnitTestProcessor& tp)
+	{
+		auto sampler = tp.addSynth<ModulatorSampler>("Sampler");
+
+		sampler->getSampleMap()->restoreFromValueTree(createSampleMap());
+
+		expect(tp.waitUntilReady(), "Preloading timeout");
+		expectEquals(sampler->getNumSounds(), (int)NumSounds, "Sound amount");
+
+		return sampler;
+	}
+
+	static StreamingSamplerSound* getSound(ModulatorSampler* sampler, int index)
+	{
+		return static_cast<ModulatorSamplerSound*>(sampler->getSound(index))->getReferenceToSound().get();
+	}
+
+	static int64 getPreloadMemory(ModulatorSampler* sampler)
+	{
+		int64 numBytes = 0;
+
+		for (int i = 0; i < sampler->getNumSounds(); i++)
+			numBytes += (int64)getSound(sampler, i)->getActualPreloadSize();
+
+		return numBytes;
+	}
+
+	static int getNumShrunkSounds(ModulatorSampler* sampler)
+	{
+		int numShrunk = 0;
+
+		for (int i = 0; i < sampler->getNumSounds(); i++)
+			numShrunk += getSound(sampler, i)->needsLazyPreload() ? 1 : 0;
+
+		return numShrunk;
+	}
+
+	/** Waits until the background job of the governor has finished. */
+	static void waitForGovernor(Governor& governor)
+	{
+		for (int i = 0; i < 500 && governor.isQueued(); i++)
+			Thread::sleep(10);
+
+		governor.waitForJobToFinish(5000);
+	}
+
+	void testBudget()
+	{
+		beginTest("Loading the preload buffers within the budget");
+
+		UnitTestProcessor tp;
+		auto sampler = createSampler(tp);
+		auto& governor = tp.getMainController()->getSampleManager().getMemoryGovernor();
+
+		expect(!governor.isActive(), "The governor is active by default");
+
+		const int64 fullSize = getPreloadMemory(sampler);
+		const int64 soundSize = fullSize / NumSounds;
+
+		expectEquals(getNumShrunkSounds(sampler), 0, "Sounds without full preload buffer");
+
+		// The samplers switch to lazy preloading and load the full buffers as long as they fit in
+		const int64 budget = fullSize / 2;
+
+		governor.setMemoryBudget(budget);
+		expect(tp.waitUntilReady(), "Preloading timeout");
+		waitForGovernor(governor);
+
+		const int numShrunk = getNumShrunkSounds(sampler);
+
+		expect(numShrunk > 0 && numShrunk < NumSounds, "Shrunk sounds: " + String(numShrunk));
+		expect(governor.getMemoryFootprint() <= budget + soundSize, "Footprint exceeds the budget: " + String(governor.getMemoryFootprint()));
+		expectEquals(governor.getMemoryFootprint(), getPreloadMemory(sampler), "Footprint");
+
+		// Without a budget everything is loaded again
+		governor.setMemoryBudget(0);
+		expect(tp.waitUntilReady(), "Preloading timeout");
+
+		expectEquals(getNumShrunkSounds(sampler), 0, "Shrunk sounds without budget");
+		expectEquals(getPreloadMemory(sampler), fullSize, "Preload memory without budget");
+	}
+
+	void testShrinking()
+	{
+		beginTest("Shrinking the least recently played sounds");
+
+		UnitTestProcessor tp;
+		auto sampler = createSampler(tp);
+		auto& governor = tp.getMainController()->getSampleManager().getMemoryGovernor();
+
+		const int64 fullSize = getPreloadMemory(sampler);
+
+		// A budget that fits everything
+		governor.setMemoryBudget(fullSize * 2);
+		expect(tp.waitUntilReady(), "Preloading timeout");
+		waitForGovernor(governor);
+
+		expectEquals(getNumShrunkSounds(sampler), 0, "Shrunk sounds");
+
+		const int lastSound = NumSounds - 1;
+
+		tp.playNote(FirstNote + lastSound, 4);
+		Thread::sleep(20);
+
+		const int64 budget = fullSize / 2;
+
+		governor.setMemoryBudget(budget);
+		waitForGovernor(governor);
+
+		expect(governor.getMemoryFootprint() <= budget, "Footprint exceeds the budget: " + String(governor.getMemoryFootprint()));
+		expect(governor.getNumEvictions() > 0, "No evictions");
+		expect(!getSound(sampler, lastSound)->needsLazyPreload(), "The last played sound was shrunk");
+		expect(getSound(sampler, 0)->needsLazyPreload(), "The first sound was not shrunk");
+
+		// If the budget is used up, playing a shrunk sound must not load its buffer again
+		governor.setMemoryBudget(governor.getMemoryFootprint());
+		waitForGovernor(governor);
+
+		const int numEvictions = governor.getNumEvictions();
+
+		tp.playNote(FirstNote, 4);
+
+		for (int i = 0; i < 50 && governor.getNumReloads() == 0; i++)
+			Thread::sleep(10);
+
+		expectEquals(governor.getNumReloads(), 0, "Reloads without room left");
+		expect(getSound(sampler, 0)->needsLazyPreload(), "The shrunk sound was loaded without room left");
+
+		// With enough room, the next note loads it again
+		governor.setMemoryBudget(fullSize * 2);
+		waitForGovernor(governor);
+
+		tp.playNote(FirstNote, 4);
+
+		for (int i = 0; i < 500 && governor.getNumReloads() == 0; i++)
+			Thread::sleep(10);
+
+		expect(governor.getNumReloads() > 0, "No reload with room left");
+		expect(!getSound(sampler, 0)->needsLazyPreload(), "The played sound was not loaded again");
+		expectEquals(governor.getNumEvictions(), numEvictions, "Evictions after the reload");
+	}
+
+	File sampleFolder;
+};
+
+static MemoryGovernorTest memoryGovernorTest;
+
+
+/** Compares the output of a sampler with and without ModulatorSynth::setUseParallelVoiceRendering().
+*
+*	The sampler has envelopes in its gain and pitch chain and a polyphonic filter, so the voice rendering goes through the
+*	modulator chains, the voice effects and the resampling buffers of the workers.
+*/
+class ParallelVoiceRenderingTest : public UnitTest
+{
+public:
+
+	ParallelVoiceRenderingTest() :
+		UnitTest("Testing the parallel voice rendering")
+	{}
+
+	void runTest() override
+	{
+		sampleFile = File::getSpecialLocation(File::tempDirectory).getChildFile("ParallelVoiceRenderingTest.wav");
+
+		createSampleFile();
+
+		beginTest("Rendering the voices on multiple threads");
+
+		const AudioSampleBuffer serial = renderNotes(0);
+		const AudioSampleBuffer parallel = renderNotes(NumWorkers);
+		const AudioSampleBuffer parallel2 = renderNotes(NumWorkers);
+
+		expect(serial.getMagnitude(0, serial.getNumSamples()) > 0.1f, "The output is silent");
+
+		// The voices are summed in a different order, so there are rounding errors
+		expectBuffersAreEqual(*this, serial, parallel, 1e-4f, "Serial vs. parallel");
+		expectBuffersAreEqual(*this, parallel, parallel2, 0.0f, "Two parallel runs");
+
+		sampleFile.deleteFile();
+	}
+
+private:
+
+	enum
+	{
+		NumWorkers = 3,
+		NumNoteBlocks = 4,
+		NotesPerBlock = 8,
+		ReleaseBlock = 6,
+		NumBlocks = 16,
+		FirstNote = 48,
+		RootNote = 64,
+
+		// Shorter than the preload buffer, so the voices don't depend on the streaming thread
+		SampleLength = 6000
+	};
+
+	void createSampleFile()
+	{
+		beginTest("Writing the sample file");
+
+		AudioSampleBuffer sine(1, SampleLength);
+
+		for (int i = 0; i < SampleLength; i++)
+			sine.setSample(0, i, 0.5f * std::sin(float_Pi * 2.0f * 220.0f * (float)i / 44100.0f));
+
+		WavAudioFormat wav;
+
+		sampleFile.deleteFile();
+
+		ScopedPointer<AudioFormatWriter> writer = wav.createWriterFor(sampleFile.createOutputStream(), 44100.0, 1, 24, StringPairArray(), 0);
+
+		expect(writer != nullptr, "Can't write " + sampleFile.getFullPathName());
+
+		if (writer != nullptr)
+			writer->writeFromAudioSampleBuffer(sine, 0, SampleLength);
+	}
+
+	ValueTree createSampleMap() const
+	{
+		ValueTree v("samplemap");
+
+		v.setProperty("ID", "ParallelVoiceTest", nullptr);
+		v.setProperty("SaveMode", SampleMap::Undefined, nullptr);
+
+		ValueTree s("sample");
+
+		s.setProperty(ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::ID), 0, nullptr);
+		s.setProperty(ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::FileName), sampleFile.getFullPathName(), nullptr);
+		s.setProperty(ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::RootNote), (int)RootNote, nullptr);
+		s.setProperty(ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::KeyLow), 0, nullptr);
+		s.setProperty(ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::KeyHigh), 127, nullptr);
+		s.setProperty(ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::VeloLow), 0, nullptr);
+		s.setProperty(ModulatorSamplerSound::getPropertyName(ModulatorSamplerSound::VeloHigh), 127, nullptr);
+
+		v.addChild(s, -1, nullptr);
+
+		return v;
+	}
+
+	void addModules(ModulatorSampler* sampler)
+	{
+		auto mc = sampler->getMainController();
+
+		auto gainChain = static_cast<ModulatorChain*>(sampler->getChildProcessor(ModulatorSynth::GainModulation));
+		auto pitchChain = static_cast<ModulatorChain*>(sampler->getChildProcessor(ModulatorSynth::PitchModulation));
+		auto effectChain = static_cast<EffectProcessorChain*>(sampler->getChildProcessor(ModulatorSynth::EffectChain));
+
+		auto ahdsr = new AhdsrEnvelope(mc, "GainEnvelope", NUM_POLYPHONIC_VOICES, Modulation::GainMode);
+		ahdsr->setAttribute(AhdsrEnvelope::Attack, 15.0f, dontSendNotification);
+		ahdsr->setAttribute(AhdsrEnvelope::Release, 40.0f, dontSendNotification);
+		gainChain->getHandler()->add(ahdsr, nullptr);
+
+		gainChain->getHandler()->add(new TableEnvelope(mc, "TableEnvelope", NUM_POLYPHONIC_VOICES, Modulation::GainMode), nullptr);
+
+		auto pitchEnvelope = new SimpleEnvelope(mc, "PitchEnvelope", NUM_POLYPHONIC_VOICES, Modulation::PitchMode);
+		pitchEnvelope->setAttribute(SimpleEnvelope::Attack, 30.0f, dontSendNotification);
+		pitchEnvelope->setIntensityFromSlider(7.0f);
+		pitchChain->getHandler()->add(pitchEnvelope, nullptr);
+
+		auto filter = new PolyFilterEffect(mc, "Filter", NUM_POLYPHONIC_VOICES);
+		filter->setAttribute(MonoFilterEffect::Frequency, 2000.0f, dontSendNotification);
+		effectChain->getHandler()->add(filter, nullptr);
+
+		auto frequencyChain = static_cast<ModulatorChain*>(filter->getChildProcessor(PolyFilterEffect::FrequencyChain));
+		auto frequencyEnvelope = new SimpleEnvelope(mc, "FilterEnvelope", NUM_POLYPHONIC_VOICES, Modulation::GainMode);
+		frequencyEnvelope->setAttribute(SimpleEnvelope::Attack, 50.0f, dontSendNotification);
+		frequencyChain->getHandler()->add(frequencyEnvelope, nullptr);
+	}
+
+	/** Plays overlapping notes that start at odd offsets and returns the output. */
+	AudioSampleBuffer renderNotes(int numWorkers)
+	{
+		UnitTestProcessor tp;
+
+		auto sampler = tp.addSynth<ModulatorSampler>("Sampler");
+
+		addModules(sampler);
+		sampler->getSampleMap()->restoreFromValueTree(createSampleMap());
+
+		expect(tp.waitUntilReady(), "Preloading timeout");
+
+		if (numWorkers > 0)
+		{
+			tp.getMainController()->getRealtimeWorkerPool().setNumWorkers(numWorkers);
+			sampler->setUseParallelVoiceRendering(true);
+
+			expect(sampler->isUsingParallelVoiceRendering(), "The parallel voice rendering is not active");
+			expectEquals(tp.getMainController()->getRealtimeWorkerPool().getNumWorkers(), numWorkers, "Worker amount");
+		}
+
+		const int blockSize = tp.getBlockSize();
+
+		return tp.renderBlocks(NumBlocks, [blockSize](int i, MidiBuffer& midi)
+		{
+			for (int n = 0; n < NotesPerBlock; n++)
+			{
+				const int noteNumber = FirstNote + (i % NumNoteBlocks) * NotesPerBlock + n;
+				const int offset = (n * 97 + i * 13) % blockSize;
+
+				if (i < NumNoteBlocks)
+					midi.addEvent(MidiMessage::noteOn(1, noteNumber, (uint8)(60 + n * 8)), offset);
+				else if (i >= ReleaseBlock && i < ReleaseBlock + NumNoteBlocks)
+					midi.addEvent(MidiMessage::noteOff(1, noteNumber), offset);
+			}
+		});
+	}
+
+	File sampleFile;
+};
+
+static ParallelVoiceRenderingTest parallelVoiceRenderingTest;
+
+
+/** Checks that ModulatorSynth::renderNextBlockWithModulators() handles the events at their exact sample position. */
+class EventTimingTest : public UnitTest
+{
+public:
+
+	EventTimingTest() :
+		UnitTest("Testing the event timing")
+	{}
+
+	void runTest() override
+	{
+		testNoteOnOffset();
+		testControllerOffset();
+	}
+
+private:
+
+	enum
+	{
+		NoteOnOffset = 37,
+		ControllerOffset = 101,
+		ControllerBlock = 3
+	};
+
+	void testNoteOnOffset()
+	{
+		beginTest("Starting a voice at an odd offset");
+
+		UnitTestProcessor tp;
+
+		tp.addSynth<SineSynth>("Sine");
+
+		AudioSampleBuffer buffer(2, tp.getBlockSize());
+		MidiBuffer midi;
+
+		midi.addEvent(MidiMessage::noteOn(1, 64, (uint8)127), NoteOnOffset);
+		tp.render(buffer, midi);
+
+		const int firstSample = getFirstNonSilentSample(buffer);
+
+		// The sine starts at zero, so the first sample of the voice can be silent
+		expect(firstSample >= NoteOnOffset && firstSample < NoteOnOffset + 4, "The voice starts at " + String(firstSample));
+	}
+
+	void testControllerOffset()
+	{
+		beginTest("Applying a controller at an odd offset");
+
+		UnitTestProcessor tp;
+
+		auto synth = tp.addSynth<SineSynth>("Sine");
+		auto gainChain = static_cast<ModulatorChain*>(synth->getChildProcessor(ModulatorSynth::GainModulation));
+
+		auto cc = new ControlModulator(tp.getMainController(), "Controller", Modulation::GainMode);
+		cc->setAttribute(ControlModulator::SmoothTime, 0.0f, dontSendNotification);
+		gainChain->getHandler()->add(cc, nullptr);
+
+		AudioSampleBuffer buffer(2, tp.getBlockSize());
+		MidiBuffer midi;
+
+		for (int i = 0; i <= ControllerBlock; i++)
+		{
+			midi.clear();
+
+			if (i == 0)
+			{
+				midi.addEvent(MidiMessage::controllerEvent(1, 1, 127), 0);
+				midi.addEvent(MidiMessage::noteOn(1, 64, (uint8)127), 0);
+			}
+
+			if (i == ControllerBlock)
+				midi.addEvent(MidiMessage::controllerEvent(1, 1, 0), ControllerOffset);
+
+			tp.render(buffer, midi);
+		}
+
+		expect(buffer.getMagnitude(0, ControllerOffset) > 0.1f, "The controller is applied too early");
+		expectEquals(buffer.getMagnitude(ControllerOffset, tp.getBlockSize() - ControllerOffset), 0.0f, "The controller is applied too late");
+	}
+
+	static int getFirstNonSilentSample(const AudioSampleBuffer& b)
+	{
+		for (int i = 0; i < b.getNumSamples(); i++)
+		{
+			if (b.getSample(0, i) != 0.0f)
+				return i;
+		}
+
+		return -1;
+	}
+};
+
+static EventTimingTest eventTimingTest;
+
+
+/** Fills the voice limit and checks the voice that each ModulatorSynth::VoiceStealingPolicy picks. */
+class VoiceStealingTest : public UnitTest
+{
+public:
+
+	VoiceStealingTest() :
+		UnitTest("Testing the voice stealing policies")
+	{}
+
+	void runTest() override
+	{
+		testPolicy(Policy::ReleasedFirst, 70, ReleasedVoice, Policy::ReleasedFirst);
+		testPolicy(Policy::Oldest, 70, OldestVoice, Policy::Oldest);
+		testPolicy(Policy::LowestAmplitude, 70, QuietVoice, Policy::LowestAmplitude);
+		testPolicy(Policy::SameNoteFirst, 66, SameNoteVoice, Policy::SameNoteFirst);
+		testPolicy(Policy::SameNoteFirst, 70, ReleasedVoice, Policy::ReleasedFirst);
+	}
+
+private:
+
+	using Policy = ModulatorSynth::VoiceStealingPolicy;
+
+	enum
+	{
+		OldestVoice = 0,	// note 60, held
+		ReleasedVoice,		// note 62, in its release phase
+		QuietVoice,			// note 64, held with velocity 1
+		SameNoteVoice,		// note 66 on channel 2, held
+		LastVoice,			// note 68, held (the new note on channel 1 kills a voice because this one reaches the limit)
+		VoiceLimit
+	};
+
+	void testPolicy(Policy policy, int noteNumber, int expectedVoice, Policy expectedCounter)
+	{
+		beginTest(getPolicyName(policy) + " with note " + String(noteNumber));
+
+		UnitTestProcessor tp;
+
+		auto synth = tp.addSynth<SineSynth>("Sine");
+		auto gainChain = static_cast<ModulatorChain*>(synth->getChildProcessor(ModulatorSynth::GainModulation));
+
+		auto envelope = new SimpleEnvelope(tp.getMainController(), "Envelope", NUM_POLYPHONIC_VOICES, Modulation::GainMode);
+		envelope->setAttribute(SimpleEnvelope::Attack, 0.0f, dontSendNotification);
+		envelope->setAttribute(SimpleEnvelope::Release, 5000.0f, dontSendNotification);
+		gainChain->getHandler()->add(envelope, nullptr);
+
+		gainChain->getHandler()->add(new VelocityModulator(tp.getMainController(), "Velocity", NUM_POLYPHONIC_VOICES, Modulation::GainMode), nullptr);
+
+		tp.waitUntilReady();
+
+		// The voice limit is scaled with the voice amount multiplier of the settings
+		synth->setVoiceLimit(roundToInt((float)VoiceLimit / tp.getMainController()->getVoiceAmountMultiplier()));
+		synth->setVoiceStealingPolicy(policy);
+
+		AudioSampleBuffer buffer(2, tp.getBlockSize());
+		MidiBuffer midi;
+
+		// Start the notes in separate blocks so that their uptimes differ. The same note is played on another
+		// channel, because a second note on with the same channel and note number would be ignored.
+		for (int i = 0; i < VoiceLimit; i++)
+		{
+			midi.clear();
+			midi.addEvent(MidiMessage::noteOn(i == SameNoteVoice ? 2 : 1, 60 + 2 * i, (uint8)(i == QuietVoice ? 1 : 127)), 0);
+			tp.render(buffer, midi);
+		}
+
+		midi.clear();
+		midi.addEvent(MidiMessage::noteOff(1, 60 + 2 * ReleasedVoice), 0);
+		tp.render(buffer, midi);
+
+		for (int i = 0; i < VoiceLimit; i++)
+		{
+			auto v = static_cast<ModulatorSynthVoice*>(synth->getVoice(i));
+			expect(!v->isInactive() && !v->isBeingKilled(), "Voice " + String(i) + " is not playing");
+			expect(v->isTailingOff() == (i == ReleasedVoice), "Voice " + String(i) + " release state");
+		}
+
+		// Start the note at the end of the block so that the kill fade can't finish before the check
+		midi.clear();
+		midi.addEvent(MidiMessage::noteOn(1, noteNumber, (uint8)127), tp.getBlockSize() - 1);
+		tp.render(buffer, midi);
+
+		for (int i = 0; i < VoiceLimit; i++)
+		{
+			auto v = static_cast<ModulatorSynthVoice*>(synth->getVoice(i));
+			expect(v->isBeingKilled() == (i == expectedVoice), "Voice " + String(i) + " kill state");
+		}
+
+		for (int i = 0; i < (int)Policy::numVoiceStealingPolicies; i++)
+		{
+			const auto p = (Policy)i;
+			expectEquals(synth->getNumStolenVoices(p), p == expectedCounter ? 1 : 0, "Stolen voices of " + getPolicyName(p));
+		}
+	}
+
+	static String getPolicyName(Policy p)
+	{
+		switch (p)
+		{
+		case Policy::ReleasedFirst:		return "ReleasedFirst";
+		case Policy::Oldest:			return "Oldest";
+		case Policy::LowestAmplitude:	return "LowestAmplitude";
+		case Policy::SameNoteFirst:		return "SameNoteFirst";
+		default:						return {};
+		}
+	}
+};
+
+static VoiceStealingTest voiceStealingTest;
+
+
+/** Renders the voice modulation with and without the constant and ramp detection (see ModulationBlockInfo) and compares the output. */
+class ModulationBlockInfoTest : public UnitTest
+{
+public:
+
+	ModulationBlockInfoTest() :
+		UnitTest("Testing the modulation block info")
+	{}
+
+	void runTest() override
+	{
+		testScenario(Sustain, "Applying the sustain as constant gain");
+		testScenario(Ramp, "Applying a changed voice start value as ramp");
+		testScenario(ClippedRamp, "Clipping a ramp below zero");
+	}
+
+private:
+
+	enum Scenario
+	{
+		Sustain = 0,	// the AHDSR reaches its sustain level
+		Ramp,			// the intensity of the velocity modulator is changed while the notes are playing
+		ClippedRamp		// the intensity is changed so that the gain of the quiet note goes below zero
+	};
+
+	enum
+	{
+		NumBlocks = 16,
+		IntensityBlock = 8,
+		QuietNote = 60,		// this voice will be tagged (the loud note is started last, so it's always calculated into the buffer)
+		LoudNote = 67
+	};
+
+	void testScenario(Scenario s, const String& name)
+	{
+		beginTest(name);
+
+		const AudioSampleBuffer tagged = render(s, true);
+		const AudioSampleBuffer untagged = render(s, false);
+
+		expect(untagged.getMagnitude(0, untagged.getNumSamples()) > 0.01f, "The output is silent");
+
+		expectBuffersAreEqual(*this, untagged, tagged, 1e-5f, "Tagged vs. untagged");
+	}
+
+	AudioSampleBuffer render(Scenario s, bool useBlockInfo)
+	{
+		UnitTestProcessor tp;
+
+		auto synth = tp.addSynth<SineSynth>("Sine");
+		auto mc = tp.getMainController();
+		auto gainChain = static_cast<ModulatorChain*>(synth->getChildProcessor(ModulatorSynth::GainModulation));
+
+		gainChain->setUseBlockInfo(useBlockInfo);
+
+		auto velocity = new VelocityModulator(mc, "Velocity", NUM_POLYPHONIC_VOICES, Modulation::GainMode);
+		gainChain->getHandler()->add(velocity, nullptr);
+
+		if (s == Sustain)
+		{
+			auto ahdsr = new AhdsrEnvelope(mc, "Envelope", NUM_POLYPHONIC_VOICES, Modulation::GainMode);
+			ahdsr->setAttribute(AhdsrEnvelope::Attack, 5.0f, dontSendNotification);
+			ahdsr->setAttribute(AhdsrEnvelope::Decay, 20.0f, dontSendNotification);
+			ahdsr->setAttribute(AhdsrEnvelope::Sustain, -12.0f, dontSendNotification);
+			gainChain->getHandler()->add(ahdsr, nullptr);
+		}
+
+		expect(tp.waitUntilReady(), "Timeout");
+
+		return tp.renderBlocks(NumBlocks, [s, velocity](int i, MidiBuffer& midi)
+		{
+			if (i == 0)
+			{
+				midi.addEvent(MidiMessage::noteOn(1, QuietNote, (uint8)50), 0);
+				midi.addEvent(MidiMessage::noteOn(1, LoudNote, (uint8)127), 1);
+			}
+
+			if (i == IntensityBlock && s != Sustain)
+				velocity->setIntensity(s == ClippedRamp ? 2.5f : 0.3f);
+		});
+	}
+};
+
+static ModulationBlockInfoTest modulationBlockInfoTest;
+
+
+/** Renders a polyphonic pattern with and without the batched envelope calculation (see EnvelopeModulator::calculateVoiceBlocks()) 
+*	and compares the output across the attack, decay, sustain and release phases.
+*/
+class BatchedEnvelopeTest : public UnitTest
+{
+public:
+
+	BatchedEnvelopeTest() :
+		UnitTest("Testing the batched envelopes")
+	{}
+
+	void runTest() override
+	{
+		beginTest("Calculating the envelopes of all voices at once");
+
+		const AudioSampleBuffer batched = renderNotes(true);
+		const AudioSampleBuffer single = renderNotes(false);
+
+		expect(single.getMagnitude(0, single.getNumSamples()) > 0.1f, "The output is silent");
+
+		for (int i = 0; i < NumBlocks; i++)
+		{
+			const AudioSampleBuffer expectedBlock(const_cast<float**>(single.getArrayOfReadPointers()), 2, i * BlockSize, BlockSize);
+			const AudioSampleBuffer actualBlock(const_cast<float**>(batched.getArrayOfReadPointers()), 2, i * BlockSize, BlockSize);
+
+			expectBuffersAreEqual(*this, expectedBlock, actualBlock, 1e-5f, "Block " + String(i));
+		}
+	}
+
+private:
+
+	enum
+	{
+		BlockSize = 512,
+		NumNotes = 8,
+		ReleaseBlock = 8,
+		NumBlocks = 20
+	};
+
+	AudioSampleBuffer renderNotes(bool useBatchedEnvelopes)
+	{
+		UnitTestProcessor tp(44100.0, BlockSize);
+
+		auto synth = tp.addSynth<SineSynth>("Sine");
+		auto mc = tp.getMainController();
+		auto gainChain = static_cast<ModulatorChain*>(synth->getChildProcessor(ModulatorSynth::GainModulation));
+		auto pitchChain = static_cast<ModulatorChain*>(synth->getChildProcessor(ModulatorSynth::PitchModulation));
+
+		gainChain->setUseBatchedEnvelopes(useBatchedEnvelopes);
+		pitchChain->setUseBatchedEnvelopes(useBatchedEnvelopes);
+
+		// attack and decay take a few blocks, so the voices are in different phases at every block
+		auto ahdsr = new AhdsrEnvelope(mc, "GainEnvelope", NUM_POLYPHONIC_VOICES, Modulation::GainMode);
+		ahdsr->setAttribute(AhdsrEnvelope::Attack, 20.0f, dontSendNotification);
+		ahdsr->setAttribute(AhdsrEnvelope::Decay, 40.0f, dontSendNotification);
+		ahdsr->setAttribute(AhdsrEnvelope::Sustain, -9.0f, dontSendNotification);
+		ahdsr->setAttribute(AhdsrEnvelope::Release, 60.0f, dontSendNotification);
+		gainChain->getHandler()->add(ahdsr, nullptr);
+
+		auto simple = new SimpleEnvelope(mc, "SimpleEnvelope", NUM_POLYPHONIC_VOICES, Modulation::GainMode);
+		simple->setAttribute(SimpleEnvelope::Attack, 30.0f, dontSendNotification);
+		simple->setAttribute(SimpleEnvelope::Release, 80.0f, dontSendNotification);
+		gainChain->getHandler()->add(simple, nullptr);
+
+		auto pitchEnvelope = new SimpleEnvelope(mc, "PitchEnvelope", NUM_POLYPHONIC_VOICES, Modulation::PitchMode);
+		pitchEnvelope->setAttribute(SimpleEnvelope::Attack, 50.0f, dontSendNotification);
+		pitchEnvelope->setIntensityFromSlider(5.0f);
+		pitchChain->getHandler()->add(pitchEnvelope, nullptr);
+
+		expect(tp.waitUntilReady(), "Timeout");
+
+		return tp.renderBlocks(NumBlocks, [](int i, MidiBuffer& midi)
+		{
+			for (int n = 0; n < NumNotes; n++)
+			{
+				const int noteNumber = 48 + 3 * n;
+				const int offset = (n * 61) % BlockSize;
+
+				// The notes are started and stopped in two blocks, so the voices are not in sync
+				if (i == n % 2)
+					midi.addEvent(MidiMessage::noteOn(1, noteNumber, (uint8)(50 + n * 10)), offset);
+
+				if (i == ReleaseBlock + n % 2)
+					midi.addEvent(MidiMessage::noteOff(1, noteNumber), offset);
+			}
+		});
+	}
+};
+
+static BatchedEnvelopeTest batchedEnvelopeTest;
+
+} // namespace hise
+
+#endif
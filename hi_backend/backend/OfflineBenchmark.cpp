@@ -0,0 +1,507 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+// This file must be the last one in the unity build because of the system headers
+#if JUCE_WINDOWS
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace hise { using namespace juce;
+
+OfflineBenchmark::OfflineBenchmark(MainController* mc_, const Settings& settings_) :
+	mc(mc_),
+	settings(settings_)
+{
+
+}
+
+juce::Result OfflineBenchmark::loadPreset()
+{
+	// The preset loading is only synchronous in command line mode
+	jassert(CompileExporter::isExportingFromCommandLine());
+
+	const File& f = settings.presetFile;
+
+	if (!f.existsAsFile())
+		return juce::Result::fail("The preset file " + f.getFullPathName() + " doesn't exist");
+
+	auto ap = mc->getAsAudioProcessor();
+
+	ap->setNonRealtime(true);
+	ap->prepareToPlay(settings.sampleRate, settings.blockSize);
+
+	if (f.hasFileExtension("hip"))
+	{
+		mc->loadPresetFromFile(f);
+	}
+	else if (f.hasFileExtension("xml"))
+	{
+		ScopedPointer<XmlElement> xml = XmlDocument::parse(f);
+
+		if (xml == nullptr)
+			return juce::Result::fail("The XML file " + f.getFullPathName() + " is not valid");
+
+		XmlBackupFunctions::restoreAllScripts(*xml, mc->getMainSynthChain(), xml->getStringAttribute("ID"));
+
+		mc->loadPresetFromValueTree(ValueTree::fromXml(*xml));
+	}
+	else
+	{
+		return juce::Result::fail("The preset must be a .hip or .xml file");
+	}
+
+	if (settings.numWorkers >= 0)
+		setParallelRendering(settings.numWorkers);
+
+	AudioSampleBuffer buffer(jmax<int>(2, ap->getTotalNumOutputChannels()), settings.blockSize);
+
+	if (!waitUntilReady(mc, buffer, 60.0))
+		return juce::Result::fail("The preset is still loading after 60 seconds");
+
+	return juce::Result::ok();
+}
+
+void OfflineBenchmark::setParallelRendering(int numWorkers)
+{
+	mc->getRealtimeWorkerPool().setNumWorkers(numWorkers);
+
+	const bool useWorkers = numWorkers > 0;
+
+	Processor::Iterator<ModulatorSynth> iter(mc->getMainSynthChain());
+
+	while (auto synth = iter.getNextProcessor())
+	{
+		if (auto chain = dynamic_cast<ModulatorSynthChain*>(synth))
+			chain->setUseParallelRendering(useWorkers);
+		else if (synth->canRenderVoicesInParallel())
+			synth->setUseParallelVoiceRendering(useWorkers);
+	}
+}
+
+bool OfflineBenchmark::waitUntilReady(MainController* mc, AudioSampleBuffer& buffer, double timeoutSeconds)
+{
+	auto ap = mc->getAsAudioProcessor();
+	MidiBuffer emptyMidi;
+
+	const double startTime = Time::getMillisecondCounterHiRes();
+	int numReadyBlocks = 0;
+
+	// The kill state handler only clears the pending actions in the audio callback
+	while (numReadyBlocks < 16)
+	{
+		if (Time::getMillisecondCounterHiRes() - startTime > timeoutSeconds * 1000.0)
+			return false;
+
+		buffer.clear();
+		emptyMidi.clear();
+
+		ap->processBlock(buffer, emptyMidi);
+
+#if JUCE_MODAL_LOOPS_PERMITTED
+		MessageManager::getInstance()->runDispatchLoopUntil(1);
+#else
+		Thread::sleep(1);
+#endif
+
+		const bool isReady = !mc->getKillStateHandler().voiceStartIsDisabled() && !mc->getSampleManager().isPreloading();
+
+		numReadyBlocks = isReady ? numReadyBlocks + 1 : 0;
+	}
+
+	return true;
+}
+
+MidiMessageSequence OfflineBenchmark::createMidiSequence() const
+{
+	MidiMessageSequence sequence;
+
+	if (settings.midiFile.existsAsFile())
+	{
+		FileInputStream fis(settings.midiFile);
+		MidiFile midiFile;
+
+		if (fis.openedOk() && midiFile.readFrom(fis))
+		{
+			midiFile.convertTimestampTicksToSeconds();
+
+			for (int i = 0; i < midiFile.getNumTracks(); i++)
+				sequence.addSequence(*midiFile.getTrack(i), 0.0, 0.0, std::numeric_limits<double>::max());
+
+			sequence.updateMatchedPairs();
+			return sequence;
+		}
+	}
+
+	// A deterministic pattern of overlapping chords over the whole key range
+	Random r(0x4853);
+
+	const double length = settings.lengthSeconds > 0.0 ? settings.lengthSeconds : 10.0;
+	const double noteLength = settings.chordInterval * 2.0;
+
+	for (double t = 0.0; t + noteLength < length; t += settings.chordInterval)
+	{
+		for (int i = 0; i < settings.numNotesPerChord; i++)
+		{
+			const int noteNumber = 36 + r.nextInt(60);
+			const uint8 velocity = (uint8)(32 + r.nextInt(96));
+
+			sequence.addEvent(MidiMessage::noteOn(1, noteNumber, velocity), t);
+			sequence.addEvent(MidiMessage::noteOff(1, noteNumber), t + noteLength);
+		}
+	}
+
+	sequence.sort();
+
+	return sequence;
+}
+
+OfflineBenchmark::Result OfflineBenchmark::render()
+{
+	Result result;
+
+	auto ap = mc->getAsAudioProcessor();
+
+	const double sampleRate = settings.sampleRate;
+	const int blockSize = settings.blockSize;
+	const int numChannels = jmax<int>(2, ap->getTotalNumOutputChannels());
+
+	const MidiMessageSequence sequence = createMidiSequence();
+
+	double length = settings.lengthSeconds;
+
+	if (length <= 0.0)
+		length = (settings.midiFile.existsAsFile() ? sequence.getEndTime() : 10.0) + 2.0;
+
+	const int numBlocks = jmax<int>(1, roundToInt(std::ceil(length * sampleRate / (double)blockSize)));
+
+	ScopedPointer<AudioFormatWriter> writer;
+
+	if (settings.outputFile != File())
+	{
+		settings.outputFile.deleteFile();
+
+		ScopedPointer<FileOutputStream> fos = settings.outputFile.createOutputStream();
+
+		if (fos != nullptr)
+		{
+			WavAudioFormat wav;
+
+			writer = wav.createWriterFor(fos, sampleRate, numChannels, 24, StringPairArray(), 0);
+
+			if (writer != nullptr)
+				fos.release();
+		}
+	}
+
+	AudioSampleBuffer buffer(numChannels, blockSize);
+	MidiBuffer midiBuffer;
+
+	Array<double> blockTimes;
+	blockTimes.ensureStorageAllocated(numBlocks);
+
+	mc->getSampleManager().getStreamingStatistics(true);
+
+	int eventIndex = 0;
+	double voiceSeconds = 0.0;
+
+	for (int i = 0; i < numBlocks; i++)
+	{
+		const int64 blockStart = (int64)i * (int64)blockSize;
+		const double blockEndTime = (double)(blockStart + blockSize) / sampleRate;
+
+		midiBuffer.clear();
+
+		while (eventIndex < sequence.getNumEvents())
+		{
+			const auto& m = sequence.getEventPointer(eventIndex)->message;
+
+			if (m.getTimeStamp() >= blockEndTime)
+				break;
+
+			const int offset = jlimit<int>(0, blockSize - 1, (int)(roundToInt(m.getTimeStamp() * sampleRate) - blockStart));
+
+			midiBuffer.addEvent(m, offset);
+
+			if (m.isNoteOn())
+				result.numNotes++;
+
+			eventIndex++;
+		}
+
+		buffer.clear();
+
+		const int64 startTicks = Time::getHighResolutionTicks();
+
+		ap->processBlock(buffer, midiBuffer);
+
+		const int64 endTicks = Time::getHighResolutionTicks();
+
+		blockTimes.add(Time::highResolutionTicksToSeconds(endTicks - startTicks) * 1000.0);
+
+		const int numVoices = mc->getNumActiveVoices();
+
+		result.peakVoices = jmax<int>(result.peakVoices, numVoices);
+		voiceSeconds += (double)numVoices * (double)blockSize / sampleRate;
+
+		if (writer != nullptr)
+			writer->writeFromAudioSampleBuffer(buffer, 0, blockSize);
+
+		// Keep the message queue from piling up (this is not measured)
+		if (i % 64 == 63)
+		{
+#if JUCE_MODAL_LOOPS_PERMITTED
+			MessageManager::getInstance()->runDispatchLoopUntil(0);
+#endif
+		}
+	}
+
+	writer = nullptr;
+
+	result.numBlocks = numBlocks;
+	result.renderedSeconds = (double)numBlocks * (double)blockSize / sampleRate;
+	result.blockDuration = 1000.0 * (double)blockSize / sampleRate;
+
+	double sum = 0.0;
+
+	for (auto t : blockTimes)
+		sum += t;
+
+	Array<double> sortedTimes(blockTimes);
+	sortedTimes.sort();
+
+	result.cpuSeconds = sum * 0.001;
+	result.meanBlockTime = sum / (double)numBlocks;
+	result.p99BlockTime = sortedTimes[jlimit<int>(0, numBlocks - 1, roundToInt(std::ceil(0.99 * (double)numBlocks)) - 1)];
+	result.maxBlockTime = sortedTimes.getLast();
+	result.voicesPerSecond = result.cpuSeconds > 0.0 ? voiceSeconds / result.cpuSeconds : 0.0;
+
+	var streamingStatistics = mc->getSampleManager().getStreamingStatistics(true);
+
+	result.numStreamingUnderruns = (int)streamingStatistics.getProperty("NumUnderruns", 0);
+	result.numEventOverflows = mc->getEventHandler().getNumOverflows();
+	result.peakMemory = getPeakMemoryUsage();
+
+	return result;
+}
+
+var OfflineBenchmark::Result::toJSON() const
+{
+	DynamicObject::Ptr obj = new DynamicObject();
+
+	obj->setProperty("NumBlocks", numBlocks);
+	obj->setProperty("RenderedSeconds", renderedSeconds);
+	obj->setProperty("CpuSeconds", cpuSeconds);
+	obj->setProperty("RealtimeFactor", cpuSeconds > 0.0 ? renderedSeconds / cpuSeconds : 0.0);
+	obj->setProperty("BlockDuration", blockDuration);
+	obj->setProperty("MeanBlockTime", meanBlockTime);
+	obj->setProperty("P99BlockTime", p99BlockTime);
+	obj->setProperty("MaxBlockTime", maxBlockTime);
+	obj->setProperty("NumNotes", numNotes);
+	obj->setProperty("PeakVoices", peakVoices);
+	obj->setProperty("VoicesPerSecond", voicesPerSecond);
+	obj->setProperty("StreamingUnderruns", numStreamingUnderruns);
+	obj->setProperty("EventOverflows", numEventOverflows);
+	obj->setProperty("PeakMemory", peakMemory);
+
+	return var(obj);
+}
+
+String OfflineBenchmark::Result::toString() const
+{
+	String s;
+	NewLine nl;
+
+	const double realtimeFactor = cpuSeconds > 0.0 ? renderedSeconds / cpuSeconds : 0.0;
+
+	s << "Rendered " << String(renderedSeconds, 2) << " seconds in " << String(cpuSeconds, 3) << " seconds (" << String(realtimeFactor, 1) << "x realtime)" << nl;
+	s << "Blocks: " << String(numBlocks) << " (" << String(blockDuration, 2) << " ms)" << nl;
+	s << "Time per block: mean " << String(meanBlockTime, 3) << " ms, p99 " << String(p99BlockTime, 3) << " ms, max " << String(maxBlockTime, 3) << " ms" << nl;
+	s << "Notes: " << String(numNotes) << ", peak voices: " << String(peakVoices) << ", voices/second: " << String(voicesPerSecond, 1) << nl;
+	s << "Streaming underruns: " << String(numStreamingUnderruns) << ", event overflows: " << String(numEventOverflows) << nl;
+	s << "Peak memory: " << (peakMemory >= 0 ? String((double)peakMemory / 1024.0 / 1024.0, 1) + " MB" : String("unknown")) << nl;
+
+	return s;
+}
+
+int64 OfflineBenchmark::getPeakMemoryUsage()
+{
+#if JUCE_WINDOWS
+	PROCESS_MEMORY_COUNTERS counters;
+
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return (int64)counters.PeakWorkingSetSize;
+
+	return -1;
+#elif JUCE_MAC || JUCE_LINUX
+	struct rusage usage;
+
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return -1;
+
+#if JUCE_MAC
+	return (int64)usage.ru_maxrss;
+#else
+	// Linux reports kilobytes
+	return (int64)usage.ru_maxrss * 1024;
+#endif
+#else
+	return -1;
+#endif
+}
+
+int OfflineBenchmark::runFromCommandLine(const String& commandLine)
+{
+	StringArray args = StringArray::fromTokens(commandLine, true);
+	args.remove(0);
+
+	auto getArgument = [&args](const String& prefix)
+	{
+		for (auto arg : args)
+		{
+			if (arg.unquoted().startsWith(prefix))
+				return arg.unquoted().fromFirstOccurrenceOf(prefix, false, false);
+		}
+
+		return String();
+	};
+
+	auto getFile = [](const String& path)
+	{
+		if (path.isEmpty())
+			return File();
+
+		return File::isAbsolutePath(path) ? File(path) : File::getCurrentWorkingDirectory().getChildFile(path);
+	};
+
+	if (args.isEmpty() || args[0].startsWith("-"))
+	{
+		std::cout << "ERROR: No preset file specified" << std::endl;
+		return 1;
+	}
+
+	Settings s;
+
+	s.presetFile = getFile(args[0].unquoted());
+	s.midiFile = getFile(getArgument("-m:"));
+	s.outputFile = getFile(getArgument("-o:"));
+	s.reportFile = getFile(getArgument("-j:"));
+
+	if (getArgument("-sr:").isNotEmpty())
+		s.sampleRate = getArgument("-sr:").getDoubleValue();
+
+	if (getArgument("-bs:").isNotEmpty())
+		s.blockSize = getArgument("-bs:").getIntValue();
+
+	if (getArgument("-l:").isNotEmpty())
+		s.lengthSeconds = getArgument("-l:").getDoubleValue();
+
+	if (getArgument("-w:").isNotEmpty())
+		s.numWorkers = getArgument("-w:").getIntValue();
+
+	if (getArgument("-n:").isNotEmpty())
+		s.numNotesPerChord = getArgument("-n:").getIntValue();
+
+	if (getArgument("-i:").isNotEmpty())
+		s.chordInterval = getArgument("-i:").getDoubleValue();
+
+	if (s.sampleRate <= 0.0 || s.blockSize <= 0 || s.chordInterval <= 0.0)
+	{
+		std::cout << "ERROR: Invalid sample rate, block size or chord interval" << std::endl;
+		return 1;
+	}
+
+	if (s.midiFile != File() && !s.midiFile.existsAsFile())
+	{
+		std::cout << "ERROR: The MIDI file " << s.midiFile.getFullPathName() << " doesn't exist" << std::endl;
+		return 1;
+	}
+
+	CompileExporter::setExportingFromCommandLine();
+
+	ScopedPointer<StandaloneProcessor> sp = new StandaloneProcessor();
+	ScopedPointer<MainController> mc = dynamic_cast<MainController*>(sp->createProcessor());
+
+	auto& handler = GET_PROJECT_HANDLER(mc->getMainSynthChain());
+
+	const File previousProject = handler.getWorkDirectory();
+	const File projectDirectory = s.presetFile.getParentDirectory().getParentDirectory();
+	const bool switchProject = previousProject != projectDirectory;
+
+	if (switchProject)
+		handler.setWorkingProject(projectDirectory, nullptr);
+
+	int exitCode = 0;
+
+	{
+		OfflineBenchmark benchmark(mc, s);
+
+		std::cout << "Loading the preset...";
+
+		auto loadResult = benchmark.loadPreset();
+
+		if (loadResult.wasOk())
+		{
+			std::cout << "DONE" << std::endl << std::endl;
+
+			auto result = benchmark.render();
+
+			std::cout << result.toString() << std::endl;
+
+			if (s.reportFile != File() && !s.reportFile.replaceWithText(JSON::toString(result.toJSON())))
+			{
+				std::cout << "ERROR: Can't write the report to " << s.reportFile.getFullPathName() << std::endl;
+				exitCode = 1;
+			}
+		}
+		else
+		{
+			std::cout << std::endl << "ERROR: " << loadResult.getErrorMessage() << std::endl;
+			exitCode = 1;
+		}
+	}
+
+	if (switchProject)
+		handler.setWorkingProject(previousProject, nullptr);
+
+	mc = nullptr;
+	sp = nullptr;
+
+	return exitCode;
+}
+
+} // namespace hise
@@ -0,0 +1,128 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef OFFLINEBENCHMARK_H_INCLUDED
+#define OFFLINEBENCHMARK_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** Renders a preset without audio device and measures the CPU time of the audio callback.
+*
+*	The preset is fed with a MIDI file or a generated note pattern and rendered as fast as possible
+*	(optionally into a WAV file). The result contains the time per block, the voice throughput and
+*	the peak memory usage of the process, so it can be used for performance regression tests.
+*
+*	This is used by the `benchmark` command of the HISE command line tool (see runFromCommandLine()).
+*/
+class OfflineBenchmark
+{
+public:
+
+	struct Settings
+	{
+		File presetFile;			///< the .hip or .xml file that will be loaded
+		File midiFile;				///< if this doesn't exist, the note pattern is used
+		File outputFile;			///< if not empty, the rendered audio is written to this WAV file
+		File reportFile;			///< if not empty, the result is written to this JSON file
+
+		double sampleRate = 44100.0;
+		int blockSize = 512;
+		double lengthSeconds = -1.0;	///< the length of the rendering (-1 uses the MIDI file length plus two seconds)
+		int numWorkers = -1;			///< the number of realtime worker threads for the parallel rendering (-1 keeps the settings of the preset)
+
+		int numNotesPerChord = 8;		///< the amount of notes that the pattern starts at once
+		double chordInterval = 0.125;	///< the time in seconds between two chords of the pattern
+	};
+
+	struct Result
+	{
+		/** Creates a JSON object with all values. */
+		var toJSON() const;
+
+		/** Creates a readable summary. */
+		String toString() const;
+
+		int numBlocks = 0;
+		double renderedSeconds = 0.0;
+		double cpuSeconds = 0.0;
+
+		double meanBlockTime = 0.0;		///< in milliseconds
+		double p99BlockTime = 0.0;
+		double maxBlockTime = 0.0;
+		double blockDuration = 0.0;		///< the duration of a block in milliseconds
+
+		int numNotes = 0;
+		int peakVoices = 0;
+		double voicesPerSecond = 0.0;	///< the rendered voice seconds per CPU second
+
+		int numStreamingUnderruns = 0;
+		int numEventOverflows = 0;		///< the number of artificial note ons that were lost (see MainController::EventIdHandler::getNumOverflows())
+		int64 peakMemory = -1;			///< the peak resident memory of the process in bytes (-1 if unknown)
+	};
+
+	OfflineBenchmark(MainController* mc, const Settings& settings);
+
+	/** Loads the preset and waits until all samples are preloaded. */
+	juce::Result loadPreset();
+
+	/** Renders the preset and returns the measurements. */
+	Result render();
+
+	/** Parses the command line arguments, runs the benchmark and prints the result. Returns the exit code. */
+	static int runFromCommandLine(const String& commandLine);
+
+	/** Returns the peak resident memory of the process in bytes or -1 if it can't be determined on this platform. */
+	static int64 getPeakMemoryUsage();
+
+	/** Renders silent blocks into the buffer until nothing is pending (script compilation, voice killing, sample loading).
+	*
+	*	Returns false if the timeout is reached. The unit tests use this to render a MainController without audio device.
+	*/
+	static bool waitUntilReady(MainController* mc, AudioSampleBuffer& buffer, double timeoutSeconds);
+
+private:
+
+	/** Creates the note pattern or loads the MIDI file with time stamps in seconds. */
+	MidiMessageSequence createMidiSequence() const;
+
+	/** Sets the number of workers and enables the parallel rendering of all synth chains and voices (or disables it if the number is zero). */
+	void setParallelRendering(int numWorkers);
+
+	MainController* mc;
+	Settings settings;
+
+	JUCE_DECLARE_NON_COPYABLE(OfflineBenchmark)
+};
+
+} // namespace hise
+
+#endif  // OFFLINEBENCHMARK_H_INCLUDED
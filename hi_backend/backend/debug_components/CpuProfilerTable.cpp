@@ -0,0 +1,200 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+CpuProfilerTable::CpuProfilerTable(BackendRootWindow* rootWindow) :
+	profiler(rootWindow->getBackendProcessor()->getCpuProfiler()),
+	font(GLOBAL_FONT())
+{
+	setName(getHeadline());
+
+	addAndMakeVisible(table);
+	table.setModel(this);
+
+	laf = new TableHeaderLookAndFeel();
+
+	table.getHeader().setLookAndFeel(laf);
+	table.getHeader().setSize(getWidth(), 22);
+
+	table.setColour(ListBox::outlineColourId, Colours::black.withAlpha(0.5f));
+	table.setColour(ListBox::backgroundColourId, HiseColourScheme::getColour(HiseColourScheme::ColourIds::DebugAreaBackgroundColourId));
+
+	table.setOutlineThickness(0);
+
+	table.getViewport()->setScrollBarsShown(true, false, false, false);
+
+	table.getHeader().addColumn("Module", Name, 200);
+	table.getHeader().addColumn("Location", Location, 150);
+	table.getHeader().addColumn("Mean", Mean, 60);
+	table.getHeader().addColumn("P99", P99, 60);
+	table.getHeader().addColumn("Max", Max, 60);
+	table.getHeader().addColumn("Calls", Calls, 50);
+	table.getHeader().addColumn("%", Share, 50);
+
+	table.addMouseListener(this, true);
+
+	refresh();
+
+	startTimer(500);
+}
+
+CpuProfilerTable::~CpuProfilerTable()
+{
+	stopTimer();
+}
+
+void CpuProfilerTable::timerCallback()
+{
+	// The statistics only change while the profiler is running
+	if (profiler.isEnabled())
+		refresh();
+}
+
+void CpuProfilerTable::refresh()
+{
+	rows.clear();
+	addRows(profiler.createProfileTree(), 0);
+
+	setName(getHeadline());
+	table.updateContent();
+	table.repaint();
+
+	if (getParentComponent() != nullptr)
+		getParentComponent()->repaint();
+}
+
+void CpuProfilerTable::addRows(const var& nodeList, int depth)
+{
+	if (auto list = nodeList.getArray())
+	{
+		for (const auto& node : *list)
+		{
+			rows.push_back({ node, depth });
+			addRows(node.getProperty("Children", var()), depth + 1);
+		}
+	}
+}
+
+int CpuProfilerTable::getNumRows()
+{
+	return (int)rows.size();
+}
+
+void CpuProfilerTable::paintRowBackground(Graphics& g, int rowNumber, int /*width*/, int /*height*/, bool rowIsSelected)
+{
+	if (rowNumber % 2) g.fillAll(Colours::white.withAlpha(0.05f));
+
+	if (rowIsSelected)
+		g.fillAll(Colour(0x44000000));
+}
+
+void CpuProfilerTable::paintCell(Graphics& g, int rowNumber, int columnId, int width, int height, bool /*rowIsSelected*/)
+{
+	if (!isPositiveAndBelow(rowNumber, (int)rows.size()))
+		return;
+
+	const Row& r = rows[rowNumber];
+
+	g.setColour(Colours::white.withAlpha(.8f));
+	g.setFont(r.depth == 0 ? font.boldened() : font);
+
+	int x = 2;
+	String text;
+
+	switch (columnId)
+	{
+	case Name:		text = r.node.getProperty("Name", "").toString(); x += 10 * r.depth; break;
+	case Location:	text = r.node.getProperty("Location", "").toString(); break;
+	case Mean:		text = String((double)r.node.getProperty("Mean", 0.0), 3); break;
+	case P99:		text = String((double)r.node.getProperty("P99", 0.0), 3); break;
+	case Max:		text = String((double)r.node.getProperty("Max", 0.0), 3); break;
+	case Calls:		text = String((double)r.node.getProperty("Calls", 0.0), 1); break;
+	case Share:		text = String((double)r.node.getProperty("Share", 0.0), 1); break;
+	default:		break;
+	}
+
+	g.drawText(text, x, 0, width - x - 2, height, Justification::centredLeft, true);
+}
+
+String CpuProfilerTable::getHeadline() const
+{
+	String x;
+
+	x << "CPU Profiler - " << (profiler.isEnabled() ? "running" : "stopped (right click to start)");
+	return x;
+}
+
+void CpuProfilerTable::resized()
+{
+	table.setBounds(getLocalBounds());
+
+	const int valueWidth = 50;
+
+	table.getHeader().setColumnWidth(Name, jmax<int>(100, getWidth() - 130 - 5 * valueWidth - 16));
+	table.getHeader().setColumnWidth(Location, 130);
+
+	for (int i = Mean; i < numColumns; i++)
+		table.getHeader().setColumnWidth(i, valueWidth);
+}
+
+void CpuProfilerTable::mouseDown(const MouseEvent &e)
+{
+	if (e.mods.isLeftButtonDown()) return;
+
+	PopupMenu m;
+
+	m.setLookAndFeel(&plaf);
+
+	enum
+	{
+		EnableProfiler = 1,
+		ResetStatistics,
+		numOperations
+	};
+
+	m.addItem(EnableProfiler, "Enable CPU profiler", true, profiler.isEnabled());
+	m.addItem(ResetStatistics, "Clear statistics");
+
+	const int result = m.show();
+
+	switch (result)
+	{
+	case EnableProfiler:	profiler.setEnabled(!profiler.isEnabled()); break;
+	case ResetStatistics:	profiler.reset(); break;
+	default:				return;
+	}
+
+	refresh();
+}
+
+} // namespace hise
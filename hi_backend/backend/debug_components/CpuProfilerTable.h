@@ -0,0 +1,110 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef CPUPROFILERTABLE_H_INCLUDED
+#define CPUPROFILERTABLE_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** A table with the measurements of the CpuProfiler.
+*	@ingroup debugComponents
+*
+*	Every row is a node of the profile tree (the children are indented below their parent). The times are in milliseconds
+*	per audio callback. Right click the table to start or stop the profiler and to clear the statistics.
+*/
+class CpuProfilerTable : public Component,
+						 public TableListBoxModel,
+						 public Timer
+{
+public:
+
+	enum ColumnId
+	{
+		Name = 1,
+		Location,
+		Mean,
+		P99,
+		Max,
+		Calls,
+		Share,
+		numColumns
+	};
+
+	CpuProfilerTable(BackendRootWindow* rootWindow);
+
+	SET_GENERIC_PANEL_ID("CpuProfilerTable");
+
+	~CpuProfilerTable();
+
+	void timerCallback() override;
+
+	int getNumRows() override;
+
+	void paintRowBackground(Graphics& g, int rowNumber, int /*width*/, int /*height*/, bool rowIsSelected) override;
+
+	void paintCell(Graphics& g, int rowNumber, int columnId, int width, int height, bool /*rowIsSelected*/) override;
+
+	String getHeadline() const;
+
+	void resized() override;
+
+	void mouseDown(const MouseEvent &e) override;
+
+private:
+
+	struct Row
+	{
+		var node;
+		int depth;
+	};
+
+	/** Rebuilds the rows from the current profile tree. */
+	void refresh();
+
+	void addRows(const var& nodeList, int depth);
+
+	CpuProfiler& profiler;
+
+	std::vector<Row> rows;
+
+	TableListBox table;
+	Font font;
+
+	ScopedPointer<TableHeaderLookAndFeel> laf;
+	PopupLookAndFeel plaf;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CpuProfilerTable)
+};
+
+} // namespace hise
+
+#endif  // CPUPROFILERTABLE_H_INCLUDED
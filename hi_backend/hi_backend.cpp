@@ -39,6 +39,7 @@
 #include "backend/BackendCommandIcons.cpp"
 
 #include "backend/debug_components/SamplePoolTable.cpp"
+#include "backend/debug_components/CpuProfilerTable.cpp"
 #include "backend/debug_components/MacroEditTable.cpp"
 #include "backend/debug_components/ScriptWatchTable.cpp"
 #include "backend/debug_components/ScriptComponentEditPanel.cpp"
@@ -68,4 +69,5 @@
 
 #include "backend/CompileExporter.cpp"
 #include "backend/HisePlayerExporter.cpp"
+#include "backend/OfflineBenchmark.cpp"
 
@@ -59,6 +59,7 @@ END_JUCE_MODULE_DECLARATION
 #include "backend/BackendBinaryData.h"
 
 #include "backend/debug_components/SamplePoolTable.h"
+#include "backend/debug_components/CpuProfilerTable.h"
 #include "backend/debug_components/MacroEditTable.h"
 #include "backend/debug_components/ScriptWatchTable.h"
 #include "backend/debug_components/ScriptComponentEditPanel.h"
@@ -81,6 +82,7 @@ END_JUCE_MODULE_DECLARATION
 #include "backend/BackendRootWindow.h"
 #include "backend/CompileExporter.h"
 #include "backend/HisePlayerExporter.h"
+#include "backend/OfflineBenchmark.h"
 
 
 
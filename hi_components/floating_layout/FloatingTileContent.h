@@ -472,6 +472,7 @@ public:
 			SampleMapBrowser,
 			WavetablePreview,
 			FilterGraphPanel,
+			CpuProfilerTable,
 			Matrix2x2,
 			ThreeColumns,
 			ThreeRows,
@@ -54,6 +54,7 @@ void FloatingTileContent::Factory::registerAllPanelTypes()
 	registerType<GenericPanel<SamplePoolTable>>(PopupMenuOptions::SamplePoolTable);
 	registerType<GenericPanel<PoolTableSubTypes::ImageFilePoolTable>>(PopupMenuOptions::ImageTable);
 	registerType<GenericPanel<PoolTableSubTypes::AudioFilePoolTable>>(PopupMenuOptions::AudioFileTable);
+	registerType<GenericPanel<CpuProfilerTable>>(PopupMenuOptions::CpuProfilerTable);
 	registerType<MainTopBar>(PopupMenuOptions::MenuCommandOffset);
 	registerType<BackendProcessorEditor>(PopupMenuOptions::MenuCommandOffset);
 	registerType<ScriptWatchTablePanel>(PopupMenuOptions::ScriptWatchTable);
@@ -586,6 +587,7 @@ void FloatingTileContent::Factory::handlePopupMenu(PopupMenu& m, FloatingTile* p
 			addToPopupMenu(m, PopupMenuOptions::MacroTable, "Macro Control Editor");
 			addToPopupMenu(m, PopupMenuOptions::Plotter, "Plotter");
 			addToPopupMenu(m, PopupMenuOptions::AudioAnalyser, "Audio Analyser");
+			addToPopupMenu(m, PopupMenuOptions::CpuProfilerTable, "CPU Profiler");
 			addToPopupMenu(m, PopupMenuOptions::TablePanel, "Table Editor");
 			addToPopupMenu(m, PopupMenuOptions::PresetBrowser, "Preset Browser");
 			addToPopupMenu(m, PopupMenuOptions::ModuleBrowser, "Module Browser");
@@ -697,6 +699,7 @@ void FloatingTileContent::Factory::handlePopupMenu(PopupMenu& m, FloatingTile* p
 	case PopupMenuOptions::AudioFileTable:		parent->setNewContent(GET_PANEL_NAME(GenericPanel<PoolTableSubTypes::AudioFilePoolTable>)); break;
 	case PopupMenuOptions::ImageTable:			parent->setNewContent(GET_PANEL_NAME(GenericPanel<PoolTableSubTypes::ImageFilePoolTable>)); break;
 	case PopupMenuOptions::ScriptWatchTable:		parent->setNewContent(GET_PANEL_NAME(GenericPanel<ScriptWatchTable>)); break;
+	case PopupMenuOptions::CpuProfilerTable:	parent->setNewContent(GET_PANEL_NAME(GenericPanel<CpuProfilerTable>)); break;
 	case PopupMenuOptions::toggleGlobalLayoutMode:    parent->getRootFloatingTile()->setLayoutModeEnabled(!parent->isLayoutModeEnabled()); break;
 	case PopupMenuOptions::exportAsJSON:		SystemClipboard::copyTextToClipboard(parent->exportAsJSON()); break;
 	case PopupMenuOptions::loadFromJSON:		parent->loadFromJSON(SystemClipboard::getTextFromClipboard()); break;
@@ -175,6 +175,39 @@ Set this to 0 to deactivate the safe checks for scripting
 #define ENABLE_SCRIPTING_SAFE_CHECKS 1
 #endif
 
+/** Config: HISE_USE_SCRIPT_BYTECODE
+
+Set this to 1 to compile the script callbacks to bytecode instead of executing them with the expression tree interpreter.
+If it's 0, the bytecode can still be enabled for a single engine with HiseJavascriptEngine::setUseBytecode().
+*/
+#ifndef HISE_USE_SCRIPT_BYTECODE
+#define HISE_USE_SCRIPT_BYTECODE 0
+#endif
+
+/** Config: HISE_ALLOCATION_FREE_CALLBACKS
+
+If this is enabled, scripts with expressions that allocate memory in the realtime callbacks (string concatenation, object or array literals, growing arrays) will not compile. Otherwise they are reported as warnings. 
+*/
+#ifndef HISE_ALLOCATION_FREE_CALLBACKS
+#define HISE_ALLOCATION_FREE_CALLBACKS 0
+#endif
+
+/** Config: HISE_COUNT_SCRIPT_ALLOCATIONS
+
+If this is enabled, the allocations of every script callback are counted and shown in the watch table. The script engine reports the allocations of string concatenations, object and array literals and growing arrays. If a realtime callback without warnings allocates memory, an assertion will fire. This is enabled for debug builds of HISE by default.
+*/
+#ifndef HISE_COUNT_SCRIPT_ALLOCATIONS
+#define HISE_COUNT_SCRIPT_ALLOCATIONS (JUCE_DEBUG && USE_BACKEND)
+#endif
+
+/** Config: HISE_COUNT_ALL_SCRIPT_ALLOCATIONS
+
+If this is enabled together with HISE_COUNT_SCRIPT_ALLOCATIONS, the global operator new and delete are replaced, so that the allocations of the API calls are counted too. This affects every allocation of the application, so it's disabled by default.
+*/
+#ifndef HISE_COUNT_ALL_SCRIPT_ALLOCATIONS
+#define HISE_COUNT_ALL_SCRIPT_ALLOCATIONS 0
+#endif
+
 /** Config: CRASH_ON_GLITCH
  
 If this is set to 1, the application will crash instantly if there is a drop out or a burst in the signal (values above 32dB = +36dB ). Use this to get a crash dump with the location.
@@ -226,6 +259,57 @@ If this is enabled, compiled plugins will write a startup log to the desktop for
 
 
 
+/** Config: HISE_USE_PARALLEL_SYNTH_RENDERING
+
+If set to 1, the child synths of every ModulatorSynthChain are rendered in parallel on the worker threads of the RealtimeWorkerPool by default. The workers are started in MainController::prepareToPlay().
+*/
+#ifndef HISE_USE_PARALLEL_SYNTH_RENDERING
+#define HISE_USE_PARALLEL_SYNTH_RENDERING 0
+#endif
+
+/** Config: HISE_MAX_REALTIME_WORKERS
+
+The maximum amount of worker threads that are used for the parallel rendering.
+*/
+#ifndef HISE_MAX_REALTIME_WORKERS
+#define HISE_MAX_REALTIME_WORKERS 8
+#endif
+
+/** Config: HISE_REALTIME_WORKER_SPIN_TIME_US
+
+The time in microseconds that an idle realtime worker keeps spinning after a task before it parks on the wake up semaphore.
+*/
+#ifndef HISE_REALTIME_WORKER_SPIN_TIME_US
+#define HISE_REALTIME_WORKER_SPIN_TIME_US 200
+#endif
+
+/** Config: HISE_MIN_VOICES_PER_RENDER_TASK
+
+The minimum amount of active voices per thread if a synth renders its voices in parallel. If there are less voices, 
+they will be rendered on less threads (or serially on the audio thread).
+*/
+#ifndef HISE_MIN_VOICES_PER_RENDER_TASK
+#define HISE_MIN_VOICES_PER_RENDER_TASK 4
+#endif
+
+/** Config: HISE_MIN_VOICES_FOR_BATCHED_ENVELOPES
+
+The minimum amount of active voices before the envelopes calculate the blocks of all voices at once. Below this
+amount, every voice calculates its envelope block separately.
+*/
+#ifndef HISE_MIN_VOICES_FOR_BATCHED_ENVELOPES
+#define HISE_MIN_VOICES_FOR_BATCHED_ENVELOPES 4
+#endif
+
+/** Config: HISE_ENABLE_CPU_PROFILER
+
+Set this to 0 to remove the per-module CPU profiler from the audio rendering. If it's enabled, 
+it still doesn't measure anything until you start it (and then costs two timer reads per module).
+*/
+#ifndef HISE_ENABLE_CPU_PROFILER
+#define HISE_ENABLE_CPU_PROFILER 1
+#endif
+
 /** Config: ENABLE_CPU_MEASUREMENT
 
 Set this to 0 to deactivate the CPU peak meter.
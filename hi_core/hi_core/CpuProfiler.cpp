@@ -0,0 +1,531 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+static std::atomic<uint32> nextCpuProfilerInstanceId(1);
+
+static thread_local uint64 currentProfilerScope = 0;
+
+// The buffer of the last profiler that was used on this thread (so the slot lookup only happens once per thread).
+static thread_local uint32 cachedProfilerSlotGeneration = 0;
+static thread_local void* cachedProfilerBuffer = nullptr;
+
+static uint64 createProfilerScopeId(uint64 parentScope, const Processor* p, int location) noexcept
+{
+	uint64 h = parentScope * 0x100000001B3ULL;
+
+	h ^= (uint64)(pointer_sized_uint)p;
+	h ^= (uint64)(location + 1) << 56;
+
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+
+	// zero is the root scope
+	return h != 0 ? h : 1;
+}
+
+CpuProfiler::CpuProfiler(MainController* mc_) :
+	Thread("CPU Profiler"),
+	mc(mc_),
+	enabled(false),
+	blockIndex(0),
+	numDroppedEvents(0),
+	slotGeneration(nextCpuProfilerInstanceId.fetch_add(1))
+{
+
+}
+
+CpuProfiler::~CpuProfiler()
+{
+	enabled.store(false);
+	stopThread(1000);
+}
+
+void CpuProfiler::setEnabled(bool shouldBeEnabled)
+{
+	if (shouldBeEnabled && !buffersAllocated)
+	{
+		// The buffers are never freed while the profiler exists because a scope might still write into them
+		for (auto& b : threadBuffers)
+			b.events.calloc(NumEventsPerThread);
+
+		history.calloc(NumHistoryEvents);
+
+		buffersAllocated = true;
+	}
+
+	enabled.store(shouldBeEnabled);
+
+	if (shouldBeEnabled && !isThreadRunning())
+		startThread(3);
+}
+
+void CpuProfiler::reset()
+{
+	ScopedLock sl(statsLock);
+
+	// drop the pending events
+	Event unused;
+
+	for (auto& b : threadBuffers)
+		while (b.pop(unused))
+			;
+
+	nodeMap.clear();
+	nodes.clear();
+	pendingEvents.clearQuick();
+	numHistoryEvents = 0;
+	numDroppedEvents.store(0);
+}
+
+void CpuProfiler::releaseThreadBuffers() noexcept
+{
+	for (auto& b : threadBuffers)
+		b.threadId.store(nullptr);
+
+	// The generation is unique across all profilers, so a thread never reuses a cached buffer of another instance
+	slotGeneration.store(nextCpuProfilerInstanceId.fetch_add(1));
+}
+
+uint64 CpuProfiler::getCurrentScope() noexcept
+{
+	return currentProfilerScope;
+}
+
+CpuProfiler::ThreadBuffer* CpuProfiler::getBufferForCurrentThread() noexcept
+{
+	const uint32 generation = slotGeneration.load();
+
+	if (cachedProfilerSlotGeneration == generation)
+		return static_cast<ThreadBuffer*>(cachedProfilerBuffer);
+
+	const auto id = Thread::getCurrentThreadId();
+
+	ThreadBuffer* buffer = nullptr;
+
+	for (auto& b : threadBuffers)
+	{
+		if (b.threadId.load() == id)
+		{
+			buffer = &b;
+			break;
+		}
+	}
+
+	if (buffer == nullptr)
+	{
+		for (auto& b : threadBuffers)
+		{
+			Thread::ThreadID expected = nullptr;
+
+			if (b.threadId.compare_exchange_strong(expected, id))
+			{
+				buffer = &b;
+				break;
+			}
+		}
+	}
+
+	// If all slots are taken, the events of this thread will be dropped.
+	cachedProfilerSlotGeneration = generation;
+	cachedProfilerBuffer = buffer;
+
+	return buffer;
+}
+
+void CpuProfiler::addEvent(Event& e) noexcept
+{
+	auto b = getBufferForCurrentThread();
+
+	if (b == nullptr)
+	{
+		numDroppedEvents.fetch_add(1);
+		return;
+	}
+
+	e.blockIndex = blockIndex.load(std::memory_order_relaxed);
+	e.threadIndex = (int16)(b - threadBuffers);
+
+	if (!b->push(e))
+		numDroppedEvents.fetch_add(1);
+}
+
+bool CpuProfiler::ThreadBuffer::push(const Event& e) noexcept
+{
+	const uint32 w = writeIndex.load(std::memory_order_relaxed);
+
+	if (w - readIndex.load(std::memory_order_acquire) >= (uint32)NumEventsPerThread)
+		return false;
+
+	events[w % NumEventsPerThread] = e;
+	writeIndex.store(w + 1, std::memory_order_release);
+
+	return true;
+}
+
+bool CpuProfiler::ThreadBuffer::pop(Event& e) noexcept
+{
+	const uint32 r = readIndex.load(std::memory_order_relaxed);
+
+	if (r == writeIndex.load(std::memory_order_acquire))
+		return false;
+
+	e = events[r % NumEventsPerThread];
+	readIndex.store(r + 1, std::memory_order_release);
+
+	return true;
+}
+
+void CpuProfiler::run()
+{
+	while (!threadShouldExit())
+	{
+		processEvents();
+		wait(isEnabled() ? 10 : 200);
+	}
+}
+
+bool CpuProfiler::processEvents()
+{
+	ScopedLock sl(statsLock);
+
+	// Every callback before this one has finished, so all of its events are in the thread buffers
+	const uint32 currentBlock = blockIndex.load(std::memory_order_acquire);
+
+	bool found = false;
+	Event e;
+
+	for (auto& b : threadBuffers)
+	{
+		while (b.pop(e))
+		{
+			found = true;
+
+			pendingEvents.add(e);
+			history[(int)(numHistoryEvents++ % NumHistoryEvents)] = e;
+		}
+	}
+
+	if (!found)
+		return false;
+
+	auto isFinished = [currentBlock](const Event& ev) { return (int32)(ev.blockIndex - currentBlock) < 0; };
+
+	auto firstPending = std::stable_partition(pendingEvents.begin(), pendingEvents.end(), isFinished);
+
+	std::stable_sort(pendingEvents.begin(), firstPending, [](const Event& first, const Event& second)
+	{
+		return (int32)(first.blockIndex - second.blockIndex) < 0;
+	});
+
+	for (auto it = pendingEvents.begin(); it != firstPending; ++it)
+	{
+		auto n = nodeMap[it->scope];
+
+		if (n == nullptr)
+		{
+			n = nodes.add(new Node(*it));
+			nodeMap.set(it->scope, n);
+		}
+
+		n->addEvent(*it);
+	}
+
+	// The last callback of every node is complete too
+	for (auto n : nodes)
+		n->commitBlock();
+
+	pendingEvents.removeRange(0, (int)(firstPending - pendingEvents.begin()));
+
+	return true;
+}
+
+CpuProfiler::Node::Node(const Event& e) :
+	scope(e.scope),
+	parentScope(e.parentScope),
+	processor(e.processor),
+	location(e.location),
+	currentBlock(e.blockIndex)
+{
+	zeromem(histogram, sizeof(histogram));
+}
+
+void CpuProfiler::Node::addEvent(const Event& e) noexcept
+{
+	if (e.blockIndex != currentBlock)
+	{
+		commitBlock();
+		currentBlock = e.blockIndex;
+	}
+
+	currentDuration += Time::highResolutionTicksToSeconds(e.endTicks - e.startTicks) * 1000.0;
+	currentCalls++;
+}
+
+void CpuProfiler::Node::commitBlock() noexcept
+{
+	if (currentCalls == 0)
+		return;
+
+	numBlocks++;
+	numCalls += currentCalls;
+	sum += currentDuration;
+	max = jmax<double>(max, currentDuration);
+
+	// logarithmic buckets starting at one microsecond
+	const double micros = currentDuration * 1000.0;
+	const int bucket = micros > 1.0 ? jlimit<int>(0, NumHistogramBuckets - 1, (int)(std::log2(micros) * (double)BucketsPerOctave)) : 0;
+
+	histogram[bucket]++;
+
+	currentDuration = 0.0;
+	currentCalls = 0;
+}
+
+double CpuProfiler::Node::getPercentile(double percent) const noexcept
+{
+	if (numBlocks == 0)
+		return 0.0;
+
+	const int64 threshold = (int64)std::ceil((double)numBlocks * percent / 100.0);
+	int64 count = 0;
+
+	for (int i = 0; i < NumHistogramBuckets; i++)
+	{
+		count += histogram[i];
+
+		if (count >= threshold)
+			return jmin<double>(max, std::pow(2.0, (double)(i + 1) / (double)BucketsPerOctave) / 1000.0);
+	}
+
+	return max;
+}
+
+void CpuProfiler::fillProcessorNames(HashMap<pointer_sized_int, String>& names) const
+{
+	Processor::Iterator<Processor> iter(mc->getMainSynthChain());
+
+	while (auto p = iter.getNextProcessor())
+		names.set((pointer_sized_int)p, p->getId());
+}
+
+String CpuProfiler::getNodeName(const HashMap<pointer_sized_int, String>& names, const Processor* p)
+{
+	const auto key = (pointer_sized_int)p;
+
+	return names.contains(key) ? names[key] : String("(deleted)");
+}
+
+var CpuProfiler::createProfileTree() const
+{
+	HashMap<pointer_sized_int, String> names;
+	fillProcessorNames(names);
+
+	ScopedLock sl(statsLock);
+
+	HashMap<uint64, Array<const Node*>> children;
+	Array<const Node*> roots;
+	double totalTime = 0.0;
+
+	for (auto n : nodes)
+	{
+		if (nodeMap.contains(n->parentScope))
+			children.getReference(n->parentScope).add(n);
+		else
+		{
+			roots.add(n);
+			totalTime += n->sum;
+		}
+	}
+
+	std::function<var(Array<const Node*>)> createNodeList;
+
+	createNodeList = [&](Array<const Node*> list)
+	{
+		std::sort(list.begin(), list.end(), [](const Node* first, const Node* second) { return first->sum > second->sum; });
+
+		Array<var> result;
+
+		for (auto n : list)
+		{
+			const double numBlocks = (double)jmax<int64>(1, n->numBlocks);
+
+			DynamicObject::Ptr obj = new DynamicObject();
+
+			obj->setProperty("Name", getNodeName(names, n->processor));
+			obj->setProperty("Location", DebugLogger::getNameForLocation((DebugLogger::Location)n->location));
+			obj->setProperty("Mean", n->sum / numBlocks);
+			obj->setProperty("P99", n->getPercentile(99.0));
+			obj->setProperty("Max", n->max);
+			obj->setProperty("Calls", (double)n->numCalls / numBlocks);
+			obj->setProperty("Share", totalTime > 0.0 ? 100.0 * n->sum / totalTime : 0.0);
+			obj->setProperty("Children", children.contains(n->scope) ? createNodeList(children[n->scope]) : var(Array<var>()));
+
+			result.add(var(obj));
+		}
+
+		return var(result);
+	};
+
+	return createNodeList(roots);
+}
+
+String CpuProfiler::createProfileReport() const
+{
+	String report;
+	String nl = "\n";
+
+	std::function<void(const var&, int)> addNodes;
+
+	addNodes = [&](const var& list, int level)
+	{
+		if (auto ar = list.getArray())
+		{
+			for (const auto& n : *ar)
+			{
+				report << String::repeatedString("  ", level);
+				report << n["Name"].toString() << " (" << n["Location"].toString() << "): ";
+				report << String((double)n["Share"], 1) << "%, mean " << String((double)n["Mean"], 3) << " ms, p99 " << String((double)n["P99"], 3);
+				report << " ms, max " << String((double)n["Max"], 3) << " ms, " << String((double)n["Calls"], 1) << " calls" << nl;
+
+				addNodes(n["Children"], level + 1);
+			}
+		}
+	};
+
+	addNodes(createProfileTree(), 0);
+
+	const int numDropped = numDroppedEvents.load();
+
+	if (numDropped > 0)
+		report << "Dropped events: " << String(numDropped) << nl;
+
+	return report;
+}
+
+Result CpuProfiler::exportAsChromeTrace(const File& targetFile) const
+{
+	HashMap<pointer_sized_int, String> names;
+	fillProcessorNames(names);
+
+	ScopedLock sl(statsLock);
+
+	const int64 numEvents = jmin<int64>(numHistoryEvents, NumHistoryEvents);
+
+	if (numEvents == 0)
+		return Result::fail("No profiling data recorded");
+
+	const int64 firstIndex = numHistoryEvents - numEvents;
+
+	int64 startTicks = history[(int)(firstIndex % NumHistoryEvents)].startTicks;
+
+	for (int64 i = firstIndex; i < numHistoryEvents; i++)
+		startTicks = jmin<int64>(startTicks, history[(int)(i % NumHistoryEvents)].startTicks);
+
+	MemoryOutputStream mos;
+
+	mos << "{\"traceEvents\":[\n";
+
+	for (int64 i = firstIndex; i < numHistoryEvents; i++)
+	{
+		const auto& e = history[(int)(i % NumHistoryEvents)];
+
+		const String name = getNodeName(names, e.processor) + " (" + DebugLogger::getNameForLocation((DebugLogger::Location)e.location) + ")";
+		const double ts = Time::highResolutionTicksToSeconds(e.startTicks - startTicks) * 1000000.0;
+		const double dur = Time::highResolutionTicksToSeconds(e.endTicks - e.startTicks) * 1000000.0;
+
+		mos << "{\"name\":" << JSON::toString(var(name)) << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << String(e.threadIndex);
+		mos << ",\"ts\":" << String(ts, 3) << ",\"dur\":" << String(dur, 3) << "}";
+		mos << (i != numHistoryEvents - 1 ? ",\n" : "\n");
+	}
+
+	mos << "],\"displayTimeUnit\":\"ms\"}\n";
+
+	if (!targetFile.replaceWithData(mos.getData(), mos.getDataSize()))
+		return Result::fail("Can't write " + targetFile.getFullPathName());
+
+	return Result::ok();
+}
+
+CpuProfiler::ScopedMeasurement::ScopedMeasurement(Processor* p, DebugLogger::Location location_) noexcept :
+	profiler(nullptr),
+	processor(p),
+	location(location_),
+	parentScope(0),
+	scope(0),
+	startTicks(0)
+{
+	auto& cpuProfiler = p->getMainController()->getCpuProfiler();
+
+	if (cpuProfiler.isEnabled())
+	{
+		profiler = &cpuProfiler;
+		parentScope = currentProfilerScope;
+		scope = createProfilerScopeId(parentScope, p, (int)location);
+		currentProfilerScope = scope;
+		startTicks = Time::getHighResolutionTicks();
+	}
+}
+
+CpuProfiler::ScopedMeasurement::~ScopedMeasurement() noexcept
+{
+	if (profiler != nullptr)
+	{
+		Event e;
+
+		e.endTicks = Time::getHighResolutionTicks();
+		e.startTicks = startTicks;
+		e.scope = scope;
+		e.parentScope = parentScope;
+		e.processor = processor;
+		e.location = (int16)location;
+
+		currentProfilerScope = parentScope;
+
+		profiler->addEvent(e);
+	}
+}
+
+CpuProfiler::ScopedParentScope::ScopedParentScope(uint64 parentScope) noexcept :
+	previousScope(currentProfilerScope)
+{
+	currentProfilerScope = parentScope;
+}
+
+CpuProfiler::ScopedParentScope::~ScopedParentScope() noexcept
+{
+	currentProfilerScope = previousScope;
+}
+
+} // namespace hise
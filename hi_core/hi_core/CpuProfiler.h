@@ -0,0 +1,246 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef CPUPROFILER_H_INCLUDED
+#define CPUPROFILER_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** Measures the CPU time of every module in the audio callback.
+*	@ingroup core
+*
+*	Add the ADD_CPU_PROFILER_SCOPE(processor, location) macro to a rendering function and the profiler measures the
+*	time until the end of the scope. Scopes are nested, so the modulator chains and effects of a synth show up as
+*	children of the synth (this also works for tasks that are executed by the RealtimeWorkerPool).
+*
+*	Nothing is measured until you call setEnabled(true) - until then a scope only checks an atomic flag. The audio
+*	thread and the realtime workers write their measurements into a lock free queue per thread and a background
+*	thread builds the tree with the mean, 99th percentile and maximum time per audio callback for every node.
+*/
+class CpuProfiler : private Thread
+{
+public:
+
+	CpuProfiler(MainController* mc);
+	~CpuProfiler();
+
+	/** Starts or stops the measurement. The statistics are kept until you call reset(). */
+	void setEnabled(bool shouldBeEnabled);
+
+	bool isEnabled() const noexcept { return enabled.load(); }
+
+	/** Clears all statistics and recorded scopes. */
+	void reset();
+
+	/** Releases the event buffers of all threads, so that threads that don't exist anymore don't keep their slot.
+	*
+	*	The threads claim a buffer again with their next scope. Call this while the audio thread and the realtime
+	*	workers don't render (the MainController does this in prepareToPlay()).
+	*/
+	void releaseThreadBuffers() noexcept;
+
+	/** Call this at the start of every audio callback. The statistics of a node use the sum of its scopes per callback. */
+	void startBlock() noexcept { blockIndex.fetch_add(1, std::memory_order_release); }
+
+	/** Creates the profile as an array of root nodes.
+	*
+	*	Every node is an object with these properties:
+	*
+	*	- "Name": the ID of the processor and "Location": the rendering stage
+	*	- "Mean", "P99" and "Max": the time in milliseconds per callback (only the callbacks where the node was active)
+	*	- "Calls": the number of scopes per active callback
+	*	- "Share": the percentage of the total measured time
+	*	- "Children": an array with the child nodes, sorted by their total time
+	*
+	*	Call this on the message thread.
+	*/
+	var createProfileTree() const;
+
+	/** Creates an indented text version of the profile tree. Call this on the message thread. */
+	String createProfileReport() const;
+
+	/** Writes the last recorded scopes as Chrome trace JSON (you can load it in chrome://tracing). Call this on the message thread. */
+	Result exportAsChromeTrace(const File& targetFile) const;
+
+	/** Returns the ID of the innermost profiler scope of the current thread. */
+	static uint64 getCurrentScope() noexcept;
+
+	/** Measures the time until the end of the scope. Use the ADD_CPU_PROFILER_SCOPE macro instead. */
+	class ScopedMeasurement
+	{
+	public:
+
+		ScopedMeasurement(Processor* processor, DebugLogger::Location location) noexcept;
+		~ScopedMeasurement() noexcept;
+
+	private:
+
+		CpuProfiler* profiler;
+		const Processor* processor;
+		const DebugLogger::Location location;
+		uint64 parentScope;
+		uint64 scope;
+		int64 startTicks;
+
+		JUCE_DECLARE_NON_COPYABLE(ScopedMeasurement)
+	};
+
+	/** Makes all scopes of the current thread children of the given scope.
+	*
+	*	The RealtimeWorkerPool uses this to attach the measurements of a task to the scope that started it.
+	*/
+	class ScopedParentScope
+	{
+	public:
+
+		ScopedParentScope(uint64 parentScope) noexcept;
+		~ScopedParentScope() noexcept;
+
+	private:
+
+		const uint64 previousScope;
+
+		JUCE_DECLARE_NON_COPYABLE(ScopedParentScope)
+	};
+
+private:
+
+	enum
+	{
+		NumThreadBuffers = HISE_MAX_REALTIME_WORKERS + 8,
+		NumEventsPerThread = 4096,
+		NumHistoryEvents = 65536,
+		NumHistogramBuckets = 256,
+		BucketsPerOctave = 8
+	};
+
+	struct Event
+	{
+		uint64 scope;
+		uint64 parentScope;
+		const Processor* processor;
+		int64 startTicks;
+		int64 endTicks;
+		uint32 blockIndex;
+		int16 location;
+		int16 threadIndex;
+	};
+
+	/** A single producer / single consumer queue for the events of one thread. */
+	struct ThreadBuffer
+	{
+		bool push(const Event& e) noexcept;
+		bool pop(Event& e) noexcept;
+
+		std::atomic<Thread::ThreadID> threadId { nullptr };
+		std::atomic<uint32> writeIndex { 0 };
+		std::atomic<uint32> readIndex { 0 };
+		HeapBlock<Event> events;
+	};
+
+	struct Node
+	{
+		Node(const Event& e);
+
+		void addEvent(const Event& e) noexcept;
+		void commitBlock() noexcept;
+		double getPercentile(double percent) const noexcept;
+
+		const uint64 scope;
+		const uint64 parentScope;
+		const Processor* processor;
+		const int location;
+
+		uint32 currentBlock;
+		double currentDuration = 0.0;
+		int currentCalls = 0;
+
+		int64 numBlocks = 0;
+		int64 numCalls = 0;
+		double sum = 0.0;
+		double max = 0.0;
+		int64 histogram[NumHistogramBuckets];
+	};
+
+	ThreadBuffer* getBufferForCurrentThread() noexcept;
+
+	void addEvent(Event& e) noexcept;
+
+	void run() override;
+
+	/** Moves the events from the thread buffers into the statistics. Returns false if there were no events.
+	*
+	*	The scopes of one callback can be measured on different threads, so the events are collected until their
+	*	callback has finished and then added in the order of the callbacks.
+	*/
+	bool processEvents();
+
+	/** Collects the IDs of all processors that are still alive (so that no pointer of the recorded events has to be dereferenced). */
+	void fillProcessorNames(HashMap<pointer_sized_int, String>& names) const;
+
+	static String getNodeName(const HashMap<pointer_sized_int, String>& names, const Processor* p);
+
+	MainController* mc;
+
+	std::atomic<bool> enabled;
+	std::atomic<uint32> blockIndex;
+	std::atomic<int> numDroppedEvents;
+
+	// Changes when the thread buffers are released, so that the threads look up their buffer again
+	std::atomic<uint32> slotGeneration;
+
+	ThreadBuffer threadBuffers[NumThreadBuffers];
+	bool buffersAllocated = false;
+
+	CriticalSection statsLock;
+
+	OwnedArray<Node> nodes;
+	HashMap<uint64, Node*> nodeMap;
+
+	// The events of the callbacks that haven't finished yet
+	Array<Event> pendingEvents;
+
+	HeapBlock<Event> history;
+	int64 numHistoryEvents = 0;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CpuProfiler)
+};
+
+#if HISE_ENABLE_CPU_PROFILER
+#define ADD_CPU_PROFILER_SCOPE(processor, location) CpuProfiler::ScopedMeasurement JUCE_JOIN_MACRO(cpuProfilerScope, __LINE__)(processor, location)
+#else
+#define ADD_CPU_PROFILER_SCOPE(processor, location)
+#endif
+
+} // namespace hise
+
+#endif  // CPUPROFILER_H_INCLUDED
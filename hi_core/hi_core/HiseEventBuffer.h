@@ -35,8 +35,11 @@
 
 namespace hise { using namespace juce;
 
+/** The number of artificial note ons that the MainController::EventIdHandler can store. This must be a power of two. */
 #define HISE_EVENT_ID_ARRAY_SIZE 16384
 
+static_assert((HISE_EVENT_ID_ARRAY_SIZE & (HISE_EVENT_ID_ARRAY_SIZE - 1)) == 0, "HISE_EVENT_ID_ARRAY_SIZE must be a power of two");
+
 /** This is a replacement of the standard midi message with more data. */
 class HiseEvent
 {
@@ -65,6 +65,7 @@ MainController::MainController():
 	processorChangeHandler(this),
 	killStateHandler(this),
 	debugLogger(this),
+	cpuProfiler(this),
 	//presetLoadRampFlag(OldUserPresetHandler::Active),
 	suspendIndex(0),
 	controlUndoManager(new UndoManager())
@@ -85,18 +86,6 @@ MainController::MainController():
 	toolbarProperties = DefaultFrontendBar::createDefaultProperties();
 
 	hostInfo = new DynamicObject();
-    
-#if HI_RUN_UNIT_TESTS
-
-	UnitTestRunner runner;
-
-	runner.setAssertOnFailure(false);
-
-	runner.runAllTests();
-
-	
-
-#endif
 };
 
 
@@ -565,7 +554,10 @@ void MainController::storePlayheadIntoDynamicObject(AudioPlayHead::CurrentPositi
 
 void MainController::processBlockCommon(AudioSampleBuffer &buffer, MidiBuffer &midiMessages)
 {
+	cpuProfiler.startBlock();
+
 	ADD_GLITCH_DETECTOR(getMainSynthChain(), DebugLogger::Location::MainRenderCallback);
+	ADD_CPU_PROFILER_SCOPE(getMainSynthChain(), DebugLogger::Location::MainRenderCallback);
     
 	
 
@@ -578,6 +570,7 @@ void MainController::processBlockCommon(AudioSampleBuffer &buffer, MidiBuffer &m
 
 	ScopedTryLock sl(processLock);
 
+	// The module tree is being changed and can't be rendered (see the documentation of this method)
 	if (!sl.isLocked())
 	{
 		buffer.clear();
@@ -793,6 +786,9 @@ void MainController::prepareToPlay(double sampleRate_, int samplesPerBlock)
 {
     LOG_START("Preparing playback");
     
+	// The audio thread might have changed, so the old thread doesn't need its profiler slot anymore
+	cpuProfiler.releaseThreadBuffers();
+
 	bufferSize = samplesPerBlock;
 	sampleRate = sampleRate_;
  
@@ -815,6 +811,12 @@ void MainController::prepareToPlay(double sampleRate_, int samplesPerBlock)
     
 	updateMultiChannelBuffer(getMainSynthChain()->getMatrix().getNumSourceChannels());
 
+#if HISE_USE_PARALLEL_SYNTH_RENDERING
+	// The chains render in parallel by default, but the pool doesn't start any workers by itself
+	if (realtimeWorkerPool.getNumWorkers() == 0)
+		realtimeWorkerPool.setNumWorkers(RealtimeWorkerPool::getDefaultNumWorkers());
+#endif
+
 	
 
 #if IS_STANDALONE_APP || IS_STANDALONE_FRONTEND
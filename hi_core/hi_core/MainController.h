@@ -165,10 +165,88 @@ public:
 
 		double& getPreloadProgress();
 
+		/** Collects the streaming statistics of all samplers and returns them as JSON object.
+		*
+		*	The statistics contain the latency histogram of the streaming jobs, the smallest buffer headroom,
+		*	the amount of buffer underruns and the streamed bytes per second for every sound since the last reset.
+		*/
+		var getStreamingStatistics(bool resetStatistics);
+
+		/** Writes the streaming statistics as JSON to the given file. */
+		bool dumpStreamingStatistics(const File& targetFile, bool resetStatistics);
+
+		/** Keeps the preload buffers of all samplers within a global memory budget.
+		*
+		*	If a budget is set, every sampler uses lazy preloading (see ModulatorSampler::setLazyPreloading()). The full
+		*	preload buffers are loaded as long as they fit into the budget. If the budget is exceeded, the buffers of the 
+		*	sounds that were not played for the longest time will be shrunk to their head. They will be loaded again in 
+		*	the background when a nearby note is played.
+		*/
+		class MemoryGovernor : public SampleThreadPoolJob
+		{
+		public:
+
+			MemoryGovernor(MainController* mc);
+			~MemoryGovernor();
+
+			/** Sets the memory budget in bytes for the preload buffers of all samplers. Zero disables the governor. */
+			void setMemoryBudget(int64 newBudgetInBytes);
+
+			int64 getMemoryBudget() const noexcept { return budget.load(); }
+
+			bool isActive() const noexcept { return budget.load() > 0; }
+
+			/** Returns the amount of bytes used by the preload buffers of all samplers. */
+			int64 getMemoryFootprint() const noexcept { return footprint.load(); }
+
+			/** Returns the number of preload buffers that were unloaded since the last reset. */
+			int getNumEvictions() const noexcept { return numEvictions.load(); }
+
+			/** Returns the number of preload buffers that were loaded again since the last reset. */
+			int getNumReloads() const noexcept { return numReloads.load(); }
+
+			/** Checks if another preload buffer can be loaded without exceeding the budget. */
+			bool hasRoomLeft() const noexcept { return footprint.load() < budget.load(); }
+
+			/** Call this whenever the preload size of a sound changes. */
+			void addToFootprint(int64 deltaInBytes) noexcept { footprint += deltaInBytes; }
+
+			void addReloads(int numReloadedSounds) noexcept { numReloads += numReloadedSounds; }
+
+			/** Starts a background job that shrinks the preload buffers if the budget is exceeded. */
+			void triggerUpdate();
+
+			void addSampler(ModulatorSampler* s);
+			void removeSampler(ModulatorSampler* s);
+
+			/** Returns the budget, the footprint and the eviction counters as JSON object. */
+			var getStatistics(bool resetStatistics);
+
+			JobStatus runJob() override;
+
+		private:
+
+			MainController* mc;
+
+			CriticalSection samplerLock;
+			Array<ModulatorSampler*> samplers;
+
+			std::atomic<int64> budget;
+			std::atomic<int64> footprint;
+			std::atomic<int> numEvictions;
+			std::atomic<int> numReloads;
+			std::atomic<int> numResidentSounds;
+		};
+
+		MemoryGovernor& getMemoryGovernor() noexcept { return memoryGovernor; }
+		const MemoryGovernor& getMemoryGovernor() const noexcept { return memoryGovernor; }
+
 	private:
 
 		CriticalSection samplerSoundLock;
 
+		double lastStreamingStatisticsReset = 0.0;
+
 		struct PreloadListenerUpdater : public AsyncUpdater
 		{
 		public:
@@ -222,6 +300,8 @@ public:
 
 		PreloadJob internalPreloadJob;
 
+		MemoryGovernor memoryGovernor;
+
 		// Just used for the listeners
 		std::atomic<bool> preloadFlag;
 
@@ -307,9 +387,15 @@ public:
 		/** Adds the artificial event to the internal stack array. */
 		void pushArtificialNoteOn(HiseEvent& noteOnEvent) noexcept;
 
-		/** Searches all active note on events and returns the one with the given event id. */
+		/** Removes and returns the artificial note on with the given event id (or an empty event if it doesn't exist anymore). */
 		HiseEvent popNoteOnFromEventId(uint16 eventId);
 
+		/** Returns the number of artificial note ons that were overwritten by newer events before they could be removed.
+		*
+		*	The artificial events are stored in a ring of HISE_EVENT_ID_ARRAY_SIZE slots that are addressed by the event ID.
+		*/
+		int getNumOverflows() const noexcept { return numOverflows.load(); }
+
 		/** You can specify a global transpose value here that will be added to all note on / note off messages. */
 		void setGlobalTransposeValue(int transposeValue);
 
@@ -329,6 +415,8 @@ public:
 		HiseEvent realNoteOnEvents[16][128];
 		uint16 currentEventId;
 
+		std::atomic<int> numOverflows;
+
 		int transposeValue = 0;
 
 		// ===========================================================================================================
@@ -781,6 +869,13 @@ public:
 
 	DebugLogger& getDebugLogger() { return debugLogger; }
 	const DebugLogger& getDebugLogger() const { return debugLogger; }
+
+	/** Returns the worker threads that can be used to render parts of the audio callback in parallel. */
+	RealtimeWorkerPool& getRealtimeWorkerPool() noexcept { return realtimeWorkerPool; }
+
+	/** Returns the profiler that measures the CPU time of the modules. */
+	CpuProfiler& getCpuProfiler() noexcept { return cpuProfiler; }
+	const CpuProfiler& getCpuProfiler() const noexcept { return cpuProfiler; }
     
 	void setBufferToPlay(const AudioSampleBuffer& buffer)
 	{
@@ -1027,7 +1122,13 @@ public:
 
 private: // Never call this directly, but wrap it through DelayedRenderer...
 
-	/** This is the main processing loop that is shared among all subclasses. */
+	/** This is the main processing loop that is shared among all subclasses.
+	*
+	*	The module tree is edited in place, so there is no previous state that could be rendered while another thread
+	*	holds the process lock. In this case the block is cleared. The chain handlers only hold the lock while they
+	*	insert or detach a module (new scripts are compiled before they go on air), but loading a preset and recompiling
+	*	a script that is on air hold it for the whole operation and still cause a dropout.
+	*/
 	void processBlockCommon(AudioSampleBuffer &b, MidiBuffer &mb);
 
 	/** Sets the sample rate for the cpu meter. */
@@ -1207,6 +1308,10 @@ private:
 
 	DebugLogger debugLogger;
 
+	CpuProfiler cpuProfiler;
+
+	RealtimeWorkerPool realtimeWorkerPool;
+
 #if USE_BACKEND
     
 	
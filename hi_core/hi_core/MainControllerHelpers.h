@@ -46,6 +46,7 @@ class Processor;
 class Console;
 class ModulatorSamplerSound;
 class ModulatorSamplerSoundPool;
+class ModulatorSampler;
 class AudioSampleBufferPool;
 class Plotter;
 class ScriptWatchTable;
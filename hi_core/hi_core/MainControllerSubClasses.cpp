@@ -290,7 +290,10 @@ MainController::EventIdHandler::EventIdHandler(HiseEventBuffer& masterBuffer_) :
 	//for (int i = 0; i < 128; i++)
 		//realNoteOnEvents[i] = HiseEvent();
 
-	memset(realNoteOnEvents, 0, sizeof(HiseEvent) * 128);
+	memset(realNoteOnEvents, 0, sizeof(realNoteOnEvents));
+	memset(lastArtificialEventIds, 0, sizeof(lastArtificialEventIds));
+
+	numOverflows.store(0);
 
 	artificialEvents.calloc(HISE_EVENT_ID_ARRAY_SIZE, sizeof(HiseEvent));
 }
@@ -417,7 +420,7 @@ void MainController::EventIdHandler::pushArtificialNoteOn(HiseEvent& noteOnEvent
 	jassert(noteOnEvent.isArtificial());
 
 	noteOnEvent.setEventId(currentEventId);
-	artificialEvents[currentEventId % HISE_EVENT_ID_ARRAY_SIZE] = noteOnEvent;
+	artificialEvents[currentEventId & (HISE_EVENT_ID_ARRAY_SIZE - 1)] = noteOnEvent;
 	lastArtificialEventIds[noteOnEvent.getNoteNumber()] = currentEventId;
 
 	currentEventId++;
@@ -430,7 +433,9 @@ HiseEvent MainController::EventIdHandler::peekNoteOn(const HiseEvent& noteOffEve
 	{
 		if (noteOffEvent.getEventId() != 0)
 		{
-			return artificialEvents[noteOffEvent.getEventId() % HISE_EVENT_ID_ARRAY_SIZE];
+			const HiseEvent& e = artificialEvents[noteOffEvent.getEventId() & (HISE_EVENT_ID_ARRAY_SIZE - 1)];
+
+			return e.getEventId() == noteOffEvent.getEventId() ? e : HiseEvent();
 		}
 		else
 		{
@@ -449,8 +454,20 @@ HiseEvent MainController::EventIdHandler::peekNoteOn(const HiseEvent& noteOffEve
 
 HiseEvent MainController::EventIdHandler::popNoteOnFromEventId(uint16 eventId)
 {
+	HiseEvent& slot = artificialEvents[eventId & (HISE_EVENT_ID_ARRAY_SIZE - 1)];
+
+	if (slot.isEmpty())
+		return HiseEvent();
+
+	if (slot.getEventId() != eventId)
+	{
+		// The slot was reused by a newer event, so the note on for this ID is lost
+		numOverflows.fetch_add(1);
+		return HiseEvent();
+	}
+
 	HiseEvent e;
-	e.swapWith(artificialEvents[eventId % HISE_EVENT_ID_ARRAY_SIZE]);
+	e.swapWith(slot);
 
 	return e;
 }
@@ -0,0 +1,228 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+static thread_local int currentRealtimeThreadIndex = 0;
+static thread_local bool isExecutingRealtimeTask = false;
+
+class RealtimeWorkerPool::Worker : public Thread
+{
+public:
+
+	Worker(RealtimeWorkerPool& parent_, int index) :
+		Thread("Realtime Worker " + String(index + 1)),
+		parent(parent_),
+		threadIndex(index + 1)
+	{};
+
+	~Worker()
+	{
+		stopThread(1000);
+	}
+
+	void run() override
+	{
+		ScopedNoDenormals snd;
+
+		currentRealtimeThreadIndex = threadIndex;
+
+		int64 lastWorkTime = Time::getHighResolutionTicks();
+		uint64 lastGeneration = 0;
+
+		while (!threadShouldExit())
+		{
+			const uint64 generation = parent.state.load() >> 32;
+
+			if (generation != lastGeneration)
+			{
+				lastGeneration = generation;
+				parent.processTasks();
+				lastWorkTime = Time::getHighResolutionTicks();
+				continue;
+			}
+
+			if (Time::getHighResolutionTicks() - lastWorkTime < parent.spinTicks)
+			{
+				Thread::yield();
+				continue;
+			}
+
+			// If runParallel() starts new tasks after this, it will see the parked worker and post the semaphore
+			parent.numParkedWorkers.fetch_add(1);
+
+			if ((parent.state.load() >> 32) == lastGeneration && !threadShouldExit())
+				parent.wakeUpSemaphore.wait();
+
+			lastWorkTime = Time::getHighResolutionTicks();
+		}
+	}
+
+private:
+
+	RealtimeWorkerPool& parent;
+	const int threadIndex;
+};
+
+RealtimeWorkerPool::RealtimeWorkerPool() :
+	state(0),
+	numTasksFinished(0),
+	numParkedWorkers(0),
+	spinTicks(Time::secondsToHighResolutionTicks((double)HISE_REALTIME_WORKER_SPIN_TIME_US * 0.000001))
+{
+
+}
+
+RealtimeWorkerPool::~RealtimeWorkerPool()
+{
+	setNumWorkers(0);
+}
+
+void RealtimeWorkerPool::setNumWorkers(int newNumWorkers)
+{
+	newNumWorkers = jlimit<int>(0, HISE_MAX_REALTIME_WORKERS, newNumWorkers);
+
+	if (newNumWorkers == workers.size())
+		return;
+
+	for (auto w : workers)
+		w->signalThreadShouldExit();
+
+	// Every worker that is parked (or about to park) gets one count, so they all return
+	wakeUpSemaphore.signal(workers.size());
+
+	workers.clear();
+	numParkedWorkers.store(0);
+
+	for (int i = 0; i < newNumWorkers; i++)
+	{
+		auto w = workers.add(new Worker(*this, i));
+		w->startThread(Thread::realtimeAudioPriority);
+	}
+}
+
+void RealtimeWorkerPool::wakeUpWorkers() noexcept
+{
+	const int numToWakeUp = numParkedWorkers.exchange(0);
+
+	if (numToWakeUp > 0)
+		wakeUpSemaphore.signal(numToWakeUp);
+}
+
+int RealtimeWorkerPool::getDefaultNumWorkers()
+{
+	return jlimit<int>(0, HISE_MAX_REALTIME_WORKERS, SystemStats::getNumCpus() - 1);
+}
+
+int RealtimeWorkerPool::getCurrentThreadIndex() noexcept
+{
+	return currentRealtimeThreadIndex;
+}
+
+void RealtimeWorkerPool::runParallel(TaskFunction f, void* context, int numTasks) noexcept
+{
+	jassert(numTasks < 0xFFFF);
+
+	if (numTasks <= 0)
+		return;
+
+	if (workers.isEmpty() || numTasks == 1 || isExecutingRealtimeTask)
+	{
+		for (int i = 0; i < numTasks; i++)
+			f(context, i);
+
+		return;
+	}
+
+	// All tasks of the last generation are finished, so no worker can read these now
+	currentFunction = f;
+	currentContext = context;
+	parentProfilerScope = CpuProfiler::getCurrentScope();
+	numTasksFinished.store(0);
+
+	const uint64 nextGeneration = (state.load() >> 32) + 1;
+
+	state.store((nextGeneration << 32) | ((uint64)numTasks << 16));
+
+	wakeUpWorkers();
+
+	// This claims every task that no worker has started yet, so after this we only wait for running tasks
+	processTasks();
+
+	const int64 yieldTime = Time::getHighResolutionTicks() + spinTicks;
+
+	while (numTasksFinished.load() != numTasks)
+	{
+		// A running task can't be taken back. If it takes unusually long (eg. because the worker was
+		// preempted), give up the time slice so that the audio thread doesn't starve it.
+		if (Time::getHighResolutionTicks() > yieldTime)
+			Thread::yield();
+	}
+}
+
+bool RealtimeWorkerPool::claimTask(int& taskIndex) noexcept
+{
+	uint64 s = state.load();
+
+	for (;;)
+	{
+		const int nextIndex = (int)(s & 0xFFFF);
+		const int numTasks = (int)((s >> 16) & 0xFFFF);
+
+		if (nextIndex >= numTasks)
+			return false;
+
+		if (state.compare_exchange_weak(s, s + 1))
+		{
+			taskIndex = nextIndex;
+			return true;
+		}
+	}
+}
+
+void RealtimeWorkerPool::processTasks() noexcept
+{
+	int taskIndex;
+
+	while (claimTask(taskIndex))
+	{
+		CpuProfiler::ScopedParentScope sps(parentProfilerScope);
+
+		isExecutingRealtimeTask = true;
+		currentFunction(currentContext, taskIndex);
+		isExecutingRealtimeTask = false;
+
+		numTasksFinished.fetch_add(1);
+	}
+}
+
+} // namespace hise
@@ -0,0 +1,123 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef REALTIMEWORKERPOOL_H_INCLUDED
+#define REALTIMEWORKERPOOL_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** A set of worker threads that can execute independent tasks of the audio callback in parallel.
+*	@ingroup core
+*
+*	Call runParallel() from the audio thread with a function and the number of tasks. The function will be
+*	called once for every task index, either by a worker or by the calling thread, and runParallel() returns
+*	when all tasks are finished. The calling thread always helps with the tasks and takes back every task
+*	that no worker has started yet, so if the workers are busy or parked, it will simply render everything itself
+*	and only waits for the tasks that are already running.
+*
+*	The workers run with the realtime audio priority. After a task they keep spinning for 
+*	HISE_REALTIME_WORKER_SPIN_TIME_US microseconds and then park on a semaphore. The audio thread never
+*	takes a lock, it only posts the semaphore if a worker is parked.
+*/
+class RealtimeWorkerPool
+{
+public:
+
+	/** The function that will be called for every task. The context is the pointer that you pass into runParallel(). */
+	using TaskFunction = void(*)(void* context, int taskIndex);
+
+	RealtimeWorkerPool();
+	~RealtimeWorkerPool();
+
+	/** Starts the given amount of worker threads. Zero stops all workers. Don't call this from the audio thread. */
+	void setNumWorkers(int newNumWorkers);
+
+	/** Returns the number of worker threads (without the calling thread). */
+	int getNumWorkers() const noexcept { return workers.size(); }
+
+	/** Executes the function for every index from 0 to numTasks - 1 and returns when all tasks are finished.
+	*
+	*	This is lock free and can be called from the audio thread. If the task function calls runParallel() again
+	*	(eg. a synth that renders its voices in parallel inside a chain that renders its children in parallel), the
+	*	nested tasks will be executed serially on the current thread.
+	*/
+	void runParallel(TaskFunction f, void* context, int numTasks) noexcept;
+
+	/** Returns a sensible number of workers for this machine (all cores except the one of the audio thread). */
+	static int getDefaultNumWorkers();
+
+	/** Returns the index of the worker that calls this method (starting with 1) or 0 for all other threads.
+	*
+	*	You can use this to pick a thread local scratch buffer in a task function. The index is always smaller
+	*	than HISE_MAX_REALTIME_WORKERS + 1.
+	*/
+	static int getCurrentThreadIndex() noexcept;
+
+private:
+
+	class Worker;
+
+	/** Wakes up the parked workers. */
+	void wakeUpWorkers() noexcept;
+
+	/** Claims and executes tasks of the current generation until there are no more tasks left. */
+	void processTasks() noexcept;
+
+	bool claimTask(int& taskIndex) noexcept;
+
+	// the generation (upper 32 bit), the number of tasks (16 bit) and the next task index (lower 16 bit)
+	std::atomic<uint64> state;
+
+	std::atomic<int> numTasksFinished;
+
+	// the number of workers that are (about to be) parked on the semaphore
+	std::atomic<int> numParkedWorkers;
+
+	moodycamel::spsc_sema::Semaphore wakeUpSemaphore;
+
+	// the time that a worker spins before it parks (and the calling thread spins before it yields)
+	const int64 spinTicks;
+
+	TaskFunction currentFunction = nullptr;
+	void* currentContext = nullptr;
+
+	// the profiler scope of the thread that started the tasks
+	uint64 parentProfilerScope = 0;
+
+	OwnedArray<Worker> workers;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RealtimeWorkerPool)
+};
+
+} // namespace hise
+
+#endif  // REALTIMEWORKERPOOL_H_INCLUDED
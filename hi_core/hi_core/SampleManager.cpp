@@ -52,10 +52,11 @@ MainController::SampleManager::SampleManager(MainController *mc_) :
 	sampleClipboard(ValueTree("clipboard")),
 	internalPreloadJob(mc_),
 	preloadListenerUpdater(this),
+	memoryGovernor(mc_),
 	preloadFlag(false)
 
 {
-
+	lastStreamingStatisticsReset = Time::getMillisecondCounterHiRes();
 }
 
 
@@ -194,6 +195,247 @@ void MainController::SampleManager::triggerSamplePreloading()
 	}
 }
 
+var MainController::SampleManager::getStreamingStatistics(bool resetStatistics)
+{
+	const double now = Time::getMillisecondCounterHiRes();
+	const double seconds = (now - lastStreamingStatisticsReset) * 0.001;
+
+	StreamingStatistics stats;
+	Array<var> soundList;
+
+	Processor::Iterator<ModulatorSampler> it(mc->getMainSynthChain());
+
+	while (ModulatorSampler* sampler = it.getNextProcessor())
+	{
+		sampler->addStreamingStatistics(stats, resetStatistics);
+		sampler->addStreamedBytesPerSound(soundList, seconds, resetStatistics);
+	}
+
+	double totalBytesPerSecond = 0.0;
+
+	for (const auto& s : soundList)
+		totalBytesPerSecond += (double)s.getProperty("BytesPerSecond", 0.0);
+
+	var data = stats.toJSON();
+
+	if (auto obj = data.getDynamicObject())
+	{
+		obj->setProperty("Duration", seconds);
+		obj->setProperty("DiskUsage", samplerLoaderThreadPool->getDiskUsage());
+		obj->setProperty("BytesPerSecond", totalBytesPerSecond);
+		obj->setProperty("Sounds", soundList);
+
+		auto& blockCache = getModulatorSamplerSoundPool()->getDecodedBlockCache();
+
+		DynamicObject::Ptr cacheData = new DynamicObject();
+
+		cacheData->setProperty("HitRate", blockCache.getHitRate());
+		cacheData->setProperty("Hits", blockCache.getNumHits());
+		cacheData->setProperty("Misses", blockCache.getNumMisses());
+		cacheData->setProperty("MemoryUsage", (int64)blockCache.getMemoryUsage());
+		cacheData->setProperty("MemoryLimit", (int64)blockCache.getMemoryLimit());
+
+		obj->setProperty("DecodedBlockCache", var(cacheData));
+
+		if (resetStatistics)
+			blockCache.resetStatistics();
+
+		obj->setProperty("MemoryGovernor", memoryGovernor.getStatistics(resetStatistics));
+	}
+
+	if (resetStatistics)
+		lastStreamingStatisticsReset = now;
+
+	return data;
+}
+
+bool MainController::SampleManager::dumpStreamingStatistics(const File& targetFile, bool resetStatistics)
+{
+	auto data = getStreamingStatistics(resetStatistics);
+
+	return targetFile.replaceWithText(JSON::toString(data));
+}
+
+MainController::SampleManager::MemoryGovernor::MemoryGovernor(MainController* mc_) :
+	SampleThreadPoolJob("Memory Governor"),
+	mc(mc_),
+	budget(0),
+	footprint(0),
+	numEvictions(0),
+	numReloads(0),
+	numResidentSounds(0)
+{
+
+}
+
+MainController::SampleManager::MemoryGovernor::~MemoryGovernor()
+{
+	signalJobShouldExit();
+	waitForJobToFinish();
+}
+
+void MainController::SampleManager::MemoryGovernor::setMemoryBudget(int64 newBudgetInBytes)
+{
+	newBudgetInBytes = jmax<int64>(0, newBudgetInBytes);
+
+	const bool wasActive = isActive();
+
+	budget.store(newBudgetInBytes);
+
+	if (wasActive != isActive())
+	{
+		// The samplers need to switch to lazy preloading (or back)
+		ScopedLock sl(samplerLock);
+
+		for (auto s : samplers)
+			s->refreshPreloadSizes();
+	}
+	else if (isActive())
+	{
+		triggerUpdate();
+	}
+}
+
+void MainController::SampleManager::MemoryGovernor::triggerUpdate()
+{
+	if (isActive() && !isQueued())
+	{
+		setDeadline(SampleThreadPool::getDeadlineFromNow(0.5));
+		mc->getSampleManager().getGlobalSampleThreadPool()->addJob(this, false);
+	}
+}
+
+void MainController::SampleManager::MemoryGovernor::addSampler(ModulatorSampler* s)
+{
+	ScopedLock sl(samplerLock);
+	samplers.addIfNotAlreadyThere(s);
+}
+
+void MainController::SampleManager::MemoryGovernor::removeSampler(ModulatorSampler* s)
+{
+	ScopedLock sl(samplerLock);
+	samplers.removeAllInstancesOf(s);
+}
+
+var MainController::SampleManager::MemoryGovernor::getStatistics(bool resetStatistics)
+{
+	DynamicObject::Ptr data = new DynamicObject();
+
+	data->setProperty("Budget", getMemoryBudget());
+	data->setProperty("Footprint", getMemoryFootprint());
+	data->setProperty("ResidentSounds", numResidentSounds.load());
+	data->setProperty("Evictions", getNumEvictions());
+	data->setProperty("Reloads", getNumReloads());
+
+	if (resetStatistics)
+	{
+		numEvictions.store(0);
+		numReloads.store(0);
+	}
+
+	return var(data);
+}
+
+SampleThreadPool::Job::JobStatus MainController::SampleManager::MemoryGovernor::runJob()
+{
+	ScopedTryLock sl(mc->getSampleManager().getSamplerSoundLock());
+
+	// The sample maps are being changed, the preloading will trigger another update when it's done
+	if (!sl.isLocked())
+		return SampleThreadPool::Job::jobHasFinished;
+
+	// The last played time is copied because the audio thread changes it while sorting
+	struct SoundInfo
+	{
+		StreamingSamplerSound* sound;
+		uint32 lastPlayedTime;
+	};
+
+	Array<StreamingSamplerSound*> soundPointers;
+
+	{
+		ScopedLock sl2(samplerLock);
+
+		for (auto sampler : samplers)
+		{
+			ModulatorSampler::SoundIterator sIter(sampler, false);
+
+			while (auto sound = sIter.getNextSound())
+			{
+				for (int i = 0; i < sound->getNumMultiMicSamples(); i++)
+				{
+					if (auto s = sound->getReferenceToSound(i))
+						soundPointers.add(s.get());
+				}
+			}
+		}
+	}
+
+	// Sounds can be shared by multiple samplers, so we need to remove the duplicates
+	DefaultElementComparator<StreamingSamplerSound*> pointerSorter;
+	soundPointers.sort(pointerSorter);
+
+	Array<SoundInfo> sounds;
+	sounds.ensureStorageAllocated(soundPointers.size());
+
+	for (int i = 0; i < soundPointers.size(); i++)
+	{
+		if (i == 0 || soundPointers[i] != soundPointers[i - 1])
+			sounds.add({ soundPointers[i], soundPointers[i]->getLastPlayedTime() });
+	}
+
+	struct LastPlayedSorter
+	{
+		static int compareElements(const SoundInfo& first, const SoundInfo& second)
+		{
+			if (first.lastPlayedTime < second.lastPlayedTime) return -1;
+			if (first.lastPlayedTime > second.lastPlayedTime) return 1;
+			return 0;
+		}
+	};
+
+	LastPlayedSorter sorter;
+	sounds.sort(sorter);
+
+	int64 numBytes = 0;
+	int numResident = 0;
+
+	for (const auto& info : sounds)
+	{
+		auto s = info.sound;
+
+		numBytes += (int64)s->getActualPreloadSize();
+
+		if (s->getLazyPreloadMemory() != 0)
+			numResident++;
+	}
+
+	const int64 limit = budget.load();
+
+	for (int i = 0; i < sounds.size() && limit > 0 && numBytes > limit; i++)
+	{
+		if (shouldExit())
+			break;
+
+		auto s = sounds[i].sound;
+
+		const int64 numBytesToFree = (int64)s->getLazyPreloadMemory();
+
+		// If a voice still reads from the buffer, it will be unloaded at the next update
+		if (numBytesToFree != 0 && s->unloadLazyPreloadBuffer())
+		{
+			numBytes -= numBytesToFree;
+			numResident--;
+			numEvictions++;
+		}
+	}
+
+	footprint.store(numBytes);
+	numResidentSounds.store(numResident);
+
+	return SampleThreadPool::Job::jobHasFinished;
+}
+
 void MainController::SampleManager::addPreloadListener(PreloadListener* p)
 {
 	preloadListeners.addIfNotAlreadyThere(p);
@@ -82,6 +82,8 @@
 #include "Popup.cpp"
 #include "Console.cpp"
 #include "BackgroundThreads.cpp"
+#include "RealtimeWorkerPool.cpp"
+#include "CpuProfiler.cpp"
 #include "Markdown.cpp"
 #include "HiseSettings.cpp"
 #include "SettingsWindows.cpp"
@@ -84,6 +84,8 @@ struct TestGlobalNamespace
 #include "ExternalFilePool.h"
 #include "Markdown.h"
 #include "BackgroundThreads.h"
+#include "RealtimeWorkerPool.h"
+#include "CpuProfiler.h"
 #include "HiseSettings.h"
 #include "SettingsWindows.h"
 
@@ -60,6 +60,7 @@
 #include "modules/ModulatorSynth.cpp"
 #include "modules/ModulatorSynthChain.cpp"
 #include "modules/ModulatorSynthGroup.cpp"
+#include "modules/ModulatorUnitTest.h"
 
 #include "plugin_parameter/PluginParameterProcessor.cpp"
 
@@ -37,16 +37,25 @@ void EffectProcessor::checkTailing(AudioSampleBuffer &b, int startSample, int nu
 	// Call this only on effects that produce a tail!
 	jassert(hasTail());
 
-	const float maxInL = FloatVectorOperations::findMaximum(tailCheck.getReadPointer(0, startSample), numSamples);
-	const float maxInR = FloatVectorOperations::findMaximum(tailCheck.getReadPointer(1, startSample), numSamples);
+	checkTailing(getTailCheckLevel(tailCheck, startSample, numSamples), b, startSample, numSamples);
+}
 
-	const float maxL = FloatVectorOperations::findMaximum(b.getReadPointer(0, startSample), numSamples);
-	const float maxR = FloatVectorOperations::findMaximum(b.getReadPointer(1, startSample), numSamples);
+void EffectProcessor::checkTailing(float inputLevel, const AudioSampleBuffer &b, int startSample, int numSamples)
+{
+	jassert(hasTail());
 
-	const float in = maxInL + maxInR;
-	const float out = maxL + maxR;
+	const float in = inputLevel;
+	const float out = getTailCheckLevel(b, startSample, numSamples);
 		
 	isTailing = (in == 0.0f && out >= 0.01f);
 }
 
+float EffectProcessor::getTailCheckLevel(const AudioSampleBuffer &b, int startSample, int numSamples)
+{
+	const float maxL = FloatVectorOperations::findMaximum(b.getReadPointer(0, startSample), numSamples);
+	const float maxR = FloatVectorOperations::findMaximum(b.getReadPointer(1, startSample), numSamples);
+
+	return maxL + maxR;
+}
+
 } // namespace hise
\ No newline at end of file
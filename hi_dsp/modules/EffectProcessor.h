@@ -123,6 +123,15 @@ protected:
 	/** If your effect produces a tail, you have to call this method after your processing. */
 	void checkTailing(AudioSampleBuffer &b, int startSample, int numSamples);
 
+	/** Checks the tail with an input level that was calculated with getTailCheckLevel() before the processing.
+	*
+	*	The voice effects use this instead of the tail check buffer, so that the voices can be rendered in parallel.
+	*/
+	void checkTailing(float inputLevel, const AudioSampleBuffer &b, int startSample, int numSamples);
+
+	/** Returns the sum of the channel maxima that checkTailing() compares. */
+	static float getTailCheckLevel(const AudioSampleBuffer &b, int startSample, int numSamples);
+
 	virtual const float *getModulationValuesForStepsizeCalculation(int /*chainIndex*/, int /*voiceIndex*/) { jassertfalse; return nullptr; };
 
 	/** Searches the modulation buffer for the minima and maxima and returns a power of two number according to the dynamic.
@@ -200,7 +209,7 @@ private:
 
 	AudioSampleBuffer emptyBuffer;
 
-	bool isTailing;
+	std::atomic<bool> isTailing;
 
 	bool useStepSize;
 };
@@ -567,7 +576,7 @@ public:
 	{
 		jassert(isOnAir());
 
-		if(hasTail()) saveBufferForTailCheck(b, startSample, numSamples);
+		const float tailInputLevel = hasTail() ? getTailCheckLevel(b, startSample, numSamples) : 0.0f;
 
 		const int startIndex = startSample;
 		const int samplesToCheck = numSamples;
@@ -589,7 +598,7 @@ public:
 			applyEffect(voiceIndex, b, startSample, numSamples);
 		}
 
-		if(hasTail()) checkTailing(b, startIndex, samplesToCheck);
+		if(hasTail()) checkTailing(tailInputLevel, b, startIndex, samplesToCheck);
 
 		return;
 	}
@@ -625,6 +634,18 @@ public:
 		}
 	}
 
+	/** Checks if one of the modulation chains has an envelope that reacts to controller events. */
+	bool hasControllerEnvelopes() const
+	{
+		for(int i = 0; i < getNumInternalChains(); i++)
+		{
+			if (static_cast<const ModulatorChain*>(getChildProcessor(i))->hasControllerEnvelopes())
+				return true;
+		}
+
+		return false;
+	}
+
 	virtual void handleHiseEvent(const HiseEvent &m)
 	{
 		for (int i = 0; i < getNumInternalChains(); i++)
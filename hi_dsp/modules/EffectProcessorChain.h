@@ -107,7 +107,15 @@ public:
 
         ADD_GLITCH_DETECTOR(parentProcessor, DebugLogger::Location::VoiceEffectRendering);
         
-		FOR_EACH_VOICE_EFFECT(renderVoice(voiceIndex, b, startSample, numSamples)); 
+		for (int i = 0; i < voiceEffects.size(); ++i)
+		{
+			if (voiceEffects[i]->isBypassed())
+				continue;
+
+			ADD_CPU_PROFILER_SCOPE(voiceEffects[i], DebugLogger::Location::VoiceEffectRendering);
+
+			voiceEffects[i]->renderVoice(voiceIndex, b, startSample, numSamples);
+		}
 	};
 
 	void renderNextBlock(AudioSampleBuffer &buffer, int startSample, int numSamples) override
@@ -129,6 +137,19 @@ public:
 		return false;
 	};
 
+	/** Checks if one of the voice effects has an envelope that reacts to controller events. */
+	bool hasControllerEnvelopes() const
+	{
+		if(isBypassed()) return false;
+
+		for(int i = 0; i < voiceEffects.size(); i++)
+		{
+			if (!voiceEffects[i]->isBypassed() && voiceEffects[i]->hasControllerEnvelopes()) return true;
+		}
+
+		return false;
+	};
+
 	bool isTailingOff() const override
 	{
 		for(int i = 0; i < allEffects.size(); i++)
@@ -145,7 +166,15 @@ public:
 
 		ADD_GLITCH_DETECTOR(parentProcessor, DebugLogger::Location::MasterEffectRendering);
         
-		FOR_EACH_MASTER_EFFECT(renderWholeBuffer(b));
+		for (int i = 0; i < masterEffects.size(); ++i)
+		{
+			if (masterEffects[i]->isBypassed())
+				continue;
+
+			ADD_CPU_PROFILER_SCOPE(masterEffects[i], DebugLogger::Location::MasterEffectRendering);
+
+			masterEffects[i]->renderWholeBuffer(b);
+		}
 
 #if ENABLE_ALL_PEAK_METERS
 		currentValues.outL = (b.getMagnitude(0, 0, b.getNumSamples()));
@@ -212,18 +241,25 @@ public:
 
 		void remove(Processor *processorToBeRemoved, bool removeEffect=true) override
 		{
-			ScopedLock sl(chain->getMainController()->getLock());
-
 			jassert(dynamic_cast<EffectProcessor*>(processorToBeRemoved) != nullptr);
-			
-			chain->allEffects.removeAllInstancesOf(dynamic_cast<EffectProcessor*>(processorToBeRemoved));
 
-			if(VoiceEffectProcessor* vep = dynamic_cast<VoiceEffectProcessor*>(processorToBeRemoved)) chain->voiceEffects.removeObject(vep, removeEffect);
-			else if (MasterEffectProcessor* mep = dynamic_cast<MasterEffectProcessor*>(processorToBeRemoved)) chain->masterEffects.removeObject(mep, removeEffect);
-			else if (MonophonicEffectProcessor* moep = dynamic_cast<MonophonicEffectProcessor*>(processorToBeRemoved)) chain->monoEffects.removeObject(moep, removeEffect);
-			else jassertfalse;
+			// The effect is deleted after the lock is released so the audio thread doesn't wait for the destructor
+			ScopedPointer<Processor> pendingDelete = removeEffect ? processorToBeRemoved : nullptr;
+
+			{
+				ScopedLock sl(chain->getMainController()->getLock());
+
+				chain->allEffects.removeAllInstancesOf(dynamic_cast<EffectProcessor*>(processorToBeRemoved));
+
+				if(VoiceEffectProcessor* vep = dynamic_cast<VoiceEffectProcessor*>(processorToBeRemoved)) chain->voiceEffects.removeObject(vep, false);
+				else if (MasterEffectProcessor* mep = dynamic_cast<MasterEffectProcessor*>(processorToBeRemoved)) chain->masterEffects.removeObject(mep, false);
+				else if (MonophonicEffectProcessor* moep = dynamic_cast<MonophonicEffectProcessor*>(processorToBeRemoved)) chain->monoEffects.removeObject(moep, false);
+				else jassertfalse;
+
+				jassert(chain->allEffects.size() == (chain->masterEffects.size() + chain->voiceEffects.size() + chain->monoEffects.size()));
+			}
 
-			jassert(chain->allEffects.size() == (chain->masterEffects.size() + chain->voiceEffects.size() + chain->monoEffects.size()));
+			pendingDelete = nullptr;
 
 			sendChangeMessage();
 		}
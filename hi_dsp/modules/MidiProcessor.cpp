@@ -240,24 +240,27 @@ bool MidiProcessorFactoryType::allowType(const Identifier &typeName) const
 
 void MidiProcessorChain::MidiProcessorChainHandler::add(Processor *newProcessor, Processor *siblingToInsertBefore)
 {
-	ScopedLock sl(chain->getMainController()->getLock());
-
 	MidiProcessor *m = dynamic_cast<MidiProcessor*>(newProcessor);
 
 	jassert(m != nullptr);
 
-	const int index = siblingToInsertBefore == nullptr ? -1 : chain->processors.indexOf(dynamic_cast<MidiProcessor*>(siblingToInsertBefore));
-
     newProcessor->prepareToPlay(chain->getSampleRate(), chain->getBlockSize());
-    
-    newProcessor->setIsOnAir(true);
-    
-	chain->processors.insert(index, m);
 
+	// The script is compiled before the processor goes on air, so the compilation doesn't take the process lock
 	if (JavascriptMidiProcessor* sp = dynamic_cast<JavascriptMidiProcessor*>(newProcessor))
 	{	
 		sp->compileScript();
 	}
+    
+	{
+		ScopedLock sl(chain->getMainController()->getLock());
+
+		const int index = siblingToInsertBefore == nullptr ? -1 : chain->processors.indexOf(dynamic_cast<MidiProcessor*>(siblingToInsertBefore));
+
+		newProcessor->setIsOnAir(true);
+
+		chain->processors.insert(index, m);
+	}
 
 	sendChangeMessage();
 }
@@ -233,18 +233,26 @@ public:
 
 		void remove(Processor *processorToBeRemoved, bool deleteMp=true)
 		{
-			ScopedLock sl(chain->getMainController()->getLock());
-
 			jassert(dynamic_cast<MidiProcessor*>(processorToBeRemoved) != nullptr);
-			for(int i = 0; i < chain->processors.size(); i++)
+
+			// The processor is deleted after the lock is released so the audio thread doesn't wait for the destructor
+			ScopedPointer<Processor> pendingDelete = deleteMp ? processorToBeRemoved : nullptr;
+
 			{
-				if (chain->processors[i] == processorToBeRemoved)
+				ScopedLock sl(chain->getMainController()->getLock());
+
+				for(int i = 0; i < chain->processors.size(); i++)
 				{
-					chain->processors.remove(i, deleteMp);
-					break;
+					if (chain->processors[i] == processorToBeRemoved)
+					{
+						chain->processors.remove(i, false);
+						break;
+					}
 				}
 			}
 
+			pendingDelete = nullptr;
+
 			sendChangeMessage();
 		};
 
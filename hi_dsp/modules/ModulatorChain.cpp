@@ -38,9 +38,10 @@ ModulatorChain::ModulatorChain(MainController *mc, const String &uid, int numVoi
 	handler(this),
 	parentProcessor(p),
 	isVoiceStartChain(false),
-    internalVoiceBuffer(numVoices, 0),
-    envelopeTempBuffer(1, 0)
+    internalVoiceBuffer(numVoices, 0)
 {
+	// The envelopes of the chain render into the voice rows, so the internal buffer is only used by the monophonic modulators
+	internalBuffer.setSize(1, 0);
 	
 
 	activeVoices.setRange(0, numVoices, false);
@@ -101,9 +102,48 @@ void ModulatorChain::handleHiseEvent(const HiseEvent &m)
 
 	for(int i = 0; i < envelopeModulators.size(); i++) envelopeModulators[i]->handleHiseEvent(m);
 
+	if (variantModulators.size() == 0)
+		return;
+
+	if (numPendingVariantEvents == NumMaxPendingVariantEvents)
+	{
+		// The queue holds a full event buffer, so this only happens if the chain wasn't rendered for a few blocks
+		sendPendingVariantEvents();
+	}
+
+	// The ModulatorSynth doesn't split the rendering at most events, so the time variant
+	// modulators would get them too early. They are sent in renderNextBlock() instead.
+	if (m.getTimeStamp() > 0 || numPendingVariantEvents > 0)
+	{
+		pendingVariantEvents[numPendingVariantEvents++] = m;
+		return;
+	}
+
 	for(int i = 0; i < variantModulators.size(); i++) variantModulators[i]->handleHiseEvent(m);
 };
 
+void ModulatorChain::sendPendingVariantEvents()
+{
+	for (int i = 0; i < numPendingVariantEvents; i++)
+	{
+		for (auto v : variantModulators)
+			v->handleHiseEvent(pendingVariantEvents[i]);
+	}
+
+	numPendingVariantEvents = 0;
+}
+
+bool ModulatorChain::hasControllerEnvelopes() const
+{
+	for (auto m : envelopeModulators)
+	{
+		if (!m->isBypassed() && m->reactsToControllerEvents())
+			return true;
+	}
+
+	return false;
+}
+
 
 float ModulatorChain::getConstantVoiceValue(int voiceIndex) const
 {
@@ -204,7 +244,6 @@ void ModulatorChain::prepareToPlay(double sampleRate, int samplesPerBlock)
 	blockSize = samplesPerBlock;
 
 	ProcessorHelpers::increaseBufferIfNeeded(internalVoiceBuffer, samplesPerBlock);
-	ProcessorHelpers::increaseBufferIfNeeded(envelopeTempBuffer, samplesPerBlock);
 
 	for(int i = 0; i < envelopeModulators.size(); i++) envelopeModulators[i]->prepareToPlay(sampleRate, samplesPerBlock);
 	for(int i = 0; i < variantModulators.size(); i++) variantModulators[i]->prepareToPlay(sampleRate, samplesPerBlock);
@@ -250,11 +289,35 @@ void ModulatorChain::ModulatorChainHandler::addModulator(Modulator *newModulator
 
 	if (chain->isInitialized())
 		newModulator->prepareToPlay(chain->getSampleRate(), chain->blockSize);
+
+	// The envelopes of a synth that renders its voices in parallel need a working channel for every thread
+	if (auto synth = dynamic_cast<ModulatorSynth*>(ProcessorHelpers::findParentProcessor(chain, true)))
+	{
+		if (synth->isUsingParallelVoiceRendering())
+		{
+			Processor::Iterator<EnvelopeModulator> iter(newModulator);
+
+			while (auto e = iter.getNextProcessor())
+				e->setUseParallelRendering(true);
+		}
+	}
 	
 	const int index = siblingToInsertBefore == nullptr ? -1 : chain->allModulators.indexOf(dynamic_cast<Modulator*>(siblingToInsertBefore));
 
+	// A script is compiled before the modulator goes on air, so the compilation doesn't take the process lock.
+	// It must be a child of the chain already, because the scripting API looks up the parent synth in the module tree.
+	if (JavascriptProcessor* sp = dynamic_cast<JavascriptProcessor*>(newModulator))
 	{
-		MainController::ScopedSuspender ss(chain->getMainController());
+		{
+			ScopedLock sl(chain->getMainController()->getLock());
+			chain->allModulators.insert(index, newModulator);
+		}
+
+		sp->compileScript();
+	}
+
+	{
+		ScopedLock sl(chain->getMainController()->getLock());
 
 		newModulator->setIsOnAir(true);
 
@@ -275,14 +338,10 @@ void ModulatorChain::ModulatorChainHandler::addModulator(Modulator *newModulator
 		}
 		else jassertfalse;
 
-		chain->allModulators.insert(index, newModulator);
+		if (!chain->allModulators.contains(newModulator))
+			chain->allModulators.insert(index, newModulator);
 
 		jassert(chain->checkModulatorStructure());
-
-		if (JavascriptProcessor* sp = dynamic_cast<JavascriptProcessor*>(newModulator))
-		{
-			sp->compileScript();
-		}
 	}
 
 	chain->sendChangeMessage();
@@ -295,8 +354,6 @@ void ModulatorChain::ModulatorChainHandler::add(Processor *newProcessor, Process
 
 	jassert(dynamic_cast<Modulator*>(newProcessor) != nullptr);
 
-	dynamic_cast<AudioProcessor*>(chain->getMainController())->suspendProcessing(true);
-
 	addModulator(dynamic_cast<Modulator*>(newProcessor), siblingToInsertBefore);
 
 	const bool isPitchChain = chain->getMode() == Modulation::PitchMode;
@@ -304,11 +361,13 @@ void ModulatorChain::ModulatorChainHandler::add(Processor *newProcessor, Process
 	{
 		ModulatorSynth *p = dynamic_cast<ModulatorSynth*>(chain->getParentProcessor());
 
-		if(p != nullptr) p->enablePitchModulation(true);
+		if (p != nullptr)
+		{
+			ScopedLock sl(chain->getMainController()->getLock());
+			p->enablePitchModulation(true);
+		}
 	}
 
-	dynamic_cast<AudioProcessor*>(chain->getMainController())->suspendProcessing(false);
-
 	sendChangeMessage();
 }
 
@@ -341,17 +400,25 @@ void ModulatorChain::ModulatorChainHandler::deleteModulator(Modulator *modulator
 
 void ModulatorChain::ModulatorChainHandler::remove(Processor *processorToBeRemoved, bool deleteMod)
 {
-	ScopedLock sl(chain->getMainController()->getLock());
-
 	jassert(dynamic_cast<Modulator*>(processorToBeRemoved) != nullptr);
-	deleteModulator(dynamic_cast<Modulator*>(processorToBeRemoved), deleteMod);
-    
-	const bool isPitchChainOfNonGroup = chain->getMode() == Modulation::PitchMode;
-	if (isPitchChainOfNonGroup && getNumModulators() == 0)
+
+	// The modulator is deleted after the lock is released so the audio thread doesn't wait for the destructor
+	ScopedPointer<Processor> pendingDelete = deleteMod ? processorToBeRemoved : nullptr;
+
 	{
-		dynamic_cast<ModulatorSynth*>(chain->getParentProcessor())->enablePitchModulation(false);
+		ScopedLock sl(chain->getMainController()->getLock());
+
+		deleteModulator(dynamic_cast<Modulator*>(processorToBeRemoved), false);
+
+		const bool isPitchChainOfNonGroup = chain->getMode() == Modulation::PitchMode;
+		if (isPitchChainOfNonGroup && getNumModulators() == 0)
+		{
+			dynamic_cast<ModulatorSynth*>(chain->getParentProcessor())->enablePitchModulation(false);
+		}
 	}
 
+	pendingDelete = nullptr;
+
 	sendChangeMessage();
 }
 
@@ -409,36 +476,26 @@ ProcessorEditorBody *ModulatorChain::createEditor(ProcessorEditor *parentEditor)
 void ModulatorChain::renderVoice(int voiceIndex, int startSample, int numSamples)
 {
     ADD_GLITCH_DETECTOR(parentProcessor, DebugLogger::Location::ModulatorChainVoiceRendering);
+	ADD_CPU_PROFILER_SCOPE(this, DebugLogger::Location::ModulatorChainVoiceRendering);
     
-	// Use the internal buffer from timeModulation as working buffer.
-
-	//initializeBuffer(internalBuffer, startSample, numSamples);
-
+	// Use the row of the voice as working buffer, so that the voices can be rendered in parallel.
+	float* voiceValues = internalVoiceBuffer.getWritePointer(voiceIndex, 0);
 
 	const int startIndex = startSample;
 	const int sampleAmount = numSamples;
 
+	// Constant values and ramps are not written to the internal buffer until an envelope needs the buffer
+	ModulationBlockInfo info = ModulationBlockInfo::createConstant(1.0f);
+
+	// The plotter and the peak meter read the internal buffer for the last started voice
+	const bool useBlockInfo = blockInfoEnabled && voiceIndex != polyManager.getLastStartedVoice();
+
 	if( shouldBeProcessed(true))
 	{
 		const float constantVoiceValue = getConstantVoiceValue(voiceIndex);
 		const float lastVoiceValue = lastVoiceValues[voiceIndex];
 
-		if (std::abs(constantVoiceValue - lastVoiceValue) > 0.001f)
-		{
-			const float stepSize = (constantVoiceValue - lastVoiceValue) / (float)numSamples;
-			float* bufferPointer = internalBuffer.getWritePointer(0, startSample);
-			float rampedGain = lastVoiceValue;
-
-			for (int i = 0; i < numSamples; i++)
-			{
-				bufferPointer[i] = rampedGain;
-				rampedGain += stepSize;
-			}
-		}
-		else
-		{
-			FloatVectorOperations::fill(internalBuffer.getWritePointer(0, startSample), constantVoiceValue, numSamples);
-		}
+		info = ModulationBlockInfo::createRamp(lastVoiceValue, constantVoiceValue);
 
 		lastVoiceValues[voiceIndex] = constantVoiceValue;
 
@@ -450,14 +507,30 @@ void ModulatorChain::renderVoice(int voiceIndex, int startSample, int numSamples
 
 			if (m->isInMonophonicMode())
 				continue;
-			
-			m->polyManager.setCurrentVoice(voiceIndex);
 
-			FloatVectorOperations::fill(envelopeTempBuffer.getWritePointer(0, startSample), 1.0f, numSamples);
+			float constantEnvelopeValue;
+
+			if (useBlockInfo && !m->hasCalculatedVoiceBlock(voiceIndex) && m->getConstantValueForNextBlock(voiceIndex, constantEnvelopeValue))
+			{
+				const float factor = m->getModulationFactor(constantEnvelopeValue);
 
-			float* bufferPointer = internalBuffer.getWritePointer(0, 0);
+				if (info.isDynamic())
+					FloatVectorOperations::multiply(voiceValues + startSample, factor, numSamples);
+				else
+					info.multiply(factor);
 
-			AudioSampleBuffer b1(&bufferPointer, 1, startSample + numSamples);
+				continue;
+			}
+
+			if (!info.isDynamic())
+			{
+				info.fill(voiceValues + startSample, numSamples);
+				info.type = ModulationBlockInfo::Dynamic;
+			}
+			
+			m->polyManager.setCurrentVoice(voiceIndex);
+
+			AudioSampleBuffer b1(&voiceValues, 1, startSample + numSamples);
 
 			m->renderNextBlock(b1, startSample, numSamples);
 
@@ -466,28 +539,65 @@ void ModulatorChain::renderVoice(int voiceIndex, int startSample, int numSamples
 
 	}
 
-	CHECK_AND_LOG_BUFFER_DATA_WITH_ID(parentProcessor, chainIdentifier, DebugLogger::Location::ModulatorChainVoiceRendering, internalBuffer.getReadPointer(0, startIndex), true, sampleAmount);
+	if (!info.isDynamic())
+	{
+		const float minValue = getMode() == Modulation::GainMode ? 0.0f : -1.0f;
 
-	if(getMode() != Modulation::PitchMode)
-		FloatVectorOperations::clip(internalBuffer.getWritePointer(0, startIndex), internalBuffer.getReadPointer(0, startIndex), (getMode() == Modulation::GainMode ? 0.0f : -1.0f), 1.0f, sampleAmount);
+		// A clipped ramp is not linear anymore
+		const bool needsClipping = getMode() != Modulation::PitchMode && (jmin(info.startValue, info.endValue) < minValue || jmax(info.startValue, info.endValue) > 1.0f);
+
+		if (needsClipping || !useBlockInfo)
+		{
+			info.fill(voiceValues + startSample, numSamples);
+			info.type = ModulationBlockInfo::Dynamic;
+		}
+	}
+
+	if (!info.isDynamic())
+	{
+		// The voice values are only written for the consumers that don't check the block info
+		if (!consumersUseBlockInfo)
+			info.fill(voiceValues + startIndex, sampleAmount);
+
+		voiceBlockInfo[voiceIndex] = info;
+		return;
+	}
+
+	voiceBlockInfo[voiceIndex] = info;
 
-	// Copy the result to the voice buffer
-	FloatVectorOperations::copy(internalVoiceBuffer.getWritePointer(voiceIndex, startIndex), internalBuffer.getReadPointer(0, startIndex), sampleAmount);
+	CHECK_AND_LOG_BUFFER_DATA_WITH_ID(parentProcessor, chainIdentifier, DebugLogger::Location::ModulatorChainVoiceRendering, voiceValues + startIndex, true, sampleAmount);
+
+	if(getMode() != Modulation::PitchMode)
+		FloatVectorOperations::clip(voiceValues + startIndex, voiceValues + startIndex, (getMode() == Modulation::GainMode ? 0.0f : -1.0f), 1.0f, sampleAmount);
 
 #if ENABLE_PLOTTER
 	if(voiceIndex == polyManager.getLastStartedVoice())
 	{
-		saveEnvelopeValueForPlotter(internalBuffer, startIndex, sampleAmount);
+		saveEnvelopeValueForPlotter(voiceValues, startIndex, sampleAmount);
 	}
 #elif ENABLE_ALL_PEAK_METERS
 	if (voiceIndex == polyManager.getLastStartedVoice())
 	{
-		envelopeOutputValue1 = internalBuffer.getSample(0, startIndex);
+		envelopeOutputValue1 = voiceValues[startIndex];
 	}
 #endif
 
 }
 
+void ModulatorChain::calculateVoiceBlocks(const int* voiceIndexes, int numVoices, int startSample, int numSamples)
+{
+	if (!batchedEnvelopesEnabled || numVoices < HISE_MIN_VOICES_FOR_BATCHED_ENVELOPES || !shouldBeProcessed(true))
+		return;
+
+	for (auto m : envelopeModulators)
+	{
+		if (m->isBypassed() || m->isInMonophonicMode() || !m->canCalculateVoiceBlocks())
+			continue;
+
+		m->renderVoiceBlocks(voiceIndexes, numVoices, startSample, numSamples);
+	}
+}
+
 void ModulatorChain::renderNextBlock(AudioSampleBuffer& buffer, int startSample, int numSamples)
 {
 	const int startIndex = startSample;
@@ -495,25 +605,53 @@ void ModulatorChain::renderNextBlock(AudioSampleBuffer& buffer, int startSample,
 
 	{
 		ADD_GLITCH_DETECTOR(parentProcessor, DebugLogger::Location::ModulatorChainTimeVariantRendering);
+		ADD_CPU_PROFILER_SCOPE(this, DebugLogger::Location::ModulatorChainTimeVariantRendering);
 
 		jassert(getSampleRate() > 0);
 
 		initializeBuffer(internalBuffer, startSample, numSamples);
 
-		for (auto v : variantModulators)
+		bool isUnity = true;
+
+		// Split the time variant modulators at the queued events. A controller modulator
+		// then starts its ramp at the exact sample without splitting the voice rendering.
+		const int endSample = startSample + numSamples;
+		int pos = startSample;
+
+		for (int i = 0; i < numPendingVariantEvents; i++)
 		{
-			if (v->isBypassed()) continue;
-			v->renderNextBlock(internalBuffer, startSample, numSamples);
+			const HiseEvent& e = pendingVariantEvents[i];
+			const int timestamp = (int)e.getTimeStamp();
+
+			// Events from behind the last block are sent at the start
+			const int eventPos = timestamp < endSample ? jmax<int>(pos, timestamp) : pos;
+
+			if (eventPos > pos)
+			{
+				isUnity &= !renderVariantModulators(pos, eventPos - pos);
+				pos = eventPos;
+			}
+
+			for (auto v : variantModulators)
+				v->handleHiseEvent(e);
 		}
 
+		numPendingVariantEvents = 0;
+
+		if (pos < endSample)
+			isUnity &= !renderVariantModulators(pos, endSample - pos);
+
 		for (auto m : envelopeModulators)
 		{
 			if (m->isBypassed()) continue;
 			if (!m->isInMonophonicMode()) continue;
 
 			m->renderNextBlock(internalBuffer, startSample, numSamples);
+			isUnity = false;
 		}
 
+		timeVariantBlockInfo = isUnity ? ModulationBlockInfo::createConstant(1.0f) : ModulationBlockInfo();
+
 #if ENABLE_PLOTTER
 		updatePlotter(internalBuffer, startSample, numSamples);
 #elif ENABLE_ALL_PEAK_METERS
@@ -528,6 +666,20 @@ void ModulatorChain::renderNextBlock(AudioSampleBuffer& buffer, int startSample,
     
 }
 
+bool ModulatorChain::renderVariantModulators(int startSample, int numSamples)
+{
+	bool rendered = false;
+
+	for (auto v : variantModulators)
+	{
+		if (v->isBypassed()) continue;
+		v->renderNextBlock(internalBuffer, startSample, numSamples);
+		rendered = true;
+	}
+
+	return rendered;
+}
+
 bool ModulatorChain::checkModulatorStructure()
 {
 	
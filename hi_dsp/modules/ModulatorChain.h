@@ -168,6 +168,13 @@ public:
 	*/
 	void renderVoice(int voiceIndex, int startSample, int numSamples);
 
+	/** Lets the envelopes calculate the next block of all given voices at once.
+	*
+	*	Call this before the renderVoice() calls of the voices with the same sample range. The envelopes that don't support this
+	*	(or voices that are skipped by the envelope) are calculated in renderVoice() as usual.
+	*/
+	void calculateVoiceBlocks(const int* voiceIndexes, int numVoices, int startSample, int numSamples);
+
 	/** Returns a read pointer to the calculated voice values. The array size is supposed to be the size of the internal buffer. */
 	float *getVoiceValues(int voiceIndex) noexcept
 	{ return internalVoiceBuffer.getWritePointer(voiceIndex); };
@@ -176,6 +183,35 @@ public:
 	const float *getVoiceValues(int voiceIndex) const noexcept
 	{ return internalVoiceBuffer.getReadPointer(voiceIndex); }
 
+	/** Returns the shape of the voice values that were calculated by the last renderVoice() call.
+	*
+	*	If this is constant or a ramp, you can apply it as scalar gain instead. The voice values are written unless
+	*	setConsumersUseBlockInfo() was called. If you change the voice values, update this too (or set it to ModulationBlockInfo::Dynamic).
+	*/
+	ModulationBlockInfo& getVoiceBlockInfo(int voiceIndex) noexcept { return voiceBlockInfo[voiceIndex]; }
+
+	/** Tells the chain that every consumer of the voice values checks getVoiceBlockInfo() first.
+	*
+	*	The chain then skips writing constant and ramp blocks into the voice values (except for the last started voice, 
+	*	which is read by the plotter).
+	*/
+	void setConsumersUseBlockInfo(bool shouldUseBlockInfo) noexcept { consumersUseBlockInfo = shouldUseBlockInfo; }
+
+	/** Enables the detection of constant and ramp blocks (it's enabled by default).
+	*
+	*	If disabled, every voice block is calculated into the voice values and tagged as dynamic. 
+	*/
+	void setUseBlockInfo(bool shouldUseBlockInfo) noexcept { blockInfoEnabled = shouldUseBlockInfo; }
+
+	/** Enables calculateVoiceBlocks() (it's enabled by default). If disabled, every voice calculates its envelopes in renderVoice(). */
+	void setUseBatchedEnvelopes(bool shouldUseBatchedEnvelopes) noexcept { batchedEnvelopesEnabled = shouldUseBatchedEnvelopes; }
+
+	/** Returns the shape of the values that were calculated by the last renderNextBlock() call. */
+	const ModulationBlockInfo& getTimeVariantBlockInfo() const noexcept { return timeVariantBlockInfo; }
+
+	/** Checks if any active envelope changes the voice values on controller events (see EnvelopeModulator::reactsToControllerEvents()). */
+	bool hasControllerEnvelopes() const;
+
 	/** This ocverrides the TimeVariant::renderNextBlock method and only calculates the TimeVariant modulators.
 	*
 	*	It assumes that the other modulators are calculated before with renderVoice().
@@ -282,15 +318,21 @@ private:
 	// Checks if the Modulators are initialized correctly and are set to the right voices */
 	bool checkModulatorStructure();
 
+	// Renders the time variant modulators and returns false if all of them are bypassed
+	bool renderVariantModulators(int startSample, int numSamples);
+
+	// Sends the queued events to the time variant modulators without waiting for their position
+	void sendPendingVariantEvents();
+
 	BigInteger activeVoices;
 
 	// Saves 4 values of the envelope modulation result for later
-	void saveEnvelopeValueForPlotter(const AudioSampleBuffer &processedBuffer, int startSample, int numSamples)
+	void saveEnvelopeValueForPlotter(const float* voiceValues, int startSample, int numSamples)
 	{
-		envelopeOutputValue1 = processedBuffer.getSample(0, startSample );
-		envelopeOutputValue2 = processedBuffer.getSample(0, startSample + numSamples / 4);
-		envelopeOutputValue3 = processedBuffer.getSample(0, startSample + numSamples / 2);
-		envelopeOutputValue4 = processedBuffer.getSample(0, startSample + (3 * numSamples) / 4);
+		envelopeOutputValue1 = voiceValues[startSample];
+		envelopeOutputValue2 = voiceValues[startSample + numSamples / 4];
+		envelopeOutputValue3 = voiceValues[startSample + numSamples / 2];
+		envelopeOutputValue4 = voiceValues[startSample + (3 * numSamples) / 4];
 
 		
 	};
@@ -325,8 +367,6 @@ private:
 	
 	// A AudioSampleBuffer with one channel per voice
 	AudioSampleBuffer internalVoiceBuffer;
-	
-	AudioSampleBuffer envelopeTempBuffer;
 
 	ModulatorChainHandler handler;
 
@@ -352,6 +392,23 @@ private:
 
 	float lastVoiceValues[NUM_POLYPHONIC_VOICES];
 
+	ModulationBlockInfo voiceBlockInfo[NUM_POLYPHONIC_VOICES];
+	ModulationBlockInfo timeVariantBlockInfo;
+
+	bool consumersUseBlockInfo = false;
+	bool blockInfoEnabled = true;
+	bool batchedEnvelopesEnabled = true;
+
+	enum
+	{
+		// A block never has more events than the event buffer of the synth
+		NumMaxPendingVariantEvents = HISE_EVENT_BUFFER_SIZE
+	};
+
+	// The time variant modulators get the events at their timestamp in the next renderNextBlock() call
+	HiseEvent pendingVariantEvents[NumMaxPendingVariantEvents];
+	int numPendingVariantEvents = 0;
+
 	bool isVoiceStartChain;
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModulatorChain)
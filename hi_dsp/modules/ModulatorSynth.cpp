@@ -75,7 +75,15 @@ bypassState(false)
 {
 	setVoiceLimit(numVoices);
 
-	
+	// The voices apply the gain with applyVoiceGainValues()
+	gainChain->setConsumersUseBlockInfo(true);
+
+	FloatVectorOperations::fill(lastVoiceGainValues, 1.0f, NUM_POLYPHONIC_VOICES);
+
+	for (auto& w : freeVoiceMask)
+		w.store(0);
+
+	resetVoiceStealingStatistics();
 
 	for (int i = 0; i < 4; i++)
 	{
@@ -128,6 +136,9 @@ ValueTree ModulatorSynth::exportAsValueTree() const
 
 	v.setProperty("IconColour", iconColour.toString(), nullptr);
 
+	if (voiceStealingPolicy != VoiceStealingPolicy::ReleasedFirst)
+		v.setProperty("VoiceStealingPolicy", (int)voiceStealingPolicy, nullptr);
+
 	return v;
 }
 
@@ -142,6 +153,9 @@ void ModulatorSynth::restoreFromValueTree(const ValueTree &v)
 
 	iconColour = Colour::fromString(v.getProperty("IconColour", Colours::transparentBlack.toString()).toString());
 
+	const int policyIndex = jlimit<int>(0, (int)VoiceStealingPolicy::numVoiceStealingPolicies - 1, (int)v.getProperty("VoiceStealingPolicy", 0));
+	setVoiceStealingPolicy((VoiceStealingPolicy)policyIndex);
+
 	Processor::restoreFromValueTree(v);
 }
 
@@ -325,6 +339,12 @@ void ModulatorSynth::processHiseEventBuffer(const HiseEventBuffer &inputBuffer,
 	midiProcessorChain->renderNextHiseEventBuffer(eventBuffer, numSamples);
 }
 
+void ModulatorSynth::preprocessHiseEventBuffer(const HiseEventBuffer &inputBuffer, int numSamples)
+{
+	processHiseEventBuffer(inputBuffer, numSamples);
+	eventsArePreprocessed = true;
+}
+
 void ModulatorSynth::addProcessorsWhenEmpty()
 {
 	
@@ -345,6 +365,7 @@ void ModulatorSynth::renderNextBlockWithModulators(AudioSampleBuffer& outputBuff
 	jassert(isOnAir());
 
     ADD_GLITCH_DETECTOR(this, DebugLogger::Location::SynthRendering);
+	ADD_CPU_PROFILER_SCOPE(this, DebugLogger::Location::SynthRendering);
     
 	int numSamples = getBlockSize(); //outputBuffer.getNumSamples();
 
@@ -358,7 +379,10 @@ void ModulatorSynth::renderNextBlockWithModulators(AudioSampleBuffer& outputBuff
 	
 	initRenderCallback();
 
-	processHiseEventBuffer(inputMidiBuffer, numSamplesFixed);
+	if (eventsArePreprocessed)
+		eventsArePreprocessed = false;
+	else
+		processHiseEventBuffer(inputMidiBuffer, numSamplesFixed);
 
 	
 	midiInputFlag = !eventBuffer.isEmpty();
@@ -368,47 +392,45 @@ void ModulatorSynth::renderNextBlockWithModulators(AudioSampleBuffer& outputBuff
 	HiseEvent m;
 	int midiEventPos;
 
+	bool hasPendingEvent = eventIterator.getNextEvent(m, midiEventPos, true, false);
+
+	// Only the events that change the playing voices split the rendering. Note ons start their voices with an offset
+	// and the modulator chains send the other events to their time variant modulators at the exact position.
 	while (numSamples > 0)
 	{
-		if (!eventIterator.getNextEvent(m, midiEventPos, true, false))
-		{
-			preVoiceRendering(startSample, numSamples);
-			renderVoice(startSample, numSamples);
-			postVoiceRendering(startSample, numSamples);
+		int numThisTime = numSamples;
 
-			break;
-		}
+		while (hasPendingEvent)
+		{
+			if (midiEventPos >= startSample + numSamples)
+				break;
 
-		const int samplesToNextMidiMessage = midiEventPos - startSample;
-		const int delta = (samplesToNextMidiMessage % 8);
-		const int rastered = samplesToNextMidiMessage - delta;
+			if (midiEventPos > startSample && needsRenderSplit(m))
+			{
+				numThisTime = midiEventPos - startSample;
+				break;
+			}
 
-		if (rastered >= numSamples)
-		{
-			preVoiceRendering(startSample, numSamples);
-			renderVoice(startSample, numSamples);
-			postVoiceRendering(startSample, numSamples);
+			voiceStartOffset = jmax<int>(startSample, midiEventPos);
 			handleHiseEvent(m);
-			break;
-		}
+			voiceStartOffset = 0;
 
-		if (rastered < 32)
-		{
-			handleHiseEvent(m);
-			continue;
+			hasPendingEvent = eventIterator.getNextEvent(m, midiEventPos, true, false);
 		}
 
-		preVoiceRendering(startSample, rastered);
-		renderVoice(startSample, rastered);
-		postVoiceRendering(startSample, rastered);
+		preVoiceRendering(startSample, numThisTime);
+		renderVoice(startSample, numThisTime);
+		postVoiceRendering(startSample, numThisTime);
 
-		handleHiseEvent(m);
-		startSample += rastered;
-		numSamples -= rastered;
+		startSample += numThisTime;
+		numSamples -= numThisTime;
 	}
 
-	while (eventIterator.getNextEvent(m, midiEventPos, true, false))
+	while (hasPendingEvent)
+	{
 		handleHiseEvent(m);
+		hasPendingEvent = eventIterator.getNextEvent(m, midiEventPos, true, false);
+	}
 
 	AudioSampleBuffer thisInternalBuffer(internalBuffer.getArrayOfWritePointers(), internalBuffer.getNumChannels(), numSamplesFixed);
 
@@ -455,6 +477,57 @@ void ModulatorSynth::renderNextBlockWithModulators(AudioSampleBuffer& outputBuff
 	handlePeakDisplay(numSamplesFixed);
 }
 
+bool ModulatorSynth::needsRenderSplit(const HiseEvent& e) const
+{
+	if (e.isNoteOff() || e.isAllNotesOff() || e.isVolumeFade() || e.isPitchFade())
+		return true;
+
+	if (e.isController())
+	{
+		// The pedals can stop voices
+		const int number = e.getControllerNumber();
+
+		if (number == 0x40 || number == 0x42 || number == 0x43)
+			return true;
+	}
+
+	if (e.isController() || e.isPitchWheel() || e.isAftertouch() || e.isChannelPressure())
+	{
+		// The time variant modulators get these events at their position (see ModulatorChain::handleHiseEvent()),
+		// but the envelopes of the playing voices are calculated per slice.
+		return activeVoices.size() != 0 && hasControllerEnvelopes();
+	}
+
+	if (e.isNoteOn())
+	{
+		// The note on might steal or kill a voice that is still playing until this position
+		if (activeVoices.size() >= jmin<int>(internalVoiceLimit, getNumVoices()) - 1)
+			return true;
+
+		for (int i = 0; i < activeVoices.size(); i++)
+		{
+			if (activeVoices[i]->getCurrentlyPlayingNote() == e.getNoteNumber())
+				return true;
+		}
+	}
+
+	return false;
+}
+
+bool ModulatorSynth::hasControllerEnvelopes() const
+{
+	for (int i = 0; i < getNumInternalChains(); i++)
+	{
+		if (auto mc = dynamic_cast<const ModulatorChain*>(getChildProcessor(i)))
+		{
+			if (mc->hasControllerEnvelopes())
+				return true;
+		}
+	}
+
+	return effectChain->hasControllerEnvelopes();
+}
+
 void ModulatorSynth::preVoiceRendering(int startSample, int numThisTime)
 {
 	// calculate the variant pitch values before the voices are rendered.
@@ -468,7 +541,13 @@ void ModulatorSynth::preVoiceRendering(int startSample, int numThisTime)
 void ModulatorSynth::renderVoice(int startSample, int numThisTime)
 {
     ADD_GLITCH_DETECTOR(this, DebugLogger::Location::SynthVoiceRendering);
+	ADD_CPU_PROFILER_SCOPE(this, DebugLogger::Location::SynthVoiceRendering);
     
+	calculateVoiceBlocks(startSample, numThisTime);
+
+	if (renderVoicesInParallel(startSample, numThisTime))
+		return;
+
 	for (int i = 0; i < activeVoices.size(); i++)
 	{
 		//jassert(!activeVoices[i]->isInactive());
@@ -476,12 +555,135 @@ void ModulatorSynth::renderVoice(int startSample, int numThisTime)
 		activeVoices[i]->renderNextBlock(internalBuffer, startSample, numThisTime);
 
 		if (activeVoices[i]->isInactive())
-		{
 			activeVoices.removeElement(i--);
-		}
 	}
 };
 
+void ModulatorSynth::calculateVoiceBlocks(int startSample, int numThisTime)
+{
+	if (activeVoices.size() < HISE_MIN_VOICES_FOR_BATCHED_ENVELOPES)
+		return;
+
+	int numGainVoices = 0;
+	int numPitchVoices = 0;
+
+	for (int i = 0; i < activeVoices.size(); i++)
+	{
+		auto v = activeVoices[i];
+
+		// A voice that starts later in this block renders its modulation with a different range
+		if (v->getStartOffset() > startSample)
+			continue;
+
+		gainBlockVoices[numGainVoices++] = v->getVoiceIndex();
+
+		if (v->isPitchModulationActive())
+			pitchBlockVoices[numPitchVoices++] = v->getVoiceIndex();
+	}
+
+	if (!isChainDisabled(GainModulation))
+		gainChain->calculateVoiceBlocks(gainBlockVoices, numGainVoices, startSample, numThisTime);
+
+	if (!isChainDisabled(PitchModulation))
+		pitchChain->calculateVoiceBlocks(pitchBlockVoices, numPitchVoices, startSample, numThisTime);
+}
+
+void ModulatorSynth::setUseParallelVoiceRendering(bool shouldRenderVoicesInParallel)
+{
+	auto& pool = getMainController()->getRealtimeWorkerPool();
+
+	MainController::ScopedSuspender ss(getMainController(), MainController::ScopedSuspender::LockType::Lock);
+
+	if (shouldRenderVoicesInParallel && pool.getNumWorkers() == 0)
+		pool.setNumWorkers(RealtimeWorkerPool::getDefaultNumWorkers());
+
+	useParallelVoiceRendering = shouldRenderVoicesInParallel && canRenderVoicesInParallel();
+	refreshParallelVoiceBuffer();
+}
+
+void ModulatorSynth::refreshParallelVoiceBuffer()
+{
+	if (useParallelVoiceRendering)
+	{
+		// renderVoicesInParallel() never creates more tasks than there are buffers
+		const int numTasks = getMainController()->getRealtimeWorkerPool().getNumWorkers() + 1;
+
+		parallelVoiceBuffer.setSize(internalBuffer.getNumChannels() * numTasks, jmax<int>(0, getBlockSize()));
+	}
+	else
+	{
+		parallelVoiceBuffer.setSize(0, 0);
+	}
+
+	Processor* chainsWithVoiceEnvelopes[3] = { gainChain, pitchChain, effectChain };
+
+	for (auto c : chainsWithVoiceEnvelopes)
+	{
+		Processor::Iterator<EnvelopeModulator> iter(c);
+
+		while (auto e = iter.getNextProcessor())
+			e->setUseParallelRendering(useParallelVoiceRendering);
+	}
+}
+
+void ModulatorSynth::renderVoiceTask(void* synth, int taskIndex)
+{
+	auto s = static_cast<ModulatorSynth*>(synth);
+
+	const int numVoices = s->activeVoices.size();
+	const int numChannels = s->internalBuffer.getNumChannels();
+	const int firstVoice = numVoices * taskIndex / s->numParallelVoiceTasks;
+	const int lastVoice = numVoices * (taskIndex + 1) / s->numParallelVoiceTasks;
+
+	AudioSampleBuffer taskBuffer(s->parallelVoiceBuffer.getArrayOfWritePointers() + taskIndex * numChannels, numChannels, s->parallelStartSample + s->parallelNumSamples);
+	taskBuffer.clear(s->parallelStartSample, s->parallelNumSamples);
+
+	for (int i = firstVoice; i < lastVoice; i++)
+		s->activeVoices[i]->renderNextBlock(taskBuffer, s->parallelStartSample, s->parallelNumSamples);
+}
+
+bool ModulatorSynth::renderVoicesInParallel(int startSample, int numThisTime)
+{
+	if (!useParallelVoiceRendering)
+		return false;
+
+	auto& pool = getMainController()->getRealtimeWorkerPool();
+
+	const int numChannels = internalBuffer.getNumChannels();
+
+	// The buffers are not prepared yet (this will be fixed at the next prepareToPlay())
+	if (numChannels == 0 || parallelVoiceBuffer.getNumSamples() < startSample + numThisTime)
+		return false;
+
+	const int numTasks = jmin<int>(pool.getNumWorkers() + 1, 
+								   activeVoices.size() / HISE_MIN_VOICES_PER_RENDER_TASK, 
+								   parallelVoiceBuffer.getNumChannels() / numChannels);
+
+	if (numTasks < 2)
+		return false;
+
+	numParallelVoiceTasks = numTasks;
+	parallelStartSample = startSample;
+	parallelNumSamples = numThisTime;
+
+	pool.runParallel(renderVoiceTask, this, numTasks);
+
+	// Sum the buffers in a fixed order so that the result doesn't depend on the thread timing
+	for (int t = 0; t < numTasks; t++)
+	{
+		for (int c = 0; c < numChannels; c++)
+			FloatVectorOperations::add(internalBuffer.getWritePointer(c, startSample), parallelVoiceBuffer.getReadPointer(t * numChannels + c, startSample), numThisTime);
+	}
+
+	for (int i = 0; i < activeVoices.size(); i++)
+	{
+		if (activeVoices[i]->isInactive())
+			activeVoices.removeElement(i--);
+	}
+
+	return true;
+}
+
 	
 void ModulatorSynth::postVoiceRendering(int startSample, int numThisTime)
 {
@@ -493,7 +695,8 @@ void ModulatorSynth::postVoiceRendering(int startSample, int numThisTime)
 	// Apply all gain modulators to the rendered voices
 	for (int i = 0; i < internalBuffer.getNumChannels(); i++)
 	{
-		FloatVectorOperations::multiply(internalBuffer.getWritePointer(i, startSample), gainBuffer.getReadPointer(0, startSample), numThisTime);
+		if (!gainChain->getTimeVariantBlockInfo().isUnity())
+			FloatVectorOperations::multiply(internalBuffer.getWritePointer(i, startSample), gainBuffer.getReadPointer(0, startSample), numThisTime);
 
 		CHECK_AND_LOG_BUFFER_DATA_WITH_ID(this, getIDAsIdentifier(), DebugLogger::Location::SynthPostVoiceRendering, internalBuffer.getReadPointer(i, startSample), i % 2 != 0, numThisTime);
 	}
@@ -704,6 +907,8 @@ void ModulatorSynth::startVoiceWithHiseEvent(ModulatorSynthVoice* voice, Synthes
 
 	activeVoices.insert(voice);
 
+	voice->setStartOffset(voiceStartOffset);
+
 	Synthesiser::startVoice(static_cast<SynthesiserVoice*>(voice), sound, e.getChannel(), e.getNoteNumber(), e.getFloatVelocity());
 }
 
@@ -713,6 +918,8 @@ void ModulatorSynth::preStartVoice(int voiceIndex, int noteNumber)
 
 	lastStartedVoice = static_cast<ModulatorSynthVoice*>(getVoice(voiceIndex));
 
+	// The voice didn't render anything yet, so it shouldn't be the quietest voice
+	lastVoiceGainValues[voiceIndex] = 1.0f;
 
 
 	gainChain->startVoice(voiceIndex);
@@ -752,6 +959,8 @@ void ModulatorSynth::prepareToPlay(double newSampleRate, int samplesPerBlock)
 
 		effectChain->prepareToPlay(newSampleRate, samplesPerBlock);
 
+		refreshParallelVoiceBuffer();
+
 		setKillFadeOutTime(killFadeTime);
 	}
 }
@@ -765,6 +974,7 @@ void ModulatorSynth::numSourceChannelsChanged()
 	{
 		jassert(getBlockSize() > 0);
 		internalBuffer.setSize(getMatrix().getNumSourceChannels(), internalBuffer.getNumSamples());
+		refreshParallelVoiceBuffer();
 	}
 
 	for (int i = 0; i < effectChain->getNumChildProcessors(); i++)
@@ -856,17 +1066,18 @@ void ModulatorSynth::noteOn(const HiseEvent &m)
         {
             // If hitting a note that's still ringing, stop it first (it could be
             // still playing because of the sustain or sostenuto pedal).
-            for (int j = voices.size(); --j >= 0;)
+			// Only the active voices need to be checked (the inactive voices don't play any channel).
+            for (int j = activeVoices.size(); --j >= 0;)
             {
-                ModulatorSynthVoice* const voice = static_cast<ModulatorSynthVoice*>(voices.getUnchecked (j));
+                ModulatorSynthVoice* const voice = activeVoices[j];
 
 				const bool voiceIsActive = voice->isPlayingChannel(midiChannel) && !voice->isBeingKilled();
 
 				// if the voiceLimit is reached, kill the voice!
 
-				if(voiceIsActive && j >= (internalVoiceLimit - 1)) 
+				if(voiceIsActive && voice->getVoiceIndex() >= (internalVoiceLimit - 1)) 
 				{
-					killLastVoice();
+					killLastVoice(midiNoteNumber);
 				}
 
                 else if (voice->getCurrentlyPlayingNote() == midiNoteNumber // Use the untransposed number for detecting repeated notes
@@ -1029,10 +1240,14 @@ void ModulatorSynthVoice::resetVoice()
 	uptimeDelta = 0.0;
 	voiceUptime = 0.0;
 	startUptime = DBL_MAX;
+	startOffset = 0;
 
 	isTailing = false;
     isActive = false;
 
+	// The voice can be reset outside of the rendering (eg. by a group), so it marks itself as free here
+	os->setVoiceFree(this);
+
 	killThisVoice = false;
 	killFadeLevel = 1.0f;
 
@@ -1136,62 +1351,180 @@ void ModulatorSynth::killAllVoicesWithNoteNumber(int noteNumber)
 
 
 	
-void ModulatorSynth::killLastVoice()
+void ModulatorSynth::killLastVoice(int noteNumberToStart)
 {
-	ModulatorSynthVoice *oldest = nullptr;
-	double oldestUptime = DBL_MAX;
+	if (auto v = getVoiceToSteal(noteNumberToStart, false))
+		v->killVoice();
+};
 
-	// search all tailing notes
-	for(int i = 0; i < voices.size(); i++)
+void ModulatorSynth::resetVoiceStealingStatistics() noexcept
+{
+	for (int i = 0; i < (int)VoiceStealingPolicy::numVoiceStealingPolicies; i++)
+		numStolenVoices[i].store(0);
+}
+
+ModulatorSynthVoice* ModulatorSynth::getVoiceToSteal(int noteNumberToStart, bool includeKilledVoices) const
+{
+	ModulatorSynthVoice* oldest = nullptr;
+	ModulatorSynthVoice* oldestReleased = nullptr;
+	ModulatorSynthVoice* oldestWithSameNote = nullptr;
+	ModulatorSynthVoice* quietest = nullptr;
+	float lowestGain = FLT_MAX;
+
+	// Find the candidates of all policies in a single pass over the active voices
+	for (int i = 0; i < activeVoices.size(); i++)
 	{
-		ModulatorSynthVoice *v = static_cast<ModulatorSynthVoice*>(voices[i]);
+		ModulatorSynthVoice* v = activeVoices[i];
 
-		if(v->isBeingKilled() || !v->isTailingOff()) continue;
+		if (v->isInactive() || (v->isBeingKilled() && !includeKilledVoices)) continue;
 
 		const double voiceUptime = v->getVoiceUptime();
 
-		if(voiceUptime < oldestUptime)
-		{
-			oldestUptime = voiceUptime;
+		if (oldest == nullptr || voiceUptime < oldest->getVoiceUptime())
 			oldest = v;
+
+		if (v->isTailingOff() && (oldestReleased == nullptr || voiceUptime < oldestReleased->getVoiceUptime()))
+			oldestReleased = v;
+
+		if (v->getCurrentlyPlayingNote() == noteNumberToStart && (oldestWithSameNote == nullptr || voiceUptime < oldestWithSameNote->getVoiceUptime()))
+			oldestWithSameNote = v;
+
+		const float gainValue = lastVoiceGainValues[v->getVoiceIndex()];
+
+		if (gainValue < lowestGain)
+		{
+			lowestGain = gainValue;
+			quietest = v;
 		}
 	}
-	
-	
-	if(oldest != nullptr)
+
+	VoiceStealingPolicy policy = voiceStealingPolicy;
+	ModulatorSynthVoice* voiceToSteal = nullptr;
+
+	if (policy == VoiceStealingPolicy::SameNoteFirst)
 	{
-		oldest->killVoice();
-		return;
+		if (oldestWithSameNote != nullptr)
+			voiceToSteal = oldestWithSameNote;
+		else
+			policy = VoiceStealingPolicy::ReleasedFirst;
 	}
 
-	// search all notes
-	for(int i = 0; i < voices.size(); i++)
+	switch (policy)
 	{
-		ModulatorSynthVoice *v = static_cast<ModulatorSynthVoice*>(voices[i]);
+	case VoiceStealingPolicy::ReleasedFirst:	voiceToSteal = oldestReleased != nullptr ? oldestReleased : oldest; break;
+	case VoiceStealingPolicy::Oldest:			voiceToSteal = oldest; break;
+	case VoiceStealingPolicy::LowestAmplitude:	voiceToSteal = quietest; break;
+	default:									break;
+	}
 
-		if(v->isBeingKilled()) continue;
+	if (voiceToSteal != nullptr)
+		numStolenVoices[(int)policy].fetch_add(1);
 
-		const double voiceUptime = v->getVoiceUptime();
+	return voiceToSteal;
+}
 
-		if(voiceUptime < oldestUptime)
+static int getIndexOfLowestSetBit(uint64 value) noexcept
+{
+	jassert(value != 0);
+
+#if JUCE_MSVC
+	unsigned long index;
+
+	if (_BitScanForward(&index, (unsigned long)(value & 0xFFFFFFFF)))
+		return (int)index;
+
+	_BitScanForward(&index, (unsigned long)(value >> 32));
+	return (int)index + 32;
+#else
+	return __builtin_ctzll(value);
+#endif
+}
+
+SynthesiserVoice* ModulatorSynth::findFreeVoice(SynthesiserSound* soundToPlay, int /*midiChannel*/, int midiNoteNumber, bool stealIfNoneAvailable) const
+{
+	const ScopedLock sl(lock);
+
+	if (numVoicesInFreeVoiceMask != voices.size())
+		rebuildFreeVoiceMask();
+
+	// Every voice sets its bit in resetVoice(), so the lowest set bit is the lowest free voice
+	for (int w = 0; w < NumFreeVoiceMaskWords; w++)
+	{
+		uint64 bits = freeVoiceMask[w].load();
+
+		while (bits != 0)
 		{
-			oldestUptime = voiceUptime;
-			oldest = v;
+			const int bitIndex = getIndexOfLowestSetBit(bits);
+			const uint64 bit = (uint64)1 << bitIndex;
+			const int voiceIndex = w * 64 + bitIndex;
+
+			bits &= ~bit;
+
+			SynthesiserVoice* v = voices.getUnchecked(voiceIndex);
+
+			if (v->isVoiceActive())
+			{
+				freeVoiceMask[w].fetch_and(~bit);
+				continue;
+			}
+
+			if (v->canPlaySound(soundToPlay))
+			{
+				freeVoiceMask[w].fetch_and(~bit);
+				return v;
+			}
 		}
 	}
 
-	if(oldest != nullptr)
+	if (stealIfNoneAvailable)
+		return findVoiceToSteal(soundToPlay, 1, midiNoteNumber);
+
+	return nullptr;
+}
+
+SynthesiserVoice* ModulatorSynth::findVoiceToSteal(SynthesiserSound* soundToPlay, int midiChannel, int midiNoteNumber) const
+{
+	if (auto v = getVoiceToSteal(midiNoteNumber, false))
+		return v;
+
+	if (auto v = getVoiceToSteal(midiNoteNumber, true))
+		return v;
+
+	return Synthesiser::findVoiceToSteal(soundToPlay, midiChannel, midiNoteNumber);
+}
+
+void ModulatorSynth::rebuildFreeVoiceMask() const
+{
+	uint64 bits[NumFreeVoiceMaskWords] = {};
+
+	const int numVoices = jmin<int>(voices.size(), NUM_POLYPHONIC_VOICES);
+
+	for (int i = 0; i < numVoices; i++)
 	{
-		oldest->killVoice();
-		return;
+		if (!voices.getUnchecked(i)->isVoiceActive())
+			bits[i / 64] |= (uint64)1 << (i % 64);
 	}
-};
+
+	for (int w = 0; w < NumFreeVoiceMaskWords; w++)
+		freeVoiceMask[w].store(bits[w]);
+
+	numVoicesInFreeVoiceMask = voices.size();
+}
+
+void ModulatorSynth::setVoiceFree(ModulatorSynthVoice* v) noexcept
+{
+	const int voiceIndex = v->getVoiceIndex();
+
+	if (isPositiveAndBelow(voiceIndex, jmin<int>(numVoicesInFreeVoiceMask, NUM_POLYPHONIC_VOICES)))
+		freeVoiceMask[voiceIndex / 64].fetch_or((uint64)1 << (voiceIndex % 64));
+}
 
 void ModulatorSynth::deleteAllVoices()
 {
 	ScopedLock sl(lock);
 	activeVoices.clear();
 	clearVoices();
+	numVoicesInFreeVoiceMask = -1;
 }
 
 void ModulatorSynth::resetAllVoices()
@@ -1204,6 +1537,7 @@ void ModulatorSynth::resetAllVoices()
 	}
 
 	activeVoices.clear();
+	numVoicesInFreeVoiceMask = -1;
 }
 
 void ModulatorSynth::killAllVoices()
@@ -1256,6 +1590,20 @@ void ModulatorSynthVoice::renderNextBlock (AudioSampleBuffer& outputBuffer, int
 {
 	if (isActive)
     { 
+		if (startOffset > startSample)
+		{
+			const int numToSkip = jmin<int>(startOffset - startSample, numSamples);
+
+			startSample += numToSkip;
+			numSamples -= numToSkip;
+
+			// The voice starts in a later part of this block
+			if (numSamples == 0)
+				return;
+		}
+
+		startOffset = 0;
+
 		if(isPitchModulationActive()) calculateVoicePitchValues(startSample, numSamples);
 
 		calculateBlock(startSample, numSamples);
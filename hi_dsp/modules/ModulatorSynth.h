@@ -95,6 +95,16 @@ public:
 		numEditorStates
 	};
 
+	/** The strategies for picking the voice that is killed when a note on needs a voice and the voice limit is reached. */
+	enum class VoiceStealingPolicy
+	{
+		ReleasedFirst = 0,	///< the oldest voice in its release phase or the oldest voice if all notes are held (default)
+		Oldest,				///< the oldest voice
+		LowestAmplitude,	///< the voice with the lowest output of the gain modulation chain
+		SameNoteFirst,		///< the oldest voice with the same note number or the ReleasedFirst voice if there is none
+		numVoiceStealingPolicies
+	};
+
 	enum ClockSpeed
 	{
 		Inactive = 0xFFF,
@@ -228,17 +238,70 @@ public:
 	*/
 	void killAllVoicesWithNoteNumber(int noteNumber);
 
-	/** Kills the voice that is playing for the longest time. */
-	void killLastVoice();
+	/** Kills the voice that is selected by the voice stealing policy with the kill fade time.
+	*
+	*	The note number of the note on that needs the voice is used by the SameNoteFirst policy.
+	*/
+	void killLastVoice(int noteNumberToStart=-1);
+
+	/** Sets the strategy that picks the voice to kill if the voice limit is reached. */
+	void setVoiceStealingPolicy(VoiceStealingPolicy newPolicy) noexcept { voiceStealingPolicy = newPolicy; }
+
+	VoiceStealingPolicy getVoiceStealingPolicy() const noexcept { return voiceStealingPolicy; }
+
+	/** Returns the number of voices that were stolen by the given policy.
+	*
+	*	If the SameNoteFirst policy doesn't find a voice with the same note, the voice is counted for ReleasedFirst.
+	*/
+	int getNumStolenVoices(VoiceStealingPolicy policy) const noexcept { return numStolenVoices[(int)policy].load(); }
+
+	void resetVoiceStealingStatistics() noexcept;
 
 	
 
 	bool isSoftBypassed() const { return bypassState; };
 
+	/** Override this and return false if other synths depend on the output of this synth within the same block.
+	*
+	*	A ModulatorSynthChain that renders its children in parallel will render these synths on the audio thread before the others.
+	*/
+	virtual bool canBeRenderedInParallel() const { return true; }
+
+	/** Runs the MIDI processors of this synth before the rendering starts.
+	*
+	*	A ModulatorSynthChain that renders its children in parallel calls this for every child on the audio thread, so that the
+	*	script callbacks and the event ID handler are never used by the worker threads. The next renderNextBlockWithModulators()
+	*	call will then skip the event processing.
+	*/
+	virtual void preprocessHiseEventBuffer(const HiseEventBuffer& inputBuffer, int numSamples);
+
+	bool hasPreprocessedEvents() const noexcept { return eventsArePreprocessed; }
+
+	/** Returns the time in milliseconds that the last render callback of this synth took. This is measured by the parent ModulatorSynthChain. */
+	double getRenderTime() const noexcept { return renderTime.load(); }
+
+	void setRenderTime(double newRenderTimeMilliseconds) noexcept { renderTime.store(newRenderTimeMilliseconds); }
+
+	/** Renders the active voices of this synth in parallel on the worker threads of the RealtimeWorkerPool.
+	*
+	*	The voices are split into contiguous chunks that are rendered into separate buffers and summed in a fixed order,
+	*	so the result doesn't depend on the thread timing. The modulator and effect chains render one voice at a time, so
+	*	this only pays off if the voice rendering itself is expensive (eg. a sampler with lots of pitched voices).
+	*/
+	void setUseParallelVoiceRendering(bool shouldRenderVoicesInParallel);
+
+	bool isUsingParallelVoiceRendering() const noexcept { return useParallelVoiceRendering; }
+
+	/** Override this and return false if the voices of this synth share any state that is written during the rendering. */
+	virtual bool canRenderVoicesInParallel() const { return true; }
+
 	void deleteAllVoices();
     
 	virtual void resetAllVoices();
 
+	/** Marks the voice as free for findFreeVoice(). This is called by ModulatorSynthVoice::resetVoice(), so it can happen on any thread. */
+	void setVoiceFree(ModulatorSynthVoice* v) noexcept;
+
 	virtual void killAllVoices();
 
 	/** Call this from the message thread and it'll kill all voices at the next buffer. 
@@ -373,7 +436,18 @@ public:
 	{
 		gainChain->renderVoice(voiceIndex, startSample, numSamples);
 		float *gainData = gainChain->getVoiceValues(voiceIndex);
-		if (scriptGainValue != 1.0f) FloatVectorOperations::multiply(gainData + startSample, scriptGainValue, numSamples);
+		auto& info = gainChain->getVoiceBlockInfo(voiceIndex);
+
+		if (scriptGainValue != 1.0f)
+		{
+			if (info.isDynamic())
+				FloatVectorOperations::multiply(gainData + startSample, scriptGainValue, numSamples);
+			else
+				info.multiply(scriptGainValue);
+		}
+
+		// Used by the LowestAmplitude voice stealing policy
+		lastVoiceGainValues[voiceIndex] = info.isDynamic() ? gainData[startSample + numSamples - 1] : info.endValue;
 
 		return gainData;
 	};
@@ -383,9 +457,20 @@ public:
 	{
         pitchChain->renderVoice(voiceIndex, startSample, numSamples);
 		float *voicePitchValues = pitchChain->getVoiceValues(voiceIndex);
-		const float *timeVariantPitchValues = getConstantPitchValues();
-		FloatVectorOperations::multiply(voicePitchValues, timeVariantPitchValues, startSample + numSamples);
-		if (scriptPitchValue != 1.0f) FloatVectorOperations::multiply(voicePitchValues, scriptPitchValue, startSample + numSamples);
+		auto& info = pitchChain->getVoiceBlockInfo(voiceIndex);
+
+		if (!pitchChain->getTimeVariantBlockInfo().isUnity())
+		{
+			const float *timeVariantPitchValues = getConstantPitchValues();
+			FloatVectorOperations::multiply(voicePitchValues, timeVariantPitchValues, startSample + numSamples);
+			info.type = ModulationBlockInfo::Dynamic;
+		}
+
+		if (scriptPitchValue != 1.0f)
+		{
+			FloatVectorOperations::multiply(voicePitchValues, scriptPitchValue, startSample + numSamples);
+			info.multiply(scriptPitchValue);
+		}
 	}
 
 	/** Returns a read pointer to the calculated pitch values. */
@@ -396,6 +481,12 @@ public:
 
 	ModulatorSynthVoice* getFreeVoice(SynthesiserSound* s, int midiChannel, int midiNoteNumber);
 
+	/** Returns the inactive voice with the lowest index from a bit mask of free voices (instead of checking every voice). */
+	SynthesiserVoice* findFreeVoice(SynthesiserSound* soundToPlay, int midiChannel, int midiNoteNumber, bool stealIfNoneAvailable) const override;
+
+	/** Returns the voice that is selected by the voice stealing policy. */
+	SynthesiserVoice* findVoiceToSteal(SynthesiserSound* soundToPlay, int midiChannel, int midiNoteNumber) const override;
+
 	HiseEventBuffer eventBuffer;
 	AudioSampleBuffer internalBuffer;
 
@@ -434,7 +525,12 @@ protected:
 	// Used to display the playing position
 	ModulatorSynthVoice *lastStartedVoice;
 
-	
+	/** Resizes the buffers for the parallel voice rendering. Override this if your voices need other thread local buffers (and call the base class method). */
+	virtual void refreshParallelVoiceBuffer();
+
+	// set by preprocessHiseEventBuffer() and cleared by the next render callback
+	bool eventsArePreprocessed = false;
+
 
 private:
 
@@ -474,6 +570,54 @@ private:
 
 	std::atomic<float> vuValue;
 
+	std::atomic<double> renderTime { 0.0 };
+
+	/** Returns true if the event must be handled at its exact position (the rendering is split at this sample). */
+	bool needsRenderSplit(const HiseEvent& e) const;
+
+	/** Checks if a modulation chain of the voices has an envelope that reacts to controller events. */
+	bool hasControllerEnvelopes() const;
+
+	// The position of the note on that is currently handled (the started voices skip the samples before this position)
+	int voiceStartOffset = 0;
+
+	static void renderVoiceTask(void* synth, int taskIndex);
+
+	/** Renders the active voices on multiple threads. Returns false if the voices need to be rendered serially. */
+	bool renderVoicesInParallel(int startSample, int numThisTime);
+
+	bool useParallelVoiceRendering = false;
+	AudioSampleBuffer parallelVoiceBuffer;
+	int numParallelVoiceTasks = 0;
+	int parallelStartSample = 0;
+	int parallelNumSamples = 0;
+
+	/** Lets the envelopes of the gain and pitch chain calculate the blocks of all active voices at once. */
+	void calculateVoiceBlocks(int startSample, int numThisTime);
+
+	int gainBlockVoices[NUM_POLYPHONIC_VOICES];
+	int pitchBlockVoices[NUM_POLYPHONIC_VOICES];
+
+	/** Returns the voice that the current voice stealing policy would kill or nullptr. This only checks the active voices. */
+	ModulatorSynthVoice* getVoiceToSteal(int noteNumberToStart, bool includeKilledVoices) const;
+
+	/** Sets the bits of all inactive voices in the free voice mask. */
+	void rebuildFreeVoiceMask() const;
+
+	enum
+	{
+		NumFreeVoiceMaskWords = (NUM_POLYPHONIC_VOICES + 63) / 64
+	};
+
+	// A set bit means the voice with this index is inactive (it's cleared when the voice is handed out)
+	mutable std::atomic<uint64> freeVoiceMask[NumFreeVoiceMaskWords];
+	mutable int numVoicesInFreeVoiceMask = -1;
+
+	float lastVoiceGainValues[NUM_POLYPHONIC_VOICES];
+
+	VoiceStealingPolicy voiceStealingPolicy = VoiceStealingPolicy::ReleasedFirst;
+	mutable std::atomic<int> numStolenVoices[(int)VoiceStealingPolicy::numVoiceStealingPolicies];
+
 	std::atomic<float> killFadeTime;
 	
 	
@@ -532,6 +676,8 @@ public:
 
 		if (pitchFader.isSmoothing())
 		{
+			getOwnerSynth()->pitchChain->getVoiceBlockInfo(voiceIndex).type = ModulationBlockInfo::Dynamic;
+
 			float* pitchValues = getVoicePitchValues() + startSample;
 
 			float eventPitchFactorFloat = (float)eventPitchFactor;
@@ -547,6 +693,7 @@ public:
 			float* pitchValues = getVoicePitchValues() + startSample;
 
 			FloatVectorOperations::multiply(pitchValues, (float)eventPitchFactor, numSamples);
+			getOwnerSynth()->pitchChain->getVoiceBlockInfo(voiceIndex).multiply((float)eventPitchFactor);
 		}
 	}
 
@@ -562,6 +709,24 @@ public:
 		return getOwnerSynth()->calculateGainValuesForVoice(voiceIndex, scriptGainValue, startSample, numSamples);
 	}
 
+	/** Multiplies the data with the values from getVoiceGainValues().
+	*
+	*	If the gain modulation of this block is constant or a ramp, it uses a scalar gain (and skips unity gain completely).
+	*/
+	void applyVoiceGainValues(float* data, const float* gainValues, int startSample, int numSamples) const noexcept
+	{
+		getOwnerSynth()->gainChain->getVoiceBlockInfo(voiceIndex).applyTo(data, gainValues + startSample, numSamples);
+	}
+
+	/** Returns the pitch values like getVoicePitchValues(), but returns nullptr if the pitch modulation of this block is unity. */
+	float *getModulatedVoicePitchValues()
+	{
+		if (!isPitchModulationActive() || getOwnerSynth()->pitchChain->getVoiceBlockInfo(voiceIndex).isUnity())
+			return nullptr;
+
+		return getVoicePitchValues();
+	}
+
 	/** This only checks if the sound is valid, but you can override this with the desired behaviour. */
 	virtual bool canPlaySound(SynthesiserSound *s) override
 	{
@@ -716,6 +881,11 @@ public:
 
 	void setStartUptime(double newUptime) noexcept { startUptime = newUptime; }
 
+	/** Sets the position in the current block where the voice starts. The voice will skip the samples before this position. */
+	void setStartOffset(int newStartOffset) noexcept { startOffset = newStartOffset; }
+
+	int getStartOffset() const noexcept { return startOffset; }
+
 	void enablePitchModulation(bool shouldBeEnabled) noexcept{ pitchModulationActive = shouldBeEnabled; }
 
 	bool isPitchModulationActive() const noexcept{ return pitchModulationActive || scriptPitchActive; }
@@ -819,7 +989,7 @@ private:
 	
 	double startUptime;
 
-	
+	int startOffset = 0;
 
 	ModulatorSynth* const ownerSynth;
 
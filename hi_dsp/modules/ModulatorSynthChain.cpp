@@ -121,6 +121,8 @@ void ModulatorSynthChain::prepareToPlay(double newSampleRate, int samplesPerBloc
 	ModulatorSynth::prepareToPlay(newSampleRate, samplesPerBlock);
 
 	for (int i = 0; i < synths.size(); i++) synths[i]->prepareToPlay(newSampleRate, samplesPerBlock);
+
+	refreshParallelRenderBuffer();
 }
 
 void ModulatorSynthChain::numSourceChannelsChanged()
@@ -139,7 +141,7 @@ void ModulatorSynthChain::numSourceChannelsChanged()
 
 	ModulatorSynth::numSourceChannelsChanged();
 
-	
+	refreshParallelRenderBuffer();
 }
 
 void ModulatorSynthChain::numDestinationChannelsChanged()
@@ -197,6 +199,7 @@ void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffe
 	if (isSoftBypassed()) return;
 
 	ADD_GLITCH_DETECTOR(this, DebugLogger::Location::SynthChainRendering);
+	ADD_CPU_PROFILER_SCOPE(this, DebugLogger::Location::SynthChainRendering);
 
 	ScopedLock sl(getSynthLock());
 
@@ -240,13 +243,27 @@ void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffe
 
 #else
 
-	processHiseEventBuffer(inputMidiBuffer, numSamples);
+	if (eventsArePreprocessed)
+		eventsArePreprocessed = false;
+	else
+		processHiseEventBuffer(inputMidiBuffer, numSamples);
 
 	// Shrink the internal buffer to the output buffer size 
 	internalBuffer.setSize(getMatrix().getNumSourceChannels(), numSamples, true, false, true);
 
 	// Process the Synths and add store their output in the internal buffer
-	for (int i = 0; i < synths.size(); i++) if (!synths[i]->isSoftBypassed()) synths[i]->renderNextBlockWithModulators(internalBuffer, eventBuffer);
+	if (!renderChildSynthsInParallel(numSamples))
+	{
+		for (int i = 0; i < synths.size(); i++)
+		{
+			if (!synths[i]->isSoftBypassed())
+			{
+				const double start = Time::getMillisecondCounterHiRes();
+				synths[i]->renderNextBlockWithModulators(internalBuffer, eventBuffer);
+				synths[i]->setRenderTime(Time::getMillisecondCounterHiRes() - start);
+			}
+		}
+	}
 
 	HiseEventBuffer::Iterator eventIterator(eventBuffer);
 
@@ -515,6 +532,126 @@ SynthGroupConstrainer::SynthGroupConstrainer()
 	forbiddenModulators.addArray(typeNames);
 }
 
+void ModulatorSynthChain::setUseParallelRendering(bool shouldRenderInParallel)
+{
+	auto& pool = getMainController()->getRealtimeWorkerPool();
+
+	MainController::ScopedSuspender ss(getMainController(), MainController::ScopedSuspender::LockType::Lock);
+
+	if (shouldRenderInParallel && pool.getNumWorkers() == 0)
+		pool.setNumWorkers(RealtimeWorkerPool::getDefaultNumWorkers());
+
+	useParallelRendering = shouldRenderInParallel;
+	refreshParallelRenderBuffer();
+}
+
+void ModulatorSynthChain::preprocessHiseEventBuffer(const HiseEventBuffer& inputBuffer, int numSamples)
+{
+	ModulatorSynth::preprocessHiseEventBuffer(inputBuffer, numSamples);
+
+	// A nested chain might be rendered on a worker thread, so its children need to be processed here too
+	for (auto s : synths)
+	{
+		if (!s->isSoftBypassed())
+			s->preprocessHiseEventBuffer(eventBuffer, numSamples);
+	}
+}
+
+var ModulatorSynthChain::getChildRenderTimes() const
+{
+	DynamicObject::Ptr data = new DynamicObject();
+
+	for (auto s : synths)
+		data->setProperty(s->getIDAsIdentifier(), s->getRenderTime());
+
+	return var(data);
+}
+
+void ModulatorSynthChain::refreshParallelRenderBuffer()
+{
+	if (useParallelRendering)
+	{
+		const int numChannels = getMatrix().getNumSourceChannels();
+
+		parallelRenderBuffer.setSize(numChannels * jmax<int>(1, synths.size()), jmax<int>(0, getBlockSize()));
+		activeChildIndexes.ensureStorageAllocated(synths.size());
+		parallelChildIndexes.ensureStorageAllocated(synths.size());
+	}
+	else
+	{
+		parallelRenderBuffer.setSize(0, 0);
+	}
+}
+
+void ModulatorSynthChain::renderChildSynthTask(void* chain, int taskIndex)
+{
+	auto c = static_cast<ModulatorSynthChain*>(chain);
+	c->renderChildSynth(c->parallelChildIndexes.getUnchecked(taskIndex));
+}
+
+void ModulatorSynthChain::renderChildSynth(int childIndex)
+{
+	auto s = synths.getUnchecked(childIndex);
+
+	const int numChannels = internalBuffer.getNumChannels();
+
+	AudioSampleBuffer childBuffer(parallelRenderBuffer.getArrayOfWritePointers() + childIndex * numChannels, numChannels, numSamplesToRender);
+	childBuffer.clear();
+
+	const double start = Time::getMillisecondCounterHiRes();
+	s->renderNextBlockWithModulators(childBuffer, eventBuffer);
+	s->setRenderTime(Time::getMillisecondCounterHiRes() - start);
+}
+
+bool ModulatorSynthChain::renderChildSynthsInParallel(int numSamples)
+{
+	auto& pool = getMainController()->getRealtimeWorkerPool();
+
+	const int numChannels = internalBuffer.getNumChannels();
+
+	if (!useParallelRendering || pool.getNumWorkers() == 0 || synths.size() < 2)
+		return false;
+
+	// The buffers are not prepared yet (this will be fixed at the next prepareToPlay())
+	if (parallelRenderBuffer.getNumChannels() < numChannels * synths.size() || parallelRenderBuffer.getNumSamples() < numSamples)
+		return false;
+
+	numSamplesToRender = numSamples;
+	activeChildIndexes.clearQuick();
+	parallelChildIndexes.clearQuick();
+
+	// The MIDI processors (and the script callbacks) of all children run here on the audio thread
+	for (auto s : synths)
+	{
+		if (!s->isSoftBypassed() && !s->hasPreprocessedEvents())
+			s->preprocessHiseEventBuffer(eventBuffer, numSamples);
+	}
+
+	for (int i = 0; i < synths.size(); i++)
+	{
+		if (synths[i]->isSoftBypassed())
+			continue;
+
+		activeChildIndexes.add(i);
+
+		if (synths[i]->canBeRenderedInParallel())
+			parallelChildIndexes.add(i);
+		else
+			renderChildSynth(i);
+	}
+
+	pool.runParallel(renderChildSynthTask, this, parallelChildIndexes.size());
+
+	// Sum the buffers in a fixed order so that the result doesn't depend on the thread timing
+	for (auto i : activeChildIndexes)
+	{
+		for (int c = 0; c < numChannels; c++)
+			FloatVectorOperations::add(internalBuffer.getWritePointer(c, 0), parallelRenderBuffer.getReadPointer(i * numChannels + c, 0), numSamples);
+	}
+
+	return true;
+}
+
 void ModulatorSynthChain::ModulatorSynthChainHandler::add(Processor *newProcessor, Processor *siblingToInsertBefore)
 {
 	ModulatorSynth *ms = dynamic_cast<ModulatorSynth*>(newProcessor);
@@ -529,9 +666,10 @@ void ModulatorSynthChain::ModulatorSynthChainHandler::add(Processor *newProcesso
 	ms->prepareToPlay(synth->getSampleRate(), synth->getBlockSize());
 
 	{
-		MainController::ScopedSuspender ss(synth->getMainController());
+		ScopedLock sl(synth->getMainController()->getLock());
 		ms->setIsOnAir(true);
 		synth->synths.insert(index, ms);
+		synth->refreshParallelRenderBuffer();
 	}
 
 	sendChangeMessage();
@@ -542,7 +680,18 @@ void ModulatorSynthChain::ModulatorSynthChainHandler::remove(Processor *processo
 	{
 		auto& tmp = synth;
 
-		auto f = [tmp, removeSynth](Processor* p) { tmp->synths.removeObject(dynamic_cast<ModulatorSynth*>(p), removeSynth); return true; };
+		auto f = [tmp, removeSynth](Processor* p)
+		{
+			// The synth is deleted after the lock is released so the audio thread doesn't wait for the destructor
+			ScopedPointer<Processor> pendingDelete = removeSynth ? p : nullptr;
+
+			{
+				ScopedLock sl(tmp->getMainController()->getLock());
+				tmp->synths.removeObject(dynamic_cast<ModulatorSynth*>(p), false);
+			}
+
+			return true;
+		};
 
 		synth->getMainController()->getKillStateHandler().killVoicesAndCall(processorToBeRemoved, f, MainController::KillStateHandler::TargetThread::MessageThread);
 		
@@ -568,9 +717,14 @@ int ModulatorSynthChain::ModulatorSynthChainHandler::getNumProcessors() const
 
 void ModulatorSynthChain::ModulatorSynthChainHandler::clear()
 {
-	ScopedLock sl(synth->getMainController()->getLock());
+	OwnedArray<ModulatorSynth> pendingDelete;
+
+	{
+		ScopedLock sl(synth->getMainController()->getLock());
+		pendingDelete.swapWith(synth->synths);
+	}
 
-	synth->synths.clear();
+	pendingDelete.clear();
 
 	sendChangeMessage();
 }
@@ -185,6 +185,23 @@ public:
 
 	bool areVoicesActive() const override;
 
+	/** Renders the child synths in parallel on the worker threads of the RealtimeWorkerPool.
+	*
+	*	Every child renders into its own buffer and the buffers are summed in a fixed order, so the output is the same
+	*	as with the serial rendering. Synths that return false in canBeRenderedInParallel() are rendered first on the audio thread.
+	*	The MIDI processors of all children are processed on the audio thread before the rendering starts, but the voice
+	*	rendering must not share any state with other synths (eg. script modulators that write global variables).
+	*/
+	void setUseParallelRendering(bool shouldRenderInParallel);
+
+	bool isUsingParallelRendering() const noexcept { return useParallelRendering; }
+
+	/** Returns the render time of the last block in milliseconds for every child synth as JSON object (with the IDs as keys). */
+	var getChildRenderTimes() const;
+
+	/** Processes the events of this chain and all child synths. */
+	void preprocessHiseEventBuffer(const HiseEventBuffer& inputBuffer, int numSamples) override;
+
 	/** Handles the ModulatorSynthChain. */
 	class ModulatorSynthChainHandler: public Chain::Handler
 	{
@@ -231,6 +248,21 @@ public:
 
 private:
 
+	static void renderChildSynthTask(void* chain, int taskIndex);
+
+	/** Renders the child synth into its own part of the parallelRenderBuffer. */
+	void renderChildSynth(int childIndex);
+
+	bool renderChildSynthsInParallel(int numSamples);
+
+	void refreshParallelRenderBuffer();
+
+	bool useParallelRendering = HISE_USE_PARALLEL_SYNTH_RENDERING;
+	AudioSampleBuffer parallelRenderBuffer;
+	Array<int> activeChildIndexes;
+	Array<int> parallelChildIndexes;
+	int numSamplesToRender = 0;
+
 	HiseEvent::ChannelFilterData activeChannels;
 	ModulatorSynthChainHandler handler;
 	int numVoices;
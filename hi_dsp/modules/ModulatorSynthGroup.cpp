@@ -191,8 +191,8 @@ void ModulatorSynthGroupVoice::calculateBlock(int startSample, int numSamples)
 
 	const float *modValues = getVoiceGainValues(startSample, numSamples);
 
-	FloatVectorOperations::multiply(voiceBuffer.getWritePointer(0, startSample), modValues + startSample, numSamples);
-	FloatVectorOperations::multiply(voiceBuffer.getWritePointer(1, startSample), modValues + startSample, numSamples);
+	applyVoiceGainValues(voiceBuffer.getWritePointer(0, startSample), modValues, startSample, numSamples);
+	applyVoiceGainValues(voiceBuffer.getWritePointer(1, startSample), modValues, startSample, numSamples);
 };
 
 
@@ -1226,7 +1226,7 @@ void ModulatorSynthGroup::ModulatorSynthGroupHandler::add(Processor *newProcesso
 
 
 	{
-		MainController::ScopedSuspender ss(group->getMainController());
+		MainController::ScopedSuspender ss(group->getMainController(), MainController::ScopedSuspender::LockType::Lock);
 
 		m->setIsOnAir(true);
 
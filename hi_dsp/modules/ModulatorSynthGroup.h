@@ -305,6 +305,9 @@ public:
 	const ModulatorSynth* getFMModulator() const;
 	const ModulatorSynth* getFMCarrier() const;
 
+	/** The group voices render the voices of the child synths into shared buffers. */
+	bool canRenderVoicesInParallel() const override { return false; }
+
 	/** returns the total amount of child groups (internal chains + all child synths) */
 	Processor *getChildProcessor(int processorIndex) override;;
 
@@ -28,4 +28,197 @@
 *   http://www.juce.com
 *
 *   ===========================================================================
-*/
\ No newline at end of file
+*/
+#ifndef MODULATORUNITTEST_H_INCLUDED
+#define MODULATORUNITTEST_H_INCLUDED
+
+#if HI_RUN_UNIT_TESTS && HI_RUN_BENCHMARKS
+
+namespace hise { using namespace juce;
+
+/** Benchmarks the voice rendering with 1 to N threads (see ModulatorSynth::setUseParallelVoiceRendering()).
+*
+*	This uses a synthetic voice that does the same kind of work as a sampler voice (resampling with a lowpass filter and
+*	a gain modulation), so it doesn't need a MainController. Every voice calculates its modulation into its own channel
+*	like ModulatorChain::renderVoice(). The test that compares the parallel output of a real sampler with the serial
+*	rendering is in BackendUnitTests.cpp.
+*/
+class VoiceRenderingBenchmark : public UnitTest
+{
+public:
+
+	VoiceRenderingBenchmark() :
+		UnitTest("Benchmarking parallel voice rendering")
+	{}
+
+	void runTest() override
+	{
+		beginTest("Benchmarking parallel voice rendering");
+
+		// one thread per core (more threads would just fight for the CPU)
+		const int maxNumThreads = RealtimeWorkerPool::getDefaultNumWorkers() + 1;
+		const int numIterations = 200;
+
+		// The time for one block at 44.1kHz
+		const double blockDuration = (double)BlockSize / 44100.0;
+
+		RealtimeWorkerPool pool;
+		double singleThreadTime = 0.0;
+
+		for (int numThreads = 1; numThreads <= maxNumThreads; numThreads++)
+		{
+			pool.setNumWorkers(numThreads - 1);
+
+			Random r(42);
+			RenderContext c(r, NumVoices);
+
+			// warm up the caches and wake up the workers
+			for (int i = 0; i < 20; i++)
+				render(pool, c, numThreads);
+
+			const int64 start = Time::getHighResolutionTicks();
+
+			for (int i = 0; i < numIterations; i++)
+				render(pool, c, numThreads);
+
+			const double time = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start) / (double)numIterations;
+
+			if (numThreads == 1)
+				singleThreadTime = time;
+
+			String message;
+
+			message << String(NumVoices) << " voices, " << String(numThreads) << (numThreads == 1 ? " thread: " : " threads: ");
+			message << String(time * 1000.0, 3) << " ms per block, ";
+			message << String(roundToInt(100.0 * time / blockDuration)) << "% of the block duration ";
+			message << "(x" << String(singleThreadTime / time, 2) << ")";
+
+			logMessage(message);
+		}
+	}
+
+private:
+
+	enum
+	{
+		BlockSize = 512,
+		SampleLength = 44100,
+		NumVoices = 64
+	};
+
+	struct TestVoice
+	{
+		double uptime = 0.0;
+		double uptimeDelta = 1.0;
+		float coefficient = 0.5f;
+		float gain = 1.0f;
+		float lastLeft = 0.0f;
+		float lastRight = 0.0f;
+	};
+
+	/** The voices and buffers that are shared between the tasks. */
+	struct RenderContext
+	{
+		RenderContext(Random& r, int numVoices) :
+			sample(2, SampleLength),
+			voiceGainValues(numVoices, BlockSize),
+			taskBuffer(2 * (HISE_MAX_REALTIME_WORKERS + 1), BlockSize),
+			output(2, BlockSize)
+		{
+			for (int c = 0; c < 2; c++)
+			{
+				for (int i = 0; i < SampleLength; i++)
+					sample.setSample(c, i, r.nextFloat() * 2.0f - 1.0f);
+			}
+
+			voices.resize(numVoices);
+
+			for (auto& v : voices)
+			{
+				v.uptimeDelta = 0.5 + r.nextDouble() * 2.0;
+				v.coefficient = 0.1f + 0.8f * r.nextFloat();
+				v.gain = r.nextFloat();
+			}
+		}
+
+		AudioSampleBuffer sample;
+		AudioSampleBuffer voiceGainValues;
+		AudioSampleBuffer taskBuffer;
+		AudioSampleBuffer output;
+
+		std::vector<TestVoice> voices;
+		int numTasks = 1;
+	};
+
+	static void renderVoice(RenderContext& c, int voiceIndex, AudioSampleBuffer& b)
+	{
+		auto& v = c.voices[voiceIndex];
+
+		float* gainValues = c.voiceGainValues.getWritePointer(voiceIndex);
+
+		for (int i = 0; i < BlockSize; i++)
+			gainValues[i] = v.gain * (1.0f - 0.5f * (float)i / (float)BlockSize);
+
+		const float* inL = c.sample.getReadPointer(0);
+		const float* inR = c.sample.getReadPointer(1);
+
+		float* outL = b.getWritePointer(0);
+		float* outR = b.getWritePointer(1);
+
+		for (int i = 0; i < BlockSize; i++)
+		{
+			const int index = (int)v.uptime % (SampleLength - 1);
+			const float alpha = (float)(v.uptime - (double)(int)v.uptime);
+
+			const float l = inL[index] + alpha * (inL[index + 1] - inL[index]);
+			const float r = inR[index] + alpha * (inR[index + 1] - inR[index]);
+
+			v.lastLeft += v.coefficient * (l - v.lastLeft);
+			v.lastRight += v.coefficient * (r - v.lastRight);
+
+			outL[i] += v.lastLeft * gainValues[i];
+			outR[i] += v.lastRight * gainValues[i];
+
+			v.uptime += v.uptimeDelta;
+		}
+	}
+
+	/** Renders a contiguous chunk of voices like ModulatorSynth::renderVoiceTask(). */
+	static void renderTask(void* context, int taskIndex)
+	{
+		auto& c = *static_cast<RenderContext*>(context);
+
+		const int numVoices = (int)c.voices.size();
+		const int firstVoice = numVoices * taskIndex / c.numTasks;
+		const int lastVoice = numVoices * (taskIndex + 1) / c.numTasks;
+
+		AudioSampleBuffer b(c.taskBuffer.getArrayOfWritePointers() + 2 * taskIndex, 2, BlockSize);
+		b.clear();
+
+		for (int i = firstVoice; i < lastVoice; i++)
+			renderVoice(c, i, b);
+	}
+
+	static void render(RealtimeWorkerPool& pool, RenderContext& c, int numThreads)
+	{
+		c.numTasks = numThreads;
+
+		pool.runParallel(renderTask, &c, numThreads);
+
+		c.output.clear();
+
+		for (int t = 0; t < numThreads; t++)
+		{
+			for (int channel = 0; channel < 2; channel++)
+				c.output.addFrom(channel, 0, c.taskBuffer, 2 * t + channel, 0, BlockSize);
+		}
+	}
+};
+
+static VoiceRenderingBenchmark voiceRenderingBenchmark;
+
+} // namespace hise
+
+#endif
+
+#endif  // MODULATORUNITTEST_H_INCLUDED
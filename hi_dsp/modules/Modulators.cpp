@@ -147,6 +147,9 @@ bool Modulator::isPlotted() const
 
 void Modulator::addValueToPlotter(float v) const
 {
+	if (RealtimeWorkerPool::getCurrentThreadIndex() != 0)
+		return;
+
 	if(attachedPlotter.getComponent() != nullptr) 
 	{
 		attachedPlotter.getComponent()->addValue(this, v);
@@ -161,9 +164,18 @@ void TimeModulation::renderNextBlock(AudioSampleBuffer &buffer, int startSample,
 
 	calculateBlock(startSample, numSamples);
 
-	if (shouldUpdatePlotter()) updatePlotter(internalBuffer, startIndex, samplesToCopy);
+	const int c = getWorkingChannel();
+
+	// The plotter is not thread safe, so only the audio thread sends its values
+	if (RealtimeWorkerPool::getCurrentThreadIndex() == 0 && shouldUpdatePlotter())
+	{
+		float* workingChannel = internalBuffer.getWritePointer(c, 0);
+		updatePlotter(AudioSampleBuffer(&workingChannel, 1, internalBuffer.getNumSamples()), startIndex, samplesToCopy);
+	}
 
-	lastConstantValue = internalBuffer.getSample(0, 0);
+	// Only the audio thread writes this value
+	if (c == 0)
+		lastConstantValue = internalBuffer.getSample(0, 0);
 
 	applyTimeModulation(buffer, startIndex, samplesToCopy);
 }
@@ -171,7 +183,7 @@ void TimeModulation::renderNextBlock(AudioSampleBuffer &buffer, int startSample,
 void TimeModulation::applyTimeModulation(AudioSampleBuffer &buffer, int startIndex, int samplesToCopy)
 {
 	float *dest = buffer.getWritePointer(0, startIndex);
-	float *mod = internalBuffer.getWritePointer(0, startIndex);
+	float *mod = internalBuffer.getWritePointer(getWorkingChannel(), startIndex);
 
 	switch (modulationMode)
 	{
@@ -300,6 +312,45 @@ EnvelopeModulator::EnvelopeModulator(MainController *mc, const String &id, int v
 
 #pragma warning( pop )
 
+void EnvelopeModulator::setUseParallelRendering(bool shouldRenderInParallel)
+{
+	// One working channel for every thread that can render the voices (see getWorkingChannel())
+	const int numChannels = shouldRenderInParallel ? HISE_MAX_REALTIME_WORKERS + 1 : 1;
+
+	if (internalBuffer.getNumChannels() != numChannels)
+		internalBuffer.setSize(numChannels, internalBuffer.getNumSamples());
+}
+
+void EnvelopeModulator::renderVoiceBlocks(const int* voiceIndexes, int numVoices, int startSample, int numSamples)
+{
+	// Not prepared yet
+	if (calculatedVoiceBlocks == nullptr || voiceBlockBuffer.getNumSamples() < startSample + numSamples)
+		return;
+
+	// Invalidates the blocks of the last call that weren't used
+	++voiceBlockCounter;
+
+	voiceBlockStart = startSample;
+	voiceBlockLength = numSamples;
+
+	calculateVoiceBlocks(voiceIndexes, numVoices, startSample, numSamples);
+}
+
+bool EnvelopeModulator::consumeVoiceBlock(int voiceIndex, int startSample, int numSamples)
+{
+	if (voiceIndex < 0 || !hasCalculatedVoiceBlock(voiceIndex))
+		return false;
+
+	calculatedVoiceBlocks[voiceIndex] = 0;
+
+	// The voice must render the same range that was calculated or the state is advanced twice
+	jassert(startSample == voiceBlockStart && numSamples == voiceBlockLength);
+
+	FloatVectorOperations::copy(internalBuffer.getWritePointer(getWorkingChannel(), startSample), voiceBlockBuffer.getReadPointer(voiceIndex, startSample), numSamples);
+
+	return true;
+}
+
 Processor *VoiceStartModulatorFactoryType::createProcessor(int typeIndex, const String &id)
 {
 	MainController *m = getOwnerProcessor()->getMainController();
@@ -360,10 +411,12 @@ void VoiceModulation::allNotesOff()
 
 void VoiceModulation::PolyphonyManager::setCurrentVoice(int newCurrentVoice) noexcept
 {
-	jassert(currentVoice == -1);
-	jassert(currentVoice < voiceAmount);
+	auto& v = currentVoice[RealtimeWorkerPool::getCurrentThreadIndex()];
+
+	jassert(v == -1);
+	jassert(newCurrentVoice < voiceAmount);
 
-	currentVoice = newCurrentVoice;
+	v = newCurrentVoice;
 }
 
 void VoiceModulation::PolyphonyManager::setLastStartedVoice(int voiceIndex)
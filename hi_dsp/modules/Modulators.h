@@ -273,6 +273,111 @@ private:
 	
 };
 
+/** Describes the shape of a block of modulation values.
+*
+*	@ingroup modulator
+*
+*	The ModulatorChain calculates this for every voice block, so the consumers can apply a constant or a linear ramp
+*	as scalar gain (or skip it completely if it's unity) instead of multiplying with the modulation buffer.
+*	A ramp goes from startValue at the first sample to endValue after the last sample.
+*/
+struct ModulationBlockInfo
+{
+	enum Type
+	{
+		Dynamic = 0, ///< the values must be read from the buffer
+		Ramp,		 ///< the values are a linear ramp from startValue to endValue
+		Constant,	 ///< all values are startValue
+		numTypes
+	};
+
+	static ModulationBlockInfo createConstant(float value) noexcept
+	{
+		ModulationBlockInfo info;
+		info.type = Constant;
+		info.startValue = value;
+		info.endValue = value;
+		return info;
+	}
+
+	/** Creates a ramp (or a constant if the values are almost equal). */
+	static ModulationBlockInfo createRamp(float startValue, float endValue) noexcept
+	{
+		if (std::abs(endValue - startValue) <= 0.001f)
+			return createConstant(endValue);
+
+		ModulationBlockInfo info;
+		info.type = Ramp;
+		info.startValue = startValue;
+		info.endValue = endValue;
+		return info;
+	}
+
+	bool isDynamic() const noexcept { return type == Dynamic; }
+	bool isConstant() const noexcept { return type == Constant; }
+	bool isUnity() const noexcept { return type == Constant && startValue == 1.0f; }
+
+	/** Scales the constant or ramp values. */
+	void multiply(float factor) noexcept
+	{
+		startValue *= factor;
+		endValue *= factor;
+	}
+
+	/** Writes the values into the buffer. This must not be called for dynamic blocks. */
+	void fill(float* data, int numSamples) const noexcept
+	{
+		jassert(!isDynamic());
+
+		if (type == Constant)
+		{
+			FloatVectorOperations::fill(data, startValue, numSamples);
+			return;
+		}
+
+		const float stepSize = (endValue - startValue) / (float)jmax<int>(1, numSamples);
+		float value = startValue;
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			data[i] = value;
+			value += stepSize;
+		}
+	}
+
+	/** Multiplies the data with the modulation values. Dynamic blocks use the given buffer, the others a scalar gain. */
+	void applyTo(float* data, const float* modulationValues, int numSamples) const noexcept
+	{
+		switch (type)
+		{
+		case Constant:
+			if (startValue != 1.0f)
+				FloatVectorOperations::multiply(data, startValue, numSamples);
+			break;
+		case Ramp:
+		{
+			const float stepSize = (endValue - startValue) / (float)jmax<int>(1, numSamples);
+			float value = startValue;
+
+			for (int i = 0; i < numSamples; i++)
+			{
+				data[i] *= value;
+				value += stepSize;
+			}
+
+			break;
+		}
+		default:
+			FloatVectorOperations::multiply(data, modulationValues, numSamples);
+			break;
+		}
+	}
+
+	Type type = Dynamic;
+	float startValue = 1.0f;
+	float endValue = 1.0f;
+};
+
 /** If a modulator subclasses this, you can calculate varying modulation values over a time. 
 *
 *	@ingroup modulator
@@ -314,6 +419,20 @@ public:
 		return lastConstantValue;
 	}
 
+	/** Returns the value that applyTimeModulation() would multiply a buffer with for the given (constant) modulation value. */
+	float getModulationFactor(float calculatedValue) const noexcept
+	{
+		float destination = 1.0f;
+
+		switch (modulationMode)
+		{
+		case GainMode: applyGainModulation(&calculatedValue, &destination, getIntensity(), 1); break;
+		case PitchMode: applyPitchModulation(&calculatedValue, &destination, getIntensity(), 1); break;
+		}
+
+		return destination;
+	}
+
 protected:
 
 	TimeModulation(Modulation::Mode m):
@@ -363,6 +482,16 @@ protected:
 	// Prepares the buffer for the processing. The buffer is cleared and filled with 1.0.
 	static void initializeBuffer(AudioSampleBuffer &bufferToBeInitialized, int startSample, int numSamples);;
 
+	/** Returns the channel of the internal buffer that calculateBlock() should write to.
+	*
+	*	The envelopes have a channel for every render thread, so the voices can be calculated in parallel.
+	*	All other modulators only have one channel.
+	*/
+	int getWorkingChannel() const noexcept
+	{
+		return jmin<int>(RealtimeWorkerPool::getCurrentThreadIndex(), internalBuffer.getNumChannels() - 1);
+	}
+
 	AudioSampleBuffer internalBuffer;
 
 private:
@@ -398,9 +527,11 @@ public:
 		// You should never create one of these directly...
 		PolyphonyManager(int voiceAmount_):
 			voiceAmount(voiceAmount_),
-			currentVoice(-1),
 			lastStartedVoice(0)
-		{};
+		{
+			for (auto& v : currentVoice)
+				v = -1;
+		};
 
 		/** Returns the amount of voices the Modulator can handle. */
 		int getVoiceAmount() const {return voiceAmount;};
@@ -419,21 +550,26 @@ public:
 		/** Call this when you finished the processing to clear the current voice. */
 		void clearCurrentVoice() noexcept
 		{
-			jassert(currentVoice != -1);
-			currentVoice = -1;
+			auto& v = currentVoice[RealtimeWorkerPool::getCurrentThreadIndex()];
+
+			jassert(v != -1);
+			v = -1;
 		};
 
 		int getCurrentVoice() const noexcept
 		{
-			jassert (currentVoice != -1);
-			return currentVoice;
+			const int v = currentVoice[RealtimeWorkerPool::getCurrentThreadIndex()];
+
+			jassert (v != -1);
+			return v;
 		};
 
 	private:
 
 		int lastStartedVoice;
 
-		int currentVoice;
+		// Every render thread has its own current voice (see ModulatorSynth::setUseParallelVoiceRendering())
+		int currentVoice[HISE_MAX_REALTIME_WORKERS + 1];
 		const int voiceAmount;
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PolyphonyManager)
@@ -796,6 +932,9 @@ public:
 #else
 		ignoreUnused(voiceIndex);
 #endif
+
+		if (calculatedVoiceBlocks != nullptr)
+			calculatedVoiceBlocks[voiceIndex] = 0;
 	}
 
 	void handleHiseEvent(const HiseEvent &m)
@@ -812,10 +951,52 @@ public:
 	{
 		Processor::prepareToPlay(sampleRate, samplesPerBlock);
 		TimeModulation::prepareToModulate(sampleRate, samplesPerBlock);
+
+		if (canCalculateVoiceBlocks())
+		{
+			voiceBlockBuffer.setSize(polyManager.getVoiceAmount(), samplesPerBlock);
+			calculatedVoiceBlocks.calloc(polyManager.getVoiceAmount());
+			voiceBlockCounter = 0;
+		}
 	}
 
 	bool isInMonophonicMode() const { return isMonophonic; }
 
+	/** Creates a working channel for every render thread, so that the voices can be calculated in parallel.
+	*
+	*	The ModulatorSynth calls this if it renders its voices in parallel, so the channels are only allocated if they are used.
+	*/
+	void setUseParallelRendering(bool shouldRenderInParallel);
+
+	/** Override this and return true if the envelope stays at the same value for the next block of the given voice (eg. the sustain state).
+	*
+	*	The ModulatorChain will then apply the value as scalar instead of calling calculateBlock() for this voice, so make sure
+	*	that you update the state like calculateBlock() would do it.
+	*/
+	virtual bool getConstantValueForNextBlock(int /*voiceIndex*/, float& /*value*/) { return false; }
+
+	/** Override this and return true if the envelope can calculate the blocks of multiple voices at once with calculateVoiceBlocks(). */
+	virtual bool canCalculateVoiceBlocks() const { return false; }
+
+	/** Override this and return true if a controller, pitch wheel or aftertouch event changes the value of a playing voice.
+	*
+	*	The ModulatorSynth splits the rendering at these events while voices are playing, so they are applied at the exact sample.
+	*/
+	virtual bool reactsToControllerEvents() const { return false; }
+
+	/** Calculates the next block of the given voices at once.
+	*
+	*	This is called by the ModulatorChain before the voices are rendered. The next calculateBlock() call of a calculated voice
+	*	must use the stored values instead of calculating them again (see consumeVoiceBlock()).
+	*/
+	void renderVoiceBlocks(const int* voiceIndexes, int numVoices, int startSample, int numSamples);
+
+	/** Returns true if the next block of the voice was already calculated by renderVoiceBlocks(). */
+	bool hasCalculatedVoiceBlock(int voiceIndex) const noexcept
+	{
+		return calculatedVoiceBlocks != nullptr && voiceBlockCounter != 0 && calculatedVoiceBlocks[voiceIndex] == voiceBlockCounter;
+	}
+
 	void startVoice(int /*voiceIndex*/) override
 	{
 		numPressedKeys++;
@@ -851,6 +1032,88 @@ protected:
 
 	EnvelopeModulator(MainController *mc, const String &id, int voiceAmount_, Modulation::Mode m);
 
+	/** The state of the voices in calculateVoiceBlocks() stored as structure of arrays.
+	*
+	*	Every lane calculates its next value with the recursion value = base + value * coef, which covers the linear
+	*	and exponential stages of the envelopes and can be vectorised across the voices.
+	*/
+	struct VoiceBlockLanes
+	{
+		void clear() noexcept { numLanes = 0; }
+
+		void add(int voiceIndex, int stage, float value, float base, float coef, float target, float* row) noexcept
+		{
+			jassert(numLanes < NUM_POLYPHONIC_VOICES);
+
+			voiceIndexes[numLanes] = voiceIndex;
+			stages[numLanes] = stage;
+			values[numLanes] = value;
+			bases[numLanes] = base;
+			coefs[numLanes] = coef;
+			targets[numLanes] = target;
+			rows[numLanes] = row;
+
+			numLanes++;
+		}
+
+		/** Removes the lane by moving the last lane to its position. */
+		void remove(int laneIndex) noexcept
+		{
+			const int last = --numLanes;
+
+			voiceIndexes[laneIndex] = voiceIndexes[last];
+			stages[laneIndex] = stages[last];
+			values[laneIndex] = values[last];
+			nextValues[laneIndex] = nextValues[last];
+			bases[laneIndex] = bases[last];
+			coefs[laneIndex] = coefs[last];
+			targets[laneIndex] = targets[last];
+			rows[laneIndex] = rows[last];
+		}
+
+		void calculateNextValues() noexcept
+		{
+			for (int i = 0; i < numLanes; i++)
+				nextValues[i] = bases[i] + values[i] * coefs[i];
+		}
+
+		void storeNextValues(int sampleIndex) noexcept
+		{
+			for (int i = 0; i < numLanes; i++)
+			{
+				values[i] = nextValues[i];
+				rows[i][sampleIndex] = nextValues[i];
+			}
+		}
+
+		int numLanes = 0;
+
+		int voiceIndexes[NUM_POLYPHONIC_VOICES];
+		int stages[NUM_POLYPHONIC_VOICES];
+		float values[NUM_POLYPHONIC_VOICES];
+		float nextValues[NUM_POLYPHONIC_VOICES];
+		float bases[NUM_POLYPHONIC_VOICES];
+		float coefs[NUM_POLYPHONIC_VOICES];
+		float targets[NUM_POLYPHONIC_VOICES];
+		float* rows[NUM_POLYPHONIC_VOICES];
+	};
+
+	/** Override this and calculate the next block for the given voices.
+	*
+	*	Write the values of each voice to getVoiceBlockWritePointer() and call setVoiceBlockCalculated(). You can skip voices
+	*	that are cheap to calculate separately (eg. voices in the sustain state), they will use calculateBlock() as usual.
+	*/
+	virtual void calculateVoiceBlocks(const int* /*voiceIndexes*/, int /*numVoices*/, int /*startSample*/, int /*numSamples*/) {}
+
+	float* getVoiceBlockWritePointer(int voiceIndex, int startSample) { return voiceBlockBuffer.getWritePointer(voiceIndex, startSample); }
+
+	void setVoiceBlockCalculated(int voiceIndex) noexcept { calculatedVoiceBlocks[voiceIndex] = voiceBlockCounter; }
+
+	/** Call this in calculateBlock(). If the block of the voice was calculated by calculateVoiceBlocks(), it copies the values
+	*	to the internal buffer and returns true.
+	*/
+	bool consumeVoiceBlock(int voiceIndex, int startSample, int numSamples);
+
 	/** A ModulatorState is a container for Modulator states in a polyphonic TimeVariantModulator.
 	*
 	*	If the modulator should be polyphonic:
@@ -895,6 +1158,12 @@ private:
 
 	int numPressedKeys = 0;
 
+	AudioSampleBuffer voiceBlockBuffer;
+	HeapBlock<uint32> calculatedVoiceBlocks;
+	uint32 voiceBlockCounter = 0;
+	int voiceBlockStart = 0;
+	int voiceBlockLength = 0;
+
 };
 
 
@@ -30,11 +30,21 @@
 
 #include "hi_lac.h"
 
+#if JUCE_LINUX || JUCE_MAC || JUCE_IOS || JUCE_ANDROID
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if HLAC_USE_SIMD_UNPACKING
+#include <immintrin.h>
+#endif
+
 #include "hlac/BitCompressors.cpp"
 #include "hlac/CompressionHelpers.cpp"
 #include "hlac/SampleBuffer.cpp"
 #include "hlac/HlacEncoder.cpp"
 #include "hlac/HlacDecoder.cpp"
+#include "hlac/HlacBlockCache.cpp"
 #include "hlac/HlacAudioFormatWriter.cpp"
 #include "hlac/HlacAudioFormatReader.cpp"
 #include "hlac/HiseLosslessAudioFormat.cpp"
@@ -101,12 +101,82 @@ If enabled, then the unit test suite will be compiled and added to all unit test
 #define HLAC_INCLUDE_TEST_SUITE 0
 #endif
 
+//=============================================================================
+/** Config: HI_RUN_BENCHMARKS
+
+Set this to true if the unit tests should also run the performance benchmarks (this makes the test run much slower).
+This is defined here because every HISE module includes this module.
+*/
+#ifndef HI_RUN_BENCHMARKS
+#define HI_RUN_BENCHMARKS 0
+#endif
+
+//=============================================================================
+/** Config: HLAC_USE_SIMD_UNPACKING
+
+If enabled, the bit compressors will use SSE4.1 or AVX2 for decompression if the CPU supports it.
+The instruction set is chosen at runtime, so you don't need to change the compiler flags.
+*/
+#ifndef HLAC_USE_SIMD_UNPACKING
+#if JUCE_INTEL && !JUCE_IOS
+#define HLAC_USE_SIMD_UNPACKING 1
+#else
+#define HLAC_USE_SIMD_UNPACKING 0
+#endif
+#endif
+
+//=============================================================================
+/** Config: HLAC_USE_PARALLEL_DECODING
+
+If enabled, large reads will be split at block boundaries and decoded on multiple threads.
+*/
+#ifndef HLAC_USE_PARALLEL_DECODING
+#define HLAC_USE_PARALLEL_DECODING 1
+#endif
+
+//=============================================================================
+/** Config: HLAC_MIN_BLOCKS_PER_DECODING_JOB
+
+The minimum amount of blocks that a decoding thread should process. Reads with less than twice this amount will be decoded on the calling thread.
+*/
+#ifndef HLAC_MIN_BLOCKS_PER_DECODING_JOB
+#define HLAC_MIN_BLOCKS_PER_DECODING_JOB 8
+#endif
+
+//=============================================================================
+/** Config: HLAC_USE_PARALLEL_ENCODING
+
+If enabled, the encoder will compress the full blocks of large buffers on multiple threads.
+*/
+#ifndef HLAC_USE_PARALLEL_ENCODING
+#define HLAC_USE_PARALLEL_ENCODING 1
+#endif
+
+//=============================================================================
+/** Config: HLAC_MIN_BLOCKS_PER_ENCODING_JOB
+
+The minimum amount of blocks that an encoding thread should process. Buffers with less than twice this amount will be encoded on the calling thread.
+*/
+#ifndef HLAC_MIN_BLOCKS_PER_ENCODING_JOB
+#define HLAC_MIN_BLOCKS_PER_ENCODING_JOB 2
+#endif
+
+//=============================================================================
+/** Config: HLAC_DEFAULT_BLOCK_CACHE_SIZE
+
+The default memory limit in bytes for the cache that stores decoded blocks (see HlacBlockCache).
+*/
+#ifndef HLAC_DEFAULT_BLOCK_CACHE_SIZE
+#define HLAC_DEFAULT_BLOCK_CACHE_SIZE (32 * 1024 * 1024)
+#endif
+
 
 #include "hlac/BitCompressors.h"
 #include "hlac/CompressionHelpers.h"
 #include "hlac/SampleBuffer.h"
 #include "hlac/HlacEncoder.h"
 #include "hlac/HlacDecoder.h"
+#include "hlac/HlacBlockCache.h"
 #include "hlac/HlacAudioFormatWriter.h"
 #include "hlac/HlacAudioFormatReader.h"
 #include "hlac/HiseLosslessAudioFormat.h"
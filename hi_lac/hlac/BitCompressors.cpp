@@ -144,6 +144,335 @@ void unpackArrayOfInt16(int16* d, int /*numValues*/, uint8 bitDepth)
 }
 
 
+#if HLAC_USE_SIMD_UNPACKING
+
+#if JUCE_MSVC
+#define HLAC_TARGET_SSE41
+#define HLAC_TARGET_AVX2
+#else
+#define HLAC_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define HLAC_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace SimdKernels
+{
+
+/** The 6, 10, 12 and 14 bit compressors write a continuous stream of 16 bit words (most significant bit first).
+*
+*	A group of 8 values uses exactly BitDepth bytes. Every value is unpacked by shuffling the two words that contain it
+*	into a 32 bit lane, shifting the value to the top and then down to the bottom.
+*/
+template <int BitDepth> struct WordLayout
+{
+	WordLayout()
+	{
+		for (int i = 0; i < 8; i++)
+		{
+			const int bitPosition = i * BitDepth;
+			const int wordIndex = bitPosition / 16;
+			const int laneStart = (i / 4) * 16 + (i % 4) * 4;
+
+			// the first word goes into the upper half of the lane
+			shuffle[laneStart + 0] = (int8)(2 * wordIndex + 2);
+			shuffle[laneStart + 1] = (int8)(2 * wordIndex + 3);
+			shuffle[laneStart + 2] = (int8)(2 * wordIndex);
+			shuffle[laneStart + 3] = (int8)(2 * wordIndex + 1);
+
+			shifts[i] = bitPosition % 16;
+			multipliers[i] = 1 << shifts[i];
+		}
+	}
+
+	alignas(32) int8 shuffle[32];
+	alignas(32) int32 shifts[8];
+	alignas(32) int32 multipliers[8];
+
+	static const int16 offset = (1 << (BitDepth - 1)) - 1;
+};
+
+template <int BitDepth> HLAC_TARGET_SSE41 int unpackWordsSSE41(int16* destination, const uint8* data, int numValues, int numPackedBytes)
+{
+	static const WordLayout<BitDepth> layout;
+
+	const __m128i shuffleLow = _mm_load_si128(reinterpret_cast<const __m128i*>(layout.shuffle));
+	const __m128i shuffleHigh = _mm_load_si128(reinterpret_cast<const __m128i*>(layout.shuffle + 16));
+	const __m128i multipliersLow = _mm_load_si128(reinterpret_cast<const __m128i*>(layout.multipliers));
+	const __m128i multipliersHigh = _mm_load_si128(reinterpret_cast<const __m128i*>(layout.multipliers + 4));
+	const __m128i offset = _mm_set1_epi16(WordLayout<BitDepth>::offset);
+
+	int numUnpacked = 0;
+
+	// Every iteration loads 16 bytes, but only consumes BitDepth bytes.
+	while (numValues - numUnpacked >= 8 && numPackedBytes >= 16)
+	{
+		const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+
+		// SSE has no variable shift, so the left shift is a multiplication
+		__m128i low = _mm_mullo_epi32(_mm_shuffle_epi8(packed, shuffleLow), multipliersLow);
+		__m128i high = _mm_mullo_epi32(_mm_shuffle_epi8(packed, shuffleHigh), multipliersHigh);
+
+		low = _mm_srli_epi32(low, 32 - BitDepth);
+		high = _mm_srli_epi32(high, 32 - BitDepth);
+
+		const __m128i values = _mm_sub_epi16(_mm_packus_epi32(low, high), offset);
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination), values);
+
+		data += BitDepth;
+		destination += 8;
+		numPackedBytes -= BitDepth;
+		numUnpacked += 8;
+	}
+
+	return numUnpacked;
+}
+
+template <int BitDepth> HLAC_TARGET_AVX2 int unpackWordsAVX2(int16* destination, const uint8* data, int numValues, int numPackedBytes)
+{
+	static const WordLayout<BitDepth> layout;
+
+	const __m256i shuffle = _mm256_load_si256(reinterpret_cast<const __m256i*>(layout.shuffle));
+	const __m256i shifts = _mm256_load_si256(reinterpret_cast<const __m256i*>(layout.shifts));
+	const __m256i offset = _mm256_set1_epi16(WordLayout<BitDepth>::offset);
+
+	int numUnpacked = 0;
+
+	while (numValues - numUnpacked >= 16 && numPackedBytes >= BitDepth + 16)
+	{
+		const __m128i firstGroup = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+		const __m128i secondGroup = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + BitDepth));
+
+		// Both 128 bit lanes need the packed data of one group
+		const __m256i first = _mm256_inserti128_si256(_mm256_castsi128_si256(firstGroup), firstGroup, 1);
+		const __m256i second = _mm256_inserti128_si256(_mm256_castsi128_si256(secondGroup), secondGroup, 1);
+
+		const __m256i a = _mm256_srli_epi32(_mm256_sllv_epi32(_mm256_shuffle_epi8(first, shuffle), shifts), 32 - BitDepth);
+		const __m256i b = _mm256_srli_epi32(_mm256_sllv_epi32(_mm256_shuffle_epi8(second, shuffle), shifts), 32 - BitDepth);
+
+		// The packing works within the 128 bit lanes, so the 64 bit parts need to be reordered
+		__m256i values = _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+		values = _mm256_sub_epi16(values, offset);
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), values);
+
+		data += 2 * BitDepth;
+		destination += 16;
+		numPackedBytes -= 2 * BitDepth;
+		numUnpacked += 16;
+	}
+
+	return numUnpacked + unpackWordsSSE41<BitDepth>(destination, data, numValues - numUnpacked, numPackedBytes);
+}
+
+/** Loads the packed bytes for 16 values of the 1, 2, 4 and 8 bit compressors without reading past them. */
+template <int NumBytes> HLAC_TARGET_SSE41 inline __m128i loadBytes(const uint8* data)
+{
+	if (NumBytes == 2)
+		return _mm_cvtsi32_si128((int)ByteOrder::littleEndianShort(data));
+	else if (NumBytes == 4)
+		return _mm_cvtsi32_si128((int)ByteOrder::littleEndianInt(data));
+	else if (NumBytes == 8)
+		return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data));
+	else
+		return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+/** Expands 16 packed values to 16 signed bytes. */
+template <int BitDepth> HLAC_TARGET_SSE41 inline __m128i expandBytes(__m128i packed)
+{
+	if (BitDepth == 1)
+	{
+		const __m128i shuffle = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1);
+		const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+
+		const __m128i x = _mm_and_si128(_mm_shuffle_epi8(packed, shuffle), bits);
+
+		return _mm_and_si128(_mm_cmpeq_epi8(x, bits), _mm_set1_epi8(1));
+	}
+	else if (BitDepth == 2)
+	{
+		// The lower bit is the value, the upper bit the sign
+		const __m128i shuffle = _mm_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3);
+		const __m128i valueBits = _mm_setr_epi8(1, 4, 16, 64, 1, 4, 16, 64, 1, 4, 16, 64, 1, 4, 16, 64);
+		const __m128i signBits = _mm_setr_epi8(2, 8, 32, -128, 2, 8, 32, -128, 2, 8, 32, -128, 2, 8, 32, -128);
+
+		const __m128i x = _mm_shuffle_epi8(packed, shuffle);
+
+		const __m128i value = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(x, valueBits), valueBits), _mm_set1_epi8(1));
+		const __m128i sign = _mm_cmpeq_epi8(_mm_and_si128(x, signBits), signBits);
+
+		return _mm_sub_epi8(_mm_xor_si128(value, sign), sign);
+	}
+	else if (BitDepth == 4)
+	{
+		// Three bits for the absolute value and the sign bit
+		const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+
+		const __m128i low = _mm_and_si128(packed, nibbleMask);
+		const __m128i high = _mm_and_si128(_mm_srli_epi16(packed, 4), nibbleMask);
+		const __m128i x = _mm_unpacklo_epi8(low, high);
+
+		const __m128i value = _mm_and_si128(x, _mm_set1_epi8(0x07));
+		const __m128i sign = _mm_cmpeq_epi8(_mm_and_si128(x, _mm_set1_epi8(0x08)), _mm_set1_epi8(0x08));
+
+		return _mm_sub_epi8(_mm_xor_si128(value, sign), sign);
+	}
+	else
+	{
+		return packed;
+	}
+}
+
+template <int BitDepth> HLAC_TARGET_SSE41 int unpackBytesSSE41(int16* destination, const uint8* data, int numValues, int numPackedBytes)
+{
+	const int numBytesPerChunk = 2 * BitDepth;
+
+	int numUnpacked = 0;
+
+	while (numValues - numUnpacked >= 16 && numPackedBytes >= numBytesPerChunk)
+	{
+		const __m128i values = expandBytes<BitDepth>(loadBytes<2 * BitDepth>(data));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm_cvtepi8_epi16(values));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 8), _mm_cvtepi8_epi16(_mm_srli_si128(values, 8)));
+
+		data += numBytesPerChunk;
+		destination += 16;
+		numPackedBytes -= numBytesPerChunk;
+		numUnpacked += 16;
+	}
+
+	return numUnpacked;
+}
+
+template <int BitDepth> HLAC_TARGET_AVX2 int unpackBytesAVX2(int16* destination, const uint8* data, int numValues, int numPackedBytes)
+{
+	const int numBytesPerChunk = 2 * BitDepth;
+
+	int numUnpacked = 0;
+
+	while (numValues - numUnpacked >= 32 && numPackedBytes >= 2 * numBytesPerChunk)
+	{
+		const __m128i first = expandBytes<BitDepth>(loadBytes<2 * BitDepth>(data));
+		const __m128i second = expandBytes<BitDepth>(loadBytes<2 * BitDepth>(data + numBytesPerChunk));
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), _mm256_cvtepi8_epi16(first));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + 16), _mm256_cvtepi8_epi16(second));
+
+		data += 2 * numBytesPerChunk;
+		destination += 32;
+		numPackedBytes -= 2 * numBytesPerChunk;
+		numUnpacked += 32;
+	}
+
+	return numUnpacked + unpackBytesSSE41<BitDepth>(destination, data, numValues - numUnpacked, numPackedBytes);
+}
+
+static Atomic<int>& getInstructionSetFlag()
+{
+	static Atomic<int> instructionSet((int)BitCompressors::SimdUnpacker::getBestAvailableInstructionSet());
+
+	return instructionSet;
+}
+
+} // namespace SimdKernels
+
+#endif
+
+BitCompressors::SimdUnpacker::InstructionSet BitCompressors::SimdUnpacker::getBestAvailableInstructionSet()
+{
+#if HLAC_USE_SIMD_UNPACKING
+	if (SystemStats::hasAVX2())
+		return InstructionSet::AVX2;
+
+	if (SystemStats::hasSSE41())
+		return InstructionSet::SSE41;
+#endif
+
+	return InstructionSet::None;
+}
+
+BitCompressors::SimdUnpacker::InstructionSet BitCompressors::SimdUnpacker::getInstructionSet()
+{
+#if HLAC_USE_SIMD_UNPACKING
+	return (InstructionSet)SimdKernels::getInstructionSetFlag().get();
+#else
+	return InstructionSet::None;
+#endif
+}
+
+void BitCompressors::SimdUnpacker::setInstructionSet(InstructionSet newInstructionSet)
+{
+#if HLAC_USE_SIMD_UNPACKING
+	auto best = getBestAvailableInstructionSet();
+
+	if ((int)newInstructionSet > (int)best)
+		newInstructionSet = best;
+
+	SimdKernels::getInstructionSetFlag().set((int)newInstructionSet);
+#else
+	ignoreUnused(newInstructionSet);
+#endif
+}
+
+String BitCompressors::SimdUnpacker::getName(InstructionSet s)
+{
+	switch (s)
+	{
+	case InstructionSet::SSE41: return "SSE4.1";
+	case InstructionSet::AVX2: return "AVX2";
+	case InstructionSet::None:
+	case InstructionSet::numInstructionSets:
+	default: return "Scalar";
+	}
+}
+
+int BitCompressors::SimdUnpacker::unpack(int bitDepth, int16* destination, const uint8* data, int numValues, int numPackedBytes) noexcept
+{
+#if HLAC_USE_SIMD_UNPACKING
+	using namespace SimdKernels;
+
+	switch ((InstructionSet)getInstructionSetFlag().get())
+	{
+	case InstructionSet::AVX2:
+		switch (bitDepth)
+		{
+		case 1:  return unpackBytesAVX2<1>(destination, data, numValues, numPackedBytes);
+		case 2:  return unpackBytesAVX2<2>(destination, data, numValues, numPackedBytes);
+		case 4:  return unpackBytesAVX2<4>(destination, data, numValues, numPackedBytes);
+		case 6:  return unpackWordsAVX2<6>(destination, data, numValues, numPackedBytes);
+		case 8:  return unpackBytesAVX2<8>(destination, data, numValues, numPackedBytes);
+		case 10: return unpackWordsAVX2<10>(destination, data, numValues, numPackedBytes);
+		case 12: return unpackWordsAVX2<12>(destination, data, numValues, numPackedBytes);
+		case 14: return unpackWordsAVX2<14>(destination, data, numValues, numPackedBytes);
+		default: return 0;
+		}
+	case InstructionSet::SSE41:
+		switch (bitDepth)
+		{
+		case 1:  return unpackBytesSSE41<1>(destination, data, numValues, numPackedBytes);
+		case 2:  return unpackBytesSSE41<2>(destination, data, numValues, numPackedBytes);
+		case 4:  return unpackBytesSSE41<4>(destination, data, numValues, numPackedBytes);
+		case 6:  return unpackWordsSSE41<6>(destination, data, numValues, numPackedBytes);
+		case 8:  return unpackBytesSSE41<8>(destination, data, numValues, numPackedBytes);
+		case 10: return unpackWordsSSE41<10>(destination, data, numValues, numPackedBytes);
+		case 12: return unpackWordsSSE41<12>(destination, data, numValues, numPackedBytes);
+		case 14: return unpackWordsSSE41<14>(destination, data, numValues, numPackedBytes);
+		default: return 0;
+		}
+	case InstructionSet::None:
+	case InstructionSet::numInstructionSets:
+	default:
+		break;
+	}
+#endif
+
+	ignoreUnused(bitDepth, destination, data);
+	ignoreUnused(numValues, numPackedBytes);
+	return 0;
+}
+
+
 int BitCompressors::ZeroBit::getAllowedBitRange() const
 {
 	return 0;
@@ -219,6 +548,12 @@ bool BitCompressors::OneBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::OneBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	const int numUnpacked = SimdUnpacker::unpack(1, destination, data, numValuesToDecompress, getByteAmount(numValuesToDecompress));
+
+	destination += numUnpacked;
+	data += numUnpacked / 8;
+	numValuesToDecompress -= numUnpacked;
+
 	const uint8 masks[8] = { 0b00000001, 0b00000010, 0b00000100, 0b00001000,
 		0b00010000, 0b00100000, 0b01000000, 0b10000000 };
 
@@ -314,6 +649,12 @@ bool BitCompressors::TwoBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::TwoBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	const int numUnpacked = SimdUnpacker::unpack(2, destination, data, numValuesToDecompress, getByteAmount(numValuesToDecompress));
+
+	destination += numUnpacked;
+	data += numUnpacked / 4;
+	numValuesToDecompress -= numUnpacked;
+
 	const uint8 signMasks[4] =  { 0b00000010, 0b00001000, 0b00100000, 0b10000000 };
 	const uint8 valueMasks[4] = { 0b00000001, 0b00000100, 0b00010000, 0b01000000 };
 
@@ -427,6 +768,12 @@ bool BitCompressors::FourBit::compress(uint8* destination, const int16* data, in
 
 bool BitCompressors::FourBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	const int numUnpacked = SimdUnpacker::unpack(4, destination, data, numValuesToDecompress, getByteAmount(numValuesToDecompress));
+
+	destination += numUnpacked;
+	data += numUnpacked / 2;
+	numValuesToDecompress -= numUnpacked;
+
 	
 
 	const uint8 signMasks[2] =  { 0b00001000, 0b10000000 };
@@ -539,6 +886,12 @@ bool BitCompressors::SixBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::SixBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	const int numUnpacked = SimdUnpacker::unpack(6, destination, data, numValuesToDecompress, (numValuesToDecompress / 8) * 6);
+
+	destination += numUnpacked;
+	data += (numUnpacked / 8) * 6;
+	numValuesToDecompress -= numUnpacked;
+
 #if HLAC_NO_SSE
 	while (numValuesToDecompress >= 8)
 	{
@@ -704,6 +1057,12 @@ bool BitCompressors::EightBit::compress(uint8* destination, const int16* data, i
 
 bool BitCompressors::EightBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	const int numUnpacked = SimdUnpacker::unpack(8, destination, data, numValuesToDecompress, numValuesToDecompress);
+
+	destination += numUnpacked;
+	data += numUnpacked;
+	numValuesToDecompress -= numUnpacked;
+
     while (--numValuesToDecompress >= 0)
 	{
 		const int8 value = *reinterpret_cast<const int8*>(data++);
@@ -791,6 +1150,12 @@ bool BitCompressors::TenBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::TenBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	const int numUnpacked = SimdUnpacker::unpack(10, destination, data, numValuesToDecompress, (numValuesToDecompress / 8) * 10);
+
+	destination += numUnpacked;
+	data += (numUnpacked / 8) * 10;
+	numValuesToDecompress -= numUnpacked;
+
 	while (numValuesToDecompress >= 8)
 	{
 		decompress10Bit(reinterpret_cast<uint16*>(destination), (void*)data);
@@ -849,6 +1214,12 @@ bool BitCompressors::TwelveBit::compress(uint8* destination, const int16* data,
 
 bool BitCompressors::TwelveBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	const int numUnpacked = SimdUnpacker::unpack(12, destination, data, numValuesToDecompress, (numValuesToDecompress / 4) * 6);
+
+	destination += numUnpacked;
+	data += (numUnpacked / 4) * 6;
+	numValuesToDecompress -= numUnpacked;
+
 #if USE_SSE
 
 	const int numInBlockProcessing = numValuesToDecompress - (numValuesToDecompress % 4);
@@ -1003,6 +1374,12 @@ bool BitCompressors::FourteenBit::compress(uint8* destination, const int16* data
 
 bool BitCompressors::FourteenBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	const int numUnpacked = SimdUnpacker::unpack(14, destination, data, numValuesToDecompress, (numValuesToDecompress / 8) * 14);
+
+	destination += numUnpacked;
+	data += (numUnpacked / 8) * 14;
+	numValuesToDecompress -= numUnpacked;
+
 	while (numValuesToDecompress >= 8)
 	{
 		decompress14Bit(destination, data);
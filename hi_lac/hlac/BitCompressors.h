@@ -203,6 +203,39 @@ struct BitCompressors
 		int getByteAmount(int numValuesToCompress) override;
 	};
 
+	/** Vectorised versions of the decompression routines.
+	*
+	*	The instruction set is detected at runtime, so the module doesn't need to be compiled with any architecture flags.
+	*	The decompress() methods call unpack() first and decode the remaining values with the scalar code.
+	*/
+	struct SimdUnpacker
+	{
+		enum class InstructionSet
+		{
+			None = 0,
+			SSE41,
+			AVX2,
+			numInstructionSets
+		};
+
+		/** Returns the best instruction set that is supported by the CPU. */
+		static InstructionSet getBestAvailableInstructionSet();
+
+		/** Returns the instruction set that is used for unpacking. */
+		static InstructionSet getInstructionSet();
+
+		/** Overrides the instruction set (eg. for testing or benchmarking). If the CPU doesn't support it, the best available one will be used instead. */
+		static void setInstructionSet(InstructionSet newInstructionSet);
+
+		static String getName(InstructionSet s);
+
+		/** Unpacks the values in chunks and returns the number of values that were unpacked.
+		*
+		*	It will not read more than numPackedBytes, so you have to decode the remaining values yourself.
+		*/
+		static int unpack(int bitDepth, int16* destination, const uint8* data, int numValues, int numPackedBytes) noexcept;
+	};
+
 	struct UnitTests;
 };
 
@@ -188,13 +188,6 @@ bool HlacReaderCommon::internalHlacRead(int** destSamples, int numDestChannels,
 
 	bool isStereo = destSamples[1] != nullptr;
 
-	if (startSampleInFile != decoder.getCurrentReadPosition())
-	{
-		auto byteOffset = header.getOffsetForReadPosition(startSampleInFile, useHeaderOffsetWhenSeeking);
-
-		decoder.seekToPosition(*input, (uint32)startSampleInFile, byteOffset);
-	}
-
 	if (isStereo)
 	{
 		if (usesFloatingPointData)
@@ -216,7 +209,7 @@ bool HlacReaderCommon::internalHlacRead(int** destSamples, int numDestChannels,
 
 			AudioSampleBuffer b(destinationFloat, 2, numSamples);
 			HiseSampleBuffer hsb(b);
-			decoder.decode(hsb, true, *input, (int)startSampleInFile, numSamples);
+			decodeRange(hsb, true, startSampleInFile, numSamples);
 		}
 		else
 		{
@@ -233,7 +226,7 @@ bool HlacReaderCommon::internalHlacRead(int** destSamples, int numDestChannels,
 			}
 
 			HiseSampleBuffer hsb(destinationFixed, 2, numSamples);
-			decoder.decode(hsb, true, *input, (int)startSampleInFile, numSamples);
+			decodeRange(hsb, true, startSampleInFile, numSamples);
 		}
 	}
 	else
@@ -245,7 +238,7 @@ bool HlacReaderCommon::internalHlacRead(int** destSamples, int numDestChannels,
 			AudioSampleBuffer b(&destinationFloat, 1, numSamples);
 			HiseSampleBuffer hsb(b);
 
-			decoder.decode(hsb, false, *input, (int)startSampleInFile, numSamples);
+			decodeRange(hsb, false, startSampleInFile, numSamples);
 		}
 		else
 		{
@@ -254,17 +247,165 @@ bool HlacReaderCommon::internalHlacRead(int** destSamples, int numDestChannels,
 			HiseSampleBuffer hsb(destinationFixed, 1, numSamples);
 
 
-			decoder.decode(hsb, false, *input, (int)startSampleInFile, numSamples);
+			decodeRange(hsb, false, startSampleInFile, numSamples);
 		}
 	}
 
 	return true;
 }
 
+void HlacReaderCommon::setBlockCache(HlacBlockCache* newCache, uint32 fileId)
+{
+	blockCache = newCache;
+	blockCacheFileId = fileId;
+
+	if (blockCache != nullptr)
+		blockBuffer = HiseSampleBuffer(false, 2, COMPRESSION_BLOCK_SIZE);
+	else
+		blockBuffer = HiseSampleBuffer();
+}
+
 bool HlacReaderCommon::fixedBufferRead(HiseSampleBuffer& buffer, int numDestChannels, int startOffsetInBuffer, int64 startSampleInFile, int numSamples)
 {
+	if (blockCache != nullptr && !buffer.isFloatingPoint() && header.usesCompression())
+		return cachedFixedBufferRead(buffer, numDestChannels, startOffsetInBuffer, startSampleInFile, numSamples);
+
 	bool isStereo = numDestChannels == 2;
 
+	if(startOffsetInBuffer == 0)
+		decodeRange(buffer, isStereo, startSampleInFile, numSamples);
+	else
+	{
+		HiseSampleBuffer offset(buffer, startOffsetInBuffer);
+
+		decodeRange(offset, isStereo, startSampleInFile, numSamples);
+
+	}
+
+	return true;
+}
+
+class HlacReaderCommon::DecodingJob : public ThreadPoolJob
+{
+public:
+
+	DecodingJob(HlacReaderCommon& parent_) :
+		ThreadPoolJob("HLAC Decoding"),
+		parent(parent_)
+	{
+		decoder.setupForDecompression();
+	}
+
+	/** Sets the range for the next read. The job must not be in the pool when you call this. */
+	void prepare(HiseSampleBuffer& destination_, int offsetInDestination_, bool isStereo_, const void* data_, size_t numBytes_, int64 startSample_, int numSamples_)
+	{
+		destination = &destination_;
+		offsetInDestination = offsetInDestination_;
+		isStereo = isStereo_;
+		data = data_;
+		numBytes = numBytes_;
+		startSample = startSample_;
+		numSamples = numSamples_;
+
+		claimed.store(false);
+	}
+
+	/** Returns true if the calling thread should decode this job (either the pool or the reading thread will get it). */
+	bool claim() noexcept { return !claimed.exchange(true); }
+
+	JobStatus runJob() override
+	{
+		if (claim())
+		{
+			decode();
+			parent.decodingJobFinished();
+		}
+
+		return jobHasFinished;
+	}
+
+	void decode()
+	{
+		HiseSampleBuffer part(*destination, offsetInDestination, numSamples);
+		MemoryInputStream mis(data, numBytes, false);
+
+		// The data starts at the beginning of the block that contains the start sample
+		decoder.seekToPosition(mis, (uint32)startSample, 0);
+		decoder.decode(part, isStereo, mis, (int)startSample, numSamples);
+	}
+
+private:
+
+	HlacReaderCommon& parent;
+	HlacDecoder decoder;
+
+	std::atomic<bool> claimed { true };
+
+	HiseSampleBuffer* destination = nullptr;
+	int offsetInDestination = 0;
+	bool isStereo = false;
+	const void* data = nullptr;
+	size_t numBytes = 0;
+	int64 startSample = 0;
+	int numSamples = 0;
+};
+
+HlacReaderCommon::HlacReaderCommon(InputStream* input_) :
+	input(input_),
+	header(input)
+{
+	decoder.setupForDecompression();
+	setUseParallelDecoding(HLAC_USE_PARALLEL_DECODING != 0);
+}
+
+HlacReaderCommon::HlacReaderCommon(const File& f) :
+	input(nullptr),
+	header(f)
+{
+	decoder.setupForDecompression();
+	setUseParallelDecoding(HLAC_USE_PARALLEL_DECODING != 0);
+}
+
+HlacReaderCommon::~HlacReaderCommon()
+{
+	setUseParallelDecoding(false);
+}
+
+void HlacReaderCommon::setUseParallelDecoding(bool shouldDecodeInParallel)
+{
+	ScopedLock sl(parallelDecodingLock);
+
+	useParallelDecoding = shouldDecodeInParallel;
+
+	if (shouldDecodeInParallel)
+	{
+		// One job is decoded by the reading thread
+		const int numJobs = decodingThreadPool->getNumJobsToUse();
+
+		while (decodingJobs.size() < numJobs)
+			decodingJobs.add(new DecodingJob(*this));
+	}
+	else
+	{
+		// A job that was decoded by the reading thread might still be in the pool
+		for (auto job : decodingJobs)
+			decodingThreadPool->removeJob(job);
+
+		decodingJobs.clear();
+	}
+}
+
+void HlacReaderCommon::decodingJobFinished()
+{
+	if (--numPendingDecodingJobs == 0)
+		decodingJobsFinished.signal();
+}
+
+void HlacReaderCommon::decodeRange(HiseSampleBuffer& destination, bool isStereo, int64 startSampleInFile, int numSamples)
+{
+	if (useParallelDecoding && parallelDecode(destination, isStereo, startSampleInFile, numSamples))
+		return;
+
 	if (startSampleInFile != decoder.getCurrentReadPosition())
 	{
 		auto byteOffset = header.getOffsetForReadPosition(startSampleInFile, useHeaderOffsetWhenSeeking);
@@ -272,14 +413,217 @@ bool HlacReaderCommon::fixedBufferRead(HiseSampleBuffer& buffer, int numDestChan
 		decoder.seekToPosition(*input, (uint32)startSampleInFile, byteOffset);
 	}
 
-	if(startOffsetInBuffer == 0)
-		decoder.decode(buffer, isStereo, *input, (int)startSampleInFile, numSamples);
+	decoder.decode(destination, isStereo, *input, (int)startSampleInFile, numSamples);
+}
+
+bool HlacReaderCommon::parallelDecode(HiseSampleBuffer& destination, bool isStereo, int64 startSampleInFile, int numSamples)
+{
+	// If another thread uses the jobs at the moment, this read will be decoded on the calling thread
+	const ScopedTryLock stl(parallelDecodingLock);
+
+	if (!stl.isLocked())
+		return false;
+
+	const int64 numBlocksInFile = (int64)header.getBlockAmount();
+
+	numSamples = jmin<int>(numSamples, destination.getNumSamples());
+
+	if (numSamples <= 0 || startSampleInFile < 0)
+		return false;
+
+	const int64 firstBlock = startSampleInFile / COMPRESSION_BLOCK_SIZE;
+	const int64 lastBlock = jmin<int64>(numBlocksInFile - 1, (startSampleInFile + numSamples - 1) / COMPRESSION_BLOCK_SIZE);
+	const int numBlocks = (int)(lastBlock - firstBlock + 1);
+
+	const int numJobs = jmin<int>(decodingJobs.size(), decodingThreadPool->getNumJobsToUse(), numBlocks / HLAC_MIN_BLOCKS_PER_DECODING_JOB);
+
+	if (numJobs < 2)
+		return false;
+
+	auto& pool = decodingThreadPool->getPool();
+
+	// A job of the last read that was decoded by the reading thread might not have left the pool yet
+	for (int i = 0; i < numJobs; i++)
+	{
+		if (pool.contains(decodingJobs[i]))
+			return false;
+	}
+
+	auto getByteOffset = [this, numBlocksInFile](int64 blockIndex)
+	{
+		if (blockIndex >= numBlocksInFile)
+			return input->getTotalLength();
+
+		return (int64)header.getOffsetForReadPosition(blockIndex * COMPRESSION_BLOCK_SIZE, useHeaderOffsetWhenSeeking);
+	};
+
+	const int64 rangeStart = getByteOffset(firstBlock);
+	const int64 rangeEnd = getByteOffset(lastBlock + 1);
+
+	if (rangeEnd <= rangeStart)
+		return false;
+
+	const size_t numBytes = (size_t)(rangeEnd - rangeStart);
+
+	// The buffer only grows, so it is reused for reads of a similar size. The jobs decode from this copy, so the
+	// stream (and the mapping of memory mapped readers) can be used by other threads while they are running.
+	compressedData.ensureSize(numBytes);
+
+	if (auto mis = dynamic_cast<MemoryInputStream*>(input))
+	{
+		if (rangeEnd > (int64)mis->getDataSize())
+			return false;
+
+		memcpy(compressedData.getData(), static_cast<const uint8*>(mis->getData()) + rangeStart, numBytes);
+	}
 	else
 	{
-		HiseSampleBuffer offset(buffer, startOffsetInBuffer);
+		input->setPosition(rangeStart);
+
+		const int numRead = input->read(compressedData.getData(), (int)numBytes);
+
+		if (numRead != (int)numBytes)
+		{
+			decoder.seekToPosition(*input, (uint32)(firstBlock * COMPRESSION_BLOCK_SIZE), (uint32)rangeStart);
+			return false;
+		}
+	}
+
+	const uint8* data = static_cast<const uint8*>(compressedData.getData());
+
+	const int numBlocksPerJob = (numBlocks + numJobs - 1) / numJobs;
+	const int64 endSample = startSampleInFile + numSamples;
+
+	int numJobsThisTime = 0;
+
+	for (int64 jobStartBlock = firstBlock; jobStartBlock <= lastBlock; jobStartBlock += numBlocksPerJob)
+	{
+		const int64 jobEndBlock = jmin<int64>(lastBlock + 1, jobStartBlock + numBlocksPerJob);
+
+		const int64 jobStartSample = jmax<int64>(startSampleInFile, jobStartBlock * COMPRESSION_BLOCK_SIZE);
+		const int64 jobEndSample = jmin<int64>(endSample, jobEndBlock * COMPRESSION_BLOCK_SIZE);
+
+		const int64 jobByteStart = getByteOffset(jobStartBlock);
+		const int64 jobByteEnd = getByteOffset(jobEndBlock);
+
+		decodingJobs[numJobsThisTime++]->prepare(destination, (int)(jobStartSample - startSampleInFile), isStereo,
+												 data + (jobByteStart - rangeStart), (size_t)(jobByteEnd - jobByteStart),
+												 jobStartSample, (int)(jobEndSample - jobStartSample));
+	}
+
+	// Leave the decoder at the end of the range so that the next sequential read doesn't need to seek
+	decoder.seekToPosition(*input, (uint32)((lastBlock + 1) * COMPRESSION_BLOCK_SIZE), (uint32)rangeEnd);
+
+	numPendingDecodingJobs.store(numJobsThisTime);
+	decodingJobsFinished.reset();
+
+	for (int i = 1; i < numJobsThisTime; i++)
+		pool.addJob(decodingJobs[i], false);
+
+	{
+		// The jobs neither use the decoder nor the stream of this reader, so other readers of this file can continue
+		ScopedReadUnlock sul(*this);
+
+		// The reading thread decodes every job that hasn't been picked up by the pool yet instead of waiting for it
+		for (int i = 0; i < numJobsThisTime; i++)
+		{
+			auto job = decodingJobs[i];
+
+			if (job->claim())
+			{
+				if (i != 0)
+					pool.removeJob(job, false, 0);
+
+				job->decode();
+				decodingJobFinished();
+			}
+		}
+
+		while (numPendingDecodingJobs.load() > 0)
+			decodingJobsFinished.wait();
+	}
+
+	return true;
+}
+
+HlacDecodingThreadPool::HlacDecodingThreadPool() :
+	numJobsToUse(jmax<int>(1, SystemStats::getNumCpus()))
+{
+}
+
+ThreadPool& HlacDecodingThreadPool::getPool()
+{
+	ScopedLock sl(poolLock);
+
+	if (pool == nullptr)
+		pool = new ThreadPool(jmax<int>(1, getNumJobsToUse() - 1));
+
+	return *pool;
+}
+
+void HlacDecodingThreadPool::removeJob(ThreadPoolJob* job)
+{
+	ScopedLock sl(poolLock);
+
+	if (pool != nullptr)
+		pool->removeJob(job, false, -1);
+}
+
+bool HlacReaderCommon::cachedFixedBufferRead(HiseSampleBuffer& buffer, int numDestChannels, int startOffsetInBuffer, int64 startSampleInFile, int numSamples)
+{
+	const bool isStereo = numDestChannels == 2;
+	const int numChannelsToRead = isStereo ? 2 : 1;
+
+	while (numSamples > 0)
+	{
+		const uint32 blockIndex = (uint32)(startSampleInFile / COMPRESSION_BLOCK_SIZE);
+		const int offsetInBlock = (int)(startSampleInFile % COMPRESSION_BLOCK_SIZE);
+		const int numThisTime = jmin<int>(numSamples, COMPRESSION_BLOCK_SIZE - offsetInBlock);
+
+		bool isCached = true;
+
+		for (int c = 0; c < numChannelsToRead && isCached; c++)
+		{
+			auto dst = static_cast<int16*>(buffer.getWritePointer(c, startOffsetInBuffer));
+			isCached = blockCache->readBlock(HlacBlockCache::createKey(blockCacheFileId, c, blockIndex), dst, offsetInBlock, numThisTime);
+		}
+
+		if (!isCached)
+		{
+			const int64 blockStart = (int64)blockIndex * COMPRESSION_BLOCK_SIZE;
+
+			// Don't decode past the end of the file (the rest of the block stays silent)
+			const int64 numSamplesInFile = (int64)header.getBlockAmount() * COMPRESSION_BLOCK_SIZE;
+			const int numSamplesToDecode = (int)jlimit<int64>(0, COMPRESSION_BLOCK_SIZE, numSamplesInFile - blockStart);
+
+			blockBuffer.clear();
+
+			if (numSamplesToDecode > 0)
+			{
+				if (blockStart != decoder.getCurrentReadPosition())
+				{
+					auto byteOffset = header.getOffsetForReadPosition(blockStart, useHeaderOffsetWhenSeeking);
+
+					decoder.seekToPosition(*input, (uint32)blockStart, byteOffset);
+				}
+
+				decoder.decode(blockBuffer, isStereo, *input, (int)blockStart, numSamplesToDecode);
+			}
 
-		decoder.decode(offset, isStereo, *input, (int)startSampleInFile, numSamples);
+			for (int c = 0; c < numChannelsToRead; c++)
+			{
+				auto decodedData = static_cast<const int16*>(blockBuffer.getReadPointer(c));
+
+				if (numSamplesToDecode > 0)
+					blockCache->writeBlock(HlacBlockCache::createKey(blockCacheFileId, c, blockIndex), decodedData);
 
+				memcpy(buffer.getWritePointer(c, startOffsetInBuffer), decodedData + offsetInBlock, sizeof(int16) * (size_t)numThisTime);
+			}
+		}
+
+		startSampleInFile += numThisTime;
+		startOffsetInBuffer += numThisTime;
+		numSamples -= numThisTime;
 	}
 
 	return true;
@@ -486,6 +830,60 @@ bool HlacMemoryMappedAudioFormatReader::copyFromMonolith(HiseSampleBuffer& desti
 	return true;
 }
 
+const int16* HlacMemoryMappedAudioFormatReader::getMappedMonolithData(int64 sampleInFile) const noexcept
+{
+	if (isMonolith && map != nullptr && mappedSection.contains(sampleInFile))
+		return static_cast<const int16*>(sampleToPointer(sampleInFile));
+
+	return nullptr;
+}
+
+void HlacMemoryMappedAudioFormatReader::prefetchMonolithData(Range<int64> samplesToPrefetch, bool lockPages) const
+{
+	if (!isMonolith || map == nullptr)
+		return;
+
+	const auto samples = samplesToPrefetch.getIntersectionWith(mappedSection);
+
+	if (samples.isEmpty())
+		return;
+
+#if JUCE_WINDOWS
+	const size_t pageSize = 4096;
+#else
+	static const size_t pageSize = (size_t)jmax<long>(4096, sysconf(_SC_PAGESIZE));
+#endif
+
+	auto start = static_cast<const char*>(sampleToPointer(samples.getStart()));
+	auto pageStart = reinterpret_cast<const char*>((pointer_sized_uint)start & ~(pointer_sized_uint)(pageSize - 1));
+
+	// The first page might start before the mapped region
+	if (pageStart < static_cast<const char*>(map->getData()))
+		pageStart += pageSize;
+
+	const auto end = start + samples.getLength() * bytesPerFrame;
+
+	if (end <= pageStart)
+		return;
+
+	const size_t numBytes = (size_t)(end - pageStart);
+
+#if JUCE_LINUX || JUCE_MAC || JUCE_IOS || JUCE_ANDROID
+	madvise(const_cast<char*>(pageStart), numBytes, MADV_WILLNEED);
+
+	if (lockPages)
+		mlock(pageStart, numBytes);
+#else
+	ignoreUnused(lockPages);
+#endif
+
+	// Reading one byte per page forces the OS to load the page now
+	volatile char sum = 0;
+
+	for (size_t i = 0; i < numBytes; i += pageSize)
+		sum += pageStart[i];
+}
+
 HlacSubSectionReader::HlacSubSectionReader(AudioFormatReader* sourceReader, int64 subsectionStartSample, int64 subsectionLength) :
 	AudioFormatReader(0, sourceReader->getFormatName()),
 	start(subsectionStartSample)
@@ -524,6 +922,8 @@ bool HlacSubSectionReader::readSamples(int** destSamples, int numDestChannels, i
 	clearSamplesBeyondAvailableLength(destSamples, numDestChannels, startOffsetInDestBuffer,
 		startSampleInFile, numSamples, length);
 
+	HlacReaderCommon::ScopedReadLock sl(*internalReader);
+
 	if(memoryReader != nullptr)
 		return memoryReader->readSamples(destSamples, numDestChannels, startOffsetInDestBuffer, startSampleInFile + start, numSamples);
 	else
@@ -535,27 +935,51 @@ void HlacSubSectionReader::readMaxLevels(int64 startSampleInFile, int64 numSampl
 	startSampleInFile = jmax((int64)0, startSampleInFile);
 	numSamples = jmax((int64)0, jmin(numSamples, length - startSampleInFile));
 
+	HlacReaderCommon::ScopedReadLock sl(*internalReader);
+
 	if(memoryReader != nullptr)
 		memoryReader->readMaxLevels(startSampleInFile + start, numSamples, results, numChannelsToRead);
 	else
 		normalReader->readMaxLevels(startSampleInFile + start, numSamples, results, numChannelsToRead);
 }
 
+const int16* HlacSubSectionReader::getMappedData(int64 readerStartSample) const noexcept
+{
+	if (isMonolith && memoryReader != nullptr && readerStartSample >= 0 && readerStartSample < length)
+		return memoryReader->getMappedMonolithData(start + readerStartSample);
+
+	return nullptr;
+}
+
+void HlacSubSectionReader::prefetch(int64 readerStartSample, int numSamples, bool lockPages) const
+{
+	if (isMonolith && memoryReader != nullptr)
+	{
+		const auto samples = Range<int64>(readerStartSample, readerStartSample + numSamples).getIntersectionWith({ 0, length });
+
+		memoryReader->prefetchMonolithData(samples + start, lockPages);
+	}
+}
+
 void HlacSubSectionReader::readIntoFixedBuffer(HiseSampleBuffer& buffer, int startSample, int numSamples, int64 readerStartSample)
 {
 	if (isMonolith)
 	{
 		if (memoryReader != nullptr)
 		{
+			// The mapped data can be read from multiple threads at once
 			memoryReader->copyFromMonolith(buffer, startSample, buffer.getNumChannels(), start + readerStartSample, numChannels, numSamples);
 		}
 		else
 		{
+			HlacReaderCommon::ScopedReadLock sl(*internalReader);
 			normalReader->copyFromMonolith(buffer, startSample, buffer.getNumChannels(), start + readerStartSample, numChannels, numSamples);
 		}
 	}
 	else
 	{
+		HlacReaderCommon::ScopedReadLock sl(*internalReader);
+
 		internalReader->fixedBufferRead(buffer, numChannels, startSample, start + readerStartSample, numSamples);
 
 		if (buffer.getNumChannels() == 2 && numChannels == 1)
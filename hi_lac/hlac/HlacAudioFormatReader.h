@@ -74,23 +74,67 @@ private:
 	uint32 headerSize;
 };
 
+/** A thread pool that decodes the blocks of large reads in parallel.
+*
+*	It is shared by all readers and the threads will be created when it is used for the first time.
+*/
+class HlacDecodingThreadPool
+{
+public:
+
+	HlacDecodingThreadPool();
+
+	/** Returns the number of jobs that a read will be split into at most (including the calling thread). */
+	int getNumJobsToUse() const { return numJobsToUse.get(); }
+
+	/** Changes the maximum number of jobs per read. The default is the number of CPU cores. */
+	void setNumJobsToUse(int newNumJobs) { numJobsToUse.set(jmax<int>(1, newNumJobs)); }
+
+	ThreadPool& getPool();
+
+	/** Removes the job from the pool and waits until it has finished (if it is running). */
+	void removeJob(ThreadPoolJob* job);
+
+private:
+
+	Atomic<int> numJobsToUse;
+
+	CriticalSection poolLock;
+	ScopedPointer<ThreadPool> pool;
+};
+
 class HlacReaderCommon
 {
 public:
 
-	HlacReaderCommon(InputStream* input_):
-		input(input_),
-		header(input)
-	{
-		decoder.setupForDecompression();
-	}
+	HlacReaderCommon(InputStream* input_);
+
+	HlacReaderCommon(const File& f);
 
-	HlacReaderCommon(const File& f) :
-		input(nullptr),
-		header(f)
+	~HlacReaderCommon();
+
+	/** Locks the decoder and the stream of this reader. Use this whenever multiple readers share this object. */
+	class ScopedReadLock
 	{
-		decoder.setupForDecompression();
-	}
+	public:
+
+		ScopedReadLock(HlacReaderCommon& r) :
+			reader(r)
+		{
+			reader.readLock.enter();
+			++reader.readLockDepth;
+		}
+
+		~ScopedReadLock()
+		{
+			--reader.readLockDepth;
+			reader.readLock.exit();
+		}
+
+	private:
+
+		HlacReaderCommon& reader;
+	};
 
 	/** You can choose what the target data type should be. If you read into integer AudioSampleBuffers, you might want to call this method
 	*	in order to save unnecessary conversions between float and integer numbers. */
@@ -102,14 +146,64 @@ public:
 		useHeaderOffsetWhenSeeking = shouldUseHeaderOffset;
 	};
 
+	/** Uses the given cache for decoded blocks. The file ID must be the same for all readers of one file (see HlacBlockCache::createFileId()). */
+	void setBlockCache(HlacBlockCache* newCache, uint32 fileId);
+
+	/** If enabled, large reads will be split at block boundaries and decoded on multiple threads.
+	*
+	*	This creates the decoders for the jobs, so a read doesn't have to allocate anything.
+	*/
+	void setUseParallelDecoding(bool shouldDecodeInParallel);
+
 private:
 
+	class DecodingJob;
+
 	friend class HlacSubSectionReader;
 
 	bool internalHlacRead(int** destSamples, int numDestChannels, int startOffsetInDestBuffer, int64 startSampleInFile, int numSamples);
 
 	bool fixedBufferRead(HiseSampleBuffer& buffer, int numDestChannels, int startOffsetInBuffer, int64 startSampleInFile, int numSamples);
 
+	/** Reads the samples block by block and only decodes the blocks that are not in the cache. */
+	bool cachedFixedBufferRead(HiseSampleBuffer& buffer, int numDestChannels, int startOffsetInBuffer, int64 startSampleInFile, int numSamples);
+
+	/** Seeks if necessary and decodes the given range (in parallel if it's big enough). */
+	void decodeRange(HiseSampleBuffer& destination, bool isStereo, int64 startSampleInFile, int numSamples);
+
+	/** Decodes the range with multiple decoders using the block offsets from the header. Returns false if the range is too small. */
+	bool parallelDecode(HiseSampleBuffer& destination, bool isStereo, int64 startSampleInFile, int numSamples);
+
+	/** Releases the read lock while the decoding jobs are running and acquires it again afterwards. */
+	class ScopedReadUnlock
+	{
+	public:
+
+		ScopedReadUnlock(HlacReaderCommon& r) :
+			reader(r),
+			depth(r.readLockDepth)
+		{
+			reader.readLockDepth = 0;
+
+			for (int i = 0; i < depth; i++)
+				reader.readLock.exit();
+		}
+
+		~ScopedReadUnlock()
+		{
+			for (int i = 0; i < depth; i++)
+				reader.readLock.enter();
+
+			reader.readLockDepth = depth;
+		}
+
+	private:
+
+		HlacReaderCommon& reader;
+		const int depth;
+	};
+
+	void decodingJobFinished();
 	
 
 	friend class HiseLosslessAudioFormatReader;
@@ -124,6 +218,31 @@ private:
 
 	bool useHeaderOffsetWhenSeeking = true;
 
+	HlacBlockCache::Ptr blockCache;
+	uint32 blockCacheFileId = 0;
+
+	bool useParallelDecoding = false;
+	SharedResourcePointer<HlacDecodingThreadPool> decodingThreadPool;
+
+	// The decoders of the parallel jobs and a buffer for the compressed data they read. They are reused for every read
+	// and can only be used by one thread at a time.
+	OwnedArray<DecodingJob> decodingJobs;
+	MemoryBlock compressedData;
+	CriticalSection parallelDecodingLock;
+
+	std::atomic<int> numPendingDecodingJobs { 0 };
+	WaitableEvent decodingJobsFinished;
+
+	// a decoded block that is written to the cache
+	HiseSampleBuffer blockBuffer;
+
+	// The decoder, the block buffer and the stream position are shared by all subsection readers of a 
+	// monolith, which can be used by multiple streaming threads at once
+	CriticalSection readLock;
+
+	// how often the thread that holds the read lock has entered it
+	int readLockDepth = 0;
+
 };
 
 class HiseLosslessAudioFormatReader : public AudioFormatReader
@@ -137,6 +256,12 @@ public:
 
 	void setTargetAudioDataType(AudioDataConverters::DataFormat dataType);
 
+	/** Uses the given cache for decoded blocks (see HlacReaderCommon::setBlockCache()). */
+	void setBlockCache(HlacBlockCache* newCache, uint32 fileId) { internalReader.setBlockCache(newCache, fileId); }
+
+	/** Enables the parallel decoding of large reads (see HlacReaderCommon::setUseParallelDecoding()). */
+	void setUseParallelDecoding(bool shouldDecodeInParallel) { internalReader.setUseParallelDecoding(shouldDecodeInParallel); }
+
 private:
 
 	friend class HlacSubSectionReader;
@@ -184,6 +309,26 @@ public:
 
 	void setTargetAudioDataType(AudioDataConverters::DataFormat dataType);
 
+	/** Uses the given cache for decoded blocks (see HlacReaderCommon::setBlockCache()). */
+	void setBlockCache(HlacBlockCache* newCache, uint32 fileId) { internalReader.setBlockCache(newCache, fileId); }
+
+	/** Enables the parallel decoding of large reads (see HlacReaderCommon::setUseParallelDecoding()). */
+	void setUseParallelDecoding(bool shouldDecodeInParallel) { internalReader.setUseParallelDecoding(shouldDecodeInParallel); }
+
+	/** Returns a pointer to the mapped sample data at the given position.
+	*
+	*	This only works with uncompressed monoliths (the samples are stored as interleaved 16 bit integers).
+	*	For compressed files or if the position is not mapped, it will return nullptr.
+	*/
+	const int16* getMappedMonolithData(int64 sampleInFile) const noexcept;
+
+	/** Tells the OS that the given range will be needed soon and touches every page so that the page faults happen on the calling thread.
+	*
+	*	If lockPages is true, the pages will also be locked in physical memory until the file is unmapped (this might fail
+	*	silently if the process exceeds its limit for locked memory).
+	*/
+	void prefetchMonolithData(Range<int64> samplesToPrefetch, bool lockPages) const;
+
 private:
 	
 	friend class HlacSubSectionReader;
@@ -211,6 +356,12 @@ public:
 
 	void readIntoFixedBuffer(HiseSampleBuffer& buffer, int startSample, int numSamples, int64 readerStartSample);
 
+	/** Returns a pointer to the mapped data of an uncompressed monolith or nullptr if the data can't be accessed directly. */
+	const int16* getMappedData(int64 readerStartSample) const noexcept;
+
+	/** Prefetches the given range of a memory mapped monolith. This does nothing if the data is not memory mapped. */
+	void prefetch(int64 readerStartSample, int numSamples, bool lockPages) const;
+
 private:
 
 	bool isMonolith = false;
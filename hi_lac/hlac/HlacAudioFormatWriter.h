@@ -54,6 +54,13 @@ public:
 
 	void setOptions(HlacEncoder::CompressorOptions& newOptions);
 
+	/** Enables the parallel compression of large buffers (see HlacEncoder::setUseParallelEncoding()).
+	*
+	*	Use writeFromAudioSampleBuffer() with large buffers to make use of this, because writeFromAudioReader() only passes
+	*	a few blocks at once to the encoder.
+	*/
+	void setUseParallelEncoding(bool shouldEncodeInParallel) { encoder.setUseParallelEncoding(shouldEncodeInParallel); }
+
 	bool write(const int** samplesToWrite, int numSamples) override;
 
 	double getCompressionRatioForLastFile() { return encoder.getCompressionRatio(); }
@@ -0,0 +1,206 @@
+/*  HISE Lossless Audio Codec
+*	�2017 Christoph Hart
+*
+*	Redistribution and use in source and binary forms, with or without modification,
+*	are permitted provided that the following conditions are met:
+*
+*	1. Redistributions of source code must retain the above copyright notice,
+*	   this list of conditions and the following disclaimer.
+*
+*	2. Redistributions in binary form must reproduce the above copyright notice,
+*	   this list of conditions and the following disclaimer in the documentation
+*	   and/or other materials provided with the distribution.
+*
+*	3. All advertising materials mentioning features or use of this software must
+*	   display the following acknowledgement:
+*	   This product includes software developed by Hart Instruments
+*
+*	4. Neither the name of the copyright holder nor the names of its contributors may be used
+*	   to endorse or promote products derived from this software without specific prior written permission.
+*
+*	THIS SOFTWARE IS PROVIDED BY CHRISTOPH HART "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+*	BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*	DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+*	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+*	GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+*	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+*	ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+*/
+
+namespace hlac { using namespace juce; 
+
+HlacBlockCache::HlacBlockCache(size_t maxMemoryInBytes)
+{
+	allocate(maxMemoryInBytes);
+}
+
+HlacBlockCache::~HlacBlockCache()
+{
+	jassert(numPendingAccesses.load() == 0);
+}
+
+bool HlacBlockCache::readBlock(uint64 key, int16* destination, int offsetInBlock, int numSamples) noexcept
+{
+	jassert(offsetInBlock >= 0 && offsetInBlock + numSamples <= COMPRESSION_BLOCK_SIZE);
+
+	if (!beginAccess())
+		return false;
+
+	auto set = getSet(key);
+
+	for (int i = 0; i < NumWays; i++)
+	{
+		auto& slot = set[i];
+
+		const uint32 versionBefore = slot.version.load(std::memory_order_acquire);
+
+		if ((versionBefore & 1) != 0 || slot.key.load(std::memory_order_acquire) != key)
+			continue;
+
+		memcpy(destination, getData(&slot) + offsetInBlock, sizeof(int16) * (size_t)numSamples);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		// The slot was overwritten while copying
+		if (slot.version.load(std::memory_order_relaxed) != versionBefore)
+			break;
+
+		slot.lastAccess.store(++accessCounter, std::memory_order_relaxed);
+
+		++numHits;
+		endAccess();
+		return true;
+	}
+
+	++numMisses;
+	endAccess();
+	return false;
+}
+
+void HlacBlockCache::writeBlock(uint64 key, const int16* source) noexcept
+{
+	if (!beginAccess())
+		return;
+
+	auto set = getSet(key);
+
+	Slot* victim = nullptr;
+	uint32 maxAge = 0;
+	const uint32 now = accessCounter.load(std::memory_order_relaxed);
+
+	for (int i = 0; i < NumWays; i++)
+	{
+		auto& slot = set[i];
+		const uint64 slotKey = slot.key.load(std::memory_order_relaxed);
+
+		// Another reader has already stored this block
+		if (slotKey == key)
+		{
+			endAccess();
+			return;
+		}
+
+		if ((slot.version.load(std::memory_order_relaxed) & 1) != 0)
+			continue;
+
+		// The age is measured relative to the current counter value so that a wrap around doesn't matter
+		const uint32 age = slotKey == 0 ? std::numeric_limits<uint32>::max() : now - slot.lastAccess.load(std::memory_order_relaxed);
+
+		if (victim == nullptr || age > maxAge)
+		{
+			victim = &slot;
+			maxAge = age;
+		}
+	}
+
+	if (victim != nullptr)
+	{
+		uint32 version = victim->version.load(std::memory_order_relaxed);
+
+		// If another thread grabs this slot at the same time, we just skip storing the block
+		if ((version & 1) == 0 && victim->version.compare_exchange_strong(version, version + 1, std::memory_order_acq_rel))
+		{
+			const bool wasEmpty = victim->key.exchange(key, std::memory_order_relaxed) == 0;
+
+			memcpy(getData(victim), source, BlockSizeInBytes);
+
+			victim->lastAccess.store(++accessCounter, std::memory_order_relaxed);
+			victim->version.store(version + 2, std::memory_order_release);
+
+			if (wasEmpty)
+				++numUsedSlots;
+		}
+	}
+
+	endAccess();
+}
+
+void HlacBlockCache::setMemoryLimit(size_t maxMemoryInBytes)
+{
+	resizing.store(true);
+
+	while (numPendingAccesses.load() != 0)
+		Thread::yield();
+
+	allocate(maxMemoryInBytes);
+
+	resizing.store(false);
+}
+
+double HlacBlockCache::getHitRate() const noexcept
+{
+	const double hits = (double)numHits.load();
+	const double total = hits + (double)numMisses.load();
+
+	return total > 0.0 ? hits / total : 0.0;
+}
+
+void HlacBlockCache::resetStatistics() noexcept
+{
+	numHits.store(0);
+	numMisses.store(0);
+}
+
+void HlacBlockCache::clear()
+{
+	setMemoryLimit(getMemoryLimit());
+}
+
+bool HlacBlockCache::beginAccess() noexcept
+{
+	++numPendingAccesses;
+
+	if (resizing.load() || numSets == 0)
+	{
+		--numPendingAccesses;
+		return false;
+	}
+
+	return true;
+}
+
+HlacBlockCache::Slot* HlacBlockCache::getSet(uint64 key) const noexcept
+{
+	// Fibonacci hashing spreads the consecutive block indexes over all sets
+	const uint64 hash = key * 0x9E3779B97F4A7C15ULL;
+	const int setIndex = (int)((hash >> 32) % (uint64)numSets);
+
+	return slots.get() + setIndex * NumWays;
+}
+
+void HlacBlockCache::allocate(size_t maxMemoryInBytes)
+{
+	numSets = (int)(maxMemoryInBytes / (size_t)(BlockSizeInBytes * NumWays));
+	numSlots = numSets * NumWays;
+
+	slots.reset(numSlots > 0 ? new Slot[numSlots] : nullptr);
+	data.free();
+
+	if (numSlots > 0)
+		data.malloc((size_t)numSlots * COMPRESSION_BLOCK_SIZE);
+
+	numUsedSlots.store(0);
+}
+
+} // namespace hlac
@@ -0,0 +1,147 @@
+/*  HISE Lossless Audio Codec
+*	�2017 Christoph Hart
+*
+*	Redistribution and use in source and binary forms, with or without modification,
+*	are permitted provided that the following conditions are met:
+*
+*	1. Redistributions of source code must retain the above copyright notice,
+*	   this list of conditions and the following disclaimer.
+*
+*	2. Redistributions in binary form must reproduce the above copyright notice,
+*	   this list of conditions and the following disclaimer in the documentation
+*	   and/or other materials provided with the distribution.
+*
+*	3. All advertising materials mentioning features or use of this software must
+*	   display the following acknowledgement:
+*	   This product includes software developed by Hart Instruments
+*
+*	4. Neither the name of the copyright holder nor the names of its contributors may be used
+*	   to endorse or promote products derived from this software without specific prior written permission.
+*
+*	THIS SOFTWARE IS PROVIDED BY CHRISTOPH HART "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+*	BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*	DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDER BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+*	SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+*	GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+*	THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+*	ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+*/
+
+#ifndef HLACBLOCKCACHE_H_INCLUDED
+#define HLACBLOCKCACHE_H_INCLUDED
+
+namespace hlac { using namespace juce; 
+
+/** A bounded cache for decoded HLAC blocks that can be shared between multiple readers.
+*
+*	If multiple voices stream the same compressed sample, every one of them would decode the same blocks again.
+*	With this cache, the first reader stores the decoded block and all others just copy it.
+*
+*	The cache is a set associative table with a fixed amount of slots (defined by the memory limit). Each block is
+*	identified by a key that contains the file, the channel and the block index. If a set is full, the least recently used
+*	slot will be replaced.
+*
+*	Reading and writing is lock-free (every slot is protected by a sequence counter), so it can be used by multiple streaming
+*	threads at the same time. A reader that races with a writer will just see a cache miss.
+*/
+class HlacBlockCache : public ReferenceCountedObject
+{
+public:
+
+	typedef ReferenceCountedObjectPtr<HlacBlockCache> Ptr;
+
+	/** Creates a cache that uses the given amount of memory for the decoded data. */
+	HlacBlockCache(size_t maxMemoryInBytes = HLAC_DEFAULT_BLOCK_CACHE_SIZE);
+
+	~HlacBlockCache();
+
+	/** Returns a new ID for a file that uses this cache. */
+	uint32 createFileId() noexcept { return ++fileIdCounter; }
+
+	/** Creates the key for the given block. The file ID must be created with createFileId(). */
+	static uint64 createKey(uint32 fileId, int channelIndex, uint32 blockIndex) noexcept
+	{
+		jassert(fileId != 0);
+
+		return ((uint64)fileId << 33) | ((uint64)(channelIndex & 1) << 32) | (uint64)blockIndex;
+	}
+
+	/** Copies the samples from the cached block to the destination and returns false if the block is not in the cache. */
+	bool readBlock(uint64 key, int16* destination, int offsetInBlock, int numSamples) noexcept;
+
+	/** Stores a decoded block (it must contain COMPRESSION_BLOCK_SIZE samples). If the cache is being resized, it does nothing. */
+	void writeBlock(uint64 key, const int16* source) noexcept;
+
+	/** Changes the maximum amount of memory and clears the cache. 
+	*
+	*	This waits until all pending read and write operations are finished, so don't call it from the audio thread.
+	*	If the limit is zero, the cache will be disabled.
+	*/
+	void setMemoryLimit(size_t maxMemoryInBytes);
+
+	/** Returns the maximum amount of memory that is used for the decoded data. */
+	size_t getMemoryLimit() const noexcept { return (size_t)numSlots * BlockSizeInBytes; }
+
+	/** Returns the amount of memory that is occupied by cached blocks. */
+	size_t getMemoryUsage() const noexcept { return (size_t)numUsedSlots.load() * BlockSizeInBytes; }
+
+	/** Returns the ratio of successful reads since the last call to resetStatistics(). */
+	double getHitRate() const noexcept;
+
+	int64 getNumHits() const noexcept { return numHits.load(); }
+	int64 getNumMisses() const noexcept { return numMisses.load(); }
+
+	/** Resets the hit and miss counters. */
+	void resetStatistics() noexcept;
+
+	/** Removes all blocks from the cache. */
+	void clear();
+
+private:
+
+	enum
+	{
+		NumWays = 8,
+		BlockSizeInBytes = COMPRESSION_BLOCK_SIZE * sizeof(int16)
+	};
+
+	struct Slot
+	{
+		// odd while the slot is being written
+		std::atomic<uint32> version { 0 };
+		std::atomic<uint64> key { 0 };
+		std::atomic<uint32> lastAccess { 0 };
+	};
+
+	/** Registers a pending operation and returns false if the cache is being resized. */
+	bool beginAccess() noexcept;
+	void endAccess() noexcept { --numPendingAccesses; }
+
+	Slot* getSet(uint64 key) const noexcept;
+	int16* getData(const Slot* slot) const noexcept { return data + (slot - slots.get()) * COMPRESSION_BLOCK_SIZE; }
+
+	void allocate(size_t maxMemoryInBytes);
+
+	std::unique_ptr<Slot[]> slots;
+	HeapBlock<int16> data;
+
+	int numSlots = 0;
+	int numSets = 0;
+
+	std::atomic<uint32> fileIdCounter { 0 };
+	std::atomic<uint32> accessCounter { 0 };
+	std::atomic<int> numUsedSlots { 0 };
+
+	std::atomic<int> numPendingAccesses { 0 };
+	std::atomic<bool> resizing { false };
+
+	std::atomic<int64> numHits { 0 };
+	std::atomic<int64> numMisses { 0 };
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HlacBlockCache)
+};
+
+} // namespace hlac
+
+#endif  // HLACBLOCKCACHE_H_INCLUDED
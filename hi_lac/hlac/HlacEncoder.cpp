@@ -39,15 +39,7 @@ void HlacEncoder::compress(AudioSampleBuffer& source, OutputStream& output, uint
 		blockOffsetData[blockIndex] = numBytesWritten;
 		++blockIndex;
 
-		if (compressStereo)
-		{
-			auto l = CompressionHelpers::getPart(source, 0, 0, COMPRESSION_BLOCK_SIZE);
-			encodeBlock(l, output);
-			auto r = CompressionHelpers::getPart(source, 1, 0, COMPRESSION_BLOCK_SIZE);
-			encodeBlock(r, output);
-		}
-		else
-			encodeBlock(source, output);
+		compressFullBlock(source, 0, output);
 
 		return;
 	}
@@ -55,30 +47,24 @@ void HlacEncoder::compress(AudioSampleBuffer& source, OutputStream& output, uint
 	blockOffset = 0;
 	int32 numSamplesRemaining = source.getNumSamples();
 
+	const int numFullBlocks = numSamplesRemaining / COMPRESSION_BLOCK_SIZE;
+
+	if (useParallelEncoding && parallelCompress(source, output, blockOffsetData, numFullBlocks))
+	{
+		blockOffset = numFullBlocks * COMPRESSION_BLOCK_SIZE;
+		numSamplesRemaining -= (int32)blockOffset;
+	}
+
 	while (numSamplesRemaining >= COMPRESSION_BLOCK_SIZE)
 	{
 		blockOffsetData[blockIndex] = numBytesWritten;
 		++blockIndex;
 
-		uint32 numTodo = jmin<int>(COMPRESSION_BLOCK_SIZE, source.getNumSamples());
-
-		if (compressStereo)
-		{
-			auto l = CompressionHelpers::getPart(source, 0, blockOffset, numTodo);
-			encodeBlock(l, output);
-			auto r = CompressionHelpers::getPart(source, 1, blockOffset, numTodo);
-			encodeBlock(r, output);
-		}
-		else
-		{
-			auto b = CompressionHelpers::getPart(source, blockOffset, numTodo);
-			encodeBlock(b, output);
-		}
-
+		compressFullBlock(source, blockOffset, output);
 
-		blockOffset += numTodo;
+		blockOffset += COMPRESSION_BLOCK_SIZE;
 
-		numSamplesRemaining -= numTodo;
+		numSamplesRemaining -= COMPRESSION_BLOCK_SIZE;
 	}
 
 	if (source.getNumSamples() - blockOffset > 0)
@@ -106,6 +92,124 @@ void HlacEncoder::compress(AudioSampleBuffer& source, OutputStream& output, uint
 	
 }
 
+void HlacEncoder::compressFullBlock(AudioSampleBuffer& source, int offset, OutputStream& output)
+{
+	if (source.getNumChannels() == 2)
+	{
+		auto l = CompressionHelpers::getPart(source, 0, offset, COMPRESSION_BLOCK_SIZE);
+		encodeBlock(l, output);
+		auto r = CompressionHelpers::getPart(source, 1, offset, COMPRESSION_BLOCK_SIZE);
+		encodeBlock(r, output);
+	}
+	else
+	{
+		auto b = CompressionHelpers::getPart(source, offset, COMPRESSION_BLOCK_SIZE);
+		encodeBlock(b, output);
+	}
+}
+
+class HlacEncoder::EncodingJob : public ThreadPoolJob
+{
+public:
+
+	EncodingJob(AudioSampleBuffer& source_, CompressorOptions options, int firstBlock_, int numBlocks_) :
+		ThreadPoolJob("HLAC Encoding"),
+		source(source_),
+		firstBlock(firstBlock_),
+		numBlocks(numBlocks_)
+	{
+		encoder.setOptions(options);
+		encoder.setUseParallelEncoding(false);
+	}
+
+	JobStatus runJob() override
+	{
+		encode();
+		return jobHasFinished;
+	}
+
+	void encode()
+	{
+		for (int i = 0; i < numBlocks; i++)
+		{
+			// The offsets are relative to the start of this job's output
+			blockOffsets.add(encoder.numBytesWritten);
+
+			encoder.compressFullBlock(source, (firstBlock + i) * COMPRESSION_BLOCK_SIZE, output);
+		}
+	}
+
+	HlacEncoder encoder;
+	MemoryOutputStream output;
+	Array<uint32> blockOffsets;
+
+private:
+
+	AudioSampleBuffer& source;
+
+	const int firstBlock;
+	const int numBlocks;
+};
+
+bool HlacEncoder::parallelCompress(AudioSampleBuffer& source, OutputStream& output, uint32* blockOffsetData, int numFullBlocks)
+{
+	const int numJobs = jmin<int>(encodingThreadPool->getNumJobsToUse(), numFullBlocks / HLAC_MIN_BLOCKS_PER_ENCODING_JOB);
+
+	if (numJobs < 2)
+		return false;
+
+	const int numBlocksPerJob = (numFullBlocks + numJobs - 1) / numJobs;
+
+	OwnedArray<EncodingJob> jobs;
+
+	for (int firstBlock = 0; firstBlock < numFullBlocks; firstBlock += numBlocksPerJob)
+		jobs.add(new EncodingJob(source, options, firstBlock, jmin<int>(numBlocksPerJob, numFullBlocks - firstBlock)));
+
+	auto& pool = encodingThreadPool->getPool();
+
+	for (int i = 1; i < jobs.size(); i++)
+		pool.addJob(jobs[i], false);
+
+	jobs[0]->encode();
+
+	for (int i = 1; i < jobs.size(); i++)
+		pool.waitForJobToFinish(jobs[i], -1);
+
+	// Write the blocks in order and shift the job offsets to the position in the stream
+	for (auto job : jobs)
+	{
+		for (auto offset : job->blockOffsets)
+		{
+			blockOffsetData[blockIndex] = numBytesWritten + offset;
+			++blockIndex;
+		}
+
+		output.write(job->output.getData(), job->output.getDataSize());
+
+		numBytesWritten += job->encoder.numBytesWritten;
+		numBytesUncompressed += job->encoder.numBytesUncompressed;
+		numTemplates += job->encoder.numTemplates;
+		numDeltas += job->encoder.numDeltas;
+	}
+
+	return true;
+}
+
+HlacEncodingThreadPool::HlacEncodingThreadPool() :
+	numJobsToUse(jmax<int>(1, SystemStats::getNumCpus()))
+{
+}
+
+ThreadPool& HlacEncodingThreadPool::getPool()
+{
+	ScopedLock sl(poolLock);
+
+	if (pool == nullptr)
+		pool = new ThreadPool(jmax<int>(1, getNumJobsToUse() - 1));
+
+	return *pool;
+}
+
 void HlacEncoder::reset()
 {
 	indexInBlock = 0;
@@ -423,7 +527,7 @@ bool HlacEncoder::encodeDiff(CompressionHelpers::AudioBufferInt16& cycle, Output
 	if (numBytesForFull > 0)
 	{
 		MemoryBlock mbFull;
-		mbFull.setSize(numBytesForFull);
+		mbFull.setSize(numBytesForFull, true);
 		compressorFull->compress((uint8*)mbFull.getData(), packedBuffer.getReadPointer(), numFullValues);
 
 		if (!output.write(mbFull.getData(), numBytesForFull))
@@ -435,7 +539,7 @@ bool HlacEncoder::encodeDiff(CompressionHelpers::AudioBufferInt16& cycle, Output
 	if (numBytesForError > 0)
 	{
 		MemoryBlock mbError;
-		mbError.setSize(numBytesForError);
+		mbError.setSize(numBytesForError, true);
 		compressorError->compress((uint8*)mbError.getData(), packedErrorBuffer.getReadPointer(), numErrorValues);
 
 		
@@ -34,6 +34,32 @@
 
 namespace hlac { using namespace juce; 
 
+/** A thread pool that compresses the blocks of large buffers in parallel.
+*
+*	It is shared by all encoders and the threads will be created when it is used for the first time.
+*/
+class HlacEncodingThreadPool
+{
+public:
+
+	HlacEncodingThreadPool();
+
+	/** Returns the number of jobs that a buffer will be split into at most (including the calling thread). */
+	int getNumJobsToUse() const { return numJobsToUse.get(); }
+
+	/** Changes the maximum number of jobs per buffer. The default is the number of CPU cores. */
+	void setNumJobsToUse(int newNumJobs) { numJobsToUse.set(jmax<int>(1, newNumJobs)); }
+
+	ThreadPool& getPool();
+
+private:
+
+	Atomic<int> numJobsToUse;
+
+	CriticalSection poolLock;
+	ScopedPointer<ThreadPool> pool;
+};
+
 class HlacEncoder
 {
 public:
@@ -155,12 +181,26 @@ public:
 		options = newOptions;
 	}
 
+	/** If enabled, the full blocks of large buffers will be compressed on multiple threads.
+	*
+	*	The blocks are independent, so the output (and the block offset table) is the same as
+	*	with the serial encoder except for the random checksum bytes at the start of each block.
+	*/
+	void setUseParallelEncoding(bool shouldEncodeInParallel) { useParallelEncoding = shouldEncodeInParallel; }
+
 	float getCompressionRatio() const;
 
 	uint32 getNumBlocksWritten() const { return blockIndex; }
 
 private:
 
+	class EncodingJob;
+
+	/** Compresses the given amount of full blocks with multiple encoders and writes them in order. Returns false if there are not enough blocks. */
+	bool parallelCompress(AudioSampleBuffer& source, OutputStream& output, uint32* blockOffsetData, int numFullBlocks);
+
+	void compressFullBlock(AudioSampleBuffer& source, int offset, OutputStream& output);
+
 	bool encodeBlock(AudioSampleBuffer& block, OutputStream& output);
 
 	bool encodeBlock(CompressionHelpers::AudioBufferInt16& block, OutputStream& output);
@@ -215,7 +255,9 @@ private:
 
 	CompressorOptions options;
 
-	
+	bool useParallelEncoding = HLAC_USE_PARALLEL_ENCODING;
+	SharedResourcePointer<HlacEncodingThreadPool> encodingThreadPool;
+
 
 	float ratio = 0.0f;
 
@@ -52,6 +52,28 @@ HiseSampleBuffer::HiseSampleBuffer(HiseSampleBuffer& otherBuffer, int offset)
 	}
 }
 
+HiseSampleBuffer::HiseSampleBuffer(HiseSampleBuffer& otherBuffer, int offset, int numSamples) :
+	numChannels(otherBuffer.numChannels),
+	size(numSamples),
+	isFloat(otherBuffer.isFloat),
+	leftIntBuffer(0),
+	rightIntBuffer(0)
+{
+	jassert(offset + numSamples <= otherBuffer.getNumSamples());
+
+	if (isFloat)
+	{
+		floatBuffer = AudioSampleBuffer(otherBuffer.floatBuffer.getArrayOfWritePointers(), otherBuffer.floatBuffer.getNumChannels(), offset, numSamples);
+	}
+	else
+	{
+		leftIntBuffer = hlac::CompressionHelpers::getPart(otherBuffer.leftIntBuffer, offset, numSamples);
+
+		if (numChannels > 1)
+			rightIntBuffer = hlac::CompressionHelpers::getPart(otherBuffer.rightIntBuffer, offset, numSamples);
+	}
+}
+
 void HiseSampleBuffer::reverse(int startSample, int numSamples)
 {
 	if (isFloatingPoint())
@@ -101,6 +101,9 @@ public:
 
 	HiseSampleBuffer(HiseSampleBuffer& otherBuffer, int offset);
 
+	/** Creates a buffer that refers to a part of the other buffer. */
+	HiseSampleBuffer(HiseSampleBuffer& otherBuffer, int offset, int numSamples);
+
 	/** Creates a HiseSampleBuffer from an existing AudioSampleBuffer. */
 	HiseSampleBuffer(AudioSampleBuffer& floatBuffer_):
 		isFloat(true),
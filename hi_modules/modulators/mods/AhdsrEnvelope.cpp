@@ -184,7 +184,7 @@ void AhdsrEnvelope::startVoice(int voiceIndex)
 {
 	if (isMonophonic)
 	{
-		state = static_cast<AhdsrEnvelopeState*>(monophonicState.get());
+		auto state = static_cast<AhdsrEnvelopeState*>(monophonicState.get());
 
 		EnvelopeModulator::startVoice(voiceIndex);
 
@@ -219,7 +219,7 @@ void AhdsrEnvelope::startVoice(int voiceIndex)
 	}
 	else
 	{
-		state = static_cast<AhdsrEnvelopeState*>(states[voiceIndex]);
+		auto state = static_cast<AhdsrEnvelopeState*>(states[voiceIndex]);
 
 		if (state->current_state != AhdsrEnvelopeState::IDLE)
 		{
@@ -264,20 +264,129 @@ void AhdsrEnvelope::stopVoice(int voiceIndex)
 	}
 }
 
+bool AhdsrEnvelope::getConstantValueForNextBlock(int voiceIndex, float& value)
+{
+	if (isMonophonic)
+		return false;
+
+	auto thisState = static_cast<AhdsrEnvelopeState*>(states[voiceIndex]);
+
+	if (thisState->current_state != AhdsrEnvelopeState::SUSTAIN)
+		return false;
+
+	const float thisSustainValue = sustain * thisState->modValues[SustainLevelChain];
+
+	// A changed sustain level is ramped in calculateBlock()
+	if (std::abs(thisSustainValue - thisState->lastSustainValue) > 0.001f)
+		return false;
+
+	thisState->lastSustainValue = thisSustainValue;
+	thisState->current_value = thisSustainValue;
+
+	value = thisSustainValue;
+	return true;
+}
+
+void AhdsrEnvelope::calculateVoiceBlocks(const int* voiceIndexes, int numVoices, int startSample, int numSamples)
+{
+	if (isMonophonic || ecoMode)
+		return;
+
+	lanes.clear();
+
+	for (int i = 0; i < numVoices; i++)
+	{
+		const int voiceIndex = voiceIndexes[i];
+		auto thisState = static_cast<AhdsrEnvelopeState*>(states[voiceIndex]);
+		float* row = getVoiceBlockWritePointer(voiceIndex, startSample);
+
+		const float thisSustain = sustain * thisState->modValues[SustainLevelChain];
+		const float value = thisState->current_value;
+
+		switch (thisState->current_state)
+		{
+		case AhdsrEnvelopeState::ATTACK:
+		{
+			if (attack == 0.0f)
+				continue;
+
+			const float target = thisState->attackLevel > thisSustain ? thisState->attackLevel : thisSustain;
+			lanes.add(voiceIndex, AhdsrEnvelopeState::ATTACK, value, thisState->attackBase, thisState->attackCoef, target, row);
+			break;
+		}
+		case AhdsrEnvelopeState::DECAY:
+			if (decay == 0.0f)
+				continue;
+
+			lanes.add(voiceIndex, AhdsrEnvelopeState::DECAY, value, thisState->decayBase, thisState->decayCoef, thisSustain, row);
+			break;
+		case AhdsrEnvelopeState::RELEASE:
+			if (release == 0.0f)
+				continue;
+
+			lanes.add(voiceIndex, AhdsrEnvelopeState::RELEASE, value, thisState->releaseBase, thisState->releaseCoef, 0.001f, row);
+			break;
+		default:
+			// The other states are cheap or don't follow the recursion, so they are calculated in calculateBlock()
+			continue;
+		}
+
+		setVoiceBlockCalculated(voiceIndex);
+	}
+
+	for (int i = 0; i < numSamples && lanes.numLanes > 0; i++)
+	{
+		lanes.calculateNextValues();
+
+		bool stageEnded = false;
+
+		for (int l = 0; l < lanes.numLanes; l++)
+			stageEnded |= isEndOfStage(lanes.stages[l], lanes.nextValues[l], lanes.targets[l]);
+
+		if (stageEnded)
+		{
+			// Finish the voices that change their state with the state machine
+			for (int l = 0; l < lanes.numLanes; l++)
+			{
+				if (!isEndOfStage(lanes.stages[l], lanes.nextValues[l], lanes.targets[l]))
+					continue;
+
+				auto state = static_cast<AhdsrEnvelopeState*>(states[lanes.voiceIndexes[l]]);
+				state->current_value = lanes.values[l];
+
+				float* row = lanes.rows[l];
+
+				for (int j = i; j < numSamples; j++)
+					row[j] = calculateNewValue(state);
+
+				lanes.remove(l--);
+			}
+		}
+
+		lanes.storeNextValues(i);
+	}
+
+	for (int l = 0; l < lanes.numLanes; l++)
+		static_cast<AhdsrEnvelopeState*>(states[lanes.voiceIndexes[l]])->current_value = lanes.values[l];
+}
+
 void AhdsrEnvelope::calculateBlock(int startSample, int numSamples)
 {
 	const int voiceIndex = isMonophonic ? -1 : polyManager.getCurrentVoice();
 
 	jassert(voiceIndex < states.size());
 
-	if (isMonophonic)
-		state = static_cast<AhdsrEnvelopeState*>(monophonicState.get());
-	else
-		state = static_cast<AhdsrEnvelopeState*>(states[voiceIndex]);
+	const int c = getWorkingChannel();
 
-	const bool isSustain = static_cast<AhdsrEnvelopeState*>(state)->current_state == AhdsrEnvelopeState::SUSTAIN;
+	auto state = static_cast<AhdsrEnvelopeState*>(isMonophonic ? monophonicState.get() : states[voiceIndex]);
 
-	if (isSustain)
+	const bool isSustain = state->current_state == AhdsrEnvelopeState::SUSTAIN;
+
+	if (consumeVoiceBlock(voiceIndex, startSample, numSamples))
+	{
+		startSample += numSamples;
+	}
+	else if (isSustain)
 	{
 		const float thisSustainValue = sustain * state->modValues[SustainLevelChain];
 		const float lastSustainValue = state->lastSustainValue;
@@ -285,7 +394,7 @@ void AhdsrEnvelope::calculateBlock(int startSample, int numSamples)
 		if (std::abs(thisSustainValue - lastSustainValue) > 0.001f)
 		{
 			const float stepSize = (thisSustainValue - lastSustainValue) / (float)numSamples;
-			float* bufferPointer = internalBuffer.getWritePointer(0, startSample);
+			float* bufferPointer = internalBuffer.getWritePointer(c, startSample);
 			float rampedGain = lastSustainValue;
 
 			for (int i = 0; i < numSamples; i++)
@@ -297,7 +406,7 @@ void AhdsrEnvelope::calculateBlock(int startSample, int numSamples)
 		}
 		else
 		{
-			FloatVectorOperations::fill(internalBuffer.getWritePointer(0, startSample), thisSustainValue, numSamples);
+			FloatVectorOperations::fill(internalBuffer.getWritePointer(c, startSample), thisSustainValue, numSamples);
 			startSample += numSamples;
 		}
 
@@ -312,7 +421,7 @@ void AhdsrEnvelope::calculateBlock(int startSample, int numSamples)
 			{
 				int numThisTime = jmin<int>(numSamples, state->leftOverSamplesFromLastBuffer);
 
-				FloatVectorOperations::fill(internalBuffer.getWritePointer(0, startSample), state->current_value, numThisTime);
+				FloatVectorOperations::fill(internalBuffer.getWritePointer(c, startSample), state->current_value, numThisTime);
 				startSample += numThisTime;
 				numSamples -= numThisTime;
 				state->leftOverSamplesFromLastBuffer -= numThisTime;
@@ -320,11 +429,11 @@ void AhdsrEnvelope::calculateBlock(int startSample, int numSamples)
 
 			while (numSamples >= downsampleFactor)
 			{
-				auto value = calculateNewValue();
+				auto value = calculateNewValue(state);
 
 				
 
-				FloatVectorOperations::fill(internalBuffer.getWritePointer(0, startSample), value, downsampleFactor);
+				FloatVectorOperations::fill(internalBuffer.getWritePointer(c, startSample), value, downsampleFactor);
 
 				numSamples -= downsampleFactor;
 				startSample += downsampleFactor;
@@ -332,9 +441,9 @@ void AhdsrEnvelope::calculateBlock(int startSample, int numSamples)
 
 			if (numSamples > 0)
 			{
-				auto value = calculateNewValue();
+				auto value = calculateNewValue(state);
 
-				FloatVectorOperations::fill(internalBuffer.getWritePointer(0, startSample), value, numSamples);
+				FloatVectorOperations::fill(internalBuffer.getWritePointer(c, startSample), value, numSamples);
 
 				state->leftOverSamplesFromLastBuffer = downsampleFactor - numSamples;
 				startSample += numSamples;
@@ -346,7 +455,7 @@ void AhdsrEnvelope::calculateBlock(int startSample, int numSamples)
 		{
 			while (numSamples > 0)
 			{
-				internalBuffer.setSample(0, startSample, calculateNewValue());
+				internalBuffer.setSample(c, startSample, calculateNewValue(state));
 				++startSample;
 				numSamples--;
 			}
@@ -356,7 +465,7 @@ void AhdsrEnvelope::calculateBlock(int startSample, int numSamples)
 	}
 
 #if ENABLE_ALL_PEAK_METERS
-	if (isMonophonic || polyManager.getCurrentVoice() == polyManager.getLastStartedVoice()) setOutputValue(internalBuffer.getSample(0, startSample-1));
+	if (isMonophonic || polyManager.getCurrentVoice() == polyManager.getLastStartedVoice()) setOutputValue(internalBuffer.getSample(c, startSample-1));
 #endif
 }
 
@@ -370,7 +479,7 @@ void AhdsrEnvelope::reset(int voiceIndex)
 	{
 		EnvelopeModulator::reset(voiceIndex);
 
-		state = static_cast<AhdsrEnvelopeState*>(states[voiceIndex]);
+		auto state = static_cast<AhdsrEnvelopeState*>(states[voiceIndex]);
 		state->current_state = AhdsrEnvelopeState::IDLE;
 		state->current_value = 0.0f;
 	}
@@ -483,7 +592,7 @@ void AhdsrEnvelope::calculateCoefficients(float timeInMilliSeconds, float base,
 	stateBase = (exp1 *invertedBase - invertedBase) * maximum;
 }
 
-float AhdsrEnvelope::calculateNewValue()
+float AhdsrEnvelope::calculateNewValue(AhdsrEnvelopeState* state)
 {
     const float thisSustain = sustain * state->modValues[SustainLevelChain];
     
@@ -117,6 +117,11 @@ public:
 
 	void calculateBlock(int startSample, int numSamples);;
 
+	/** Returns the sustain level if the voice is in the sustain state. */
+	bool getConstantValueForNextBlock(int voiceIndex, float& value) override;
+
+	bool canCalculateVoiceBlocks() const override { return true; }
+
 	void handleHiseEvent(const HiseEvent &e) override;
 	
 
@@ -212,6 +217,11 @@ public:
 
 	ModulatorState *createSubclassedState(int voiceIndex) const override {return new AhdsrEnvelopeState(voiceIndex, this); };
 
+protected:
+
+	/** Calculates the attack, decay and release stages of all given voices at once. */
+	void calculateVoiceBlocks(const int* voiceIndexes, int numVoices, int startSample, int numSamples) override;
+
 	void calculateCoefficients(float timeInMilliSeconds, float base, float maximum, float &stateBase, float &stateCoeff) const;
 
 private:
@@ -230,7 +240,18 @@ private:
 
 	float calcCoef(float rate, float targetRatio) const;
 
-	float calculateNewValue ();
+	float calculateNewValue(AhdsrEnvelopeState* state);
+
+	/** Returns true if the lane value leaves the stage (this mirrors the checks in calculateNewValue()). */
+	static bool isEndOfStage(int stage, float value, float target) noexcept
+	{
+		switch (stage)
+		{
+		case AhdsrEnvelopeState::ATTACK:	return value >= target;
+		case AhdsrEnvelopeState::DECAY:		return (value - target) < 0.001f;
+		default:							return value <= target;
+		}
+	}
 	
 	void setAttackCurve(float newValue);
 	void setDecayCurve(float newValue);
@@ -262,7 +283,7 @@ private:
 
 	bool ecoMode = false;
 
-	AhdsrEnvelopeState *state;
+	VoiceBlockLanes lanes;
 
 	float release_delta;
 
@@ -288,6 +288,8 @@ void CCEnvelope::reset(int voiceIndex)
 
 	CCEnvelopeState *state = static_cast<CCEnvelopeState*>(states[voiceIndex]);
 
+	SpinLock::ScopedLockType sl(dutyVoiceLock);
+
 	if (voiceIndex == dutyVoice) dutyVoice = INT_MAX;
 
 	state->current_state = CCEnvelopeState::IDLE;
@@ -297,6 +299,10 @@ void CCEnvelope::reset(int voiceIndex)
 
 void CCEnvelope::calculateBlock(int startSample, int numSamples)
 {
+	SpinLock::ScopedLockType sl(dutyVoiceLock);
+
+	const int c = getWorkingChannel();
+
 	if (--numSamples >= 0)
 	{
 		int voiceIndex = polyManager.getCurrentVoice();
@@ -304,7 +310,7 @@ void CCEnvelope::calculateBlock(int startSample, int numSamples)
 		if (dutyVoice == INT_MAX) dutyVoice = voiceIndex;
 
 		const float value = calculateNewValue();
-		internalBuffer.setSample(0, startSample, value);
+		internalBuffer.setSample(c, startSample, value);
 		++startSample;
 
 		if (useTable) sendTableIndexChangeMessage(false, table, inputValue);
@@ -321,7 +327,7 @@ void CCEnvelope::calculateBlock(int startSample, int numSamples)
 
 	while (--numSamples >= 0)
 	{
-		internalBuffer.setSample(0, startSample, calculateNewValue());
+		internalBuffer.setSample(c, startSample, calculateNewValue());
 		++startSample;
 	}
 }
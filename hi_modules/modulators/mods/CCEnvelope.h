@@ -130,6 +130,7 @@ public:
 
 	void calculateBlock(int startSample, int numSamples) override;;
 	void handleHiseEvent(const HiseEvent& e);
+	bool reactsToControllerEvents() const override { return true; }
 	void prepareToPlay(double sampleRate, int samplesPerBlock) override;
 
 	ProcessorEditorBody *createEditor(ProcessorEditor *parentEditor)  override;
@@ -197,6 +198,9 @@ private:
 
 	int dutyVoice; // the first active voice will handle the smoothing
 
+	// The duty voice and the smoothed value are shared, so the voices can't be calculated in parallel
+	SpinLock dutyVoiceLock;
+
 	ScopedPointer<ModulatorChain> startLevelChain;
 	ScopedPointer<ModulatorChain> holdChain;
 	ScopedPointer<ModulatorChain> endLevelChain;
@@ -266,58 +266,156 @@ bool SimpleEnvelope::isPlaying(int voiceIndex) const
 	}
 }
 
+bool SimpleEnvelope::getConstantValueForNextBlock(int voiceIndex, float& value)
+{
+	if (isMonophonic)
+		return false;
+
+	auto thisState = static_cast<SimpleEnvelopeState*>(states[voiceIndex]);
+
+	if (thisState->current_state != SimpleEnvelopeState::SUSTAIN)
+		return false;
+
+	value = 1.0f;
+	return true;
+}
+
+void SimpleEnvelope::calculateVoiceBlocks(const int* voiceIndexes, int numVoices, int startSample, int numSamples)
+{
+	if (isMonophonic)
+		return;
+
+	lanes.clear();
+
+	for (int i = 0; i < numVoices; i++)
+	{
+		const int voiceIndex = voiceIndexes[i];
+		auto thisState = static_cast<SimpleEnvelopeState*>(states[voiceIndex]);
+		float* row = getVoiceBlockWritePointer(voiceIndex, startSample);
+
+		const float value = thisState->current_value;
+
+		// The linear stages use the same recursion with a coefficient of 1.0
+		if (thisState->current_state == SimpleEnvelopeState::ATTACK)
+		{
+			if (linearMode)
+				lanes.add(voiceIndex, SimpleEnvelopeState::ATTACK, value, thisState->attackDelta, 1.0f, 1.0f, row);
+			else
+				lanes.add(voiceIndex, SimpleEnvelopeState::ATTACK, value, thisState->expAttackBase, thisState->expAttackCoef, 1.0f, row);
+		}
+		else if (thisState->current_state == SimpleEnvelopeState::RELEASE)
+		{
+			if (linearMode)
+				lanes.add(voiceIndex, SimpleEnvelopeState::RELEASE, value, -release_delta, 1.0f, 0.0f, row);
+			else
+				lanes.add(voiceIndex, SimpleEnvelopeState::RELEASE, value, expReleaseBase, expReleaseCoef, 0.0001f, row);
+		}
+		else
+		{
+			continue;
+		}
+
+		setVoiceBlockCalculated(voiceIndex);
+	}
+
+	for (int i = 0; i < numSamples && lanes.numLanes > 0; i++)
+	{
+		lanes.calculateNextValues();
+
+		bool stageEnded = false;
+
+		for (int l = 0; l < lanes.numLanes; l++)
+			stageEnded |= isEndOfStage(lanes.stages[l], lanes.nextValues[l], lanes.targets[l]);
+
+		if (stageEnded)
+		{
+			// Finish the voices that change their state with the state machine
+			for (int l = 0; l < lanes.numLanes; l++)
+			{
+				if (!isEndOfStage(lanes.stages[l], lanes.nextValues[l], lanes.targets[l]))
+					continue;
+
+				auto state = static_cast<SimpleEnvelopeState*>(states[lanes.voiceIndexes[l]]);
+				state->current_value = lanes.values[l];
+
+				float* row = lanes.rows[l];
+
+				for (int j = i; j < numSamples; j++)
+					row[j] = linearMode ? calculateNewValue(state) : calculateNewExpValue(state);
+
+				lanes.remove(l--);
+			}
+		}
+
+		lanes.storeNextValues(i);
+	}
+
+	for (int l = 0; l < lanes.numLanes; l++)
+		static_cast<SimpleEnvelopeState*>(states[lanes.voiceIndexes[l]])->current_value = lanes.values[l];
+}
+
 void SimpleEnvelope::calculateBlock(int startSample, int numSamples)
 {
 	const int voiceIndex = isMonophonic ? -1 : polyManager.getCurrentVoice();
 
 	jassert(voiceIndex < states.size());
 
-	if(isMonophonic)
-		state = static_cast<SimpleEnvelopeState*>(monophonicState.get());
-	else
-		state = static_cast<SimpleEnvelopeState*>(states[voiceIndex]);
+	const int c = getWorkingChannel();
+
+	auto state = static_cast<SimpleEnvelopeState*>(isMonophonic ? monophonicState.get() : states[voiceIndex]);
 
-	if (state->current_state == SimpleEnvelopeState::SUSTAIN)
+	if (consumeVoiceBlock(voiceIndex, startSample, numSamples))
+	{
+		if (polyManager.getCurrentVoice() == polyManager.getLastStartedVoice()) setOutputValue(internalBuffer.getSample(c, startSample));
+	}
+	else if (state->current_state == SimpleEnvelopeState::SUSTAIN)
 	{
-		FloatVectorOperations::fill(internalBuffer.getWritePointer(0, startSample), 1.0f, numSamples);
+		FloatVectorOperations::fill(internalBuffer.getWritePointer(c, startSample), 1.0f, numSamples);
 		setOutputValue(1.0f);
 	}
 	else if (state->current_state == SimpleEnvelopeState::IDLE)
 	{
-		FloatVectorOperations::fill(internalBuffer.getWritePointer(0, startSample), 0.0f, numSamples);
+		FloatVectorOperations::fill(internalBuffer.getWritePointer(c, startSample), 0.0f, numSamples);
 		setOutputValue(0.0f);
 	}
 	else
 	{
 		
-		float *out = internalBuffer.getWritePointer(0, startSample);
+		float *out = internalBuffer.getWritePointer(c, startSample);
 		
 		if (linearMode)
 		{
-			while (numSamples > 0)
+			while (numSamples >= 4)
 			{
-				*out++ = calculateNewValue();
-				*out++ = calculateNewValue();
-				*out++ = calculateNewValue();
-				*out++ = calculateNewValue();
+				*out++ = calculateNewValue(state);
+				*out++ = calculateNewValue(state);
+				*out++ = calculateNewValue(state);
+				*out++ = calculateNewValue(state);
 
 				numSamples -= 4;
 			}
+
+			// The blocks are split at the exact event positions, so there might be some samples left
+			while (--numSamples >= 0)
+				*out++ = calculateNewValue(state);
 		}
 		else
 		{
-			while (numSamples > 0)
+			while (numSamples >= 4)
 			{
-				*out++ = calculateNewExpValue();
-				*out++ = calculateNewExpValue();
-				*out++ = calculateNewExpValue();
-				*out++ = calculateNewExpValue();
+				*out++ = calculateNewExpValue(state);
+				*out++ = calculateNewExpValue(state);
+				*out++ = calculateNewExpValue(state);
+				*out++ = calculateNewExpValue(state);
 
 				numSamples -= 4;
 			}
+
+			while (--numSamples >= 0)
+				*out++ = calculateNewExpValue(state);
 		}
 
-		if (isMonophonic || polyManager.getCurrentVoice() == polyManager.getLastStartedVoice()) setOutputValue(internalBuffer.getSample(0, 0));
+		if (isMonophonic || polyManager.getCurrentVoice() == polyManager.getLastStartedVoice()) setOutputValue(internalBuffer.getSample(c, 0));
 	}
 
 	
@@ -373,7 +471,7 @@ float SimpleEnvelope::calcCoefficient(float time, float targetRatio/*=1.0f*/) co
 	}
 }
 
-float SimpleEnvelope::calculateNewValue()
+float SimpleEnvelope::calculateNewValue(SimpleEnvelopeState* state)
 {
 	switch (state->current_state)
 	{
@@ -412,7 +510,7 @@ float SimpleEnvelope::calculateNewValue()
 	return state->current_value;
 }
 
-float SimpleEnvelope::calculateNewExpValue()
+float SimpleEnvelope::calculateNewExpValue(SimpleEnvelopeState* state)
 {
 	switch (state->current_state)
 	{
@@ -107,6 +107,8 @@ public:
 
 	void prepareToPlay(double sampleRate, int samplesPerBlock) override;
 	void calculateBlock(int startSample, int numSamples) override;
+	bool getConstantValueForNextBlock(int voiceIndex, float& value) override;
+	bool canCalculateVoiceBlocks() const override { return true; }
 	void handleHiseEvent(const HiseEvent& m) override;
 	
 	ProcessorEditorBody *createEditor(ProcessorEditor *parentEditor)  override;
@@ -153,6 +155,11 @@ public:
 
 	ModulatorState *createSubclassedState(int voiceIndex) const override {return new SimpleEnvelopeState(voiceIndex); };
 
+protected:
+
+	/** Calculates the attack and release stages of all given voices at once. */
+	void calculateVoiceBlocks(const int* voiceIndexes, int numVoices, int startSample, int numSamples) override;
+
 private:
 
 	float calcCoefficient(float time, float targetRatio=1.0f) const;
@@ -164,8 +171,14 @@ private:
 	
 	The calculation is linear and not logarithmic, so it may be sounding cheep
 	*/
-	float calculateNewValue ();
-	float calculateNewExpValue();
+	float calculateNewValue(SimpleEnvelopeState* state);
+	float calculateNewExpValue(SimpleEnvelopeState* state);
+
+	/** Returns true if the lane value leaves the stage (this mirrors the checks in calculateNewValue()). */
+	static bool isEndOfStage(int stage, float value, float target) noexcept
+	{
+		return stage == SimpleEnvelopeState::ATTACK ? value >= target : value <= target;
+	}
 
 	float inputValue;
 	float attack;
@@ -184,7 +197,7 @@ private:
 
 	ScopedPointer<ModulatorChain> attackChain;
 
-	SimpleEnvelopeState *state;
+	VoiceBlockLanes lanes;
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SimpleEnvelope)
 };
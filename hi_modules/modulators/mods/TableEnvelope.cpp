@@ -181,10 +181,12 @@ void TableEnvelope::calculateBlock(int startSample, int numSamples)
 
 	auto state = static_cast<TableEnvelopeState*>(isMonophonic ? monophonicState.get() : states[voiceIndex]);
 
+	const int c = getWorkingChannel();
+
 	if (--numSamples >= 0)
 	{
 		const float value = calculateNewValue();
-		internalBuffer.setSample(0, startSample, value);
+		internalBuffer.setSample(c, startSample, value);
 		++startSample;
 		if (isMonophonic || voiceIndex == polyManager.getLastStartedVoice())
 		{
@@ -212,7 +214,7 @@ void TableEnvelope::calculateBlock(int startSample, int numSamples)
 
 	while (--numSamples >= 0)
 	{
-		internalBuffer.setSample(0, startSample, calculateNewValue());
+		internalBuffer.setSample(c, startSample, calculateNewValue());
 		++startSample;
 	}
 }
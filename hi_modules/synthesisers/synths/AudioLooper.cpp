@@ -183,8 +183,8 @@ void AudioLooperVoice::calculateBlock(int startSample, int numSamples)
 
 	getOwnerSynth()->effectChain->renderVoice(voiceIndex, voiceBuffer, startIndex, samplesToCopy);
 
-	FloatVectorOperations::multiply(voiceBuffer.getWritePointer(0, startIndex), modValues + startIndex, samplesToCopy);
-	FloatVectorOperations::multiply(voiceBuffer.getWritePointer(1, startIndex), modValues + startIndex, samplesToCopy);
+	applyVoiceGainValues(voiceBuffer.getWritePointer(0, startIndex), modValues, startIndex, samplesToCopy);
+	applyVoiceGainValues(voiceBuffer.getWritePointer(1, startIndex), modValues, startIndex, samplesToCopy);
 
 	if (isLastVoice && looper->length != 0 && looper->inputMerger.shouldUpdate())
 	{
@@ -122,6 +122,9 @@ public:
 
 	void addProcessorsWhenEmpty() override {};
 
+	/** The other synths read the modulation values, so this must be rendered before them. */
+	bool canBeRenderedInParallel() const override { return false; }
+
 	void prepareToPlay(double sampleRate, int samplesPerBlock) override;
 
 private:
@@ -88,8 +88,8 @@ public:
 
 		getOwnerSynth()->effectChain->renderVoice(voiceIndex, voiceBuffer, startIndex, samplesToCopy);
 
-		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(0, startIndex), modValues + startIndex, samplesToCopy);
-		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(1, startIndex), modValues + startIndex, samplesToCopy);
+		applyVoiceGainValues(voiceBuffer.getWritePointer(0, startIndex), modValues, startIndex, samplesToCopy);
+		applyVoiceGainValues(voiceBuffer.getWritePointer(1, startIndex), modValues, startIndex, samplesToCopy);
 	};
 
 private:
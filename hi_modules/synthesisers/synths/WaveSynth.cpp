@@ -546,8 +546,8 @@ void WaveSynthVoice::calculateBlock(int startSample, int numSamples)
 
 	getOwnerSynth()->effectChain->renderVoice(voiceIndex, voiceBuffer, startIndex, samplesToCopy);
 
-	FloatVectorOperations::multiply(voiceBuffer.getWritePointer(0, startIndex), modValues + startIndex, samplesToCopy);
-	FloatVectorOperations::multiply(voiceBuffer.getWritePointer(1, startIndex), modValues + startIndex, samplesToCopy);
+	applyVoiceGainValues(voiceBuffer.getWritePointer(0, startIndex), modValues, startIndex, samplesToCopy);
+	applyVoiceGainValues(voiceBuffer.getWritePointer(1, startIndex), modValues, startIndex, samplesToCopy);
 }
 
 void WaveSynthVoice::setOctaveTransposeFactor(double newFactor, bool leftFactor)
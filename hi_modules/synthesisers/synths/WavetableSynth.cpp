@@ -293,8 +293,8 @@ void WavetableSynthVoice::calculateBlock(int startSample, int numSamples)
 
 	getOwnerSynth()->effectChain->renderVoice(voiceIndex, voiceBuffer, startIndex, samplesToCopy);
 
-	FloatVectorOperations::multiply(voiceBuffer.getWritePointer(0, startIndex), modValues + startIndex, samplesToCopy);
-	FloatVectorOperations::multiply(voiceBuffer.getWritePointer(1, startIndex), modValues + startIndex, samplesToCopy);
+	applyVoiceGainValues(voiceBuffer.getWritePointer(0, startIndex), modValues, startIndex, samplesToCopy);
+	applyVoiceGainValues(voiceBuffer.getWritePointer(1, startIndex), modValues, startIndex, samplesToCopy);
 
 	if (getOwnerSynth()->getLastStartedVoice() == this)
 	{
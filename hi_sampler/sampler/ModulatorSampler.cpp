@@ -82,6 +82,14 @@ SET_DOCUMENTATION(ModulatorSampler)
 	ADD_PARAMETER_DOC(Reversed, 
 		"If this is true, the samples will be fully loaded into preload buffer and reversed");
 
+	ADD_PARAMETER_DOC_WITH_NAME(InterpolationMode, "Interpolation",
+		"The resampling algorithm for pitched samples. `0` is linear interpolation, `1` uses 4-point Hermite interpolation " \
+		"and `2` uses a 16-point windowed sinc interpolation, which sounds the best but needs the most CPU.");
+
+	ADD_PARAMETER_DOC_WITH_NAME(LazyPreloading, "Lazy Preloading",
+		"If this is true, only the first few samples of every sound are preloaded with the sample map and the rest of the preload buffer " \
+		"is loaded in the background when a nearby note is played. Use this for huge sample maps to reduce the loading time and memory usage.");
+
 	ADD_CHAIN_DOC(SampleStartModulation, "Sample Start", 
 		"Allows modification of the sample start if the sound allows this. The modulation range is depending on the *SampleStartMod* value of each sample.");
 
@@ -114,7 +122,8 @@ numChannels(1),
 deactivateUIUpdate(false),
 samplePreloadPending(false),
 temporaryVoiceBuffer(true, 2, 0),
-samplePropertyUpdater(this)
+samplePropertyUpdater(this),
+lazyPreloadJob(this)
 {
 #if USE_BACKEND
 	sampleEditHandler = new SampleEditHandler(this);
@@ -127,6 +136,8 @@ samplePropertyUpdater(this)
 
 	enableAllocationFreeMessages(50);
 
+	mc->getSampleManager().getMemoryGovernor().addSampler(this);
+
 	parameterNames.add("PreloadSize");
 	parameterNames.add("BufferSize");
 	parameterNames.add("VoiceAmount");
@@ -137,6 +148,8 @@ samplePropertyUpdater(this)
 	parameterNames.add("CrossfadeGroups");
 	parameterNames.add("Purged");
 	parameterNames.add("Reversed");
+	parameterNames.add("InterpolationMode");
+	parameterNames.add("LazyPreloading");
 
 	editorStateIdentifiers.add("SampleStartChainShown");
 	editorStateIdentifiers.add("SettingsShown");
@@ -179,6 +192,13 @@ samplePropertyUpdater(this)
 
 ModulatorSampler::~ModulatorSampler()
 {
+	getMainController()->getSampleManager().getMemoryGovernor().removeSampler(this);
+
+	lazyPreloadJob.signalJobShouldExit();
+
+	// the pool only keeps a weak reference to queued jobs, so we just need to wait for a running job
+	lazyPreloadJob.waitForJobToFinish();
+
 	sampleMap = nullptr;
 	deleteAllSounds();
 }
@@ -232,6 +252,32 @@ void ModulatorSampler::setReversed(bool shouldBeReversed)
     }
 }
 
+void ModulatorSampler::setInterpolationMode(SampleInterpolator::InterpolationMode newMode)
+{
+	interpolationMode = newMode;
+
+	for (int i = 0; i < getNumVoices(); i++)
+	{
+		static_cast<ModulatorSamplerVoice*>(getVoice(i))->setInterpolationMode(newMode);
+	}
+}
+
+void ModulatorSampler::setLazyPreloading(bool shouldLoadLazily)
+{
+	if (lazyPreloading != shouldLoadLazily)
+	{
+		lazyPreloading = shouldLoadLazily;
+
+		// The new mode will be picked up by preloadSample()
+		refreshPreloadSizes();
+	}
+}
+
+bool ModulatorSampler::shouldLoadLazily() const noexcept
+{
+	return lazyPreloading || getMainController()->getSampleManager().getMemoryGovernor().isActive();
+}
+
 void ModulatorSampler::setNumChannels(int numNewChannels)
 {
 
@@ -328,6 +374,8 @@ void ModulatorSampler::restoreFromValueTree(const ValueTree &v)
 	setVoiceAmount(v.getProperty("VoiceAmount", voiceAmount));
 	
 	loadAttribute(Reversed, "Reversed");
+	loadAttribute(InterpolationMode, "InterpolationMode");
+	loadAttribute(LazyPreloading, "LazyPreloading");
 
 	loadAttribute(SamplerRepeatMode, "SamplerRepeatMode");
 	loadAttribute(Purged, "Purged");
@@ -359,6 +407,8 @@ ValueTree ModulatorSampler::exportAsValueTree() const
 	saveAttribute(CrossfadeGroups, "CrossfadeGroups");
 	saveAttribute(Purged, "Purged");
 	saveAttribute(Reversed, "Reversed");
+	saveAttribute(InterpolationMode, "InterpolationMode");
+	saveAttribute(LazyPreloading, "LazyPreloading");
 	v.setProperty("NumChannels", numChannels, nullptr);
 
 	ValueTree channels("channels");
@@ -400,6 +450,8 @@ float ModulatorSampler::getAttribute(int parameterIndex) const
 	case CrossfadeGroups:	return crossfadeGroups ? 1.0f : 0.0f;
 	case Purged:			return purged ? 1.0f : 0.0f;
 	case Reversed:			return reversed ? 1.0f : 0.0f;
+	case InterpolationMode:	return (float)interpolationMode;
+	case LazyPreloading:	return lazyPreloading ? 1.0f : 0.0f;
 	default:				jassertfalse; return -1.0f;
 	}
 }
@@ -427,6 +479,8 @@ void ModulatorSampler::setInternalAttribute(int parameterIndex, float newValue)
 	case PitchTracking:		pitchTrackingEnabled = newValue == 1.0f; break;
 	case OneShot:			oneShotEnabled = newValue == 1.0f; break;
 	case Reversed:			setReversed(newValue > 0.5f); break;
+	case InterpolationMode:	setInterpolationMode((SampleInterpolator::InterpolationMode)jlimit<int>(0, SampleInterpolator::numInterpolationModes - 1, (int)newValue)); break;
+	case LazyPreloading:	setLazyPreloading(newValue > 0.5f); break;
 	case CrossfadeGroups:	crossfadeGroups = newValue == 1.0f; refreshCrossfadeTables(); break;
 	case Purged:			purgeAllSamples(newValue == 1.0f); break;
 	default:				jassertfalse; break;
@@ -622,6 +676,83 @@ double ModulatorSampler::getDiskUsage()
 	return diskUsage * 100.0;
 }
 
+void ModulatorSampler::addStreamingStatistics(StreamingStatistics& target, bool resetStatistics)
+{
+	for (int i = 0; i < getNumVoices(); i++)
+	{
+		if (auto v = getVoice(i))
+		{
+			static_cast<ModulatorSamplerVoice*>(v)->addStreamingStatistics(target, resetStatistics);
+		}
+	}
+}
+
+void ModulatorSampler::addStreamedBytesPerSound(Array<var>& soundList, double secondsSinceLastReset, bool resetStatistics)
+{
+	ModulatorSampler::SoundIterator sIter(this);
+
+	while (auto sound = sIter.getNextSound())
+	{
+		for (int i = 0; i < sound->getNumMultiMicSamples(); i++)
+		{
+			auto s = sound->getReferenceToSound(i);
+
+			if (s == nullptr)
+				continue;
+
+			const int64 numBytes = resetStatistics ? s->resetNumStreamedBytes() : s->getNumStreamedBytes();
+
+			if (numBytes == 0)
+				continue;
+
+			DynamicObject::Ptr entry = new DynamicObject();
+
+			entry->setProperty("Sampler", getId());
+			entry->setProperty("FileName", s->getFileName(true));
+			entry->setProperty("BytesPerSecond", secondsSinceLastReset > 0.0 ? (double)numBytes / secondsSinceLastReset : 0.0);
+
+			soundList.add(var(entry));
+		}
+	}
+}
+
+hlac::HiseSampleBuffer* ModulatorSampler::getTemporaryVoiceBuffer()
+{
+	const int threadIndex = RealtimeWorkerPool::getCurrentThreadIndex();
+
+	if (threadIndex == 0)
+		return &temporaryVoiceBuffer;
+
+	// refreshParallelVoiceBuffer() creates a buffer for every possible worker
+	jassert(threadIndex <= workerVoiceBuffers.size());
+
+	if (auto b = workerVoiceBuffers[threadIndex - 1])
+		return b;
+
+	return &temporaryVoiceBuffer;
+}
+
+void ModulatorSampler::refreshParallelVoiceBuffer()
+{
+	ModulatorSynth::refreshParallelVoiceBuffer();
+
+	if (isUsingParallelVoiceRendering())
+	{
+		while (workerVoiceBuffers.size() < HISE_MAX_REALTIME_WORKERS)
+			workerVoiceBuffers.add(new hlac::HiseSampleBuffer(temporaryVoiceBuffer.isFloatingPoint(), 2, 0));
+
+		if (getBlockSize() > 0)
+		{
+			for (auto b : workerVoiceBuffers)
+				StreamingSamplerVoice::initTemporaryVoiceBuffer(b, getBlockSize());
+		}
+	}
+	else
+	{
+		workerVoiceBuffers.clear();
+	}
+}
+
 void ModulatorSampler::refreshMemoryUsage()
 {
 	if (sampleMap == nullptr)
@@ -640,9 +771,13 @@ void ModulatorSampler::refreshMemoryUsage()
 		{
 			static_cast<ModulatorSamplerVoice*>(getVoice(i))->setStreamingBufferDataType(temporaryBufferShouldBeFloatingPoint);
 		}
+
+		workerVoiceBuffers.clear();
+		refreshParallelVoiceBuffer();
 	}
 
 	int64 actualPreloadSize = 0;
+	bool soundsNeedStreamingBuffers = false;
 
 	{
 		SoundIterator sIter(this, false);
@@ -651,17 +786,25 @@ void ModulatorSampler::refreshMemoryUsage()
 		{
 			for (int j = 0; j < numChannels; j++)
 			{
-				actualPreloadSize += sound->getReferenceToSound(j)->getActualPreloadSize();
+				auto s = sound->getReferenceToSound(j);
+
+				actualPreloadSize += s->getActualPreloadSize();
+
+				// Voices that play the preload buffer or read the memory mapped monolith never fill the streaming buffers
+				soundsNeedStreamingBuffers |= !s->isEntireSampleLoaded() && s->getMappedSampleData() == nullptr;
 			}
 		}
 	}
 
+	setVoicesUseStreamingBuffers(soundsNeedStreamingBuffers);
+
 	for (int i = 0; i < getNumVoices(); i++)
 	{
 		//actualPreloadSize += static_cast<ModulatorSamplerVoice*>(getVoice(i))->getStreamingBufferSize();
 	}
 
-	const int64 streamBufferSizePerVoice = 2 *				// two buffers
+	const int64 streamBufferSizePerVoice = !voicesUseStreamingBuffers ? 0 :
+		2 *				// two buffers
 		bufferSize *		// buffer size per buffer
 		(sampleMap->isMonolith() ? 2 : 4) *  // bytes per sample
 		2 * numChannels;				// number of channels
@@ -672,6 +815,16 @@ void ModulatorSampler::refreshMemoryUsage()
 	getMainController()->getSampleManager().getModulatorSamplerSoundPool()->sendChangeMessage();
 }
 
+void ModulatorSampler::setVoicesUseStreamingBuffers(bool shouldUseStreamingBuffers)
+{
+	voicesUseStreamingBuffers = shouldUseStreamingBuffers;
+
+	for (int i = 0; i < getNumVoices(); i++)
+	{
+		static_cast<ModulatorSamplerVoice*>(getVoice(i))->setUseStreamingBuffers(shouldUseStreamingBuffers);
+	}
+}
+
 void ModulatorSampler::setVoiceAmount(int newVoiceAmount)
 {
 	
@@ -712,6 +865,7 @@ void ModulatorSampler::setVoiceAmountInternal()
 			}
 
 			dynamic_cast<ModulatorSamplerVoice*>(voices.getLast())->setStreamingBufferDataType(temporaryVoiceBuffer.isFloatingPoint());
+			dynamic_cast<ModulatorSamplerVoice*>(voices.getLast())->setInterpolationMode(interpolationMode);
 
 			if (Processor::getSampleRate() != -1.0)
 			{
@@ -822,6 +976,180 @@ void ModulatorSampler::AsyncPurger::handleAsyncUpdate()
 	sampler->refreshChannelsForSounds();
 }
 
+ModulatorSampler::LazyPreloadJob::LazyPreloadJob(ModulatorSampler* s) :
+	SampleThreadPoolJob("Lazy Preloading"),
+	sampler(s),
+	writeIndex(0),
+	notesPending(false),
+	memoryUsage(0)
+{
+	for (int i = 0; i < NumPendingNotes; i++)
+		pendingNotes[i].store(0);
+}
+
+void ModulatorSampler::LazyPreloadJob::addPlayedNote(int noteNumber, int velocity) noexcept
+{
+	const int index = writeIndex.fetch_add(1) % NumPendingNotes;
+
+	pendingNotes[index].store(((jlimit<int>(0, 127, noteNumber) << 8) | jlimit<int>(0, 127, velocity)) + 1);
+
+	notesPending.store(true);
+
+	if (shouldExit() || isQueued())
+		return;
+
+	setDeadline(SampleThreadPool::getDeadlineFromNow(0.05));
+	sampler->getMainController()->getSampleManager().getGlobalSampleThreadPool()->addJob(this, false);
+}
+
+SampleThreadPoolJob::JobStatus ModulatorSampler::LazyPreloadJob::runJob()
+{
+	auto& soundLock = sampler->getMainController()->getSampleManager().getSamplerSoundLock();
+
+	ScopedTryLock sl(soundLock);
+
+	// The sample map is being changed. The pending notes stay in the queue and will be picked up with the next note.
+	if (!sl.isLocked())
+		return jobHasFinished;
+
+	notesPending.store(false);
+
+	Array<int> playedNotes;
+
+	for (int i = 0; i < NumPendingNotes; i++)
+	{
+		if (auto packed = pendingNotes[i].exchange(0))
+			playedNotes.add(packed - 1);
+	}
+
+	Array<StreamingSamplerSound*> loadedSounds;
+	Array<StreamingSamplerSound*> justLoadedSounds;
+	int64 numBytes = 0;
+
+	auto& governor = sampler->getMainController()->getSampleManager().getMemoryGovernor();
+
+	ModulatorSampler::SoundIterator sIter(sampler, false);
+
+	while (auto sound = sIter.getNextSound())
+	{
+		if (shouldExit())
+			return jobHasFinished;
+
+		const bool isNear = !playedNotes.isEmpty() && isNearPlayedNote(sound, playedNotes);
+
+		for (int i = 0; i < sound->getNumMultiMicSamples(); i++)
+		{
+			auto s = sound->getReferenceToSound(i);
+
+			if (s == nullptr || !s->isUsingLazyPreload())
+				continue;
+
+			// If the global budget is used up, the buffer would just be unloaded again by the next governor update
+			const bool canLoad = !governor.isActive() || governor.hasRoomLeft();
+
+			if (isNear && canLoad && s->needsLazyPreload())
+			{
+				try
+				{
+					if (s->loadLazyPreloadBuffer())
+					{
+						justLoadedSounds.add(s.get());
+
+						if (governor.isActive())
+							governor.addToFootprint((int64)s->getLazyPreloadMemory());
+					}
+				}
+				catch (StreamingSamplerSound::LoadingError l)
+				{
+					sampler->getMainController()->getDebugLogger().logMessage("Error at lazy preloading sample " + l.fileName + ": " + l.errorDescription);
+				}
+			}
+
+			if (s->getLazyPreloadMemory() != 0)
+			{
+				numBytes += (int64)s->getLazyPreloadMemory();
+
+				if (!justLoadedSounds.contains(s.get()))
+					loadedSounds.add(s.get());
+			}
+		}
+	}
+
+	const int64 limit = sampler->getLazyPreloadMemoryLimit();
+
+	if (numBytes > limit)
+	{
+		unloadLeastRecentlyPlayed(loadedSounds, numBytes - limit);
+
+		numBytes = 0;
+
+		for (auto s : loadedSounds)
+			numBytes += (int64)s->getLazyPreloadMemory();
+
+		for (auto s : justLoadedSounds)
+			numBytes += (int64)s->getLazyPreloadMemory();
+	}
+
+	memoryUsage.store(numBytes);
+
+	if (governor.isActive() && !justLoadedSounds.isEmpty())
+	{
+		governor.addReloads(justLoadedSounds.size());
+		governor.triggerUpdate();
+	}
+
+	// Notes that were played while this job was running didn't add it to the pool again
+	return notesPending.load() ? jobNeedsRunningAgain : jobHasFinished;
+}
+
+bool ModulatorSampler::LazyPreloadJob::isNearPlayedNote(const ModulatorSamplerSound* sound, const Array<int>& playedNotes) const
+{
+	const Range<int> keyRange((int)sound->getProperty(ModulatorSamplerSound::KeyLow), (int)sound->getProperty(ModulatorSamplerSound::KeyHigh) + 1);
+	const Range<int> veloRange((int)sound->getProperty(ModulatorSamplerSound::VeloLow), (int)sound->getProperty(ModulatorSamplerSound::VeloHigh) + 1);
+
+	for (auto packed : playedNotes)
+	{
+		const int noteNumber = packed >> 8;
+		const int velocity = packed & 0xFF;
+
+		const Range<int> nearKeys(noteNumber - HISE_LAZY_PRELOAD_KEY_RANGE, noteNumber + HISE_LAZY_PRELOAD_KEY_RANGE + 1);
+		const Range<int> nearVelocities(velocity - HISE_LAZY_PRELOAD_VELOCITY_RANGE, velocity + HISE_LAZY_PRELOAD_VELOCITY_RANGE + 1);
+
+		if (keyRange.intersects(nearKeys) && veloRange.intersects(nearVelocities))
+			return true;
+	}
+
+	return false;
+}
+
+void ModulatorSampler::LazyPreloadJob::unloadLeastRecentlyPlayed(Array<StreamingSamplerSound*>& loadedSounds, int64 numBytesToFree)
+{
+	struct LastPlayedSorter
+	{
+		static int compareElements(const StreamingSamplerSound* first, const StreamingSamplerSound* second)
+		{
+			if (first->getLastPlayedTime() < second->getLastPlayedTime()) return -1;
+			if (first->getLastPlayedTime() > second->getLastPlayedTime()) return 1;
+			return 0;
+		}
+	};
+
+	LastPlayedSorter sorter;
+	loadedSounds.sort(sorter);
+
+	for (auto s : loadedSounds)
+	{
+		if (numBytesToFree <= 0)
+			break;
+
+		const int64 numBytes = (int64)s->getLazyPreloadMemory();
+
+		// If a voice still reads from the buffer, it will be unloaded at the next run
+		if (s->unloadLazyPreloadBuffer())
+			numBytesToFree -= numBytes;
+	}
+}
+
 void ModulatorSampler::setPreloadSize(int newPreloadSize)
 {
 	if (newPreloadSize != 0 && newPreloadSize != preloadSize)
@@ -885,6 +1213,10 @@ ModulatorSamplerSound* ModulatorSampler::addSamplerSound(const ValueTree &descri
 
 	if (newSound != nullptr)
 	{
+		// The new sound isn't preloaded yet, so refreshMemoryUsage() has to decide again if the voices can skip the streaming buffers
+		if (!voicesUseStreamingBuffers)
+			setVoicesUseStreamingBuffers(true);
+
 		newSound->restoreFromValueTree(description);
 
 		sounds.add(newSound);
@@ -911,6 +1243,9 @@ void ModulatorSampler::addSamplerSounds(OwnedArray<ModulatorSamplerSound>& monol
 
 	const int numNewSounds = monolithicSounds.size();
 
+	if (numNewSounds != 0 && !voicesUseStreamingBuffers)
+		setVoicesUseStreamingBuffers(true);
+
 	for (int i = 0; i < numNewSounds; i++)
 	{
 		ModulatorSamplerSound* newSound = monolithicSounds.removeAndReturn(0);
@@ -1042,6 +1377,9 @@ void ModulatorSampler::preHiseEventCallback(const HiseEvent &m)
 
 		if (m.isNoteOn())
 		{
+			if (shouldLoadLazily())
+				lazyPreloadJob.addPlayedNote(m.getNoteNumber() + m.getTransposeAmount(), m.getVelocity());
+
 			samplerDisplayValues.currentNotes[m.getNoteNumber() + m.getTransposeAmount()] = m.getVelocity();
 		}
 		else
@@ -1342,6 +1680,8 @@ bool ModulatorSampler::preloadAllSamples()
 	setHasPendingSampleLoad(false);
 	sendChangeMessage();
 
+	getMainController()->getSampleManager().getMemoryGovernor().triggerUpdate();
+
 	return true;
 }
 
@@ -1352,10 +1692,23 @@ bool ModulatorSampler::preloadSample(StreamingSamplerSound * s, const int preloa
 
 	String fileName = s->getFileName(false);
 
+	auto& governor = getMainController()->getSampleManager().getMemoryGovernor();
+
 	try
 	{
+		const int64 previousSize = (int64)s->getActualPreloadSize();
+
+		s->setLazyPreload(shouldLoadLazily());
 		s->setPreloadSize(s->hasActiveState() ? preloadSizeToUse : 0, true);
+
+		// Without the lazy preloading attribute, the governor loads everything that fits into the budget
+		if (!lazyPreloading && governor.hasRoomLeft())
+			s->loadLazyPreloadBuffer();
+
 		s->closeFileHandle();
+
+		governor.addToFootprint((int64)s->getActualPreloadSize() - previousSize);
+
 		return true;
 	}
 	catch (StreamingSamplerSound::LoadingError l)
@@ -150,6 +150,8 @@ public:
 		CrossfadeGroups, 
 		Purged, 
 		Reversed, 
+		InterpolationMode,
+		LazyPreloading,
 		numModulatorSamplerParameters
 	};
 
@@ -234,7 +236,19 @@ public:
 	/** Returns the time spent reading samples from disk. */
 	double getDiskUsage();
 
-	/** Scans all sounds and voices and adds their memory usage. */
+	/** Adds the streaming statistics of all voices to the given object and optionally resets them. */
+	void addStreamingStatistics(StreamingStatistics& target, bool resetStatistics);
+
+	/** Adds the streamed bytes for every sound that was streamed from disk to the given array.
+	*
+	*	The entries are JSON objects with the file name and the bytes per second for the given time span. 
+	*/
+	void addStreamedBytesPerSound(Array<var>& soundList, double secondsSinceLastReset, bool resetStatistics);
+
+	/** Scans all sounds and voices and adds their memory usage.
+	*
+	*	If all sounds are either entirely preloaded or can be read from the memory mapped monolith, the voices won't allocate their streaming buffers.
+	*/
 	void refreshMemoryUsage();
 
 	int getNumActiveVoices() const override
@@ -287,6 +301,7 @@ public:
 	{
 		if (purged)
 		{
+			eventsArePreprocessed = false;
 			return;
 		}
 
@@ -385,6 +400,29 @@ public:
 
     void setReversed(bool shouldBeReversed);
 
+	/** Sets the resampling algorithm of all voices. */
+	void setInterpolationMode(SampleInterpolator::InterpolationMode newMode);
+
+	/** Enables the lazy preloading for huge sample maps.
+	*
+	*	If enabled, only a small head of every sample is preloaded when the sample map is loaded. The rest of the
+	*	preload buffer is loaded in the background when a note is played that is near the mapped key and velocity range.
+	*/
+	void setLazyPreloading(bool shouldLoadLazily);
+
+	bool isUsingLazyPreloading() const noexcept { return lazyPreloading; }
+
+	/** Returns true if the sounds are loaded lazily, either because it's enabled for this sampler or because the global memory governor is active. */
+	bool shouldLoadLazily() const noexcept;
+
+	/** Sets the amount of bytes that the lazily loaded preload buffers may use. If it's exceeded, the sounds that were not played for the longest time will be unloaded. */
+	void setLazyPreloadMemoryLimit(int64 newLimitInBytes) noexcept { lazyPreloadMemoryLimit.store(newLimitInBytes); }
+
+	int64 getLazyPreloadMemoryLimit() const noexcept { return lazyPreloadMemoryLimit.load(); }
+
+	/** Returns the amount of bytes that are currently used by the lazily loaded preload buffers. */
+	int64 getLazyPreloadMemoryUsage() const noexcept { return lazyPreloadJob.getMemoryUsage(); }
+
 	void purgeAllSamples(bool shouldBePurged)
 	{
 		
@@ -535,7 +573,8 @@ public:
 		return saveString;
 	}
 
-	hlac::HiseSampleBuffer* getTemporaryVoiceBuffer() { return &temporaryVoiceBuffer; }
+	/** Returns the buffer that the voices use for the resampling. If the voices are rendered in parallel, every worker thread gets its own buffer. */
+	hlac::HiseSampleBuffer* getTemporaryVoiceBuffer();
 
 	bool checkAndLogIsSoftBypassed(DebugLogger::Location location) const;
 
@@ -559,8 +598,14 @@ public:
     
     bool isUsingStaticMatrix() const noexcept { return useStaticMatrix; };
 
+protected:
+
+	void refreshParallelVoiceBuffer() override;
+
 private:
 
+	void setVoicesUseStreamingBuffers(bool shouldUseStreamingBuffers);
+
 	bool isOnSampleLoadingThread() const
 	{
 		return getMainController()->getKillStateHandler().getCurrentThread() == MainController::KillStateHandler::SampleLoadingThread;
@@ -633,6 +678,45 @@ private:
 		ModulatorSampler *sampler;
 	};
 
+	/** Loads the preload buffers of the sounds around the played notes if lazy preloading is enabled and unloads the 
+	*	buffers of the least recently played sounds if the memory limit is exceeded. 
+	*/
+	class LazyPreloadJob : public SampleThreadPoolJob
+	{
+	public:
+
+		LazyPreloadJob(ModulatorSampler* s);
+
+		/** Adds a note to the prediction queue. Call this from the audio thread.
+		*
+		*	The note is written into a lock free queue and the job is added to the pool the same way
+		*	a streaming voice requests new data. If the job is already queued, it picks up the note before it finishes.
+		*/
+		void addPlayedNote(int noteNumber, int velocity) noexcept;
+
+		JobStatus runJob() override;
+
+		int64 getMemoryUsage() const noexcept { return memoryUsage.load(); }
+
+	private:
+
+		enum { NumPendingNotes = 32 };
+
+		bool isNearPlayedNote(const ModulatorSamplerSound* sound, const Array<int>& playedNotes) const;
+
+		void unloadLeastRecentlyPlayed(Array<StreamingSamplerSound*>& loadedSounds, int64 numBytesToFree);
+
+		ModulatorSampler* sampler;
+
+		// packed as ((noteNumber << 8) | velocity) + 1 so that zero means empty
+		std::atomic<int> pendingNotes[NumPendingNotes];
+		std::atomic<int> writeIndex;
+
+		std::atomic<bool> notesPending;
+
+		std::atomic<int64> memoryUsage;
+	};
+
 	SamplePropertyUpdater samplePropertyUpdater;
     
 
@@ -651,6 +735,13 @@ private:
 
 	bool reversed = false;
 
+	SampleInterpolator::InterpolationMode interpolationMode = SampleInterpolator::Linear;
+
+	std::atomic<bool> lazyPreloading { false };
+	std::atomic<int64> lazyPreloadMemoryLimit { HISE_LAZY_PRELOAD_MEMORY_LIMIT };
+
+	LazyPreloadJob lazyPreloadJob;
+
 	bool useGlobalFolder;
 	bool pitchTrackingEnabled;
 	bool oneShotEnabled;
@@ -672,6 +763,8 @@ private:
 	int preloadSize;
 	int bufferSize;
 
+	bool voicesUseStreamingBuffers = true;
+
 
 	bool useStaticMatrix = false;
 
@@ -683,6 +776,8 @@ private:
 
 	hlac::HiseSampleBuffer temporaryVoiceBuffer;
 
+	OwnedArray<hlac::HiseSampleBuffer> workerVoiceBuffers;
+
 	float groupGainValues[8];
 
 	ChannelData channelData[NUM_MIC_POSITIONS];
@@ -958,6 +958,12 @@ void MonolithExporter::writeFiles(int channelIndex, bool overwriteExistingData)
 
 		dynamic_cast<hlac::HiseLosslessAudioFormatWriter*>(writer.get())->setOptions(options);
 
+		// Pass big chunks to the writer so that the encoder can compress the blocks on multiple threads.
+		// The chunk size must be a multiple of the block size because the last block of each write is padded.
+		const int numSamplesPerChunk = COMPRESSION_BLOCK_SIZE * 256;
+
+		AudioSampleBuffer chunk(writer->getNumChannels(), numSamplesPerChunk);
+
 		for (int i = 0; i < channelList->size(); i++)
 		{
 			setProgress((double)i / (double)numSamples);
@@ -966,7 +972,13 @@ void MonolithExporter::writeFiles(int channelIndex, bool overwriteExistingData)
 
 			if (reader != nullptr)
 			{
-				writer->writeFromAudioReader(*reader, 0, -1);
+				for (int64 pos = 0; pos < reader->lengthInSamples; pos += numSamplesPerChunk)
+				{
+					const int numThisTime = (int)jmin<int64>(numSamplesPerChunk, reader->lengthInSamples - pos);
+
+					reader->read(&chunk, 0, numThisTime, pos, true, true);
+					writer->writeFromAudioSampleBuffer(chunk, 0, numThisTime);
+				}
 			}
 			else
 			{
@@ -545,7 +545,7 @@ bool ModulatorSamplerSound::preloadBufferIsNonZero() const noexcept
 {
 	for (auto s: soundArray)
 	{
-		if (!s->isPurged() && s->getPreloadBuffer().getNumSamples() != 0)
+		if (!s->isPurged() && s->hasPreloadData())
 		{
 			return true;
 		}
@@ -668,6 +668,16 @@ void ModulatorSamplerSound::setPreloadPropertyInternal(Property p, int newValue)
 
 	auto f = [this, p, newValue](Processor*)->bool {
 		setPropertyInternal(p, newValue);
+
+		// Looped sounds can't be read from the memory mapped monolith, so the voices might need their streaming buffers again
+		if (p == LoopEnabled)
+		{
+			Processor::Iterator<ModulatorSampler> iter(getMainController()->getMainSynthChain());
+
+			while (auto s = iter.getNextProcessor())
+				s->refreshMemoryUsage();
+		}
+
 		return true;
 	};
 
@@ -722,7 +732,8 @@ updatePool(true),
 searchPool(true),
 forcePoolSearch(false),
 isCurrentlyLoading(false),
-asyncCleaner(*this)
+asyncCleaner(*this),
+blockCache(new hlac::HlacBlockCache())
 {
 	
 }
@@ -759,6 +770,10 @@ bool ModulatorSamplerSoundPool::loadMonolithicData(const ValueTree &sampleMap, c
 	try
 	{
 		hmaf->fillMetadataInfo(sampleMap);
+
+#if !USE_OLD_MONOLITH_FORMAT
+		hmaf->setBlockCache(blockCache);
+#endif
 	}
 	catch (StreamingSamplerSound::LoadingError l)
 	{
@@ -521,6 +521,12 @@ public:
 	*/
 	size_t getMemoryUsageForAllSamples() const noexcept;;
 
+	/** Returns the cache for decoded HLAC blocks that is shared by all monoliths of this pool.
+	*
+	*	You can use this to change the memory limit or to check the hit rate.
+	*/
+	hlac::HlacBlockCache& getDecodedBlockCache() noexcept { return *blockCache; }
+
 	String getTextForPoolTable(int columnId, int indexInPool);
 
 	// ================================================================================================================
@@ -582,6 +588,8 @@ private:
 
 	AsyncCleaner asyncCleaner;
 
+	hlac::HlacBlockCache::Ptr blockCache;
+
 	ReferenceCountedArray<MonolithInfoToUse> loadedMonoliths;
 
 	int getSoundIndexFromPool(int64 hashCode, int64 otherPossibleHashCode);
@@ -108,7 +108,7 @@ void ModulatorSamplerVoice::calculateBlock(int startSample, int numSamples)
 	const int startIndex = startSample;
 	const int samplesInBlock = numSamples;
 
-	float *voicePitchValues = isPitchModulationActive() ? getVoicePitchValues() : nullptr;
+	float *voicePitchValues = getModulatedVoicePitchValues();
 	const double propertyPitch = currentlyPlayingSamplerSound->getPropertyPitch();
 	
 	const double pitchCounter = limitPitchDataToMaxSamplerPitch(voicePitchValues, uptimeDelta * propertyPitch, startSample, numSamples);
@@ -118,6 +118,7 @@ void ModulatorSamplerVoice::calculateBlock(int startSample, int numSamples)
 	wrappedVoice.setPitchCounterForThisBlock(pitchCounter);
 	wrappedVoice.setPitchValues(voicePitchValues);
 	wrappedVoice.setDynamicPitchFactor(propertyPitch);
+	wrappedVoice.setTemporaryVoiceBuffer(sampler->getTemporaryVoiceBuffer());
 
 	voiceBuffer.clear();
 
@@ -137,8 +138,8 @@ void ModulatorSamplerVoice::calculateBlock(int startSample, int numSamples)
 
 	getOwnerSynth()->effectChain->renderVoice(voiceIndex, voiceBuffer, startIndex, samplesInBlock);
 
-	FloatVectorOperations::multiply(voiceBuffer.getWritePointer(0, startIndex), modValues + startIndex, samplesInBlock);
-	FloatVectorOperations::multiply(voiceBuffer.getWritePointer(1, startIndex), modValues + startIndex, samplesInBlock);
+	applyVoiceGainValues(voiceBuffer.getWritePointer(0, startIndex), modValues, startIndex, samplesInBlock);
+	applyVoiceGainValues(voiceBuffer.getWritePointer(1, startIndex), modValues, startIndex, samplesInBlock);
 
 	const float propertyGain = currentlyPlayingSamplerSound->getPropertyVolume();
 	const float normalizationGain = currentlyPlayingSamplerSound->getNormalizedPeak();
@@ -240,6 +241,16 @@ double ModulatorSamplerVoice::getDiskUsage()
 	return wrappedVoice.getDiskUsage();
 }
 
+void ModulatorSamplerVoice::addStreamingStatistics(StreamingStatistics& target, bool resetStatistics)
+{
+	auto& stats = wrappedVoice.getStreamingStatistics();
+
+	target.addStatistics(stats);
+
+	if (resetStatistics)
+		stats.reset();
+}
+
 size_t ModulatorSamplerVoice::getStreamingBufferSize() const
 {
 	return wrappedVoice.loader.getActualStreamingBufferSize();
@@ -252,6 +263,16 @@ void ModulatorSamplerVoice::setStreamingBufferDataType(bool shouldBeFloat)
 	wrappedVoice.loader.setStreamingBufferDataType(shouldBeFloat);
 }
 
+void ModulatorSamplerVoice::setUseStreamingBuffers(bool shouldUseStreamingBuffers)
+{
+	wrappedVoice.loader.setUseStreamingBuffers(shouldUseStreamingBuffers);
+}
+
+void ModulatorSamplerVoice::setInterpolationMode(SampleInterpolator::InterpolationMode newMode)
+{
+	wrappedVoice.setInterpolationMode(newMode);
+}
+
 const float * ModulatorSamplerVoice::getCrossfadeModulationValues(int startSample, int numSamples)
 {
 
@@ -350,7 +371,7 @@ void MultiMicModulatorSamplerVoice::calculateBlock(int startSample, int numSampl
 	const int startIndex = startSample;
 	const int samplesInBlock = numSamples;
 
-	float *voicePitchValues = isPitchModulationActive() ? getVoicePitchValues() : nullptr;
+	float *voicePitchValues = getModulatedVoicePitchValues();
 	const double propertyPitch = (float)currentlyPlayingSamplerSound->getPropertyPitch();
 	const double pitchCounter = limitPitchDataToMaxSamplerPitch(voicePitchValues, uptimeDelta * propertyPitch, startSample, numSamples);
 
@@ -367,6 +388,7 @@ void MultiMicModulatorSamplerVoice::calculateBlock(int startSample, int numSampl
 		wrappedVoices[i]->setPitchValues(voicePitchValues);
 		wrappedVoices[i]->setPitchCounterForThisBlock(pitchCounter);
 		wrappedVoices[i]->uptimeDelta = uptimeDelta * propertyPitch;
+		wrappedVoices[i]->setTemporaryVoiceBuffer(sampler->getTemporaryVoiceBuffer());
 
 		float *leftChannel = voiceBuffer.getWritePointer(2*i);
 		float *rightChannel = voiceBuffer.getWritePointer(2*i + 1);
@@ -402,8 +424,8 @@ void MultiMicModulatorSamplerVoice::calculateBlock(int startSample, int numSampl
 		if (wrappedVoices[i]->getLoadedSound() == nullptr) continue;
 
 		// Apply Modulation
-		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(2*i, startIndex), modValues + startIndex, samplesInBlock);
-		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(2*i + 1, startIndex), modValues + startIndex, samplesInBlock);
+		applyVoiceGainValues(voiceBuffer.getWritePointer(2*i, startIndex), modValues, startIndex, samplesInBlock);
+		applyVoiceGainValues(voiceBuffer.getWritePointer(2*i + 1, startIndex), modValues, startIndex, samplesInBlock);
 
 		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(2*i, startIndex), lSum, samplesInBlock);
 		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(2*i + 1, startIndex), rSum, samplesInBlock);
@@ -463,6 +485,19 @@ double MultiMicModulatorSamplerVoice::getDiskUsage()
 	return diskUsage;
 }
 
+void MultiMicModulatorSamplerVoice::addStreamingStatistics(StreamingStatistics& target, bool resetStatistics)
+{
+	for (int i = 0; i < wrappedVoices.size(); i++)
+	{
+		auto& stats = wrappedVoices[i]->getStreamingStatistics();
+
+		target.addStatistics(stats);
+
+		if (resetStatistics)
+			stats.reset();
+	}
+}
+
 size_t MultiMicModulatorSamplerVoice::getStreamingBufferSize() const
 {
 	size_t size = 0;
@@ -483,6 +518,22 @@ void MultiMicModulatorSamplerVoice::setStreamingBufferDataType(bool shouldBeFloa
 	}
 }
 
+void MultiMicModulatorSamplerVoice::setUseStreamingBuffers(bool shouldUseStreamingBuffers)
+{
+	for (int i = 0; i < wrappedVoices.size(); i++)
+	{
+		wrappedVoices[i]->loader.setUseStreamingBuffers(shouldUseStreamingBuffers);
+	}
+}
+
+void MultiMicModulatorSamplerVoice::setInterpolationMode(SampleInterpolator::InterpolationMode newMode)
+{
+	for (int i = 0; i < wrappedVoices.size(); i++)
+	{
+		wrappedVoices[i]->setInterpolationMode(newMode);
+	}
+}
+
 void MultiMicModulatorSamplerVoice::resetVoice()
 {
 	sampler->resetNoteDisplay(this->getCurrentlyPlayingNote());
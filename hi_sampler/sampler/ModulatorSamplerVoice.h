@@ -71,8 +71,17 @@ public:
 	virtual double getDiskUsage();
 	virtual size_t getStreamingBufferSize() const;
 
+	/** Adds the streaming statistics of this voice to the given object and optionally resets them. */
+	virtual void addStreamingStatistics(StreamingStatistics& target, bool resetStatistics);
+
 	virtual void setStreamingBufferDataType(bool shouldBeFloat);
 
+	/** Enables or disables the allocation of the streaming buffers (see SampleLoader::setUseStreamingBuffers()). */
+	virtual void setUseStreamingBuffers(bool shouldUseStreamingBuffers);
+
+	/** Sets the resampling algorithm of the wrapped voice. */
+	virtual void setInterpolationMode(SampleInterpolator::InterpolationMode newMode);
+
 	// ================================================================================================================
 
 	const float *getCrossfadeModulationValues(int startSample, int numSamples);
@@ -138,8 +147,14 @@ public:
 	double getDiskUsage() override;
 	size_t getStreamingBufferSize() const override;
 
+	void addStreamingStatistics(StreamingStatistics& target, bool resetStatistics) override;
+
 	void setStreamingBufferDataType(bool shouldBeFloat) override;
 
+	void setUseStreamingBuffers(bool shouldUseStreamingBuffers) override;
+
+	void setInterpolationMode(SampleInterpolator::InterpolationMode newMode) override;
+
 	/** Resets the display value for the current note. */
 	void resetVoice() override;
 
@@ -54,11 +54,13 @@
 #include "scripting/engine/JavascriptEngineStatements.cpp"
 #include "scripting/engine/JavascriptEngineOperators.cpp"
 #include "scripting/engine/JavascriptEngineCustom.cpp"
+#include "scripting/engine/JavascriptEngineBytecode.cpp"
 #include "scripting/engine/JavascriptEngineParser.cpp"
 #include "scripting/engine/JavascriptEngineObjects.cpp"
 #include "scripting/engine/JavascriptEngineMathObject.cpp"
 #include "scripting/engine/JavascriptEngineAdditionalMethods.cpp"
 #include "scripting/engine/JavascriptEngineCyclicReferenceChecks.cpp"
+#include "scripting/engine/JavascriptEngineRealtimeChecks.cpp"
 
 #include "scripting/api/XmlApi.cpp"
 #include "scripting/api/ScriptingApiObjects.cpp"
@@ -604,6 +604,9 @@ JavascriptProcessor::SnippetResult JavascriptProcessor::compileInternal()
 
 			lastResult = scriptEngine->execute(getSnippet(i)->getSnippetAsFunction(), callbackId == onInit);
 
+			if (lastResult.wasOk() && isRealtimeCallback(callbackId))
+				lastResult = checkRealtimeCallback(callbackId);
+
 			if (!lastResult.wasOk())
 			{
 				debugError(thisAsProcessor, lastResult.getErrorMessage());
@@ -772,6 +775,32 @@ const JavascriptProcessor::SnippetDocument * JavascriptProcessor::getSnippet(con
 	return nullptr;
 }
 
+bool JavascriptProcessor::isRealtimeCallback(const Identifier& callbackId) const
+{
+	static const Identifier onInit("onInit");
+	static const Identifier onControl("onControl");
+	static const Identifier prepareToPlay("prepareToPlay");
+
+	return callbackId != onInit && callbackId != onControl && callbackId != prepareToPlay;
+}
+
+Result JavascriptProcessor::checkRealtimeCallback(const Identifier& callbackId)
+{
+	const StringArray problems = scriptEngine->checkRealtimeCallback(callbackId);
+
+	if (problems.isEmpty())
+		return Result::ok();
+
+#if HISE_ALLOCATION_FREE_CALLBACKS
+	return Result::fail("Allocation in realtime callback:\n" + problems.joinIntoString("\n"));
+#else
+	for (const auto& problem : problems)
+		debugToConsole(dynamic_cast<Processor*>(this), "Warning: " + problem);
+
+	return Result::ok();
+#endif
+}
+
 #if 0
 void JavascriptProcessor::DelayedPositionUpdater::scriptComponentChanged(ReferenceCountedObject *componentThatWasChanged, Identifier idThatWasChanged)
 {
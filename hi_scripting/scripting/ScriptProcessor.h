@@ -378,6 +378,15 @@ public:
 	SnippetDocument *getSnippet(const Identifier& id);
 	const SnippetDocument *getSnippet(const Identifier& id) const;
 
+	/** Returns true if the callback can be executed in the audio thread. By default, these are all callbacks except for
+	*	onInit, onControl and prepareToPlay. */
+	virtual bool isRealtimeCallback(const Identifier& callbackId) const;
+
+	/** Checks the callback for expressions that allocate memory. The problems are either written to the console or 
+	*	fail the compilation (if HISE_ALLOCATION_FREE_CALLBACKS is enabled). A callback without problems fires an assertion
+	*	if it allocates anyway (if HISE_COUNT_SCRIPT_ALLOCATIONS is enabled). */
+	Result checkRealtimeCallback(const Identifier& callbackId);
+
 
 	
 
@@ -159,6 +159,7 @@ void JavascriptMidiProcessor::processHiseEvent(HiseEvent &m)
 	else
 	{
 		ADD_GLITCH_DETECTOR(this, DebugLogger::Location::ScriptMidiEventCallback);
+		ADD_CPU_PROFILER_SCOPE(this, DebugLogger::Location::ScriptMidiEventCallback);
 
 		if (currentMidiMessage != nullptr)
 		{
@@ -1151,10 +1152,13 @@ void JavascriptEnvelopeModulator::calculateBlock(int startSample, int numSamples
 	const int voiceIndex = polyManager.getCurrentVoice();
 	ScriptEnvelopeState* state = static_cast<ScriptEnvelopeState*>(states[voiceIndex]);
 
+	const int c = getWorkingChannel();
 
 	if (!renderVoiceCallback->isSnippetEmpty() && lastResult.wasOk())
 	{
-		buffer->referToData(internalBuffer.getWritePointer(0, startSample), numSamples);
+		SpinLock::ScopedLockType svl(renderVoiceLock);
+
+		buffer->referToData(internalBuffer.getWritePointer(c, startSample), numSamples);
 
 		ScopedReadLock sl(mainController->getCompileLock());
 
@@ -1172,7 +1176,7 @@ void JavascriptEnvelopeModulator::calculateBlock(int startSample, int numSamples
 	}
 
 #if ENABLE_ALL_PEAK_METERS
-	setOutputValue(internalBuffer.getSample(0, startSample));
+	setOutputValue(internalBuffer.getSample(c, startSample));
 #endif
 
 }
@@ -1385,8 +1389,8 @@ public:
 
 		getOwnerSynth()->effectChain->renderVoice(voiceIndex, voiceBuffer, startIndex, samplesToCopy);
 
-		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(0, startIndex), modValues + startIndex, samplesToCopy);
-		FloatVectorOperations::multiply(voiceBuffer.getWritePointer(1, startIndex), modValues + startIndex, samplesToCopy);
+		applyVoiceGainValues(voiceBuffer.getWritePointer(0, startIndex), modValues, startIndex, samplesToCopy);
+		applyVoiceGainValues(voiceBuffer.getWritePointer(1, startIndex), modValues, startIndex, samplesToCopy);
 	}
 
 	Array<var> channels;
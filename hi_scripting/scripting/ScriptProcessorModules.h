@@ -99,6 +99,9 @@ public:
 	void deferCallbacks(bool addToFront_);
 	bool isDeferred() const { return deferred; };
 
+	/** The callbacks of a deferred script are executed on the message thread, so they are not checked for allocations. */
+	bool isRealtimeCallback(const Identifier& callbackId) const override { return !isDeferred() && JavascriptProcessor::isRealtimeCallback(callbackId); }
+
 	void handleAsyncUpdate() override;
 
 	
@@ -365,6 +368,7 @@ public:
 	ProcessorEditorBody *createEditor(ProcessorEditor *parentEditor)  override;
 
 	void handleHiseEvent(const HiseEvent &m) override;
+	bool reactsToControllerEvents() const override { return true; }
 	void prepareToPlay(double sampleRate, int samplesPerBlock) override;
 	void calculateBlock(int startSample, int numSamples) override;;
 
@@ -408,6 +412,9 @@ private:
 	VariantBuffer::Ptr buffer;
 	var bufferVar;
 
+	// The script engine and the buffer are shared, so the voices can't be calculated in parallel
+	SpinLock renderVoiceLock;
+
 	ScopedPointer<SnippetDocument> onInitCallback;
 	ScopedPointer<SnippetDocument> prepareToPlayCallback;
 	ScopedPointer<SnippetDocument> renderVoiceCallback;
@@ -913,6 +913,9 @@ struct ScriptingApi::Engine::Wrapper
 	API_VOID_METHOD_WRAPPER_1(Engine, setHostBpm);
 	API_METHOD_WRAPPER_0(Engine, getCpuUsage);
 	API_METHOD_WRAPPER_0(Engine, getNumVoices);
+	API_METHOD_WRAPPER_1(Engine, getStreamingStatistics);
+	API_VOID_METHOD_WRAPPER_1(Engine, setPreloadMemoryBudget);
+	API_VOID_METHOD_WRAPPER_1(Engine, setDecodedBlockCacheSize);
 	API_METHOD_WRAPPER_0(Engine, getMemoryUsage);
 	API_METHOD_WRAPPER_1(Engine, getMilliSecondsForTempo);
 	API_METHOD_WRAPPER_1(Engine, getSamplesForMilliSeconds);
@@ -939,6 +942,8 @@ struct ScriptingApi::Engine::Wrapper
 	API_VOID_METHOD_WRAPPER_1(Engine, saveUserPreset);
 	API_METHOD_WRAPPER_0(Engine, createSliderPackData);
 	API_METHOD_WRAPPER_0(Engine, createMidiList);
+	API_METHOD_WRAPPER_1(Engine, createFloat32Array);
+	API_METHOD_WRAPPER_1(Engine, createInt32Array);
 	API_METHOD_WRAPPER_0(Engine, createTimerObject);
 	API_METHOD_WRAPPER_0(Engine, createMessageHolder);
 	API_METHOD_WRAPPER_0(Engine, getPlayHead);
@@ -975,6 +980,9 @@ ApiClass(0)
 	ADD_API_METHOD_1(setHostBpm);
 	ADD_API_METHOD_0(getCpuUsage);
 	ADD_API_METHOD_0(getNumVoices);
+	ADD_API_METHOD_1(getStreamingStatistics);
+	ADD_API_METHOD_1(setPreloadMemoryBudget);
+	ADD_API_METHOD_1(setDecodedBlockCacheSize);
 	ADD_API_METHOD_0(getMemoryUsage);
 	ADD_API_METHOD_1(getMilliSecondsForTempo);
 	ADD_API_METHOD_1(getSamplesForMilliSeconds);
@@ -999,6 +1007,8 @@ ApiClass(0)
 	ADD_API_METHOD_1(loadUserPreset);
 	ADD_API_METHOD_0(getUserPresetList);
 	ADD_API_METHOD_0(createMidiList);
+	ADD_API_METHOD_1(createFloat32Array);
+	ADD_API_METHOD_1(createInt32Array);
 	ADD_API_METHOD_0(getPlayHead);
 	ADD_API_METHOD_2(dumpAsJSON);
 	ADD_API_METHOD_1(loadFromJSON);
@@ -1102,6 +1112,19 @@ double ScriptingApi::Engine::getMemoryUsage() const
 
 double ScriptingApi::Engine::getCpuUsage() const { return (double)getProcessor()->getMainController()->getCpuUsage(); }
 int ScriptingApi::Engine::getNumVoices() const { return getProcessor()->getMainController()->getNumActiveVoices(); }
+var ScriptingApi::Engine::getStreamingStatistics(bool resetStatistics) { return getProcessor()->getMainController()->getSampleManager().getStreamingStatistics(resetStatistics); }
+
+void ScriptingApi::Engine::setPreloadMemoryBudget(double megaBytes)
+{
+	getProcessor()->getMainController()->getSampleManager().getMemoryGovernor().setMemoryBudget((int64)(jmax<double>(0.0, megaBytes) * 1024.0 * 1024.0));
+}
+
+void ScriptingApi::Engine::setDecodedBlockCacheSize(double megaBytes)
+{
+	auto& blockCache = getProcessor()->getMainController()->getSampleManager().getModulatorSamplerSoundPool()->getDecodedBlockCache();
+
+	blockCache.setMemoryLimit((size_t)(jmax<double>(0.0, megaBytes) * 1024.0 * 1024.0));
+}
 
 String ScriptingApi::Engine::getMacroName(int index)
 {
@@ -1326,6 +1349,28 @@ int ScriptingApi::Engine::isControllerUsedByAutomation(int controllerNumber)
 
 ScriptingObjects::MidiList *ScriptingApi::Engine::createMidiList() { return new ScriptingObjects::MidiList(getScriptProcessor()); };
 
+var ScriptingApi::Engine::createFloat32Array(int size)
+{
+	if (size <= 0)
+	{
+		reportScriptError("createFloat32Array: the size must be greater than zero");
+		RETURN_IF_NO_THROW(var())
+	}
+
+	return var(new ScriptingObjects::TypedArray(getScriptProcessor(), ScriptingObjects::TypedArray::DataType::Float32, size));
+}
+
+var ScriptingApi::Engine::createInt32Array(int size)
+{
+	if (size <= 0)
+	{
+		reportScriptError("createInt32Array: the size must be greater than zero");
+		RETURN_IF_NO_THROW(var())
+	}
+
+	return var(new ScriptingObjects::TypedArray(getScriptProcessor(), ScriptingObjects::TypedArray::DataType::Int32, size));
+}
+
 ScriptingObjects::ScriptSliderPackData* ScriptingApi::Engine::createSliderPackData() { return new ScriptingObjects::ScriptSliderPackData(getScriptProcessor()); }
 
 ScriptingObjects::TimerObject* ScriptingApi::Engine::createTimerObject() { return new ScriptingObjects::TimerObject(getScriptProcessor()); }
@@ -1970,6 +2015,11 @@ struct ScriptingApi::Synth::Wrapper
 	API_METHOD_WRAPPER_1(Synth, isKeyDown);
 	API_VOID_METHOD_WRAPPER_1(Synth, setClockSpeed);
 	API_VOID_METHOD_WRAPPER_1(Synth, setShouldKillRetriggeredNote);
+	API_VOID_METHOD_WRAPPER_1(Synth, setVoiceStealingPolicy);
+	API_METHOD_WRAPPER_1(Synth, getNumStolenVoices);
+	API_VOID_METHOD_WRAPPER_1(Synth, setUseParallelRendering);
+	API_VOID_METHOD_WRAPPER_1(Synth, setUseParallelVoiceRendering);
+	API_METHOD_WRAPPER_0(Synth, getChildRenderTimes);
 };
 
 
@@ -2034,6 +2084,11 @@ ScriptingApi::Synth::Synth(ProcessorWithScriptingContent *p, ModulatorSynth *own
 	ADD_API_METHOD_1(isKeyDown);
 	ADD_API_METHOD_1(setClockSpeed);
 	ADD_API_METHOD_1(setShouldKillRetriggeredNote);
+	ADD_API_METHOD_1(setVoiceStealingPolicy);
+	ADD_API_METHOD_1(getNumStolenVoices);
+	ADD_API_METHOD_1(setUseParallelRendering);
+	ADD_API_METHOD_1(setUseParallelVoiceRendering);
+	ADD_API_METHOD_0(getChildRenderTimes);
 	
 };
 
@@ -2877,6 +2932,59 @@ void ScriptingApi::Synth::setShouldKillRetriggeredNote(bool killNote)
 	}
 }
 
+void ScriptingApi::Synth::setVoiceStealingPolicy(int policyIndex)
+{
+	if (!isPositiveAndBelow(policyIndex, (int)ModulatorSynth::VoiceStealingPolicy::numVoiceStealingPolicies))
+	{
+		reportScriptError("Illegal voice stealing policy: " + String(policyIndex));
+		return;
+	}
+
+	if (owner != nullptr)
+	{
+		owner->setVoiceStealingPolicy((ModulatorSynth::VoiceStealingPolicy)policyIndex);
+	}
+}
+
+int ScriptingApi::Synth::getNumStolenVoices(int policyIndex) const
+{
+	if (!isPositiveAndBelow(policyIndex, (int)ModulatorSynth::VoiceStealingPolicy::numVoiceStealingPolicies))
+	{
+		reportScriptError("Illegal voice stealing policy: " + String(policyIndex));
+		RETURN_IF_NO_THROW(0)
+	}
+
+	return owner != nullptr ? owner->getNumStolenVoices((ModulatorSynth::VoiceStealingPolicy)policyIndex) : 0;
+}
+
+void ScriptingApi::Synth::setUseParallelRendering(bool shouldRenderInParallel)
+{
+	if (auto chain = dynamic_cast<ModulatorSynthChain*>(owner))
+		chain->setUseParallelRendering(shouldRenderInParallel);
+	else
+		reportScriptError("setUseParallelRendering() can only be called on Containers");
+}
+
+void ScriptingApi::Synth::setUseParallelVoiceRendering(bool shouldRenderVoicesInParallel)
+{
+	if (owner == nullptr || !owner->canRenderVoicesInParallel())
+	{
+		reportScriptError("setUseParallelVoiceRendering() can't be called on this synth");
+		return;
+	}
+
+	owner->setUseParallelVoiceRendering(shouldRenderVoicesInParallel);
+}
+
+var ScriptingApi::Synth::getChildRenderTimes() const
+{
+	if (auto chain = dynamic_cast<const ModulatorSynthChain*>(owner))
+		return chain->getChildRenderTimes();
+
+	reportScriptError("getChildRenderTimes() can only be called on Containers");
+	RETURN_IF_NO_THROW(var())
+}
+
 var ScriptingApi::Synth::getAllModulators(String regex)
 {
 	Processor::Iterator<Modulator> iter(owner->getMainController()->getMainSynthChain());
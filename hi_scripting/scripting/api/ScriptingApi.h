@@ -283,6 +283,15 @@ public:
 		/** Returns the amount of currently active voices. */
 		int getNumVoices() const;
 
+		/** Returns an object with the disk streaming statistics (latency histogram, buffer headroom, underruns and bytes per second). */
+		var getStreamingStatistics(bool resetStatistics);
+
+		/** Sets a memory budget in MB for the preload buffers of all samplers. The buffers of the least recently played sounds will be shrunk if the budget is exceeded. 0 disables the budget. */
+		void setPreloadMemoryBudget(double megaBytes);
+
+		/** Sets the memory limit in MB for the cache of decoded HLAC blocks. This clears the cache and 0 disables it. */
+		void setDecodedBlockCacheSize(double megaBytes);
+
 		/** Returns the name for the given macro index. */
 		String getMacroName(int index);
 		
@@ -325,6 +334,12 @@ public:
 		/** Creates a MIDI List object. */
         ScriptingObjects::MidiList *createMidiList(); 
 
+		/** Creates a fixed size array of float numbers that can be used in the realtime callbacks. */
+		var createFloat32Array(int size);
+
+		/** Creates a fixed size array of integer numbers that can be used in the realtime callbacks. */
+		var createInt32Array(int size);
+
 		/** Creates a SliderPack Data object. */
 		ScriptingObjects::ScriptSliderPackData* createSliderPackData();
 
@@ -542,6 +557,21 @@ public:
 		/** If set to true, this will kill retriggered notes (default). */
 		void setShouldKillRetriggeredNote(bool killNote);
 
+		/** Sets the voice stealing policy (0 = released voices first (default), 1 = oldest, 2 = lowest amplitude, 3 = same note first). */
+		void setVoiceStealingPolicy(int policyIndex);
+
+		/** Returns the number of voices that were stolen with the given voice stealing policy. */
+		int getNumStolenVoices(int policyIndex) const;
+
+		/** Renders the child synths of this container on multiple threads. The MIDI callbacks of the children are still called on the audio thread. */
+		void setUseParallelRendering(bool shouldRenderInParallel);
+
+		/** Renders the voices of this synth on multiple threads. This needs at least a few active voices per thread to pay off. */
+		void setUseParallelVoiceRendering(bool shouldRenderVoicesInParallel);
+
+		/** Returns the render time of the last block in milliseconds for every child synth of this container (with the IDs as keys). */
+		var getChildRenderTimes() const;
+
 		/** Returns an array of all modulators that match the given regex. */
 		var getAllModulators(String regex);
 
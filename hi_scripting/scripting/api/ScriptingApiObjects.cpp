@@ -156,6 +156,189 @@ void ScriptingObjects::MidiList::restoreFromBase64String(String base64encodedVal
 	Base64::convertFromBase64(stream, base64encodedValues);
 }
 
+// TypedArray ===================================================================================================================
+
+struct ScriptingObjects::TypedArray::Wrapper
+{
+	API_VOID_METHOD_WRAPPER_1(TypedArray, fill);
+	API_VOID_METHOD_WRAPPER_0(TypedArray, clear);
+	API_VOID_METHOD_WRAPPER_1(TypedArray, copyFrom);
+	API_VOID_METHOD_WRAPPER_1(TypedArray, multiply);
+	API_VOID_METHOD_WRAPPER_2(TypedArray, addWithMultiply);
+	API_METHOD_WRAPPER_0(TypedArray, getMin);
+	API_METHOD_WRAPPER_0(TypedArray, getMax);
+	API_METHOD_WRAPPER_0(TypedArray, getSum);
+};
+
+ScriptingObjects::TypedArray::TypedArray(ProcessorWithScriptingContent *p, DataType type_, int size_) :
+ConstScriptingObject(p, 1),
+type(type_),
+size(jmax<int>(0, size_))
+{
+	addConstant("length", size);
+
+	ADD_API_METHOD_1(fill);
+	ADD_API_METHOD_0(clear);
+	ADD_API_METHOD_1(copyFrom);
+	ADD_API_METHOD_1(multiply);
+	ADD_API_METHOD_2(addWithMultiply);
+	ADD_API_METHOD_0(getMin);
+	ADD_API_METHOD_0(getMax);
+	ADD_API_METHOD_0(getSum);
+
+	if (isFloat())
+		floatData.calloc(size);
+	else
+		intData.calloc(size);
+}
+
+const ScriptingObjects::TypedArray* ScriptingObjects::TypedArray::getTypedArray(const var& v) const
+{
+	return dynamic_cast<const TypedArray*>(v.getObject());
+}
+
+void ScriptingObjects::TypedArray::fill(var valueToFill)
+{
+	if (isFloat())
+	{
+		float v = (float)valueToFill;
+		FloatVectorOperations::fill(floatData, FloatSanitizers::sanitizeFloatNumber(v), size);
+	}
+	else
+		std::fill(intData.get(), intData + size, toIntegerElement((double)valueToFill));
+}
+
+void ScriptingObjects::TypedArray::clear()
+{
+	if (isFloat())
+		FloatVectorOperations::clear(floatData, size);
+	else
+		zeromem(intData, sizeof(int) * size);
+}
+
+void ScriptingObjects::TypedArray::copyFrom(var source)
+{
+	if (const TypedArray* other = getTypedArray(source))
+	{
+		const int numToCopy = jmin<int>(size, other->size);
+
+		if (isFloat() && other->isFloat())
+			FloatVectorOperations::copy(floatData, other->floatData, numToCopy);
+		else if (isFloat())
+			FloatVectorOperations::convertFixedToFloat(floatData, other->intData, 1.0f, numToCopy);
+		else if (other->isFloat())
+		{
+			for (int i = 0; i < numToCopy; i++)
+				intData[i] = toIntegerElement((double)other->floatData[i]);
+		}
+		else
+			memcpy(intData, other->intData, sizeof(int) * numToCopy);
+	}
+	else if (const Array<var>* a = source.getArray())
+	{
+		const int numToCopy = jmin<int>(size, a->size());
+
+		for (int i = 0; i < numToCopy; i++)
+			setElement(i, a->getUnchecked(i));
+	}
+	else
+		reportScriptError("copyFrom: the source must be an Array or a TypedArray");
+}
+
+void ScriptingObjects::TypedArray::multiply(var factor)
+{
+	if (isFloat())
+	{
+		FloatVectorOperations::multiply(floatData, (float)factor, size);
+		FloatSanitizers::sanitizeArray(floatData, size);
+	}
+	else
+	{
+		const double f = (double)factor;
+
+		for (int i = 0; i < size; i++)
+			intData[i] = toIntegerElement((double)intData[i] * f);
+	}
+}
+
+void ScriptingObjects::TypedArray::addWithMultiply(var source, var factor)
+{
+	const TypedArray* other = getTypedArray(source);
+
+	if (other == nullptr)
+	{
+		reportScriptError("addWithMultiply: the source must be a TypedArray");
+		RETURN_VOID_IF_NO_THROW()
+	}
+
+	const int numToAdd = jmin<int>(size, other->size);
+
+	if (isFloat() && other->isFloat())
+	{
+		FloatVectorOperations::addWithMultiply(floatData, other->floatData, (float)factor, numToAdd);
+		FloatSanitizers::sanitizeArray(floatData, numToAdd);
+	}
+	else
+	{
+		const double f = (double)factor;
+
+		for (int i = 0; i < numToAdd; i++)
+		{
+			const double v = (double)other->getElement(i) * f;
+
+			if (isFloat())
+			{
+				float sum = floatData[i] + (float)v;
+				floatData[i] = FloatSanitizers::sanitizeFloatNumber(sum);
+			}
+			else
+				intData[i] = toIntegerElement((double)intData[i] + v);
+		}
+	}
+}
+
+var ScriptingObjects::TypedArray::getMin() const
+{
+	if (size == 0)
+		return var(0);
+
+	if (isFloat())
+		return FloatVectorOperations::findMinimum(floatData, size);
+
+	return *std::min_element(intData.get(), intData + size);
+}
+
+var ScriptingObjects::TypedArray::getMax() const
+{
+	if (size == 0)
+		return var(0);
+
+	if (isFloat())
+		return FloatVectorOperations::findMaximum(floatData, size);
+
+	return *std::max_element(intData.get(), intData + size);
+}
+
+var ScriptingObjects::TypedArray::getSum() const
+{
+	if (isFloat())
+	{
+		double sum = 0.0;
+
+		for (int i = 0; i < size; i++)
+			sum += floatData[i];
+
+		return sum;
+	}
+
+	int64 sum = 0;
+
+	for (int i = 0; i < size; i++)
+		sum += intData[i];
+
+	return sum;
+}
+
 void addScriptParameters(ConstScriptingObject* this_, Processor* p)
 {
 	DynamicObject::Ptr scriptedParameters = new DynamicObject();
@@ -171,6 +171,112 @@ public:
 		// ============================================================================================================
 	};
 
+	/** A fixed size array of 32bit float or integer numbers.
+	*
+	*	The data is allocated when the array is created, so you can use it in the realtime callbacks
+	*	without allocating memory. The elements are read and written directly by the [] operator and
+	*	the bulk operations of the Float32 arrays use the FloatVectorOperations.
+	*/
+	class TypedArray : public ConstScriptingObject,
+					   public DebugableObject
+	{
+	public:
+
+		enum class DataType
+		{
+			Float32 = 0,
+			Int32
+		};
+
+		// ============================================================================================================
+
+		TypedArray(ProcessorWithScriptingContent *p, DataType type_, int size_);
+		~TypedArray() {};
+
+		Identifier getObjectName() const override { RETURN_STATIC_IDENTIFIER("TypedArray"); }
+
+		String getDebugName() const override { return isFloat() ? "Float32Array" : "Int32Array"; };
+		String getDebugValue() const override { return String(size); };
+
+		bool isFloat() const noexcept { return type == DataType::Float32; }
+		int getNumElements() const noexcept { return size; }
+
+		/** Returns the element as var. The index must be checked by the caller. */
+		var getElement(int index) const noexcept
+		{
+			jassert(isPositiveAndBelow(index, size));
+
+			return isFloat() ? var(floatData[index]) : var(intData[index]);
+		}
+
+		/** Sets the element to the given value. The index must be checked by the caller. */
+		void setElement(int index, const var& newValue) noexcept
+		{
+			jassert(isPositiveAndBelow(index, size));
+
+			if (isFloat())
+			{
+				float v = (float)newValue;
+				floatData[index] = FloatSanitizers::sanitizeFloatNumber(v);
+			}
+			else
+				intData[index] = toIntegerElement((double)newValue);
+		}
+
+		// ================================================================================================ API METHODS
+
+		/** Sets all elements to the given value. */
+		void fill(var valueToFill);
+
+		/** Sets all elements to zero. */
+		void clear();
+
+		/** Copies the values from another typed array or an Array (up to the size of this array). */
+		void copyFrom(var source);
+
+		/** Multiplies all elements with the given factor. */
+		void multiply(var factor);
+
+		/** Adds the elements of another typed array multiplied with the factor to this array. */
+		void addWithMultiply(var source, var factor);
+
+		/** Returns the smallest element. */
+		var getMin() const;
+
+		/** Returns the biggest element. */
+		var getMax() const;
+
+		/** Returns the sum of all elements. */
+		var getSum() const;
+
+		// ============================================================================================================
+
+		struct Wrapper;
+
+	private:
+
+		const TypedArray* getTypedArray(const var& v) const;
+
+		/** Converts the value to an integer element. It's clamped to the int range (and NaN becomes zero), because casting an out of range float is undefined. */
+		static int toIntegerElement(double v) noexcept
+		{
+			if (std::isnan(v))
+				return 0;
+
+			return (int)jlimit<double>((double)std::numeric_limits<int>::min(), (double)std::numeric_limits<int>::max(), v);
+		}
+
+		const DataType type;
+		const int size;
+
+		HeapBlock<float> floatData;
+		HeapBlock<int> intData;
+
+		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TypedArray);
+
+		// ============================================================================================================
+	};
+
 	class ScriptSliderPackData : public ConstScriptingObject,
 								 public DebugableObject
 	{
@@ -98,7 +98,11 @@ void HiseJavascriptEngine::setBreakpoints(Array<Breakpoint> &breakpoints)
 }
 
 
-void HiseJavascriptEngine::prepareTimeout() const noexcept{ root->timeout = Time::getCurrentTime() + maximumExecutionTime; }
+void HiseJavascriptEngine::prepareTimeout() const noexcept
+{ 
+	root->timeout = Time::getMillisecondCounter() + (uint32)maximumExecutionTime.inMilliseconds();
+	root->numTimeoutChecksLeft = RootObject::TimeoutCheckInterval;
+}
 
 
 
@@ -457,9 +461,19 @@ struct HiseJavascriptEngine::RootObject::Scope
 
 	bool invokeMidiCallback(const Identifier &callbackName, const var::NativeFunctionArgs &args, var &result, DynamicObject*functionScope) const;
 
+	/** Checks if the script is running too long. 
+	*
+	*	This is called for every loop iteration and function call, so it only reads the clock 
+	*	every RootObject::TimeoutCheckInterval calls. 
+	*/
 	void checkTimeOut(const CodeLocation& location) const
 	{
-		if (Time::getCurrentTime() > root->timeout)
+		if (--root->numTimeoutChecksLeft > 0)
+			return;
+
+		root->numTimeoutChecksLeft = RootObject::TimeoutCheckInterval;
+
+		if ((int32)(Time::getMillisecondCounter() - root->timeout) > 0)
 			location.throwError("Execution timed-out");
 	}
 };
@@ -690,6 +704,30 @@ void HiseJavascriptEngine::setCallStackEnabled(bool shouldBeEnabled)
 	root->setCallStackEnabled(shouldBeEnabled);
 }
 
+void HiseJavascriptEngine::setUseBytecode(bool shouldUseBytecode)
+{
+	// The program must exist before the callbacks can pick it up
+	if (shouldUseBytecode)
+		root->compileBytecode();
+
+	root->useBytecode = shouldUseBytecode;
+}
+
+bool HiseJavascriptEngine::isUsingBytecode() const
+{
+	return root->useBytecode;
+}
+
+void HiseJavascriptEngine::setUsePropertyCache(bool shouldUsePropertyCache)
+{
+	root->usePropertyCache = shouldUsePropertyCache;
+}
+
+bool HiseJavascriptEngine::isUsingPropertyCache() const
+{
+	return root->usePropertyCache;
+}
+
 void HiseJavascriptEngine::registerApiClass(ApiClass *apiClass)
 {
 	root->hiseSpecialData.apiClasses.add(apiClass);
@@ -78,6 +78,18 @@ class DialogWindowWithBackgroundThread;
  *      
  *  @see VariantBuffer.
  *
+ *  **Typed Arrays**
+ *
+ *  Fixed size arrays of floats or integers which don't allocate after their creation. The [] operator reads
+ *  and writes the elements directly, so they can replace `Array` in the realtime callbacks:
+ *
+ *      const var pattern = Engine.createInt32Array(16);
+ *      const var table = Engine.createFloat32Array(128);
+ *      pattern[3] = 1;
+ *      table.multiply(0.5);             // Uses the FloatVectorOperations
+ *
+ *  @see ScriptingObjects::TypedArray
+ *
  *  **Register variables**
  *
  *  A special storage location with accelerated access / lookup times. There are 32 slots which can be directly
@@ -86,7 +98,13 @@ class DialogWindowWithBackgroundThread;
  *
  *  @see VarRegister
  *
+ *  **Bytecode**
  *
+ *  The callbacks and inline functions are compiled to a register based bytecode after parsing (if HISE_USE_SCRIPT_BYTECODE or setUseBytecode() is enabled).
+ *  Local variables, registers and API calls are resolved to slots at compile time and numbers are stored without boxing them into a var.
+ *  Everything else falls back to the expression tree, so the semantics and error locations stay the same.
+ *
+ *  @see setUseBytecode()
  *
  */
 class HiseJavascriptEngine
@@ -193,6 +211,34 @@ public:
 
 	void setCallStackEnabled(bool shouldBeEnabled);
 
+	/** Selects the backend that executes the callbacks and inline functions. 
+	*
+	*	If this is false, the expression tree is interpreted directly. If it's true, the callbacks that haven't been compiled to
+	*	bytecode yet are compiled now, so don't call this while a callback is executed. Once compiled, the bytecode is kept, 
+	*	so you can switch back and forth between the backends (eg. for comparing the performance).
+	*
+	*	The default is HISE_USE_SCRIPT_BYTECODE.
+	*/
+	void setUseBytecode(bool shouldUseBytecode);
+
+	bool isUsingBytecode() const;
+
+	/** Enables the inline caches for the property lookups and method calls on objects (this is on by default).
+	*
+	*	If this is false, every access searches the properties of the object again (eg. for comparing the performance).
+	*/
+	void setUsePropertyCache(bool shouldUsePropertyCache);
+
+	bool isUsingPropertyCache() const;
+
+	/** Checks the callback for expressions that allocate memory (string concatenation, object and array literals, `new`,
+	*	growing arrays and calls of non-inline functions) and marks it as realtime callback.
+	*
+	*	Inline functions that are called by the callback are checked too. It returns a message with the location for
+	*	every problem.
+	*/
+	StringArray checkRealtimeCallback(const Identifier& callbackName);
+
 	CriticalSection& getDebugLock() const;
 
 	void registerApiClass(ApiClass *apiClass);
@@ -335,7 +381,14 @@ public:
 	{
 		RootObject();
 
-		Time timeout;
+		/** The number of timeout checks between two clock reads. */
+		static constexpr int TimeoutCheckInterval = 128;
+
+		/** The deadline of the current execution (see Time::getMillisecondCounter()). */
+		uint32 timeout = 0;
+
+		/** Counts down the timeout checks until the clock is read again. */
+		int numTimeoutChecksLeft = 0;
 
 		Array<Breakpoint> breakpoints;
 
@@ -409,6 +462,10 @@ public:
 
 			String getEncodedLocation(Processor* p) const
 			{
+				// The engine can be used without a processor (eg. in the unit tests)
+				if (p == nullptr)
+					return String();
+
 				String l;
 
 				l << p->getId() << "|";
@@ -480,6 +537,7 @@ public:
 
 		struct FunctionCall;			struct NewOperator;			struct DotOperator;
 		struct ObjectDeclaration;		struct ArrayDeclaration;	struct FunctionObject;
+		struct PropertyCache;
 
 		// HISE special
 
@@ -491,6 +549,39 @@ public:
 		struct CallbackLocalStatement;  struct CallbackLocalReference;  struct ExternalCFunction;
 		struct NativeJIT;				struct IsDefinedTest;
 
+		// Bytecode backend
+
+		struct BytecodeProgram;			struct BytecodeCompiler;
+
+		// Realtime checks
+
+		struct RealtimeChecker;
+
+		/** Counts the heap allocations of the current thread while a callback is executed.
+		*
+		*	The script operations that allocate (string concatenation, object and array literals and growing arrays)
+		*	report this to the active counter of the thread. If HISE_COUNT_ALL_SCRIPT_ALLOCATIONS is enabled, the global
+		*	operator new reports every allocation too. If the counter traps allocations, every allocation will fire an assertion.
+		*/
+		struct AllocationCounter
+		{
+			AllocationCounter(bool shouldTrapAllocations) noexcept;
+			~AllocationCounter();
+
+			/** Adds the allocation to the active counter of this thread (if there is one). */
+			static void addAllocation(size_t numBytes) noexcept;
+
+			int numAllocations = 0;
+			int64 numBytes = 0;
+
+		private:
+
+			AllocationCounter* previousCounter;
+			const bool trapAllocations;
+
+			JUCE_DECLARE_NON_COPYABLE(AllocationCounter);
+		};
+
 		// Parser classes
 
 		struct TokenIterator;
@@ -531,10 +622,14 @@ public:
 
 			Callback(const Identifier &id, int numArgs, double bufferTime_);
 
+			~Callback();
+
 			var perform(RootObject *root);
 
 			void setStatements(BlockStatement *s) noexcept;
 
+			BlockStatement* getStatements() const noexcept { return statements; }
+
 			bool isDefined() const noexcept{ return isCallbackDefined; }
 
 			const Identifier &getName() const { return callbackName; }
@@ -563,9 +658,27 @@ public:
 			String getDebugValue() const override 
 			{
 				const double percentage = lastExecutionTime / bufferTime * 100.0;
+
+#if HISE_COUNT_SCRIPT_ALLOCATIONS
+				if (lastNumAllocations > 0)
+					return String(percentage, 2) + "%, " + String(lastNumAllocations) + " allocations (" + String(lastNumAllocatedBytes) + " bytes)";
+#endif
+
 				return String(percentage, 2) + "%";
 			}
 
+			/** Marks the callback as realtime callback. If it has no warnings, an allocation fires an assertion (if HISE_COUNT_SCRIPT_ALLOCATIONS is enabled). */
+			void setRealtimeCallback(bool isRealtimeCallback, bool shouldTrapAllocations) noexcept 
+			{ 
+				realtimeCallback = isRealtimeCallback; 
+				trapAllocations = isRealtimeCallback && shouldTrapAllocations;
+			}
+
+			bool isRealtimeCallback() const noexcept { return realtimeCallback; }
+
+			int getNumAllocations() const noexcept { return lastNumAllocations; }
+			int64 getNumAllocatedBytes() const noexcept { return lastNumAllocatedBytes; }
+
 			var createDynamicObjectForBreakpoint()
 			{
 				DynamicObject::Ptr object = new DynamicObject();
@@ -611,6 +724,8 @@ public:
 
 			NamedValueSet localProperties;
 
+			ScopedPointer<BytecodeProgram> program;
+
 		private:
 
 			ScopedPointer<BlockStatement> statements;
@@ -621,6 +736,11 @@ public:
 			const double bufferTime;
 
 			bool isCallbackDefined = false;
+			bool realtimeCallback = false;
+			bool trapAllocations = false;
+
+			int lastNumAllocations = 0;
+			int64 lastNumAllocatedBytes = 0;
 		};
 
 		struct JavascriptNamespace: public ReferenceCountedObject,
@@ -802,8 +922,15 @@ public:
 			shouldUseCycleCheck = true;
 		}
 
+		/** Compiles the bytecode for all callbacks and inline functions that were parsed since the last call. */
+		void compileBytecode();
+
 		HiseSpecialData hiseSpecialData;
 
+		bool useBytecode = HISE_USE_SCRIPT_BYTECODE != 0;
+
+		bool usePropertyCache = true;
+
 		private:
 
 		Array<CallStackEntry> callStack;
@@ -341,6 +341,23 @@ void ApiClass::getIndexAndNumArgsForFunction(const Identifier &id, int &index, i
 	numArgs = -1;
 }
 
+bool ApiClass::isFunctionAt(const Identifier &id, int index, int numArgs) const noexcept
+{
+	if (!isPositiveAndBelow(index, NUM_API_FUNCTION_SLOTS))
+		return false;
+
+	switch (numArgs)
+	{
+	case 0: return id0[index] == id;
+	case 1: return id1[index] == id;
+	case 2: return id2[index] == id;
+	case 3: return id3[index] == id;
+	case 4: return id4[index] == id;
+	case 5: return id5[index] == id;
+	default: return false;
+	}
+}
+
 var ApiClass::callFunction(int index, var *args, int numArgs)
 {
 	if (index > NUM_API_FUNCTION_SLOTS)
@@ -227,6 +227,9 @@ public:
     *   The JavascriptEngine uses this to resolve the function call into a function pointer at compile time.
     *   When the script is executed, this information will be used for blazing fast access to the methods.*/
 	void getIndexAndNumArgsForFunction(const Identifier &id, int &index, int &numArgs) const;
+
+	/** Checks if the function with the given name is stored at the index (this is used to validate cached lookups). */
+	bool isFunctionAt(const Identifier &id, int index, int numArgs) const noexcept;
     
     /** Calls the function with the index and the argument data.
     *
@@ -196,7 +196,9 @@ var HiseJavascriptEngine::RootObject::FunctionCall::getResult(const Scope& s) co
 
 			if (ConstScriptingObject* c = dynamic_cast<ConstScriptingObject*>(thisObject.getObject()))
 			{
-				c->getIndexAndNumArgsForFunction(dot->child, functionIndex, numArgs);
+				// Objects of the same class have the function at the same slot, so the last lookup is reused
+				if (!s.root->usePropertyCache || !c->isFunctionAt(dot->child, functionIndex, numArgs))
+					c->getIndexAndNumArgsForFunction(dot->child, functionIndex, numArgs);
 
 				CHECK_CONDITION_WITH_LOCATION(functionIndex != -1, "function not found");
 				CHECK_CONDITION_WITH_LOCATION(numArgs == arguments.size(), "argument amount mismatch: " + String(arguments.size()) + ", Expected: " + String(numArgs));
@@ -211,9 +213,9 @@ var HiseJavascriptEngine::RootObject::FunctionCall::getResult(const Scope& s) co
 
 			if (DynamicObject* dynObj = thisObject.getDynamicObject())
 			{
-				var property = dynObj->getProperty(dot->child);
+				const var* property = dot->propertyCache.getPropertyPointer(s, dynObj, dot->child);
 
-				if (auto obj = dynamic_cast<InlineFunction::Object*>(property.getObject()))
+				if (auto obj = property != nullptr ? dynamic_cast<InlineFunction::Object*>(property->getObject()) : nullptr)
 				{
 					var parameters[5];
 
@@ -752,10 +754,20 @@ var HiseJavascriptEngine::executeCallback(int callbackIndex, Result *result)
 	return var();
 }
 
+HiseJavascriptEngine::RootObject::Callback::~Callback()
+{
+	program = nullptr;
+	statements = nullptr;
+}
+
 void HiseJavascriptEngine::RootObject::Callback::setStatements(BlockStatement *s) noexcept
 {
+	program = nullptr;
 	statements = s;
 	isCallbackDefined = s->statements.size() != 0;
+
+	// The script processor checks the callback again after the compilation
+	setRealtimeCallback(false, false);
 }
 
 
@@ -770,17 +782,29 @@ var HiseJavascriptEngine::RootObject::Callback::perform(RootObject *root)
 
 
 	root->addToCallStack(callbackName, nullptr);
+#endif
 
+	{
+#if HISE_COUNT_SCRIPT_ALLOCATIONS
+		AllocationCounter allocationCounter(trapAllocations);
+#endif
 
+		if (program != nullptr && root->useBytecode)
+			program->perform(s, &returnValue);
+		else
+			statements->perform(s, &returnValue);
 
-	statements->perform(s, &returnValue);
+#if HISE_COUNT_SCRIPT_ALLOCATIONS
+		lastNumAllocations = allocationCounter.numAllocations;
+		lastNumAllocatedBytes = allocationCounter.numBytes;
+#endif
+	}
 
+#if USE_BACKEND
 	root->removeFromCallStack(callbackName);
 
 	const double post = Time::getMillisecondCounterHiRes();
 	lastExecutionTime = post - pre;
-#else
-	statements->perform(s, &returnValue);
 #endif
 
 	return returnValue;
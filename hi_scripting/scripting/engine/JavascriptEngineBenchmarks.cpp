@@ -0,0 +1,548 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#include "AppConfig.h"
+
+#if HI_RUN_UNIT_TESTS
+
+#include  "JuceHeader.h"
+
+using namespace hise;
+
+/** The engine setup of the script tests in this file. */
+struct ScriptTestEngine
+{
+	/** The callbacks are indexed in the order of registration. */
+	enum Callbacks
+	{
+		OnInit = 0,
+		OnNoteOn
+	};
+
+	static HiseJavascriptEngine* create()
+	{
+		auto engine = new HiseJavascriptEngine(nullptr);
+		engine->registerGlobalStorge(new DynamicObject());
+
+		engine->registerCallbackName("onInit", 0, 0.0);
+		engine->registerCallbackName("onNoteOn", 0, 0.0);
+
+		return engine;
+	}
+};
+
+/** Runs a set of script callbacks with the bytecode backend and the expression tree interpreter.
+*
+*	Every script must return the same value with both backends. If HI_RUN_BENCHMARKS is enabled,
+*	the callbacks are also timed and the timings are written to the log so that you can compare the backends.
+*/
+class ScriptBackendTest : public UnitTest
+{
+public:
+
+	ScriptBackendTest() :
+		UnitTest("Testing the script backends")
+	{}
+
+	void runTest() override
+	{
+		testScript("Arithmetic with reg variables",
+			"reg x = 0;\n"
+			"reg i = 0;\n"
+			"function onNoteOn()\n"
+			"{\n"
+			"    x = 0;\n"
+			"    for(i = 0; i < 2000; i++)\n"
+			"        x += (i * 3) % 7 - i / 4;\n"
+			"    return x;\n"
+			"}\n");
+
+		testScript("Callback local variables and branches",
+			"function onNoteOn()\n"
+			"{\n"
+			"    local sum = 0;\n"
+			"    local j = 0;\n"
+			"    while(j < 2000)\n"
+			"    {\n"
+			"        if(j % 3 == 0) sum += j;\n"
+			"        else if (j & 1) sum -= 1;\n"
+			"        else { j++; continue; }\n"
+			"        if(sum > 100000) break;\n"
+			"        j++;\n"
+			"    }\n"
+			"    return sum;\n"
+			"}\n");
+
+		testScript("Math API calls",
+			"reg v = 0.0;\n"
+			"function onNoteOn()\n"
+			"{\n"
+			"    local i = 0;\n"
+			"    v = 0.0;\n"
+			"    for(i = 0; i < 1000; i++)\n"
+			"        v += Math.sin(i * 0.01) * Math.max(0.5, Math.abs(v));\n"
+			"    return v;\n"
+			"}\n");
+
+		testScript("Inline function calls",
+			"inline function mix(a, b, alpha)\n"
+			"{\n"
+			"    local inv = 1.0 - alpha;\n"
+			"    return a * inv + b * alpha;\n"
+			"}\n"
+			"reg y = 0.0;\n"
+			"reg i = 0;\n"
+			"function onNoteOn()\n"
+			"{\n"
+			"    y = 0.0;\n"
+			"    for(i = 0; i < 1000; i++)\n"
+			"        y = mix(y, i, 0.25);\n"
+			"    return y;\n"
+			"}\n");
+
+		testScript("Inline function calls with tree nodes",
+			"const var data = [1, 2, 3, 4];\n"
+			"reg x = 0;\n"
+			"inline function sumOf(list, offset)\n"
+			"{\n"
+			"    local sum = offset;\n"
+			"    for(x in list) sum += x;\n"
+			"    return sum;\n"
+			"}\n"
+			"inline function twice(v)\n"
+			"{\n"
+			"    return v * 2;\n"
+			"}\n"
+			"reg z = 0;\n"
+			"reg i = 0;\n"
+			"function onNoteOn()\n"
+			"{\n"
+			"    z = 0;\n"
+			"    for(i = 0; i < 500; i++)\n"
+			"        z += twice(sumOf(data, i));\n"
+			"    return z;\n"
+			"}\n");
+
+		testScript("Arrays and strings (tree fallback)",
+			"const var data = [];\n"
+			"reg i = 0;\n"
+			"reg e = 0;\n"
+			"for(i = 0; i < 128; i++) data[i] = i;\n"
+			"reg s = 0;\n"
+			"function onNoteOn()\n"
+			"{\n"
+			"    s = 0;\n"
+			"    for(e in data) s += e;\n"
+			"    for(i = 0; i < data.length; i++) s += data[i];\n"
+			"    return \"Sum: \" + s;\n"
+			"}\n");
+
+		testScript("Object property access",
+			"const var state = {\"gain\": 0.5, \"pan\": 0.0, \"voices\": 0, \"name\": \"Pad\"};\n"
+			"const var keys = [\"gain\", \"pan\", \"voices\"];\n"
+			"function onNoteOn()\n"
+			"{\n"
+			"    local i = 0;\n"
+			"    state.gain = 0.5;\n"
+			"    state.pan = 0.0;\n"
+			"    state.voices = 0;\n"
+			"    for(i = 0; i < 500; i++)\n"
+			"    {\n"
+			"        state.voices = state.voices + 1;\n"
+			"        state.pan = state.gain * 0.5 - state.pan;\n"
+			"        state[keys[i % 3]] += 1;\n"
+			"    }\n"
+			"    return state.voices + state[\"gain\"];\n"
+			"}\n", true);
+
+		testErrorLocation();
+	}
+
+private:
+
+	static constexpr int NumIterations = 200;
+
+	/** Runs the script with both backends. If comparePropertyCache is true, the bytecode also runs without the property cache. */
+	void testScript(const String& name, const String& code, bool comparePropertyCache=false)
+	{
+		beginTest(name);
+
+		ScopedPointer<HiseJavascriptEngine> engine = ScriptTestEngine::create();
+
+		const int callbackIndex = ScriptTestEngine::OnNoteOn;
+
+		auto r = engine->execute(code);
+
+		expect(r.wasOk(), r.getErrorMessage());
+
+		if (!r.wasOk())
+			return;
+
+		engine->setUseBytecode(false);
+		const var treeResult = run(*engine, callbackIndex);
+
+		engine->setUseBytecode(true);
+		expect(engine->isUsingBytecode(), "The bytecode is not active");
+
+		const var bytecodeResult = run(*engine, callbackIndex);
+
+		expectEquals(bytecodeResult.toString(), treeResult.toString(), "Result mismatch");
+
+		if (comparePropertyCache)
+		{
+			engine->setUsePropertyCache(false);
+			const var uncachedResult = run(*engine, callbackIndex);
+			engine->setUsePropertyCache(true);
+
+			expectEquals(uncachedResult.toString(), treeResult.toString(), "Result mismatch without the property cache");
+		}
+
+#if HI_RUN_BENCHMARKS
+		runBenchmark(*engine, name, comparePropertyCache);
+#endif
+	}
+
+#if HI_RUN_BENCHMARKS
+
+	void runBenchmark(HiseJavascriptEngine& engine, const String& name, bool comparePropertyCache)
+	{
+		const int callbackIndex = ScriptTestEngine::OnNoteOn;
+
+		engine.setUseBytecode(false);
+		const double treeTime = getExecutionTime(engine, callbackIndex);
+
+		engine.setUseBytecode(true);
+		const double bytecodeTime = getExecutionTime(engine, callbackIndex);
+
+		String s;
+		s << name << ": Tree: " << String(treeTime, 2) << "ms, Bytecode: " << String(bytecodeTime, 2) << "ms";
+
+		if (bytecodeTime > 0.0)
+			s << " (" << String(treeTime / bytecodeTime, 2) << "x)";
+
+		if (comparePropertyCache)
+		{
+			engine.setUsePropertyCache(false);
+			const double uncachedTime = getExecutionTime(engine, callbackIndex);
+			engine.setUsePropertyCache(true);
+
+			s << ", Bytecode without property cache: " << String(uncachedTime, 2) << "ms";
+
+			if (bytecodeTime > 0.0)
+				s << " (cache: " << String(uncachedTime / bytecodeTime, 2) << "x)";
+		}
+
+		logMessage(s);
+	}
+
+	static double getExecutionTime(HiseJavascriptEngine& engine, int callbackIndex)
+	{
+		Result r = Result::ok();
+
+		const double start = Time::getMillisecondCounterHiRes();
+
+		for (int i = 0; i < NumIterations; i++)
+			engine.executeCallback(callbackIndex, &r);
+
+		return Time::getMillisecondCounterHiRes() - start;
+	}
+
+#endif
+
+	void testErrorLocation()
+	{
+		beginTest("Error location");
+
+		const String code = "const var obj = {};\n"
+							"function onNoteOn()\n"
+							"{\n"
+							"    local x = 2;\n"
+							"    x = x + Math.sin(obj.missing);\n"
+							"}\n";
+
+		String messages[2];
+
+		for (int i = 0; i < 2; i++)
+		{
+			ScopedPointer<HiseJavascriptEngine> engine = ScriptTestEngine::create();
+			const int callbackIndex = ScriptTestEngine::OnNoteOn;
+
+			engine->setUseBytecode(i == 0);
+
+			if (engine->execute(code).wasOk())
+			{
+				Result r = Result::ok();
+				engine->executeCallback(callbackIndex, &r);
+				messages[i] = r.getErrorMessage();
+			}
+		}
+
+		expectEquals(messages[0], messages[1], "Error message mismatch");
+	}
+
+	static var run(HiseJavascriptEngine& engine, int callbackIndex)
+	{
+		Result r = Result::ok();
+		const var result = engine.executeCallback(callbackIndex, &r);
+
+		return r.wasOk() ? result : var(r.getErrorMessage());
+	}
+};
+
+static ScriptBackendTest scriptBackendTest;
+
+
+/** Checks that the property cache of the script engine returns the right values if the objects change. */
+class PropertyCacheTest : public UnitTest
+{
+public:
+
+	PropertyCacheTest() :
+		UnitTest("Testing the script property cache")
+	{}
+
+	void runTest() override
+	{
+		testChangingObjects(true);
+		testChangingObjects(false);
+	}
+
+private:
+
+	void testChangingObjects(bool usePropertyCache)
+	{
+		beginTest(usePropertyCache ? "Changing objects with the property cache" : "Changing objects without the property cache");
+
+		// The same call sites are used with objects that have a different property order
+		// and with an object that gets a new property.
+		const String code = "const var a = {\"x\": 1, \"y\": 2};\n"
+							"const var b = {\"y\": 10, \"x\": 20};\n"
+							"const var list = [a, b];\n"
+							"function onNoteOn()\n"
+							"{\n"
+							"    local sum = 0;\n"
+							"    local i = 0;\n"
+							"    for(i = 0; i < 4; i++)\n"
+							"    {\n"
+							"        local o = list[i % 2];\n"
+							"        sum += o.x * 100 + o.y + o[\"x\"];\n"
+							"    }\n"
+							"    a.z = 5;\n"
+							"    sum += a.z + a[\"z\"];\n"
+							"    return sum;\n"
+							"}\n";
+
+		ScopedPointer<HiseJavascriptEngine> engine = ScriptTestEngine::create();
+		engine->setUsePropertyCache(usePropertyCache);
+
+		auto r = engine->execute(code);
+		expect(r.wasOk(), r.getErrorMessage());
+
+		Result cr = Result::ok();
+		const var result = engine->executeCallback(ScriptTestEngine::OnNoteOn, &cr);
+
+		expect(cr.wasOk(), cr.getErrorMessage());
+		expectEquals<int>((int)result, 4276, "Property values");
+	}
+};
+
+static PropertyCacheTest propertyCacheTest;
+
+
+/** Checks the Float32 / Int32 arrays (ScriptingObjects::TypedArray) in a script callback. */
+class TypedArrayTest : public UnitTest
+{
+public:
+
+	TypedArrayTest() :
+		UnitTest("Testing the typed arrays")
+	{}
+
+	void runTest() override
+	{
+		testTypedArrays();
+	}
+
+private:
+
+	void testTypedArrays()
+	{
+		beginTest("Reading and writing the elements");
+
+		const String code = "function onNoteOn()\n"
+							"{\n"
+							"    local i = 0;\n"
+							"    for(i = 0; i < floats.length; i++)\n"
+							"    {\n"
+							"        floats[i] = i * 0.5;\n"
+							"        ints[i] = i;\n"
+							"    }\n"
+							"    ints[3] += 10;\n"
+							"    floats.multiply(2.0);\n"
+							"    ints.addWithMultiply(floats, 2.0);\n"
+							"    local sum = 0;\n"
+							"    local v = 0;\n"
+							"    for(v in ints) sum += v;\n"
+							"    return sum + floats.getSum() + floats.getMax() + ints.getMin();\n"
+							"}\n";
+
+		ScopedPointer<HiseJavascriptEngine> engine = ScriptTestEngine::create();
+
+		ReferenceCountedObjectPtr<ScriptingObjects::TypedArray> floats = new ScriptingObjects::TypedArray(nullptr, ScriptingObjects::TypedArray::DataType::Float32, 16);
+		ReferenceCountedObjectPtr<ScriptingObjects::TypedArray> ints = new ScriptingObjects::TypedArray(nullptr, ScriptingObjects::TypedArray::DataType::Int32, 16);
+
+		engine->getRootObject()->setProperty("floats", var(floats.get()));
+		engine->getRootObject()->setProperty("ints", var(ints.get()));
+
+		auto r = engine->execute(code);
+		expect(r.wasOk(), r.getErrorMessage());
+
+		Result cr = Result::ok();
+		const var result = engine->executeCallback(ScriptTestEngine::OnNoteOn, &cr);
+
+		expect(cr.wasOk(), cr.getErrorMessage());
+		expectEquals<int>((int)result, 505, "Typed array values");
+
+		floats->copyFrom(Array<var>(var(0.25), var(2)));
+		expectEquals<double>((double)floats->getElement(0), 0.25, "copyFrom Array");
+
+		ints->copyFrom(var(floats.get()));
+		expectEquals<int>((int)ints->getElement(1), 2, "copyFrom Float32 to Int32");
+
+		floats->fill(1e30);
+		ints->copyFrom(var(floats.get()));
+		expectEquals<int>((int)ints->getElement(0), std::numeric_limits<int>::max(), "Out of range floats are clamped");
+
+		ints->multiply(-1e30);
+		expectEquals<int>((int)ints->getElement(0), std::numeric_limits<int>::min(), "Out of range products are clamped");
+
+		floats->multiply(1e30);
+		expectEquals<double>((double)floats->getElement(0), 0.0, "Infinite products are sanitized");
+
+		r = engine->execute("ints[16] = 1;");
+		expect(r.failed(), "Index out of bounds must fail");
+	}
+};
+
+static TypedArrayTest typedArrayTest;
+
+
+/** Checks the allocation warnings of the realtime callbacks (HiseJavascriptEngine::checkRealtimeCallback()) and the allocation counter. */
+class RealtimeCallbackTest : public UnitTest
+{
+public:
+
+	RealtimeCallbackTest() :
+		UnitTest("Testing the realtime callback checks")
+	{}
+
+	void runTest() override
+	{
+		testRealtimeChecks();
+		testAllocationCounter();
+	}
+
+private:
+
+	void testRealtimeChecks()
+	{
+		beginTest("Finding the allocations in a callback");
+
+		const String code = "const var list = [];\n"
+							"inline function describe(n)\n"
+							"{\n"
+							"    return \"Note: \" + n;\n"
+							"}\n"
+							"function onNoteOn()\n"
+							"{\n"
+							"    local o = {\"x\": 1};\n"
+							"    list.push(o.x);\n"
+							"    return describe(o.x) + describe(2);\n"
+							"}\n";
+
+		ScopedPointer<HiseJavascriptEngine> engine = ScriptTestEngine::create();
+
+		auto r = engine->execute(code);
+		expect(r.wasOk(), r.getErrorMessage());
+
+		// The inline function is only checked once
+		const StringArray problems = engine->checkRealtimeCallback("onNoteOn");
+		expectEquals(problems.size(), 3, problems.joinIntoString("\n"));
+
+		engine = ScriptTestEngine::create();
+
+		r = engine->execute("const var list = [0, 1, 2];\n"
+							"function onNoteOn()\n"
+							"{\n"
+							"    local sum = 0;\n"
+							"    local v = 0;\n"
+							"    for(v in list) sum += v * 2;\n"
+							"    list[1] = sum;\n"
+							"    return sum;\n"
+							"}\n");
+
+		expect(r.wasOk(), r.getErrorMessage());
+		expect(engine->checkRealtimeCallback("onNoteOn").isEmpty(), "No allocations");
+	}
+
+	void testAllocationCounter()
+	{
+		beginTest("Counting the allocations of the script operations");
+
+		ScopedPointer<HiseJavascriptEngine> engine = ScriptTestEngine::create();
+
+		{
+			HiseJavascriptEngine::RootObject::AllocationCounter counter(false);
+
+			auto r = engine->execute("const var list = [1, 2];\n"
+									 "const var obj = {\"x\": list[1]};\n"
+									 "list[4] = \"Value: \" + obj.x;\n");
+
+			expect(r.wasOk(), r.getErrorMessage());
+			expectEquals(counter.numAllocations, 4, "Array literal, object literal, string concatenation and array growth");
+		}
+
+		{
+			HiseJavascriptEngine::RootObject::AllocationCounter counter(false);
+
+			auto r = engine->execute("reg x = 0;\n"
+									 "x = x * 2 + 1;\n");
+
+			expect(r.wasOk(), r.getErrorMessage());
+			expectEquals(counter.numAllocations, 0, "Arithmetic with a reg variable");
+		}
+	}
+};
+
+static RealtimeCallbackTest realtimeCallbackTest;
+
+#endif
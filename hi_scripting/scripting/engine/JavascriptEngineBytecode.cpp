@@ -0,0 +1,1085 @@
+namespace hise { using namespace juce;
+
+/** A compiled callback or inline function body.
+*
+*	The program is a flat list of instructions that operate on a fixed amount of typed registers. The registers
+*	are allocated by the compiler, so executing the program doesn't allocate anything. Numbers are stored in the
+*	registers without a var, everything else (strings, objects, arrays) is stored as var.
+*
+*	Expressions and statements without an instruction are executed by the expression tree (Evaluate, Assign and
+*	Perform), so the semantics and the error locations are the same as with the tree interpreter.
+*/
+struct HiseJavascriptEngine::RootObject::BytecodeProgram
+{
+	enum class OpCode : uint8
+	{
+		LoadConstant = 0,	// r[a] = constants[b]
+		LoadVar,			// r[a] = *variable
+		StoreVar,			// *variable = r[a]
+		LoadNamed,			// r[a] = set[b]
+		StoreNamed,			// set[b] = r[a]
+		LoadParameter,		// r[a] = parameter b of the current call of another inline function
+		Move,				// r[a] = r[b]
+		Add,				// r[a] = r[b] + r[c]
+		Subtract,
+		Multiply,
+		Divide,
+		Modulo,
+		BitwiseAnd,
+		BitwiseOr,
+		BitwiseXor,
+		LeftShift,
+		RightShift,
+		RightShiftUnsigned,
+		Equals,
+		NotEquals,
+		LessThan,
+		LessThanOrEqual,
+		GreaterThan,
+		GreaterThanOrEqual,
+		TypeEquals,
+		TypeNotEquals,
+		ToBool,				// r[a] = (bool)r[b]
+		Jump,				// goto a
+		JumpIfFalse,		// if (!r[a]) goto b
+		JumpIfTrue,			// if (r[a]) goto b
+		CheckTimeout,		// throws if the script runs too long
+		CheckParameter,		// throws if the API call parameter r[a] with the index b is undefined
+		ApiCall,			// r[a] = API call with the arguments r[b] ... r[b + numArgs - 1]
+		InlineCall,			// r[a] = result of the inline function call with the arguments r[b] ... r[b + numArgs - 1]
+		Evaluate,			// r[a] = result of the expression
+		Assign,				// assigns r[a] to the expression
+		Perform,			// performs the statement, b and c are the jump targets for break and continue (or -1)
+		Return,				// *returnValue = r[a], returns returnWasHit
+		Exit,				// returns the result code a
+		numOpCodes
+	};
+
+	struct Register
+	{
+		enum class Type : uint8
+		{
+			Undefined = 0,
+			Bool,
+			Int,
+			Int64,
+			Double,
+			Var
+		};
+
+		Register() noexcept { number.i = 0; }
+
+		void set(const Register& other)
+		{
+			if (other.type == Type::Var)
+				setVar(other.object);
+			else
+			{
+				releaseObject();
+				type = other.type;
+				number = other.number;
+			}
+		}
+
+		void setVar(const var& v)
+		{
+			if (v.isInt())				setInt((int)v);
+			else if (v.isDouble())		setDouble((double)v);
+			else if (v.isBool())		setBool((bool)v);
+			else if (v.isInt64())		setInt64((int64)v);
+			else if (v.isUndefined())	setUndefined();
+			else
+			{
+				object = v;
+				type = Type::Var;
+			}
+		}
+
+		void setUndefined() noexcept { releaseObject(); type = Type::Undefined; number.i = 0; }
+		void setBool(bool b) noexcept { releaseObject(); type = Type::Bool; number.i = b ? 1 : 0; }
+		void setInt(int v) noexcept { releaseObject(); type = Type::Int; number.i = v; }
+		void setInt64(int64 v) noexcept { releaseObject(); type = Type::Int64; number.i = v; }
+		void setDouble(double v) noexcept { releaseObject(); type = Type::Double; number.d = v; }
+
+		var toVar() const
+		{
+			switch (type)
+			{
+			case Type::Undefined:	return var::undefined();
+			case Type::Bool:		return var(number.i != 0);
+			case Type::Int:			return var((int)number.i);
+			case Type::Int64:		return var(number.i);
+			case Type::Double:		return var(number.d);
+			case Type::Var:			return object;
+			}
+
+			return var::undefined();
+		}
+
+		bool toBool() const
+		{
+			switch (type)
+			{
+			case Type::Double:	return number.d != 0.0;
+			case Type::Var:		return (bool)object;
+			default:			return number.i != 0;
+			}
+		}
+
+		/** Same as isNumericOrUndefined() for a var. */
+		bool isNumericOrUndefined() const noexcept { return type != Type::Var; }
+
+		bool isUndefinedOrVoid() const noexcept { return type == Type::Undefined || (type == Type::Var && object.isVoid()); }
+
+		double toDouble() const noexcept { return type == Type::Double ? number.d : (double)number.i; }
+		int64 toInt64() const noexcept { return type == Type::Double ? (int64)number.d : number.i; }
+
+		void releaseObject() noexcept
+		{
+			if (type == Type::Var)
+				object = var();
+		}
+
+		Type type = Type::Undefined;
+
+		union
+		{
+			int64 i;
+			double d;
+		} number;
+
+		var object;
+	};
+
+	struct Instruction
+	{
+		OpCode op;
+		int a = 0, b = 0, c = 0;
+
+		var* variable = nullptr;
+		NamedValueSet* set = nullptr;
+		const Statement* node = nullptr;
+	};
+
+	BytecodeProgram(const Statement* source_) :
+		source(source_)
+	{}
+
+	/** Executes the program. If it's already running (a recursive inline function call), the expression tree is used. */
+	Statement::ResultCode perform(const Scope& s, var* returnValue)
+	{
+		if (running)
+			return source->perform(s, returnValue);
+
+		ScopedExecution se(*this);
+
+		// The parameters of an inline function body live in the first registers
+		if (inlineFunction != nullptr && inlineFunction->e != nullptr)
+		{
+			for (int i = 0; i < numParameters; i++)
+				registers[i].setVar(inlineFunction->e->parameterResults[i]);
+		}
+
+		return run(s, returnValue, nullptr);
+	}
+
+	/** Returns true if the inline function body can be called with performWithRegisters().
+	*
+	*	This is not possible if the body is already running or if it has nodes that are executed by the
+	*	expression tree (they would read the parameters from the function call object).
+	*/
+	bool canTakeRegisterArguments() const noexcept { return inlineFunction != nullptr && !running && numTreeNodes == 0; }
+
+	/** Executes an inline function body with the arguments in the registers of the caller (without converting them to a var). */
+	Statement::ResultCode performWithRegisters(const Scope& s, const Register* arguments, Register& result)
+	{
+		jassert(canTakeRegisterArguments());
+
+		ScopedExecution se(*this);
+
+		for (int i = 0; i < numParameters; i++)
+			registers[i].set(arguments[i]);
+
+		return run(s, nullptr, &result);
+	}
+
+	int getNumInstructions() const noexcept { return instructions.size(); }
+	int getNumRegisters() const noexcept { return (int)registers.size(); }
+
+	/** Returns the number of statements and expressions that are executed by the expression tree. */
+	int getNumTreeNodes() const noexcept { return numTreeNodes; }
+
+private:
+
+	friend struct BytecodeCompiler;
+
+	/** Releases the objects in the registers after the execution (also if an error was thrown). */
+	struct ScopedExecution
+	{
+		ScopedExecution(BytecodeProgram& p_) : p(p_) { p.running = true; }
+
+		~ScopedExecution()
+		{
+			for (auto& r : p.registers)
+				r.releaseObject();
+
+			p.running = false;
+		}
+
+		BytecodeProgram& p;
+	};
+
+	Statement::ResultCode run(const Scope& s, var* returnValue, Register* returnRegister);
+
+	static void performBinaryOperation(const Instruction& ins, Register& dst, const Register& a, const Register& b);
+
+	Array<Instruction> instructions;
+	std::vector<Register> constants;
+	std::vector<Register> registers;
+
+	const Statement* source;
+	InlineFunction::Object* inlineFunction = nullptr;
+	int numParameters = 0;
+	int numTreeNodes = 0;
+	bool running = false;
+
+	JUCE_DECLARE_NON_COPYABLE(BytecodeProgram)
+};
+
+
+void HiseJavascriptEngine::RootObject::BytecodeProgram::performBinaryOperation(const Instruction& ins, Register& dst, const Register& a, const Register& b)
+{
+	if (a.isNumericOrUndefined() && b.isNumericOrUndefined())
+	{
+		if (a.type == Register::Type::Double || b.type == Register::Type::Double)
+		{
+			const double x = a.toDouble();
+			const double y = b.toDouble();
+
+			switch (ins.op)
+			{
+			case OpCode::Add:					dst.setDouble(x + y); return;
+			case OpCode::Subtract:				dst.setDouble(x - y); return;
+			case OpCode::Multiply:				dst.setDouble(x * y); return;
+			case OpCode::Divide:				dst.setDouble(y != 0 ? x / y : std::numeric_limits<double>::infinity()); return;
+			case OpCode::Equals:				dst.setBool(x == y); return;
+			case OpCode::NotEquals:				dst.setBool(x != y); return;
+			case OpCode::LessThan:				dst.setBool(x < y); return;
+			case OpCode::LessThanOrEqual:		dst.setBool(x <= y); return;
+			case OpCode::GreaterThan:			dst.setBool(x > y); return;
+			case OpCode::GreaterThanOrEqual:	dst.setBool(x >= y); return;
+			default:							break; // not allowed for doubles, the operator throws the error
+			}
+		}
+		else
+		{
+			const int64 x = a.toInt64();
+			const int64 y = b.toInt64();
+
+			switch (ins.op)
+			{
+			case OpCode::Add:					dst.setInt64(x + y); return;
+			case OpCode::Subtract:				dst.setInt64(x - y); return;
+			case OpCode::Multiply:				dst.setInt64(x * y); return;
+			case OpCode::Divide:				dst.setDouble(y != 0 ? x / (double)y : std::numeric_limits<double>::infinity()); return;
+			case OpCode::Modulo:				if (y != 0) dst.setInt64(x % y); else dst.setDouble(std::numeric_limits<double>::infinity()); return;
+			case OpCode::BitwiseAnd:			dst.setInt64(x & y); return;
+			case OpCode::BitwiseOr:				dst.setInt64(x | y); return;
+			case OpCode::BitwiseXor:			dst.setInt64(x ^ y); return;
+			case OpCode::LeftShift:				dst.setInt(((int)x) << (int)y); return;
+			case OpCode::RightShift:			dst.setInt(((int)x) >> (int)y); return;
+			case OpCode::RightShiftUnsigned:	dst.setInt((int)(((uint32)x) >> (int)y)); return;
+			case OpCode::Equals:				dst.setBool(x == y); return;
+			case OpCode::NotEquals:				dst.setBool(x != y); return;
+			case OpCode::LessThan:				dst.setBool(x < y); return;
+			case OpCode::LessThanOrEqual:		dst.setBool(x <= y); return;
+			case OpCode::GreaterThan:			dst.setBool(x > y); return;
+			case OpCode::GreaterThanOrEqual:	dst.setBool(x >= y); return;
+			default:							break;
+			}
+		}
+	}
+
+	// Strings, objects, buffers and errors are handled by the operator of the expression tree
+	auto op = static_cast<const BinaryOperator*>(ins.node);
+
+	dst.setVar(op->getWithValues(a.toVar(), b.toVar()));
+}
+
+
+HiseJavascriptEngine::RootObject::Statement::ResultCode HiseJavascriptEngine::RootObject::BytecodeProgram::run(const Scope& s, var* returnValue, Register* returnRegister)
+{
+	const Instruction* code = instructions.getRawDataPointer();
+	Register* r = registers.data();
+	int pc = 0;
+
+	for (;;)
+	{
+		const Instruction& ins = code[pc++];
+
+		switch (ins.op)
+		{
+		case OpCode::LoadConstant:	r[ins.a].set(constants[ins.b]); break;
+		case OpCode::LoadVar:		r[ins.a].setVar(*ins.variable); break;
+		case OpCode::StoreVar:		*ins.variable = r[ins.a].toVar(); break;
+		case OpCode::LoadNamed:		r[ins.a].setVar(ins.set->getValueAt(ins.b)); break;
+		case OpCode::StoreNamed:
+		{
+			if (var* v = ins.set->getVarPointerAt(ins.b))
+				*v = r[ins.a].toVar();
+
+			break;
+		}
+		case OpCode::LoadParameter:
+		{
+			auto p = static_cast<const InlineFunction::ParameterReference*>(ins.node);
+
+			if (p->f->e == nullptr)
+				p->location.throwError("Accessing parameter reference outside the function call");
+
+			r[ins.a].setVar(p->f->e->parameterResults[p->index]);
+			break;
+		}
+		case OpCode::Move:			r[ins.a].set(r[ins.b]); break;
+		case OpCode::Add:
+		case OpCode::Subtract:
+		case OpCode::Multiply:
+		case OpCode::Divide:
+		case OpCode::Modulo:
+		case OpCode::BitwiseAnd:
+		case OpCode::BitwiseOr:
+		case OpCode::BitwiseXor:
+		case OpCode::LeftShift:
+		case OpCode::RightShift:
+		case OpCode::RightShiftUnsigned:
+		case OpCode::Equals:
+		case OpCode::NotEquals:
+		case OpCode::LessThan:
+		case OpCode::LessThanOrEqual:
+		case OpCode::GreaterThan:
+		case OpCode::GreaterThanOrEqual:
+			performBinaryOperation(ins, r[ins.a], r[ins.b], r[ins.c]);
+			break;
+		case OpCode::TypeEquals:	r[ins.a].setBool(areTypeEqual(r[ins.b].toVar(), r[ins.c].toVar())); break;
+		case OpCode::TypeNotEquals:	r[ins.a].setBool(!areTypeEqual(r[ins.b].toVar(), r[ins.c].toVar())); break;
+		case OpCode::ToBool:		r[ins.a].setBool(r[ins.b].toBool()); break;
+		case OpCode::Jump:			pc = ins.a; break;
+		case OpCode::JumpIfFalse:	if (!r[ins.a].toBool()) pc = ins.b; break;
+		case OpCode::JumpIfTrue:	if (r[ins.a].toBool()) pc = ins.b; break;
+		case OpCode::CheckTimeout:	s.checkTimeOut(ins.node->location); break;
+		case OpCode::CheckParameter:
+		{
+			if (r[ins.a].isUndefinedOrVoid())
+				HiseJavascriptEngine::checkValidParameter(ins.b, r[ins.a].toVar(), ins.node->location);
+
+			break;
+		}
+		case OpCode::ApiCall:
+		{
+			auto call = static_cast<const ApiCall*>(ins.node);
+
+			var arguments[5];
+
+			for (int i = 0; i < call->expectedNumArguments; i++)
+				arguments[i] = r[ins.b + i].toVar();
+
+			r[ins.a].setVar(call->callWithArguments(arguments));
+			break;
+		}
+		case OpCode::InlineCall:
+		{
+			auto call = static_cast<const InlineFunction::FunctionCall*>(ins.node);
+			auto f = call->f;
+
+			if (f->program != nullptr && f->program->canTakeRegisterArguments())
+			{
+				r[ins.a].setUndefined();
+
+				s.root->addToCallStack(f->name, &call->location);
+				f->program->performWithRegisters(s, r + ins.b, r[ins.a]);
+				s.root->removeFromCallStack(f->name);
+
+				f->cleanLocalProperties();
+				f->lastReturnValue = r[ins.a].toVar();
+			}
+			else
+			{
+				f->setFunctionCall(call);
+
+				for (int i = 0; i < call->numArgs; i++)
+					call->parameterResults.setUnchecked(i, r[ins.b + i].toVar());
+
+				r[ins.a].setVar(call->performWithParameters(s));
+			}
+
+			break;
+		}
+		case OpCode::Evaluate:		r[ins.a].setVar(static_cast<const Expression*>(ins.node)->getResult(s)); break;
+		case OpCode::Assign:		static_cast<const Expression*>(ins.node)->assign(s, r[ins.a].toVar()); break;
+		case OpCode::Perform:
+		{
+			const auto result = ins.node->perform(s, returnValue);
+
+			if (result == Statement::ok)
+				break;
+
+			if (result == Statement::breakWasHit && ins.b != -1)
+			{
+				pc = ins.b;
+				break;
+			}
+
+			if (result == Statement::continueWasHit && ins.c != -1)
+			{
+				pc = ins.c;
+				break;
+			}
+
+			return result;
+		}
+		case OpCode::Return:
+		{
+			if (returnRegister != nullptr)
+				returnRegister->set(r[ins.a]);
+			else if (returnValue != nullptr)
+				*returnValue = r[ins.a].toVar();
+
+			return Statement::returnWasHit;
+		}
+		case OpCode::Exit:			return (Statement::ResultCode)ins.a;
+		case OpCode::numOpCodes:	jassertfalse; return Statement::ok;
+		}
+	}
+}
+
+
+/** Lowers the expression tree of a callback or inline function to a BytecodeProgram. */
+struct HiseJavascriptEngine::RootObject::BytecodeCompiler
+{
+	using OpCode = BytecodeProgram::OpCode;
+	using Instruction = BytecodeProgram::Instruction;
+
+	BytecodeCompiler(RootObject* root_) :
+		root(root_)
+	{}
+
+	/** Compiles a callback or inline function body. The parameters of the inline function get the first registers. */
+	BytecodeProgram* compile(const BlockStatement* body, InlineFunction::Object* inlineFunction=nullptr)
+	{
+		ScopedPointer<BytecodeProgram> p = new BytecodeProgram(body);
+
+		program = p;
+
+		if (inlineFunction != nullptr)
+		{
+			p->inlineFunction = inlineFunction;
+			p->numParameters = inlineFunction->parameterNames.size();
+		}
+
+		numUsedRegisters = p->numParameters;
+		maxRegisters = p->numParameters;
+
+		compileStatement(body);
+		emit(OpCode::Exit, Statement::ok);
+
+		p->registers.resize((size_t)maxRegisters);
+		p->instructions.minimiseStorageOverheads();
+
+		program = nullptr;
+
+		return p.release();
+	}
+
+private:
+
+	/** The pending jumps of the innermost loop that will be resolved at the end of the loop. */
+	struct LoopTargets
+	{
+		Array<int> breakInstructions;
+		Array<int> continueInstructions;
+	};
+
+	int emit(OpCode op, int a = 0, int b = 0, int c = 0, const Statement* node = nullptr)
+	{
+		Instruction i;
+		i.op = op;
+		i.a = a;
+		i.b = b;
+		i.c = c;
+		i.node = node;
+
+		program->instructions.add(i);
+
+		return program->instructions.size() - 1;
+	}
+
+	int getPosition() const { return program->instructions.size(); }
+
+	Instruction& getInstruction(int index) { return program->instructions.getReference(index); }
+
+	int allocateRegister()
+	{
+		const int index = numUsedRegisters++;
+		maxRegisters = jmax<int>(maxRegisters, numUsedRegisters);
+		return index;
+	}
+
+	int addConstant(const var& value)
+	{
+		BytecodeProgram::Register r;
+		r.setVar(value);
+
+		program->constants.push_back(r);
+		return (int)program->constants.size() - 1;
+	}
+
+	/** Sets the jump target of a Jump or Perform instruction. */
+	void resolveJump(int instructionIndex, int target, bool isBreak)
+	{
+		auto& i = getInstruction(instructionIndex);
+
+		if (i.op == OpCode::Jump)
+			i.a = target;
+		else if (isBreak)
+			i.b = target;
+		else
+			i.c = target;
+	}
+
+	void emitTreeStatement(const Statement* s)
+	{
+		const int index = emit(OpCode::Perform, 0, -1, -1, s);
+		program->numTreeNodes++;
+
+		if (currentLoop != nullptr)
+		{
+			currentLoop->breakInstructions.add(index);
+			currentLoop->continueInstructions.add(index);
+		}
+	}
+
+	int emitTreeExpression(const Expression* e)
+	{
+		const int dst = allocateRegister();
+		emit(OpCode::Evaluate, dst, 0, 0, e);
+		program->numTreeNodes++;
+		return dst;
+	}
+
+	static bool hasBreakpoints(const BlockStatement* b)
+	{
+#if ENABLE_SCRIPTING_BREAKPOINTS
+		for (auto s : b->statements)
+		{
+			if (s->breakpointReference.index != -1)
+				return true;
+		}
+#else
+		ignoreUnused(b);
+#endif
+
+		return false;
+	}
+
+	static int getNamedIndex(const NamedValueSet& set, const Identifier& id)
+	{
+		return set.indexOf(id);
+	}
+
+	// ================================================================================================================ Statements
+
+	void compileStatement(const Statement* s)
+	{
+		const int registerMark = numUsedRegisters;
+
+		if (typeid(*s) == typeid(Statement))
+		{
+			// empty statement
+		}
+		else if (auto b = dynamic_cast<const BlockStatement*>(s))
+		{
+			if (b->lockStatements.size() != 0 || hasBreakpoints(b))
+				emitTreeStatement(b);
+			else
+			{
+				for (auto child : b->statements)
+					compileStatement(child);
+			}
+		}
+		else if (auto is = dynamic_cast<const IfStatement*>(s))
+		{
+			const int condition = compileExpression(is->condition);
+			const int jumpToFalse = emit(OpCode::JumpIfFalse, condition, -1);
+
+			compileStatement(is->trueBranch);
+
+			const int jumpToEnd = emit(OpCode::Jump, -1);
+
+			getInstruction(jumpToFalse).b = getPosition();
+			compileStatement(is->falseBranch);
+			getInstruction(jumpToEnd).a = getPosition();
+		}
+		else if (auto ls = dynamic_cast<const LoopStatement*>(s))
+		{
+			if (ls->isIterator)
+				emitTreeStatement(ls);
+			else
+				compileLoop(ls);
+		}
+		else if (auto rs = dynamic_cast<const ReturnStatement*>(s))
+		{
+			emit(OpCode::Return, compileExpression(rs->returnValue));
+		}
+		else if (dynamic_cast<const BreakStatement*>(s) != nullptr)
+		{
+			if (currentLoop != nullptr)
+				currentLoop->breakInstructions.add(emit(OpCode::Jump, -1));
+			else
+				emit(OpCode::Exit, Statement::breakWasHit);
+		}
+		else if (dynamic_cast<const ContinueStatement*>(s) != nullptr)
+		{
+			if (currentLoop != nullptr)
+				currentLoop->continueInstructions.add(emit(OpCode::Jump, -1));
+			else
+				emit(OpCode::Exit, Statement::continueWasHit);
+		}
+		else if (auto cls = dynamic_cast<const CallbackLocalStatement*>(s))
+		{
+			compileLocalDefinition(cls, cls->parentCallback->localProperties, cls->name, cls->initialiser);
+		}
+		else if (auto lvs = dynamic_cast<const LocalVarStatement*>(s))
+		{
+			compileLocalDefinition(lvs, lvs->parentFunction->localProperties, lvs->name, lvs->initialiser);
+		}
+		else if (auto e = dynamic_cast<const Expression*>(s))
+		{
+			compileExpression(e);
+		}
+		else
+		{
+			emitTreeStatement(s);
+		}
+
+		numUsedRegisters = registerMark;
+	}
+
+	void compileLocalDefinition(const Statement* s, NamedValueSet& set, const Identifier& name, const Expression* initialiser)
+	{
+		const int index = getNamedIndex(set, name);
+
+		if (index == -1)
+		{
+			emitTreeStatement(s);
+			return;
+		}
+
+		const int value = compileExpression(initialiser);
+		const int i = emit(OpCode::StoreNamed, value, index);
+		getInstruction(i).set = &set;
+	}
+
+	void compileLoop(const LoopStatement* ls)
+	{
+		LoopTargets targets;
+		ScopedValueSetter<LoopTargets*> svs(currentLoop, &targets);
+
+		if (ls->initialiser != nullptr)
+		{
+			// break and continue in the initialiser are not caught by this loop
+			ScopedValueSetter<LoopTargets*> noLoop(currentLoop, nullptr);
+			compileStatement(ls->initialiser);
+		}
+
+		const int registerMark = numUsedRegisters;
+		const int start = getPosition();
+		int continueTarget = -1;
+		Array<int> jumpsToEnd;
+
+		if (!ls->isDoLoop)
+		{
+			const int condition = compileExpression(ls->condition);
+			jumpsToEnd.add(emit(OpCode::JumpIfFalse, condition, -1));
+			numUsedRegisters = registerMark;
+
+			emit(OpCode::CheckTimeout, 0, 0, 0, ls);
+			compileStatement(ls->body);
+
+			continueTarget = getPosition();
+
+			if (ls->iterator != nullptr)
+				compileStatement(ls->iterator);
+
+			emit(OpCode::Jump, start);
+		}
+		else
+		{
+			emit(OpCode::CheckTimeout, 0, 0, 0, ls);
+			compileStatement(ls->body);
+
+			if (ls->iterator != nullptr)
+				compileStatement(ls->iterator);
+
+			const int condition = compileExpression(ls->condition);
+			jumpsToEnd.add(emit(OpCode::JumpIfFalse, condition, -1));
+			emit(OpCode::Jump, start);
+
+			// A continue skips the condition of a do loop
+			continueTarget = getPosition();
+
+			if (ls->iterator != nullptr)
+				compileStatement(ls->iterator);
+
+			emit(OpCode::Jump, start);
+		}
+
+		const int end = getPosition();
+
+		for (auto j : jumpsToEnd)
+			getInstruction(j).b = end;
+
+		for (auto i : targets.breakInstructions)
+			resolveJump(i, end, true);
+
+		for (auto i : targets.continueInstructions)
+			resolveJump(i, continueTarget, false);
+	}
+
+	// ================================================================================================================ Expressions
+
+	int compileExpression(const Expression* e)
+	{
+		if (typeid(*e) == typeid(Expression))
+		{
+			const int dst = allocateRegister();
+			emit(OpCode::LoadConstant, dst, addConstant(var::undefined()));
+			return dst;
+		}
+
+		if (auto l = dynamic_cast<const LiteralValue*>(e))
+		{
+			const int dst = allocateRegister();
+			emit(OpCode::LoadConstant, dst, addConstant(l->value));
+			return dst;
+		}
+
+		if (auto rn = dynamic_cast<const RegisterName*>(e))
+		{
+			if (rn->data != nullptr)
+				return emitLoadVar(rn->data);
+		}
+		else if (auto cpr = dynamic_cast<const CallbackParameterReference*>(e))
+		{
+			if (cpr->data != nullptr)
+				return emitLoadVar(cpr->data);
+		}
+		else if (auto clr = dynamic_cast<const CallbackLocalReference*>(e))
+		{
+			auto& set = clr->parentCallback->localProperties;
+			const int index = getNamedIndex(set, clr->name);
+
+			if (index != -1)
+				return emitLoadNamed(set, index);
+		}
+		else if (auto lr = dynamic_cast<const LocalReference*>(e))
+		{
+			auto& set = lr->parentFunction->localProperties;
+			const int index = getNamedIndex(set, lr->id);
+
+			if (index != -1)
+				return emitLoadNamed(set, index);
+		}
+		else if (auto cr = dynamic_cast<const ConstReference*>(e))
+		{
+			return emitLoadNamed(cr->ns->constObjects, cr->index);
+		}
+		else if (auto pr = dynamic_cast<const InlineFunction::ParameterReference*>(e))
+		{
+			if (pr->f == program->inlineFunction)
+				return pr->index;
+
+			const int dst = allocateRegister();
+			emit(OpCode::LoadParameter, dst, pr->index, 0, pr);
+			return dst;
+		}
+		else if (auto ra = dynamic_cast<const RegisterAssignment*>(e))
+		{
+			if (var* data = root->hiseSpecialData.varRegister.getVarPointer(ra->registerIndex))
+			{
+				const int value = compileExpression(ra->source);
+				emitStoreVar(data, value);
+				return value;
+			}
+		}
+		else if (auto pa = dynamic_cast<const PostAssignment*>(e))
+		{
+			const int oldValue = compileExpression(pa->target);
+			const int newValue = compileExpression(pa->newValue);
+			compileStore(pa->target, newValue);
+			return oldValue;
+		}
+		else if (auto sa = dynamic_cast<const SelfAssignment*>(e))
+		{
+			const int newValue = compileExpression(sa->newValue);
+			compileStore(sa->target, newValue);
+			return newValue;
+		}
+		else if (auto a = dynamic_cast<const Assignment*>(e))
+		{
+			const int newValue = compileExpression(a->newValue);
+			compileStore(a->target, newValue);
+			return newValue;
+		}
+		else if (auto andOp = dynamic_cast<const LogicalAndOp*>(e))
+		{
+			return compileLogicalOperator(andOp, true);
+		}
+		else if (auto orOp = dynamic_cast<const LogicalOrOp*>(e))
+		{
+			return compileLogicalOperator(orOp, false);
+		}
+		else if (auto te = dynamic_cast<const TypeEqualsOp*>(e))
+		{
+			return compileBinaryOperator(te, OpCode::TypeEquals);
+		}
+		else if (auto tne = dynamic_cast<const TypeNotEqualsOp*>(e))
+		{
+			return compileBinaryOperator(tne, OpCode::TypeNotEquals);
+		}
+		else if (auto co = dynamic_cast<const ConditionalOp*>(e))
+		{
+			const int dst = allocateRegister();
+			const int condition = compileExpression(co->condition);
+			const int jumpToFalse = emit(OpCode::JumpIfFalse, condition, -1);
+
+			emit(OpCode::Move, dst, compileExpression(co->trueBranch));
+			const int jumpToEnd = emit(OpCode::Jump, -1);
+
+			getInstruction(jumpToFalse).b = getPosition();
+			emit(OpCode::Move, dst, compileExpression(co->falseBranch));
+			getInstruction(jumpToEnd).a = getPosition();
+
+			return dst;
+		}
+		else if (auto bo = dynamic_cast<const BinaryOperator*>(e))
+		{
+			const OpCode op = getOpCode(bo);
+
+			if (op != OpCode::numOpCodes)
+				return compileBinaryOperator(bo, op);
+		}
+		else if (auto ac = dynamic_cast<const ApiCall*>(e))
+		{
+			return compileApiCall(ac);
+		}
+		else if (auto ic = dynamic_cast<const InlineFunction::FunctionCall*>(e))
+		{
+			return compileInlineCall(ic);
+		}
+
+		return emitTreeExpression(e);
+	}
+
+	void compileStore(const Expression* target, int value)
+	{
+		if (auto rn = dynamic_cast<const RegisterName*>(target))
+		{
+			if (rn->data != nullptr)
+			{
+				emitStoreVar(rn->data, value);
+				return;
+			}
+		}
+		else if (auto clr = dynamic_cast<const CallbackLocalReference*>(target))
+		{
+			auto& set = clr->parentCallback->localProperties;
+			const int index = getNamedIndex(set, clr->name);
+
+			if (index != -1)
+			{
+				emitStoreNamed(set, index, value);
+				return;
+			}
+		}
+		else if (auto lr = dynamic_cast<const LocalReference*>(target))
+		{
+			auto& set = lr->parentFunction->localProperties;
+			const int index = getNamedIndex(set, lr->id);
+
+			if (index != -1)
+			{
+				emitStoreNamed(set, index, value);
+				return;
+			}
+		}
+
+		emit(OpCode::Assign, value, 0, 0, target);
+		program->numTreeNodes++;
+	}
+
+	int compileBinaryOperator(const BinaryOperatorBase* bo, OpCode op)
+	{
+		const int a = compileExpression(bo->lhs);
+		const int b = compileExpression(bo->rhs);
+		const int dst = allocateRegister();
+
+		emit(op, dst, a, b, bo);
+		return dst;
+	}
+
+	int compileLogicalOperator(const BinaryOperatorBase* bo, bool isAnd)
+	{
+		const int dst = allocateRegister();
+
+		emit(OpCode::ToBool, dst, compileExpression(bo->lhs));
+		const int shortCircuit = emit(isAnd ? OpCode::JumpIfFalse : OpCode::JumpIfTrue, dst, -1);
+
+		emit(OpCode::ToBool, dst, compileExpression(bo->rhs));
+		getInstruction(shortCircuit).b = getPosition();
+
+		return dst;
+	}
+
+	int compileApiCall(const ApiCall* ac)
+	{
+		const int numArgs = ac->expectedNumArguments;
+
+		if (!isPositiveAndNotGreaterThan(numArgs, 5))
+			return emitTreeExpression(ac);
+
+		const int firstArgument = numUsedRegisters;
+
+		for (int i = 0; i < numArgs; i++)
+			allocateRegister();
+
+		for (int i = 0; i < numArgs; i++)
+		{
+			emit(OpCode::Move, firstArgument + i, compileExpression(ac->argumentList[i]));
+
+#if ENABLE_SCRIPTING_SAFE_CHECKS
+			emit(OpCode::CheckParameter, firstArgument + i, i, 0, ac);
+#endif
+		}
+
+		const int dst = allocateRegister();
+		emit(OpCode::ApiCall, dst, firstArgument, 0, ac);
+		return dst;
+	}
+
+	int compileInlineCall(const InlineFunction::FunctionCall* ic)
+	{
+		const int firstArgument = numUsedRegisters;
+
+		for (int i = 0; i < ic->numArgs; i++)
+			allocateRegister();
+
+		for (int i = 0; i < ic->numArgs; i++)
+			emit(OpCode::Move, firstArgument + i, compileExpression(ic->parameterExpressions.getUnchecked(i)));
+
+		const int dst = allocateRegister();
+		emit(OpCode::InlineCall, dst, firstArgument, 0, ic);
+		return dst;
+	}
+
+	static OpCode getOpCode(const BinaryOperator* bo)
+	{
+		if (dynamic_cast<const AdditionOp*>(bo) != nullptr)				return OpCode::Add;
+		if (dynamic_cast<const SubtractionOp*>(bo) != nullptr)			return OpCode::Subtract;
+		if (dynamic_cast<const MultiplyOp*>(bo) != nullptr)				return OpCode::Multiply;
+		if (dynamic_cast<const DivideOp*>(bo) != nullptr)				return OpCode::Divide;
+		if (dynamic_cast<const ModuloOp*>(bo) != nullptr)				return OpCode::Modulo;
+		if (dynamic_cast<const BitwiseAndOp*>(bo) != nullptr)			return OpCode::BitwiseAnd;
+		if (dynamic_cast<const BitwiseOrOp*>(bo) != nullptr)			return OpCode::BitwiseOr;
+		if (dynamic_cast<const BitwiseXorOp*>(bo) != nullptr)			return OpCode::BitwiseXor;
+		if (dynamic_cast<const LeftShiftOp*>(bo) != nullptr)			return OpCode::LeftShift;
+		if (dynamic_cast<const RightShiftOp*>(bo) != nullptr)			return OpCode::RightShift;
+		if (dynamic_cast<const RightShiftUnsignedOp*>(bo) != nullptr)	return OpCode::RightShiftUnsigned;
+		if (dynamic_cast<const EqualsOp*>(bo) != nullptr)				return OpCode::Equals;
+		if (dynamic_cast<const NotEqualsOp*>(bo) != nullptr)			return OpCode::NotEquals;
+		if (dynamic_cast<const LessThanOp*>(bo) != nullptr)				return OpCode::LessThan;
+		if (dynamic_cast<const LessThanOrEqualOp*>(bo) != nullptr)		return OpCode::LessThanOrEqual;
+		if (dynamic_cast<const GreaterThanOp*>(bo) != nullptr)			return OpCode::GreaterThan;
+		if (dynamic_cast<const GreaterThanOrEqualOp*>(bo) != nullptr)	return OpCode::GreaterThanOrEqual;
+
+		return OpCode::numOpCodes;
+	}
+
+	int emitLoadVar(var* data)
+	{
+		const int dst = allocateRegister();
+		getInstruction(emit(OpCode::LoadVar, dst)).variable = data;
+		return dst;
+	}
+
+	void emitStoreVar(var* data, int value)
+	{
+		getInstruction(emit(OpCode::StoreVar, value)).variable = data;
+	}
+
+	int emitLoadNamed(NamedValueSet& set, int index)
+	{
+		const int dst = allocateRegister();
+		getInstruction(emit(OpCode::LoadNamed, dst, index)).set = &set;
+		return dst;
+	}
+
+	void emitStoreNamed(NamedValueSet& set, int index, int value)
+	{
+		getInstruction(emit(OpCode::StoreNamed, value, index)).set = &set;
+	}
+
+	RootObject* root;
+	BytecodeProgram* program = nullptr;
+	LoopTargets* currentLoop = nullptr;
+
+	int numUsedRegisters = 0;
+	int maxRegisters = 0;
+
+	JUCE_DECLARE_NON_COPYABLE(BytecodeCompiler)
+};
+
+
+void HiseJavascriptEngine::RootObject::compileBytecode()
+{
+	for (auto c : hiseSpecialData.callbackNEW)
+	{
+		if (c->isDefined() && c->program == nullptr)
+			c->program = BytecodeCompiler(this).compile(c->getStatements());
+	}
+
+	auto compileInlineFunctions = [this](JavascriptNamespace* ns)
+	{
+		for (auto o : ns->inlineFunctions)
+		{
+			if (auto f = dynamic_cast<InlineFunction::Object*>(o))
+			{
+				if (f->body != nullptr && f->program == nullptr)
+					f->program = BytecodeCompiler(this).compile(f->body, f);
+			}
+		}
+	};
+
+	compileInlineFunctions(&hiseSpecialData);
+
+	for (auto ns : hiseSpecialData.namespaces)
+		compileInlineFunctions(ns);
+}
+
+
+HiseJavascriptEngine::RootObject::InlineFunction::Object::~Object()
+{
+	parameterNames.clear();
+	program = nullptr;
+	body = nullptr;
+	dynamicFunctionCall = nullptr;
+}
+
+HiseJavascriptEngine::RootObject::Statement::ResultCode HiseJavascriptEngine::RootObject::InlineFunction::Object::performBody(const Scope& s, var* returnValue)
+{
+	if (program != nullptr && s.root->useBytecode)
+		return program->perform(s, returnValue);
+
+	return body->perform(s, returnValue);
+}
+
+} // namespace hise
@@ -95,11 +95,17 @@ struct HiseJavascriptEngine::RootObject::ApiCall : public Expression
 			HiseJavascriptEngine::checkValidParameter(i, results[i], location);
 		}
 
+		return callWithArguments(results);
+	}
+
+	/** Calls the API function with the evaluated arguments (this is also used by the bytecode backend). */
+	var callWithArguments(var* arguments) const
+	{
 		CHECK_CONDITION_WITH_LOCATION(apiClass != nullptr, "API class does not exist");
 
 		try
 		{
-			return apiClass->callFunction(functionIndex, results, expectedNumArguments);
+			return apiClass->callFunction(functionIndex, arguments, expectedNumArguments);
 		}
 		catch (String& error)
 		{
@@ -230,12 +236,7 @@ struct HiseJavascriptEngine::RootObject::InlineFunction
 			dynamicFunctionCall = new FunctionCall(lo, this, false);
 		}
 
-		~Object()
-		{
-			parameterNames.clear();
-			body = nullptr;
-			dynamicFunctionCall = nullptr;
-		}
+		~Object();
 
 		String getDebugValue() const override { return lastReturnValue.toString(); }
 
@@ -315,7 +316,7 @@ struct HiseJavascriptEngine::RootObject::InlineFunction
 				dynamicFunctionCall->parameterResults.setUnchecked(i, args[i]);
 			}
 
-			Statement::ResultCode c = body->perform(s, &lastReturnValue);
+			Statement::ResultCode c = performBody(s, &lastReturnValue);
 
 			cleanUpAfterExecution();
 
@@ -323,6 +324,9 @@ struct HiseJavascriptEngine::RootObject::InlineFunction
 			else return var::undefined();
 		}
 
+		/** Executes the body (using the bytecode program if it was compiled). */
+		Statement::ResultCode performBody(const Scope& s, var* returnValue);
+
 		void cleanLocalProperties()
 		{
 #if ENABLE_SCRIPTING_SAFE_CHECKS
@@ -343,6 +347,7 @@ struct HiseJavascriptEngine::RootObject::InlineFunction
 		Array<Identifier> parameterNames;
 		typedef ReferenceCountedObjectPtr<Object> Ptr;
 		ScopedPointer<BlockStatement> body;
+		ScopedPointer<BytecodeProgram> program;
 
 		String functionDef;
 		String commentDoc;
@@ -403,11 +408,17 @@ struct HiseJavascriptEngine::RootObject::InlineFunction
 				parameterResults.setUnchecked(i, parameterExpressions.getUnchecked(i)->getResult(s));
 			}
 
+			return performWithParameters(s);
+		}
+
+		/** Executes the function after the parameters were set (this is also used by the bytecode backend). */
+		var performWithParameters(const Scope& s) const
+		{
 			s.root->addToCallStack(f->name, &location);
 
 			try
 			{
-				ResultCode c = f->body->perform(s, &returnVar);
+				ResultCode c = f->performBody(s, &returnVar);
 
 				s.root->removeFromCallStack(f->name);
 
@@ -73,6 +73,52 @@ struct HiseJavascriptEngine::RootObject::ConstReference : public Expression
 
 
 
+/** An inline cache for the property lookup of a DynamicObject at a single call site.
+*
+*	It remembers the slot of the property in the last object. If the next object has the same property
+*	at this slot (which is a pointer comparison of the Identifier), the linear search is skipped.
+*	If the properties were changed (or it's another object with a different layout), the slot is searched again.
+*
+*	The same expression can be evaluated on multiple threads, so the slot is an atomic index and nothing else is cached.
+*
+*	If the cache is disabled with HiseJavascriptEngine::setUsePropertyCache(), every lookup searches the properties.
+*/
+struct HiseJavascriptEngine::RootObject::PropertyCache
+{
+	var* getPropertyPointer(const Scope& s, DynamicObject* o, const Identifier& id) const noexcept
+	{
+		auto& properties = o->getProperties();
+
+		if (!s.root->usePropertyCache)
+			return properties.getVarPointer(id);
+
+		int slot = cachedSlot.load(std::memory_order_relaxed);
+
+		if (isPositiveAndBelow(slot, properties.size()))
+		{
+			auto& p = properties.begin()[slot];
+
+			if (p.name == id)
+				return &p.value;
+		}
+
+		slot = properties.indexOf(id);
+		cachedSlot.store(slot, std::memory_order_relaxed);
+
+		return slot != -1 ? properties.getVarPointerAt(slot) : nullptr;
+	}
+
+	void setProperty(const Scope& s, DynamicObject* o, const Identifier& id, const var& newValue) const
+	{
+		if (var* v = getPropertyPointer(s, o, id))
+			*v = newValue;
+		else
+			o->setProperty(id, newValue);
+	}
+
+	mutable std::atomic<int> cachedSlot { -1 };
+};
+
 struct HiseJavascriptEngine::RootObject::ArraySubscript : public Expression
 {
 	ArraySubscript(const CodeLocation& l) noexcept : Expression(l) {}
@@ -86,22 +132,40 @@ struct HiseJavascriptEngine::RootObject::ArraySubscript : public Expression
 			const int i = index->getResult(s);
 			return (*b)[i];
 		}
+		else if (const Array<var>* array = result.getArray())
+			return (*array)[static_cast<int> (index->getResult(s))];
+		else if (ScriptingObjects::TypedArray* typedArray = dynamic_cast<ScriptingObjects::TypedArray*>(result.getObject()))
+		{
+			const int i = index->getResult(s);
+
+			CHECK_CONDITION_WITH_LOCATION(isPositiveAndBelow(i, typedArray->getNumElements()), "Typed array index out of bounds: " + String(i));
+
+			return typedArray->getElement(i);
+		}
 		else if (AssignableObject * instance = dynamic_cast<AssignableObject*>(result.getObject()))
 		{
 			cacheIndex(instance, s);
 
 			return instance->getAssignedValue(cachedIndex);
 		}
-		else if (const Array<var>* array = result.getArray())
-			return (*array)[static_cast<int> (index->getResult(s))];
-
         else if (const DynamicObject* obj = result.getDynamicObject())
         {
+            if (literalKey.isValid())
+            {
+				if (const var* v = propertyCache.getPropertyPointer(s, const_cast<DynamicObject*>(obj), literalKey))
+					return *v;
+
+				return var();
+            }
+
             const String name = index->getResult(s).toString();
             
             if(name.isNotEmpty())
             {
-                return obj->getProperty(Identifier(name));
+				if (const var* v = propertyCache.getPropertyPointer(s, const_cast<DynamicObject*>(obj), Identifier(name)))
+					return *v;
+
+				return var();
             }
             
             
@@ -126,12 +190,25 @@ struct HiseJavascriptEngine::RootObject::ArraySubscript : public Expression
 		else if (Array<var>* array = result.getArray())
 		{
 			const int i = index->getResult(s);
+
+			if (i >= array->size())
+				AllocationCounter::addAllocation(sizeof(var) * (size_t)(i + 1 - array->size()));
+
 			while (array->size() < i)
 				array->add(var::undefined());
 
 			array->set(i, newValue);
 			return;
 		}
+		else if (ScriptingObjects::TypedArray* typedArray = dynamic_cast<ScriptingObjects::TypedArray*>(result.getObject()))
+		{
+			const int i = index->getResult(s);
+
+			CHECK_CONDITION_WITH_LOCATION(isPositiveAndBelow(i, typedArray->getNumElements()), "Typed array index out of bounds: " + String(i));
+
+			typedArray->setElement(i, newValue);
+			return;
+		}
 		else if (AssignableObject * instance = dynamic_cast<AssignableObject*>(result.getObject()))
 		{
 			cacheIndex(instance, s);
@@ -142,9 +219,12 @@ struct HiseJavascriptEngine::RootObject::ArraySubscript : public Expression
 		}
         else if (DynamicObject* obj = result.getDynamicObject())
         {
+            if (literalKey.isValid())
+                return propertyCache.setProperty(s, obj, literalKey, newValue);
+
             const String name = index->getResult(s).toString();
                      
-            return obj->setProperty(Identifier(name), newValue);
+            return propertyCache.setProperty(s, obj, Identifier(name), newValue);
         }
 
 
@@ -156,7 +236,12 @@ struct HiseJavascriptEngine::RootObject::ArraySubscript : public Expression
 
 	ExpPtr object, index;
 
+	/** The property name if the index is a string literal (it's created by the parser so that the lookup doesn't build an Identifier). */
+	Identifier literalKey;
+
 	mutable int cachedIndex = -1;
+
+	PropertyCache propertyCache;
 };
 
 
@@ -179,7 +264,7 @@ struct HiseJavascriptEngine::RootObject::DotOperator : public Expression
 		}
 
 		if (DynamicObject* o = p.getDynamicObject())
-			if (const var* v = getPropertyPointer(o, child))
+			if (const var* v = propertyCache.getPropertyPointer(s, o, child))
 				return *v;
 
 		if (ConstScriptingObject* o = dynamic_cast<ConstScriptingObject*>(p.getObject()))
@@ -197,13 +282,15 @@ struct HiseJavascriptEngine::RootObject::DotOperator : public Expression
 	void assign(const Scope& s, const var& newValue) const override
 	{
 		if (DynamicObject* o = parent->getResult(s).getDynamicObject())
-			o->setProperty(child, newValue);
+			propertyCache.setProperty(s, o, child, newValue);
 		else
 			Expression::assign(s, newValue);
 	}
 
 	ExpPtr parent;
 	Identifier child;
+
+	PropertyCache propertyCache;
 };
 
 
@@ -304,6 +391,8 @@ struct HiseJavascriptEngine::RootObject::ObjectDeclaration : public Expression
 
 	var getResult(const Scope& s) const override
 	{
+		AllocationCounter::addAllocation(sizeof(DynamicObject) + sizeof(NamedValueSet::NamedValue) * (size_t)names.size());
+
 		DynamicObject::Ptr newObject(new DynamicObject());
 
 		for (int i = 0; i < names.size(); ++i)
@@ -322,6 +411,8 @@ struct HiseJavascriptEngine::RootObject::ArrayDeclaration : public Expression
 
 	var getResult(const Scope& s) const override
 	{
+		AllocationCounter::addAllocation(sizeof(var) * (size_t)values.size());
+
 		Array<var> a;
 
 		for (int i = 0; i < values.size(); ++i)
@@ -76,6 +76,8 @@ struct HiseJavascriptEngine::RootObject::ArrayClass : public DynamicObject
 	{
 		if (Array<var>* array = a.thisObject.getArray())
 		{
+			AllocationCounter::addAllocation(sizeof(var) * (size_t)a.numArguments);
+
 			for (int i = 0; i < a.numArguments; ++i)
 				array->add(a.arguments[i]);
 
@@ -131,6 +133,8 @@ struct HiseJavascriptEngine::RootObject::ArrayClass : public DynamicObject
 		{
 			int index = getInt(a, 0);
 
+			AllocationCounter::addAllocation(sizeof(var) * (size_t)jmax(0, a.numArguments - 1));
+
 			for (int i = 1; i < a.numArguments; i++)
 			{
 				array->insert(index++, get(a, i));
@@ -24,6 +24,12 @@ struct HiseJavascriptEngine::RootObject::BinaryOperator : public BinaryOperatorB
 	{
 		var a(lhs->getResult(s)), b(rhs->getResult(s));
 
+		return getWithValues(a, b);
+	}
+
+	/** Applies the operator to the evaluated operands (this is also used by the bytecode backend). */
+	var getWithValues(const var& a, const var& b) const
+	{
 		if (isNumericOrUndefined(a) && isNumericOrUndefined(b))
 			return (a.isDouble() || b.isDouble()) ? getWithDoubles(a, b) : getWithInts(a, b);
 
@@ -107,7 +113,11 @@ struct HiseJavascriptEngine::RootObject::AdditionOp : public BinaryOperator
 	AdditionOp(const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator(l, a, b, TokenTypes::plus) {}
 	var getWithDoubles(double a, double b) const override                 { return a + b; }
 	var getWithInts(int64 a, int64 b) const override                      { return a + b; }
-	var getWithStrings(const String& a, const String& b) const override   { return a + b; }
+	var getWithStrings(const String& a, const String& b) const override
+	{
+		AllocationCounter::addAllocation(a.getNumBytesAsUTF8() + b.getNumBytesAsUTF8() + 1);
+		return a + b;
+	}
 
 	var getWithArrayOrObject(const var &a, const var& b) const override
 	{
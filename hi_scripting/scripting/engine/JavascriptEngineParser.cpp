@@ -1729,6 +1729,13 @@ private:
 			ScopedPointer<ArraySubscript> s(new ArraySubscript(location));
 			s->object = input;
 			s->index = parseExpression();
+
+			if (auto literal = dynamic_cast<LiteralValue*>(s->index.get()))
+			{
+				if (literal->value.isString() && literal->value.toString().isNotEmpty())
+					s->literalKey = Identifier(literal->value.toString());
+			}
+
 			match(TokenTypes::closeBracket);
 			return parseSuffixes(s.release());
 		}
@@ -2367,6 +2374,9 @@ void HiseJavascriptEngine::RootObject::execute(const String& code, bool allowCon
 	tb.setupApiData(hiseSpecialData, allowConstDeclarations ? code : String());
 
 	auto sl = ScopedPointer<BlockStatement>(tb.parseStatementList());
+
+	if (useBytecode)
+		compileBytecode();
 	
 	if(shouldUseCycleCheck)
 		prepareCycleReferenceCheck();
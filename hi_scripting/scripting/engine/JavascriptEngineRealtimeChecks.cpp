@@ -0,0 +1,289 @@
+namespace hise { using namespace juce;
+
+/** Walks through the expression tree of a realtime callback and looks for expressions that allocate memory.
+*
+*	It can't know the type of a variable, so only the expressions that always allocate (or most likely will) are
+*	reported. The runtime counters of the callbacks (HISE_COUNT_SCRIPT_ALLOCATIONS) catch the rest.
+*/
+struct HiseJavascriptEngine::RootObject::RealtimeChecker
+{
+	RealtimeChecker(RootObject* root_, const Identifier& callbackName_, StringArray& problems_) :
+		root(root_),
+		callbackName(callbackName_),
+		problems(problems_)
+	{}
+
+	void checkStatement(const Statement* s)
+	{
+		if (s == nullptr)
+			return;
+
+		if (auto e = dynamic_cast<const Expression*>(s))
+			checkExpression(e);
+		else if (auto b = dynamic_cast<const BlockStatement*>(s))
+		{
+			for (auto child : b->statements)
+				checkStatement(child);
+		}
+		else if (auto is = dynamic_cast<const IfStatement*>(s))
+		{
+			checkExpression(is->condition);
+			checkStatement(is->trueBranch);
+			checkStatement(is->falseBranch);
+		}
+		else if (auto ss = dynamic_cast<const SwitchStatement*>(s))
+		{
+			checkExpression(ss->condition);
+
+			for (auto c : ss->cases)
+				checkStatement(c);
+
+			checkStatement(ss->defaultCase);
+		}
+		else if (auto cs = dynamic_cast<const CaseStatement*>(s))
+		{
+			for (auto& c : cs->conditions)
+				checkExpression(c);
+
+			checkStatement(cs->body);
+		}
+		else if (auto ls = dynamic_cast<const LoopStatement*>(s))
+		{
+			checkStatement(ls->initialiser);
+			checkExpression(ls->condition);
+			checkExpression(ls->currentIterator);
+			checkStatement(ls->iterator);
+			checkStatement(ls->body);
+		}
+		else if (auto rs = dynamic_cast<const ReturnStatement*>(s))
+			checkExpression(rs->returnValue);
+		else if (auto vs = dynamic_cast<const VarStatement*>(s))
+			checkExpression(vs->initialiser);
+		else if (auto lvs = dynamic_cast<const LocalVarStatement*>(s))
+			checkExpression(lvs->initialiser);
+		else if (auto cls = dynamic_cast<const CallbackLocalStatement*>(s))
+			checkExpression(cls->initialiser);
+		else if (auto rvs = dynamic_cast<const RegisterVarStatement*>(s))
+			checkExpression(rvs->initialiser);
+		else if (auto gvs = dynamic_cast<const GlobalVarStatement*>(s))
+			checkExpression(gvs->initialiser);
+	}
+
+	void checkExpression(const Expression* e)
+	{
+		if (e == nullptr)
+			return;
+
+		if (auto ao = dynamic_cast<const AdditionOp*>(e))
+		{
+			if (isStringLiteral(ao->lhs) || isStringLiteral(ao->rhs))
+				addProblem(e, "String concatenation allocates a new string");
+
+			checkExpression(ao->lhs);
+			checkExpression(ao->rhs);
+		}
+		else if (auto bo = dynamic_cast<const BinaryOperatorBase*>(e))
+		{
+			checkExpression(bo->lhs);
+			checkExpression(bo->rhs);
+		}
+		else if (auto co = dynamic_cast<const ConditionalOp*>(e))
+		{
+			checkExpression(co->condition);
+			checkExpression(co->trueBranch);
+			checkExpression(co->falseBranch);
+		}
+		else if (auto a = dynamic_cast<const Assignment*>(e))
+		{
+			checkExpression(a->target);
+			checkExpression(a->newValue);
+		}
+		else if (auto sa = dynamic_cast<const SelfAssignment*>(e))
+		{
+			// The target is a part of the new value expression
+			checkExpression(sa->newValue);
+		}
+		else if (auto ra = dynamic_cast<const RegisterAssignment*>(e))
+			checkExpression(ra->source);
+		else if (auto dot = dynamic_cast<const DotOperator*>(e))
+			checkExpression(dot->parent);
+		else if (auto as = dynamic_cast<const ArraySubscript*>(e))
+		{
+			checkExpression(as->object);
+			checkExpression(as->index);
+		}
+		else if (dynamic_cast<const NewOperator*>(e) != nullptr)
+			addProblem(e, "The new operator creates a new object");
+		else if (auto fc = dynamic_cast<const FunctionCall*>(e))
+			checkFunctionCall(fc);
+		else if (auto od = dynamic_cast<const ObjectDeclaration*>(e))
+		{
+			addProblem(e, "The object literal creates a new object");
+
+			for (auto i : od->initialisers)
+				checkExpression(i);
+		}
+		else if (auto ad = dynamic_cast<const ArrayDeclaration*>(e))
+		{
+			addProblem(e, "The array literal creates a new array");
+
+			for (auto v : ad->values)
+				checkExpression(v);
+		}
+		else if (auto ac = dynamic_cast<const ApiCall*>(e))
+		{
+			for (auto& arg : ac->argumentList)
+				checkExpression(arg);
+		}
+		else if (auto coac = dynamic_cast<const ConstObjectApiCall*>(e))
+		{
+			for (auto& arg : coac->argumentList)
+				checkExpression(arg);
+		}
+		else if (auto idt = dynamic_cast<const IsDefinedTest*>(e))
+			checkExpression(idt->test);
+		else if (auto ifc = dynamic_cast<const InlineFunction::FunctionCall*>(e))
+		{
+			for (auto p : ifc->parameterExpressions)
+				checkExpression(p);
+
+			// Every inline function is only checked once (this also stops recursive functions)
+			if (!checkedFunctions.contains(ifc->f))
+			{
+				checkedFunctions.add(ifc->f);
+				checkStatement(ifc->f->body);
+			}
+		}
+	}
+
+	void checkFunctionCall(const FunctionCall* fc)
+	{
+		if (auto dot = dynamic_cast<const DotOperator*>(fc->object.get()))
+		{
+			if (getAllocatingMethods().contains(dot->child))
+				addProblem(fc, "The method " + dot->child.toString() + "() allocates memory");
+		}
+		else if (auto un = dynamic_cast<const UnqualifiedName*>(fc->object.get()))
+		{
+			if (dynamic_cast<FunctionObject*>(root->getProperty(un->name).getObject()) != nullptr)
+				addProblem(fc, "Calling the function " + un->name.toString() + "() creates a new scope. Use an inline function instead");
+		}
+
+		checkExpression(fc->object);
+
+		for (auto arg : fc->arguments)
+			checkExpression(arg);
+	}
+
+	static bool isStringLiteral(const ExpPtr& e)
+	{
+		if (auto l = dynamic_cast<const LiteralValue*>(e.get()))
+			return l->value.isString();
+
+		return false;
+	}
+
+	/** The Array and String methods that resize an array or create a new string. */
+	static const Array<Identifier>& getAllocatingMethods()
+	{
+		static const Array<Identifier> methods = { "push", "insert", "concat", "join", "split",
+												   "replace", "substring", "toUpperCase", "toLowerCase" };
+
+		return methods;
+	}
+
+	void addProblem(const Expression* e, const String& message)
+	{
+		problems.add(callbackName.toString() + "() - " + e->location.getLocationString() + ": " + message);
+	}
+
+	RootObject* root;
+	const Identifier callbackName;
+	StringArray& problems;
+
+	Array<const InlineFunction::Object*> checkedFunctions;
+
+	JUCE_DECLARE_NON_COPYABLE(RealtimeChecker)
+};
+
+StringArray HiseJavascriptEngine::checkRealtimeCallback(const Identifier& callbackName)
+{
+	StringArray problems;
+
+	if (auto c = root->hiseSpecialData.getCallback(callbackName))
+	{
+		if (c->isDefined())
+			RootObject::RealtimeChecker(root, callbackName, problems).checkStatement(c->getStatements());
+
+		// The allocations of a callback with warnings are already known, so only the others are trapped
+		c->setRealtimeCallback(true, problems.isEmpty());
+	}
+
+	return problems;
+}
+
+
+static thread_local HiseJavascriptEngine::RootObject::AllocationCounter* currentAllocationCounter = nullptr;
+
+HiseJavascriptEngine::RootObject::AllocationCounter::AllocationCounter(bool shouldTrapAllocations) noexcept :
+	previousCounter(currentAllocationCounter),
+	trapAllocations(shouldTrapAllocations)
+{
+	currentAllocationCounter = this;
+}
+
+HiseJavascriptEngine::RootObject::AllocationCounter::~AllocationCounter()
+{
+	currentAllocationCounter = previousCounter;
+}
+
+void HiseJavascriptEngine::RootObject::AllocationCounter::addAllocation(size_t numBytes) noexcept
+{
+	if (auto c = currentAllocationCounter)
+	{
+		c->numAllocations++;
+		c->numBytes += (int64)numBytes;
+
+		if (c->trapAllocations)
+		{
+			// The assertion might allocate itself, so the counter is deactivated until it returns
+			currentAllocationCounter = nullptr;
+
+			// A realtime callback allocated memory. Check the call stack for the expression that caused this.
+			jassertfalse;
+
+			currentAllocationCounter = c;
+		}
+	}
+}
+
+} // namespace hise
+
+#if HISE_COUNT_SCRIPT_ALLOCATIONS && HISE_COUNT_ALL_SCRIPT_ALLOCATIONS
+
+void* operator new(std::size_t numBytes, const std::nothrow_t&) noexcept
+{
+	hise::HiseJavascriptEngine::RootObject::AllocationCounter::addAllocation(numBytes);
+
+	return std::malloc(numBytes != 0 ? numBytes : 1);
+}
+
+void* operator new(std::size_t numBytes)
+{
+	if (void* p = operator new(numBytes, std::nothrow))
+		return p;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t numBytes)									{ return operator new(numBytes); }
+void* operator new[](std::size_t numBytes, const std::nothrow_t&) noexcept	{ return operator new(numBytes, std::nothrow); }
+
+void operator delete(void* p) noexcept									{ std::free(p); }
+void operator delete[](void* p) noexcept								{ std::free(p); }
+void operator delete(void* p, std::size_t) noexcept						{ std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept					{ std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept			{ std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept			{ std::free(p); }
+
+#endif
@@ -238,6 +238,7 @@ struct HiseJavascriptEngine::RootObject::LoopStatement : public Statement
 				return data->getArray()->getUnchecked(loop->index);
 			}
 			else if (data->isBuffer())		return data->getBuffer()->getSample(loop->index);
+			else if (auto ta = dynamic_cast<ScriptingObjects::TypedArray*>(data->getObject())) return ta->getElement(loop->index);
 			else if (data->isObject())		return data->getDynamicObject()->getProperties().getName(loop->index).toString();
 			else location.throwError("Illegal iterator target");
 
@@ -252,6 +253,7 @@ struct HiseJavascriptEngine::RootObject::LoopStatement : public Statement
 
 			if (data->isArray())		data->getArray()->set(loop->index, newValue);
 			else if (data->isBuffer())	data->getBuffer()->setSample(loop->index, newValue);
+			else if (auto ta = dynamic_cast<ScriptingObjects::TypedArray*>(data->getObject())) ta->setElement(loop->index, newValue);
 			else if (data->isObject())	*data->getDynamicObject()->getProperties().getVarPointerAt(loop->index) = newValue;	   
 		}
 
@@ -273,8 +275,11 @@ struct HiseJavascriptEngine::RootObject::LoopStatement : public Statement
 			ScopedValueSetter<void*> loopScoper(s.currentLoopStatement, (void*)this);
 			index = 0;
 
+			auto typedArray = dynamic_cast<ScriptingObjects::TypedArray*>(currentObject.getObject());
+
 			const int size = currentObject.isArray() ? currentObject.getArray()->size() :
 							 currentObject.isBuffer() ? currentObject.getBuffer()->size :
+							 typedArray != nullptr ? typedArray->getNumElements() :
 							 currentObject.isObject() ? currentObject.getDynamicObject()->getProperties().size() : 0;
 
 			while (index < size)
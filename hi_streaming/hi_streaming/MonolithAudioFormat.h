@@ -302,6 +302,15 @@ public:
 	{
 		return multiChannelSampleInformation[channelIndex][sampleIndex].fileName;
 	}
+
+	/** Returns the monolith file for the given channel. */
+	File getMonolithicFile(int channelIndex) const
+	{
+		if (isPositiveAndBelow(channelIndex, (int)monolithicFiles.size()))
+			return monolithicFiles[channelIndex];
+
+		return File();
+	}
     
     int64 getMonolithOffset(int sampleIndex) const
     {
@@ -387,11 +396,35 @@ public:
 
 	void fillMetadataInfo(const ValueTree& sampleMap);
 
+	/** Lets all readers share the decoded blocks in the given cache. Call this after fillMetadataInfo(). */
+	void setBlockCache(hlac::HlacBlockCache* cache)
+	{
+		for (int i = 0; i < (int)monolithicFiles.size(); i++)
+		{
+			const uint32 fileId = cache != nullptr ? cache->createFileId() : 0;
+
+			if (auto r = fallbackReaders[i])
+				r->setBlockCache(cache, fileId);
+
+			if (auto r = memoryReaders[i])
+				r->setBlockCache(cache, fileId);
+		}
+	}
+
 	String getFileName(int channelIndex, int sampleIndex) const
 	{
 		return multiChannelSampleInformation[channelIndex][sampleIndex].fileName;
 	}
 
+	/** Returns the monolith file for the given channel. */
+	File getMonolithicFile(int channelIndex) const
+	{
+		if (isPositiveAndBelow(channelIndex, (int)monolithicFiles.size()))
+			return monolithicFiles[channelIndex];
+
+		return File();
+	}
+
 	int64 getMonolithOffset(int sampleIndex) const
 	{
 		return multiChannelSampleInformation[0][sampleIndex].start;
@@ -0,0 +1,1011 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#if JUCE_USE_SSE_INTRINSICS
+#include <emmintrin.h>
+#elif JUCE_USE_ARM_NEON
+#include <arm_neon.h>
+#endif
+
+namespace hise { using namespace juce;
+
+namespace InterpolatorHelpers
+{
+
+struct FixedPitch
+{
+	FixedPitch(double uptimeDelta) :
+		delta((float)uptimeDelta)
+	{}
+
+	forcedinline float getDelta(int /*index*/) const noexcept { return delta; }
+
+	const float delta;
+};
+
+struct ModulatedPitch
+{
+	ModulatedPitch(const float* pitchData_) :
+		pitchData(pitchData_)
+	{}
+
+	forcedinline float getDelta(int index) const noexcept
+	{
+		jassert(pitchData[index] <= (float)MAX_SAMPLER_PITCH);
+		return pitchData[index];
+	}
+
+	const float* pitchData;
+};
+
+forcedinline float getGainFactor(const int16*) noexcept { return 1.0f / (float)INT16_MAX; }
+forcedinline float getGainFactor(const float*) noexcept { return 1.0f; }
+
+/** The offsets of four consecutive frames relative to the read position of the first frame.
+*
+*	The read position is not accumulated frame by frame, but in blocks of four frames: the offsets
+*	within a block are a prefix sum of the pitch deltas and only the last value is added to the
+*	running index. This keeps the dependency chain at one addition per four frames. The sums are
+*	evaluated in the same order as the vectorised scan, so both implementations yield identical
+*	read positions.
+*/
+struct BlockOffsets
+{
+	template <typename PitchType> BlockOffsets(const PitchType& pitch, int startIndex, int numFrames)
+	{
+		float p[4];
+
+		for (int j = 0; j < 4; j++)
+			p[j] = j < numFrames ? pitch.getDelta(startIndex + j) : 0.0f;
+
+		offsets[0] = 0.0f;
+		offsets[1] = p[0];
+		offsets[2] = p[0] + p[1];
+		offsets[3] = (p[1] + p[2]) + p[0];
+		offsets[4] = (p[2] + p[3]) + (p[0] + p[1]);
+	}
+
+	float offsets[5];
+};
+
+/** 2-point linear interpolation between the sample at the read position and the next sample. */
+struct LinearKernel
+{
+	template <typename SignalType> forcedinline void processFrame(const SignalType* inL, const SignalType* inR, int pos, float alpha, float& l, float& r) const noexcept
+	{
+		const float invAlpha = 1.0f - alpha;
+
+		l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
+		r = ((float)inR[pos] * invAlpha + (float)inR[pos + 1] * alpha);
+	}
+};
+
+/** 4-point, 3rd-order Hermite interpolation (x-form). */
+struct HermiteKernel
+{
+	static forcedinline float interpolate(float ym1, float y0, float y1, float y2, float x) noexcept
+	{
+		const float c1 = 0.5f * (y1 - ym1);
+		const float c2 = (ym1 + 2.0f * y1) - (2.5f * y0 + 0.5f * y2);
+		const float c3 = 0.5f * (y2 - ym1) + 1.5f * (y0 - y1);
+
+		return ((c3 * x + c2) * x + c1) * x + y0;
+	}
+
+	template <typename SignalType> forcedinline void processFrame(const SignalType* inL, const SignalType* inR, int pos, float alpha, float& l, float& r) const noexcept
+	{
+		l = interpolate((float)inL[pos - 1], (float)inL[pos], (float)inL[pos + 1], (float)inL[pos + 2], alpha);
+		r = interpolate((float)inR[pos - 1], (float)inR[pos], (float)inR[pos + 1], (float)inR[pos + 2], alpha);
+	}
+};
+
+/** Convolves the signal with the coefficients from the SincTable. */
+struct SincKernel
+{
+	using Table = SampleInterpolator::SincTable;
+
+	enum
+	{
+		FirstTap = 1 - Table::NumTaps / 2
+	};
+
+	SincKernel(const Table& table_, int tableIndex_) :
+		table(table_),
+		tableIndex(tableIndex_)
+	{}
+
+	template <typename SignalType> forcedinline void processFrame(const SignalType* inL, const SignalType* inR, int pos, float alpha, float& l, float& r) const noexcept
+	{
+		const float phase = alpha * (float)Table::NumPhases;
+		const int phaseIndex = (int)phase;
+		const float phaseAlpha = phase - (float)phaseIndex;
+
+		const float* row = table.getRow(tableIndex, phaseIndex);
+		const float* delta = row + Table::NumTaps;
+
+		inL += pos + FirstTap;
+		inR += pos + FirstTap;
+
+		l = 0.0f;
+		r = 0.0f;
+
+		for (int i = 0; i < Table::NumTaps; i++)
+		{
+			const float c = row[i] + delta[i] * phaseAlpha;
+
+			l += (float)inL[i] * c;
+			r += (float)inR[i] * c;
+		}
+	}
+
+	const Table& table;
+	const int tableIndex;
+};
+
+/** Interpolates the frames from startIndex to numSamples. index is the (fractional) read position of the frame at startIndex. */
+template <typename KernelType, typename SignalType, typename PitchType> void processScalar(const KernelType& kernel, const SignalType* inL, const SignalType* inR, float* outL, float* outR, float index, const PitchType& pitch, int startIndex, int numSamples)
+{
+	const float gainFactor = getGainFactor(inL);
+
+	for (int i = startIndex; i < numSamples; i += 4)
+	{
+		const int numFrames = jmin<int>(4, numSamples - i);
+		const BlockOffsets block(pitch, i, numFrames);
+
+		for (int j = 0; j < numFrames; j++)
+		{
+			const float frameIndex = index + block.offsets[j];
+			const int pos = int(frameIndex);
+			const float alpha = frameIndex - (float)pos;
+
+			float l, r;
+
+			kernel.processFrame(inL, inR, pos, alpha, l, r);
+
+			outL[i + j] = l * gainFactor;
+			outR[i + j] = r * gainFactor;
+		}
+
+		index += block.offsets[4];
+	}
+}
+
+#if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+
+/** A thin wrapper around the SSE2 / NEON instructions that are needed by the kernels. */
+struct VectorOps
+{
+#if JUCE_USE_SSE_INTRINSICS
+	using FloatType = __m128;
+	using IntType = __m128i;
+
+	static forcedinline FloatType load(const float* data) noexcept { return _mm_loadu_ps(data); }
+	static forcedinline FloatType set(const float* v) noexcept { return _mm_set_ps(v[3], v[2], v[1], v[0]); }
+	static forcedinline void store(float* data, FloatType v) noexcept { _mm_storeu_ps(data, v); }
+	static forcedinline void store(int* data, IntType v) noexcept { _mm_storeu_si128(reinterpret_cast<IntType*>(data), v); }
+	static forcedinline FloatType expand(float value) noexcept { return _mm_set1_ps(value); }
+	static forcedinline IntType truncate(FloatType v) noexcept { return _mm_cvttps_epi32(v); }
+	static forcedinline FloatType toFloat(IntType v) noexcept { return _mm_cvtepi32_ps(v); }
+	static forcedinline FloatType add(FloatType a, FloatType b) noexcept { return _mm_add_ps(a, b); }
+	static forcedinline FloatType sub(FloatType a, FloatType b) noexcept { return _mm_sub_ps(a, b); }
+	static forcedinline FloatType mul(FloatType a, FloatType b) noexcept { return _mm_mul_ps(a, b); }
+
+	/** Moves the elements one lane up and shifts in zeros. */
+	static forcedinline FloatType shiftUp1(FloatType v) noexcept { return _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 4)); }
+
+	/** Moves the elements two lanes up and shifts in zeros. */
+	static forcedinline FloatType shiftUp2(FloatType v) noexcept { return _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 8)); }
+
+	static forcedinline FloatType broadcastLast(FloatType v) noexcept { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)); }
+
+	static forcedinline void transpose(FloatType& r0, FloatType& r1, FloatType& r2, FloatType& r3) noexcept
+	{
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	}
+
+	/** Loads four consecutive samples. */
+	static forcedinline FloatType loadFour(const int16* data) noexcept
+	{
+		const IntType v = _mm_loadl_epi64(reinterpret_cast<const IntType*>(data));
+		return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+	}
+
+	static forcedinline FloatType loadFour(const float* data) noexcept { return _mm_loadu_ps(data); }
+
+	/** Loads the samples at the positions p and p + 1. */
+	static forcedinline void gather(const int16* in, const int* p, FloatType& a, FloatType& b) noexcept
+	{
+		// in[p] and in[p+1] are adjacent, so one 32 bit load fetches both samples
+		const IntType pairs = _mm_set_epi32(loadPair(in + p[3]), loadPair(in + p[2]), loadPair(in + p[1]), loadPair(in + p[0]));
+
+		a = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(pairs, 16), 16));
+		b = _mm_cvtepi32_ps(_mm_srai_epi32(pairs, 16));
+	}
+
+	static forcedinline void gather(const float* in, const int* p, FloatType& a, FloatType& b) noexcept
+	{
+		const FloatType p01 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(in + p[0])), reinterpret_cast<const __m64*>(in + p[1]));
+		const FloatType p23 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(in + p[2])), reinterpret_cast<const __m64*>(in + p[3]));
+
+		a = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0));
+		b = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(3, 1, 3, 1));
+	}
+#else
+	using FloatType = float32x4_t;
+	using IntType = int32x4_t;
+
+	static forcedinline FloatType load(const float* data) noexcept { return vld1q_f32(data); }
+	static forcedinline FloatType set(const float* v) noexcept { return vld1q_f32(v); }
+	static forcedinline void store(float* data, FloatType v) noexcept { vst1q_f32(data, v); }
+	static forcedinline void store(int* data, IntType v) noexcept { vst1q_s32(data, v); }
+	static forcedinline FloatType expand(float value) noexcept { return vdupq_n_f32(value); }
+	static forcedinline IntType truncate(FloatType v) noexcept { return vcvtq_s32_f32(v); }
+	static forcedinline FloatType toFloat(IntType v) noexcept { return vcvtq_f32_s32(v); }
+	static forcedinline FloatType add(FloatType a, FloatType b) noexcept { return vaddq_f32(a, b); }
+	static forcedinline FloatType sub(FloatType a, FloatType b) noexcept { return vsubq_f32(a, b); }
+	static forcedinline FloatType mul(FloatType a, FloatType b) noexcept { return vmulq_f32(a, b); }
+	static forcedinline FloatType shiftUp1(FloatType v) noexcept { return vextq_f32(vdupq_n_f32(0.0f), v, 3); }
+	static forcedinline FloatType shiftUp2(FloatType v) noexcept { return vextq_f32(vdupq_n_f32(0.0f), v, 2); }
+	static forcedinline FloatType broadcastLast(FloatType v) noexcept { return vdupq_n_f32(vgetq_lane_f32(v, 3)); }
+
+	static forcedinline void transpose(FloatType& r0, FloatType& r1, FloatType& r2, FloatType& r3) noexcept
+	{
+		const float32x4x2_t t01 = vtrnq_f32(r0, r1);
+		const float32x4x2_t t23 = vtrnq_f32(r2, r3);
+
+		r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+		r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+		r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+		r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+	}
+
+	static forcedinline FloatType loadFour(const int16* data) noexcept { return vcvtq_f32_s32(vmovl_s16(vld1_s16(data))); }
+	static forcedinline FloatType loadFour(const float* data) noexcept { return vld1q_f32(data); }
+
+	static forcedinline void gather(const int16* in, const int* p, FloatType& a, FloatType& b) noexcept
+	{
+		const int32 data[4] = { loadPair(in + p[0]), loadPair(in + p[1]), loadPair(in + p[2]), loadPair(in + p[3]) };
+		const IntType pairs = vld1q_s32(data);
+
+		a = vcvtq_f32_s32(vshrq_n_s32(vshlq_n_s32(pairs, 16), 16));
+		b = vcvtq_f32_s32(vshrq_n_s32(pairs, 16));
+	}
+
+	static forcedinline void gather(const float* in, const int* p, FloatType& a, FloatType& b) noexcept
+	{
+		const FloatType p01 = vcombine_f32(vld1_f32(in + p[0]), vld1_f32(in + p[1]));
+		const FloatType p23 = vcombine_f32(vld1_f32(in + p[2]), vld1_f32(in + p[3]));
+		const float32x4x2_t deinterleaved = vuzpq_f32(p01, p23);
+
+		a = deinterleaved.val[0];
+		b = deinterleaved.val[1];
+	}
+#endif
+
+	/** Reads two adjacent int16 samples as one (little endian) 32 bit word. */
+	static forcedinline int32 loadPair(const int16* data) noexcept
+	{
+		int32 v;
+		memcpy(&v, data, sizeof(int32));
+		return v;
+	}
+
+	/** Loads the four samples starting at p[i] + offset for each frame and transposes them
+	*	so that every vector contains one tap position of all four frames.
+	*/
+	template <typename SignalType> static forcedinline void loadTransposed(const SignalType* in, const int* p, int offset, FloatType& t0, FloatType& t1, FloatType& t2, FloatType& t3) noexcept
+	{
+		t0 = loadFour(in + p[0] + offset);
+		t1 = loadFour(in + p[1] + offset);
+		t2 = loadFour(in + p[2] + offset);
+		t3 = loadFour(in + p[3] + offset);
+
+		transpose(t0, t1, t2, t3);
+	}
+
+	/** Calculates the offsets of the four frames and the increment for the next block (see BlockOffsets). */
+	static forcedinline void getOffsets(const FixedPitch& pitch, int /*startIndex*/, FloatType& offsets, FloatType& increment) noexcept
+	{
+		// the compiler hoists this out of the loop
+		const BlockOffsets block(pitch, 0, 4);
+
+		offsets = set(block.offsets);
+		increment = expand(block.offsets[4]);
+	}
+
+	static forcedinline void getOffsets(const ModulatedPitch& pitch, int startIndex, FloatType& offsets, FloatType& increment) noexcept
+	{
+		jassert(pitch.getDelta(startIndex) <= (float)MAX_SAMPLER_PITCH);
+
+		const FloatType p = load(pitch.pitchData + startIndex);
+
+		// Inclusive prefix sum: [p0, p0+p1, (p1+p2)+p0, (p2+p3)+(p0+p1)]
+		FloatType scan = add(p, shiftUp1(p));
+		scan = add(scan, shiftUp2(scan));
+
+		offsets = shiftUp1(scan);
+		increment = broadcastLast(scan);
+	}
+};
+
+using V = VectorOps;
+
+struct LinearVectorKernel
+{
+	LinearVectorKernel() :
+		one(V::expand(1.0f))
+	{}
+
+	template <typename SignalType> forcedinline void process(const SignalType* inL, const SignalType* inR, const int* positions, V::FloatType alpha, V::FloatType& l, V::FloatType& r) const noexcept
+	{
+		const V::FloatType invAlpha = V::sub(one, alpha);
+
+		V::FloatType a, b;
+
+		// Same order of operations as the scalar kernel (and no fused multiply-adds) to stay bit-exact
+		V::gather(inL, positions, a, b);
+		l = V::add(V::mul(a, invAlpha), V::mul(b, alpha));
+
+		V::gather(inR, positions, a, b);
+		r = V::add(V::mul(a, invAlpha), V::mul(b, alpha));
+	}
+
+	const V::FloatType one;
+};
+
+struct HermiteVectorKernel
+{
+	HermiteVectorKernel() :
+		half(V::expand(0.5f)),
+		oneAndHalf(V::expand(1.5f)),
+		two(V::expand(2.0f)),
+		twoAndHalf(V::expand(2.5f))
+	{}
+
+	forcedinline V::FloatType interpolate(V::FloatType ym1, V::FloatType y0, V::FloatType y1, V::FloatType y2, V::FloatType x) const noexcept
+	{
+		const V::FloatType c1 = V::mul(half, V::sub(y1, ym1));
+		const V::FloatType c2 = V::sub(V::add(ym1, V::mul(two, y1)), V::add(V::mul(twoAndHalf, y0), V::mul(half, y2)));
+		const V::FloatType c3 = V::add(V::mul(half, V::sub(y2, ym1)), V::mul(oneAndHalf, V::sub(y0, y1)));
+
+		return V::add(V::mul(V::add(V::mul(V::add(V::mul(c3, x), c2), x), c1), x), y0);
+	}
+
+	template <typename SignalType> forcedinline void process(const SignalType* inL, const SignalType* inR, const int* positions, V::FloatType alpha, V::FloatType& l, V::FloatType& r) const noexcept
+	{
+		V::FloatType ym1, y0, y1, y2;
+
+		V::loadTransposed(inL, positions, -1, ym1, y0, y1, y2);
+		l = interpolate(ym1, y0, y1, y2, alpha);
+
+		V::loadTransposed(inR, positions, -1, ym1, y0, y1, y2);
+		r = interpolate(ym1, y0, y1, y2, alpha);
+	}
+
+	const V::FloatType half, oneAndHalf, two, twoAndHalf;
+};
+
+struct SincVectorKernel
+{
+	using Table = SampleInterpolator::SincTable;
+
+	SincVectorKernel(const Table& table_, int tableIndex_) :
+		table(table_),
+		tableIndex(tableIndex_),
+		numPhases(V::expand((float)Table::NumPhases))
+	{
+		static_assert(Table::NumTaps == 16, "The loop below is unrolled for 16 taps");
+	}
+
+	template <typename SignalType> forcedinline void process(const SignalType* inL, const SignalType* inR, const int* positions, V::FloatType alpha, V::FloatType& l, V::FloatType& r) const noexcept
+	{
+		const V::FloatType phase = V::mul(alpha, numPhases);
+		const V::IntType phaseIndex = V::truncate(phase);
+
+		int phaseIndexes[4];
+		float phaseAlphas[4];
+
+		V::store(phaseIndexes, phaseIndex);
+		V::store(phaseAlphas, V::sub(phase, V::toFloat(phaseIndex)));
+
+		V::FloatType sumL[4], sumR[4];
+
+		for (int j = 0; j < 4; j++)
+		{
+			const float* row = table.getRow(tableIndex, phaseIndexes[j]);
+			const V::FloatType phaseAlpha = V::expand(phaseAlphas[j]);
+
+			const SignalType* frameL = inL + positions[j] + SincKernel::FirstTap;
+			const SignalType* frameR = inR + positions[j] + SincKernel::FirstTap;
+
+			V::FloatType accL = V::expand(0.0f);
+			V::FloatType accR = accL;
+
+			for (int t = 0; t < Table::NumTaps; t += 4)
+			{
+				const V::FloatType c = V::add(V::load(row + t), V::mul(V::load(row + Table::NumTaps + t), phaseAlpha));
+
+				accL = V::add(accL, V::mul(V::loadFour(frameL + t), c));
+				accR = V::add(accR, V::mul(V::loadFour(frameR + t), c));
+			}
+
+			sumL[j] = accL;
+			sumR[j] = accR;
+		}
+
+		// The horizontal sums of all four frames in one go
+		V::transpose(sumL[0], sumL[1], sumL[2], sumL[3]);
+		V::transpose(sumR[0], sumR[1], sumR[2], sumR[3]);
+
+		l = V::add(V::add(sumL[0], sumL[1]), V::add(sumL[2], sumL[3]));
+		r = V::add(V::add(sumR[0], sumR[1]), V::add(sumR[2], sumR[3]));
+	}
+
+	const Table& table;
+	const int tableIndex;
+	const V::FloatType numPhases;
+};
+
+/** Interpolates four frames per iteration and hands the remaining frames to the scalar kernel. */
+template <typename VectorKernelType, typename KernelType, typename SignalType, typename PitchType> void processVectorised(const VectorKernelType& vectorKernel, const KernelType& kernel, const SignalType* inL, const SignalType* inR, float* outL, float* outR, float index, const PitchType& pitch, int numSamples)
+{
+	const V::FloatType gainFactor = V::expand(getGainFactor(inL));
+
+	V::FloatType blockIndex = V::expand(index);
+
+	int positions[4];
+	int i = 0;
+
+	for (; i + 4 <= numSamples; i += 4)
+	{
+		V::FloatType offsets, increment;
+		V::getOffsets(pitch, i, offsets, increment);
+
+		const V::FloatType idx = V::add(blockIndex, offsets);
+		const V::IntType pos = V::truncate(idx);
+
+		V::store(positions, pos);
+
+		const V::FloatType alpha = V::sub(idx, V::toFloat(pos));
+
+		V::FloatType l, r;
+
+		vectorKernel.process(inL, inR, positions, alpha, l, r);
+
+		V::store(outL + i, V::mul(l, gainFactor));
+		V::store(outR + i, V::mul(r, gainFactor));
+
+		blockIndex = V::add(blockIndex, increment);
+	}
+
+	if (i < numSamples)
+	{
+		float lastIndex[4];
+		V::store(lastIndex, blockIndex);
+
+		processScalar(kernel, inL, inR, outL, outR, lastIndex[0], pitch, i, numSamples);
+	}
+}
+
+#define HI_VECTORISED_INTERPOLATION 1
+#else
+#define HI_VECTORISED_INTERPOLATION 0
+#endif
+
+template <typename VectorKernelType, typename KernelType, typename SignalType> void process(const VectorKernelType& vectorKernel, const KernelType& kernel, const SignalType* inL, const SignalType* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples, bool allowVectorisation)
+{
+	const float index = (float)indexInBuffer;
+
+#if HI_VECTORISED_INTERPOLATION
+	if (allowVectorisation)
+	{
+		if (pitchData != nullptr)
+			processVectorised(vectorKernel, kernel, inL, inR, outL, outR, index, ModulatedPitch(pitchData + startSample), numSamples);
+		else
+			processVectorised(vectorKernel, kernel, inL, inR, outL, outR, index, FixedPitch(uptimeDelta), numSamples);
+
+		return;
+	}
+#else
+	ignoreUnused(vectorKernel, allowVectorisation);
+#endif
+
+	if (pitchData != nullptr)
+		processScalar(kernel, inL, inR, outL, outR, index, ModulatedPitch(pitchData + startSample), 0, numSamples);
+	else
+		processScalar(kernel, inL, inR, outL, outR, index, FixedPitch(uptimeDelta), 0, numSamples);
+}
+
+#if !HI_VECTORISED_INTERPOLATION
+struct LinearVectorKernel {};
+struct HermiteVectorKernel {};
+
+struct SincVectorKernel
+{
+	SincVectorKernel(const SampleInterpolator::SincTable&, int) {}
+};
+#endif
+
+template <typename SignalType> void processWithMode(SampleInterpolator::InterpolationMode mode, const SampleInterpolator::SincTable* sincTable, const SignalType* inL, const SignalType* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples, bool allowVectorisation)
+{
+	if (mode == SampleInterpolator::Sinc && sincTable == nullptr)
+	{
+		// You need to pass in the table for this mode...
+		jassertfalse;
+		mode = SampleInterpolator::Linear;
+	}
+
+	switch (mode)
+	{
+	case SampleInterpolator::Hermite:
+		process(HermiteVectorKernel(), HermiteKernel(), inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, allowVectorisation);
+		break;
+	case SampleInterpolator::Sinc:
+	{
+		// The cutoff frequency of the kernel follows the pitch at the start of the block
+		const double pitchRatio = pitchData != nullptr ? (double)pitchData[startSample] : uptimeDelta;
+		const int tableIndex = SampleInterpolator::SincTable::getTableIndex(pitchRatio);
+
+		process(SincVectorKernel(*sincTable, tableIndex), SincKernel(*sincTable, tableIndex), inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, allowVectorisation);
+		break;
+	}
+	case SampleInterpolator::Linear:
+	default:
+		process(LinearVectorKernel(), LinearKernel(), inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, allowVectorisation);
+		break;
+	}
+}
+
+/** The zeroth order modified Bessel function of the first kind (for the Kaiser window). */
+static double besselI0(double x)
+{
+	double sum = 1.0;
+	double term = 1.0;
+
+	for (int k = 1; k < 32; k++)
+	{
+		const double t = x / (2.0 * (double)k);
+		term *= t * t;
+		sum += term;
+
+		if (term < sum * 1e-12)
+			break;
+	}
+
+	return sum;
+}
+
+} // namespace InterpolatorHelpers
+
+
+SampleInterpolator::SincTable::SincTable()
+{
+	// The cutoff frequency (relative to the sample rate of the source) for unpitched playback
+	const double baseCutoff = 0.45;
+
+	// The Kaiser window shape (~70dB stopband attenuation)
+	const double beta = 7.0;
+	const double halfLength = (double)NumTaps / 2.0;
+	const double windowGain = 1.0 / InterpolatorHelpers::besselI0(beta);
+
+	data.calloc(NumTables * (NumPhases + 1) * RowSize);
+
+	for (int t = 0; t < NumTables; t++)
+	{
+		const double cutoff = baseCutoff / std::pow(2.0, 0.5 * (double)t);
+
+		for (int p = 0; p <= NumPhases; p++)
+		{
+			auto row = const_cast<float*>(getRow(t, p));
+			const double alpha = (double)p / (double)NumPhases;
+
+			double sum = 0.0;
+			double coefficients[NumTaps];
+
+			for (int i = 0; i < NumTaps; i++)
+			{
+				// the distance between the tap and the interpolated position
+				const double x = (double)(i + InterpolatorHelpers::SincKernel::FirstTap) - alpha;
+				const double w = x / halfLength;
+				const double window = std::abs(w) < 1.0 ? InterpolatorHelpers::besselI0(beta * std::sqrt(1.0 - w * w)) * windowGain : 0.0;
+				const double arg = double_Pi * 2.0 * cutoff * x;
+				const double sinc = x == 0.0 ? 1.0 : std::sin(arg) / arg;
+
+				coefficients[i] = 2.0 * cutoff * sinc * window;
+				sum += coefficients[i];
+			}
+
+			// normalise the DC gain of every phase
+			for (int i = 0; i < NumTaps; i++)
+				row[i] = (float)(coefficients[i] / sum);
+		}
+
+		for (int p = 0; p < NumPhases; p++)
+		{
+			auto row = const_cast<float*>(getRow(t, p));
+			auto nextRow = getRow(t, p + 1);
+
+			for (int i = 0; i < NumTaps; i++)
+				row[NumTaps + i] = nextRow[i] - row[i];
+		}
+	}
+}
+
+int SampleInterpolator::SincTable::getTableIndex(double pitchRatio) noexcept
+{
+	if (pitchRatio <= 1.0)
+		return 0;
+
+	// Pick the table with the next lower cutoff frequency so that nothing is folded back
+	const int index = (int)std::ceil(2.0 * std::log2(pitchRatio) - 0.001);
+
+	return jlimit<int>(0, NumTables - 1, index);
+}
+
+void SampleInterpolator::interpolate(InterpolationMode mode, const SincTable* sincTable, const int16* inL, const int16* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples)
+{
+	InterpolatorHelpers::processWithMode(mode, sincTable, inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, true);
+}
+
+void SampleInterpolator::interpolate(InterpolationMode mode, const SincTable* sincTable, const float* inL, const float* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples)
+{
+	InterpolatorHelpers::processWithMode(mode, sincTable, inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, true);
+}
+
+void SampleInterpolator::interpolateScalar(InterpolationMode mode, const SincTable* sincTable, const int16* inL, const int16* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples)
+{
+	InterpolatorHelpers::processWithMode(mode, sincTable, inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, false);
+}
+
+void SampleInterpolator::interpolateScalar(InterpolationMode mode, const SincTable* sincTable, const float* inL, const float* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples)
+{
+	InterpolatorHelpers::processWithMode(mode, sincTable, inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, false);
+}
+
+bool SampleInterpolator::isVectorised() noexcept
+{
+	return HI_VECTORISED_INTERPOLATION != 0;
+}
+
+StringArray SampleInterpolator::getInterpolationModeNames()
+{
+	return { "Linear", "Hermite", "Sinc" };
+}
+
+#if HI_RUN_UNIT_TESTS
+
+class SampleInterpolatorTests : public UnitTest
+{
+public:
+
+	SampleInterpolatorTests() :
+		UnitTest("Testing sample interpolation kernels")
+	{}
+
+	void runTest() override
+	{
+		testLinearKernel<int16>("int16");
+		testLinearKernel<float>("float");
+
+		testVectorisedKernels<int16>("int16");
+		testVectorisedKernels<float>("float");
+
+		testSincTable();
+		testAccuracy();
+
+#if HI_RUN_BENCHMARKS
+		runBenchmark();
+#endif
+	}
+
+private:
+
+	using Mode = SampleInterpolator::InterpolationMode;
+
+	enum
+	{
+		BlockSize = 512,
+		Margin = SampleInterpolator::NumMarginSamples,
+		InputSize = BlockSize * MAX_SAMPLER_PITCH + 2 * Margin + 16
+	};
+
+	static void createRandomSample(Random& r, int16& s) { s = (int16)r.nextInt({ -INT16_MAX, INT16_MAX }); }
+	static void createRandomSample(Random& r, float& s) { s = r.nextFloat() * 2.0f - 1.0f; }
+
+	/** The input data with the margin that the kernels need before and after the read position. */
+	template <typename SignalType> struct TestData
+	{
+		TestData(Random& r):
+			inL(InputSize),
+			inR(InputSize)
+		{
+			for (int i = 0; i < InputSize; i++)
+			{
+				createRandomSample(r, inL[i]);
+				createRandomSample(r, inR[i]);
+			}
+		}
+
+		const SignalType* getLeft() const { return inL.data() + Margin; }
+		const SignalType* getRight() const { return inR.data() + Margin; }
+
+		std::vector<SignalType> inL;
+		std::vector<SignalType> inR;
+	};
+
+	template <typename SignalType> void compareImplementations(Mode mode, const String& typeName, float tolerance)
+	{
+		Random r;
+		TestData<SignalType> data(r);
+
+		AudioSampleBuffer scalar(2, BlockSize);
+		AudioSampleBuffer vectorised(2, BlockSize);
+		std::vector<float> pitchData(BlockSize * 2);
+
+		float maxError = 0.0f;
+
+		for (int iteration = 0; iteration < 200; iteration++)
+		{
+			// odd sizes and offsets test the scalar tail
+			const int numSamples = r.nextInt({ 1, BlockSize });
+			const int startSample = r.nextInt(BlockSize);
+			const double indexInBuffer = r.nextDouble() * 4.0;
+			const double uptimeDelta = 0.25 + r.nextDouble() * (MAX_SAMPLER_PITCH - 1.0);
+
+			const bool useModulation = (iteration % 2) == 1;
+
+			for (auto& p : pitchData)
+				p = (float)uptimeDelta * (0.5f + r.nextFloat() * 0.5f);
+
+			const float* pitch = useModulation ? pitchData.data() : nullptr;
+
+			scalar.clear();
+			vectorised.clear();
+
+			SampleInterpolator::interpolateScalar(mode, sincTable, data.getLeft(), data.getRight(), pitch, scalar.getWritePointer(0), scalar.getWritePointer(1), startSample, indexInBuffer, uptimeDelta, numSamples);
+			SampleInterpolator::interpolate(mode, sincTable, data.getLeft(), data.getRight(), pitch, vectorised.getWritePointer(0), vectorised.getWritePointer(1), startSample, indexInBuffer, uptimeDelta, numSamples);
+
+			for (int c = 0; c < 2; c++)
+			{
+				for (int i = 0; i < BlockSize; i++)
+					maxError = jmax(maxError, std::abs(scalar.getSample(c, i) - vectorised.getSample(c, i)));
+			}
+		}
+
+		const String modeName = SampleInterpolator::getInterpolationModeNames()[(int)mode];
+
+		expect(maxError <= tolerance, modeName + " (" + typeName + "): max deviation " + String(maxError));
+	}
+
+	template <typename SignalType> void testLinearKernel(const String& typeName)
+	{
+		beginTest("Testing vectorised linear interpolation with " + typeName + " data");
+
+		// Both paths use the same order of operations, but the compiler might contract them to FMA instructions
+		compareImplementations<SignalType>(SampleInterpolator::Linear, typeName, 1e-6f);
+	}
+
+	template <typename SignalType> void testVectorisedKernels(const String& typeName)
+	{
+		beginTest("Testing vectorised Hermite & Sinc interpolation with " + typeName + " data");
+
+		// The sums are evaluated in a different order, so there are rounding differences
+		compareImplementations<SignalType>(SampleInterpolator::Hermite, typeName, 1e-5f);
+		compareImplementations<SignalType>(SampleInterpolator::Sinc, typeName, 1e-5f);
+	}
+
+	void testSincTable()
+	{
+		beginTest("Testing sinc table");
+
+		using Table = SampleInterpolator::SincTable;
+
+		expectEquals(Table::getTableIndex(0.5), 0, "Pitched down");
+		expectEquals(Table::getTableIndex(1.0), 0, "Unpitched");
+		expectEquals(Table::getTableIndex(1.2), 1, "Pitched up");
+		expectEquals(Table::getTableIndex(2.0), 2, "One octave");
+		expectEquals(Table::getTableIndex(16.0), Table::NumTables - 1, "Four octaves");
+
+		for (int t = 0; t < Table::NumTables; t++)
+		{
+			for (int p = 0; p <= Table::NumPhases; p++)
+			{
+				auto row = sincTable->getRow(t, p);
+
+				float sum = 0.0f;
+
+				for (int i = 0; i < Table::NumTaps; i++)
+					sum += row[i];
+
+				expectWithinAbsoluteError(sum, 1.0f, 1e-5f, "DC gain");
+			}
+		}
+	}
+
+	/** Returns the RMS error when resampling a sine wave. */
+	double getResamplingError(Mode mode, double frequency, double uptimeDelta)
+	{
+		std::vector<float> input(InputSize);
+
+		for (int i = 0; i < InputSize; i++)
+			input[i] = (float)std::sin(double_Pi * 2.0 * frequency * (double)(i - Margin));
+
+		AudioSampleBuffer output(2, BlockSize);
+
+		const double start = 3.25;
+
+		SampleInterpolator::interpolate(mode, sincTable, input.data() + Margin, input.data() + Margin, nullptr, output.getWritePointer(0), output.getWritePointer(1), 0, start, uptimeDelta, BlockSize);
+
+		double sum = 0.0;
+
+		for (int i = 0; i < BlockSize; i++)
+		{
+			const double expected = std::sin(double_Pi * 2.0 * frequency * (start + (double)i * uptimeDelta));
+			const double delta = (double)output.getSample(0, i) - expected;
+			sum += delta * delta;
+		}
+
+		return std::sqrt(sum / (double)BlockSize);
+	}
+
+	void testAccuracy()
+	{
+		beginTest("Testing interpolation accuracy");
+
+		const double frequency = 0.1;
+		const double uptimeDelta = 0.7311;
+
+		const double linearError = getResamplingError(SampleInterpolator::Linear, frequency, uptimeDelta);
+		const double hermiteError = getResamplingError(SampleInterpolator::Hermite, frequency, uptimeDelta);
+		const double sincError = getResamplingError(SampleInterpolator::Sinc, frequency, uptimeDelta);
+
+		logMessage("RMS error at 0.1 fs: linear " + String(linearError, 6) + ", hermite " + String(hermiteError, 6) + ", sinc " + String(sincError, 6));
+
+		expect(hermiteError < linearError, "Hermite is not better than linear interpolation");
+		expect(sincError < hermiteError, "Sinc is not better than Hermite interpolation");
+	}
+
+#if HI_RUN_BENCHMARKS
+
+	enum class Implementation
+	{
+		Previous,
+		Scalar,
+		Vectorised
+	};
+
+	/** The linear interpolation of StreamingSamplerVoice before the SampleInterpolator was added. */
+	template <typename SignalType> static void interpolatePrevious(const SignalType* inL, const SignalType* inR, const float* pitchData, float* outL, float* outR, double indexInBuffer, double uptimeDelta, int numSamples)
+	{
+		const float gainFactor = std::is_same<SignalType, float>::value ? 1.0f : (1.0f / (float)INT16_MAX);
+
+		float indexInBufferFloat = (float)indexInBuffer;
+		const float uptimeDeltaFloat = (float)uptimeDelta;
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			const int pos = int(indexInBufferFloat);
+			const float alpha = indexInBufferFloat - (float)pos;
+			const float invAlpha = 1.0f - alpha;
+
+			const float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
+			const float r = ((float)inR[pos] * invAlpha + (float)inR[pos + 1] * alpha);
+
+			outL[i] = l * gainFactor;
+			outR[i] = r * gainFactor;
+
+			indexInBufferFloat += pitchData != nullptr ? pitchData[i] : uptimeDeltaFloat;
+		}
+	}
+
+	template <typename SignalType> double measure(Mode mode, const TestData<SignalType>& data, Implementation implementation, const float* pitchData, int numIterations)
+	{
+		AudioSampleBuffer output(2, BlockSize);
+
+		const int64 start = Time::getHighResolutionTicks();
+
+		for (int i = 0; i < numIterations; i++)
+		{
+			switch (implementation)
+			{
+			case Implementation::Previous:
+				interpolatePrevious(data.getLeft(), data.getRight(), pitchData, output.getWritePointer(0), output.getWritePointer(1), 0.5, 1.4983, BlockSize);
+				break;
+			case Implementation::Scalar:
+				SampleInterpolator::interpolateScalar(mode, sincTable, data.getLeft(), data.getRight(), pitchData, output.getWritePointer(0), output.getWritePointer(1), 0, 0.5, 1.4983, BlockSize);
+				break;
+			case Implementation::Vectorised:
+				SampleInterpolator::interpolate(mode, sincTable, data.getLeft(), data.getRight(), pitchData, output.getWritePointer(0), output.getWritePointer(1), 0, 0.5, 1.4983, BlockSize);
+				break;
+			}
+		}
+
+		return Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start) / (double)numIterations;
+	}
+
+	template <typename SignalType> void logVoicesPerCore(Mode mode, const String& typeName, const float* pitchData)
+	{
+		Random r;
+		TestData<SignalType> data(r);
+
+		const int numIterations = 2000;
+
+		// warm up the caches
+		measure(mode, data, Implementation::Vectorised, pitchData, 100);
+
+		const double previousTime = measure(mode, data, Implementation::Previous, pitchData, numIterations);
+		const double scalarTime = measure(mode, data, Implementation::Scalar, pitchData, numIterations);
+		const double vectorisedTime = measure(mode, data, Implementation::Vectorised, pitchData, numIterations);
+
+		// The time for one 512 sample block at 44.1kHz divided by the time that it takes to resample one voice
+		const double blockDuration = (double)BlockSize / 44100.0;
+
+		String message;
+
+		message << SampleInterpolator::getInterpolationModeNames()[(int)mode] << ", ";
+		message << typeName << (pitchData != nullptr ? ", modulated pitch" : ", fixed pitch") << ": ";
+		message << "previous linear " << String(roundToInt(blockDuration / previousTime)) << " voices per core, ";
+		message << "scalar " << String(roundToInt(blockDuration / scalarTime)) << ", ";
+		message << "vectorised " << String(roundToInt(blockDuration / vectorisedTime)) << " ";
+		message << "(x" << String(previousTime / vectorisedTime, 2) << " compared to the previous implementation)";
+
+		logMessage(message);
+	}
+
+	void runBenchmark()
+	{
+		beginTest("Benchmarking interpolation modes");
+
+		std::vector<float> pitchData(BlockSize, 1.4983f);
+
+		for (int i = 0; i < SampleInterpolator::numInterpolationModes; i++)
+		{
+			const Mode mode = (Mode)i;
+
+			logVoicesPerCore<int16>(mode, "int16", nullptr);
+			logVoicesPerCore<int16>(mode, "int16", pitchData.data());
+			logVoicesPerCore<float>(mode, "float", nullptr);
+			logVoicesPerCore<float>(mode, "float", pitchData.data());
+		}
+	}
+
+#endif
+
+	SharedResourcePointer<SampleInterpolator::SincTable> sincTable;
+};
+
+static SampleInterpolatorTests sampleInterpolatorTests;
+
+#endif
+
+} // namespace hise
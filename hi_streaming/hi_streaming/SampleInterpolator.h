@@ -0,0 +1,137 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#ifndef SAMPLEINTERPOLATOR_H_INCLUDED
+#define SAMPLEINTERPOLATOR_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** The resampling kernels used by the StreamingSamplerVoice.
+*
+*	The kernels read from the (not resampled) stereo voice buffer and write the interpolated
+*	signal into the output. They work on both the int16 buffers of HLAC compressed samples
+*	and the float buffers of normal samples and use either a fixed pitch ratio or a
+*	sample-accurate pitch modulation buffer.
+*
+*	If SSE2 or NEON is available, four output frames are gathered, converted and interpolated
+*	per iteration. The read positions are calculated in the same order in both implementations,
+*	so the vectorised linear interpolation produces exactly the same output as the scalar one.
+*
+*	The higher quality modes read samples before and after the read position, so the input
+*	must be readable from -NumMarginSamples up to NumMarginSamples after the last position.
+*/
+struct SampleInterpolator
+{
+	enum InterpolationMode
+	{
+		Linear = 0, ///< 2-point linear interpolation (the cheapest mode)
+		Hermite, ///< 4-point, 3rd-order Hermite interpolation
+		Sinc, ///< 16-point polyphase windowed sinc interpolation
+		numInterpolationModes
+	};
+
+	enum
+	{
+		/** The amount of samples that the widest kernel needs before and after the read position. */
+		NumMarginSamples = 8
+	};
+
+	/** The precomputed coefficients for the Sinc mode.
+	*
+	*	This contains a Kaiser windowed sinc kernel with 16 taps for 128 fractional positions
+	*	(the coefficients for positions in between are interpolated). There is one table for each
+	*	half octave of upwards pitch shifting (up to two octaves) with a lower cutoff frequency,
+	*	so that pitching up samples doesn't fold the upper partials back into the audible range.
+	*
+	*	Creating the table takes a few milliseconds, so use it as SharedResourcePointer and don't
+	*	create it on the audio thread.
+	*/
+	class SincTable
+	{
+	public:
+
+		enum
+		{
+			NumTaps = 16,
+			NumPhases = 128,
+			NumTables = 5,
+			RowSize = 2 * NumTaps
+		};
+
+		SincTable();
+
+		/** Returns the table index for the given pitch ratio. */
+		static int getTableIndex(double pitchRatio) noexcept;
+
+		/** Returns the coefficients for the given phase followed by the difference to the next phase. */
+		const float* getRow(int tableIndex, int phaseIndex) const noexcept
+		{
+			jassert(isPositiveAndBelow(tableIndex, (int)NumTables));
+			jassert(isPositiveAndNotGreaterThan(phaseIndex, (int)NumPhases));
+
+			return data + (tableIndex * (NumPhases + 1) + phaseIndex) * RowSize;
+		}
+
+	private:
+
+		HeapBlock<float> data;
+
+		JUCE_DECLARE_NON_COPYABLE(SincTable);
+	};
+
+	/** Resamples the stereo signal with the given interpolation mode.
+	*
+	*	If pitchData is not nullptr, it will be used (starting at startSample) instead of the
+	*	fixed uptimeDelta. The sinc table is only needed for the Sinc mode.
+	*/
+	static void interpolate(InterpolationMode mode, const SincTable* sincTable, const int16* inL, const int16* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples);
+
+	/** Resamples the stereo signal with the given interpolation mode. */
+	static void interpolate(InterpolationMode mode, const SincTable* sincTable, const float* inL, const float* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples);
+
+	/** The non vectorised implementation. This is used as fallback on other CPUs and as reference in the unit test. */
+	static void interpolateScalar(InterpolationMode mode, const SincTable* sincTable, const int16* inL, const int16* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples);
+
+	/** The non vectorised implementation. */
+	static void interpolateScalar(InterpolationMode mode, const SincTable* sincTable, const float* inL, const float* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples);
+
+	/** Returns true if the kernels are compiled with SSE2 or NEON instructions. */
+	static bool isVectorised() noexcept;
+
+	/** Returns the names of the interpolation modes. */
+	static StringArray getInterpolationModeNames();
+};
+
+} // namespace hise
+
+#endif  // SAMPLEINTERPOLATOR_H_INCLUDED
@@ -30,57 +30,395 @@
 *   ===========================================================================
 */
 
+#if !JUCE_WINDOWS
+#include <sys/stat.h>
+#endif
+
 namespace hise { using namespace juce;
 
 
 struct SampleThreadPool::Pimpl
 {
-	Pimpl() :
-		jobQueue(2048),
-		currentlyExecutedJob(nullptr),
-		diskUsage(0.0),
+	/** The state of a thread that processes a queue. */
+	struct Slot
+	{
+		Slot() :
+			currentlyExecutedJob(nullptr),
+			diskUsage(0.0),
+			startTime(0),
+			endTime(0),
+			fileKey(0)
+		{};
+
+		std::atomic<Job*> currentlyExecutedJob;
+
+		std::atomic<double> diskUsage;
+
+		int64 startTime, endTime;
+
+		// The file key of the running job (only accessed with the queue lock)
+		int64 fileKey;
+	};
+
+	/** A job queue that is processed by one or more threads.
+	*
+	*	The jobs are added to a lock free queue and then moved into the pending list by the thread
+	*	that picks the next job, which is the one with the earliest deadline. Every queue has its own
+	*	lock, so the threads of different queues never wait for each other.
+	*/
+	struct Queue
+	{
+		Queue(int numThreads) :
+			jobQueue(2048)
+		{
+			for (int i = 0; i < numThreads; i++)
+				slots.add(new Slot());
+
+			pendingJobs.reserve(2048);
+		};
+
+		/** Picks the pending job with the earliest deadline and marks it as running.
+		*
+		*	This must be called with the lock of the queue. Jobs that should exit are removed
+		*	without being started, so the job can be destroyed as soon as its waitForJobToFinish() returns.
+		*	A job that is already running on another thread or reads the same file as a running job is skipped.
+		*/
+		Job* startNextJob(Thread* currentThread, Slot& slot, Atomic<int>& counter)
+		{
+			WeakReference<Job> newJob;
+
+			while (jobQueue.try_dequeue(newJob))
+			{
+				if (newJob.get() != nullptr && std::find(pendingJobs.begin(), pendingJobs.end(), newJob.get()) == pendingJobs.end())
+					pendingJobs.push_back(newJob);
+			}
+
+			Job* nextJob = nullptr;
+			int64 earliestDeadline = std::numeric_limits<int64>::max();
+
+			for (size_t i = 0; i < pendingJobs.size();)
+			{
+				Job* j = pendingJobs[i].get();
+
+				if (j == nullptr)
+				{
+					pendingJobs.erase(pendingJobs.begin() + i);
+					continue;
+				}
+
+				// The thread that runs this job will remove it when it's done
+				if (j->isRunning())
+				{
+					i++;
+					continue;
+				}
+
+				if (j->shouldExit())
+				{
+					finishJob(j, counter);
+					pendingJobs.erase(pendingJobs.begin() + i);
+					continue;
+				}
+
+				if (!isFileBusy(j->getFileKey()))
+				{
+					const int64 thisDeadline = j->getDeadline();
+
+					if (nextJob == nullptr || thisDeadline < earliestDeadline)
+					{
+						nextJob = j;
+						earliestDeadline = thisDeadline;
+					}
+				}
+
+				i++;
+			}
+
+			if (nextJob != nullptr)
+			{
+				slot.currentlyExecutedJob.store(nextJob);
+				slot.fileKey = nextJob->getFileKey();
+
+				nextJob->currentThread.store(currentThread);
+				nextJob->notRunning.reset();
+				nextJob->running.store(true);
+			}
+
+			return nextJob;
+		}
+
+		bool runNextJob(Thread* currentThread, int slotIndex, Pimpl& parent)
+		{
+			Slot& slot = *slots[slotIndex];
+			Job* j = nullptr;
+
+			{
+				ScopedLock sl(lock);
+
+				j = startNextJob(currentThread, slot, parent.counter);
+			}
+
+			if (j == nullptr)
+				return false;
+
+#if ENABLE_CPU_MEASUREMENT
+			const int64 lastEndTime = slot.endTime;
+			slot.startTime = Time::getHighResolutionTicks();
+#endif
+
+			Job::JobStatus status = j->runJob();
+
+			{
+				ScopedLock sl(lock);
+
+				j->running.store(false);
+
+				if (status == Job::jobHasFinished)
+				{
+					auto it = std::find(pendingJobs.begin(), pendingJobs.end(), j);
+
+					if (it != pendingJobs.end())
+						pendingJobs.erase(it);
+
+					finishJob(j, parent.counter);
+				}
+
+				slot.fileKey = 0;
+				slot.currentlyExecutedJob.store(nullptr);
+
+				// The job might be destroyed as soon as this is signaled, so don't touch it afterwards
+				j->notRunning.signal();
+			}
+
+#if ENABLE_CPU_MEASUREMENT
+			slot.endTime = Time::getHighResolutionTicks();
+
+			const int64 idleTime = slot.startTime - lastEndTime;
+			const int64 busyTime = slot.endTime - slot.startTime;
+
+			slot.diskUsage.store((double)busyTime / (double)(idleTime + busyTime));
+#endif
+
+			return true;
+		}
+
+		/** Checks if another thread of this queue reads the file with the given key. */
+		bool isFileBusy(int64 fileKey) const noexcept
+		{
+			if (fileKey == 0)
+				return false;
+
+			for (auto s : slots)
+			{
+				if (s->fileKey == fileKey)
+					return true;
+			}
+
+			return false;
+		}
+
+		static void finishJob(Job* j, Atomic<int>& counter)
+		{
+			j->queueIndex.store(-1);
+			j->queued.store(false);
+			--counter;
+		}
+
+		void signalCurrentJobsShouldExit()
+		{
+			for (auto s : slots)
+			{
+				if (Job* currentJob = s->currentlyExecutedJob.load())
+					currentJob->shouldStop.store(true);
+			}
+		}
+
+		void notify()
+		{
+			for (auto t : threads)
+				t->notify();
+		}
+
+		moodycamel::ReaderWriterQueue<WeakReference<Job>> jobQueue;
+
+		// The queue has only one producer slot, but jobs are added from multiple threads
+		SpinLock enqueueLock;
+
+		// Held while a thread picks or finishes a job (and while a job is told to exit, see ScopedAllQueuesLock)
+		CriticalSection lock;
+
+		// Only accessed with the lock
+		std::vector<WeakReference<Job>> pendingJobs;
+
+		OwnedArray<Slot> slots;
+
+		// The threads that process this queue (in the order of the slots)
+		Array<Thread*> threads;
+	};
+
+	/** A thread that streams the samples of one volume. */
+	struct Worker : public Thread
+	{
+		Worker(Pimpl& parent_, int queueIndex_, int slotIndex_) :
+			Thread("Sample Streaming Thread " + String(queueIndex_) + "." + String(slotIndex_)),
+			parent(parent_),
+			queueIndex(queueIndex_),
+			slotIndex(slotIndex_)
+		{};
+
+		void run() override
+		{
+			while (!threadShouldExit())
+			{
+				if (!parent.queues[queueIndex]->runNextJob(this, slotIndex, parent))
+					wait(500);
+			}
+		}
+
+		Pimpl& parent;
+		const int queueIndex;
+		const int slotIndex;
+	};
+
+	/** Locks all queues so that no thread can start a job. This is used when a job is told to exit or destroyed. */
+	struct ScopedAllQueuesLock
+	{
+		ScopedAllQueuesLock(Pimpl& p_) :
+			p(p_)
+		{
+			for (auto q : p.queues)
+				q->lock.enter();
+		}
+
+		~ScopedAllQueuesLock()
+		{
+			for (int i = p.queues.size() - 1; i >= 0; i--)
+				p.queues[i]->lock.exit();
+		}
+
+		Pimpl& p;
+	};
+
+	Pimpl(SampleThreadPool& pool) :
 		counter(0)
-	{};
+	{
+		for (int i = 0; i < HISE_NUM_STREAMING_VOLUMES; i++)
+			volumeIds[i].store(0);
+
+		// The first queue is used by the pool's own thread
+		queues.add(new Queue(1));
+		queues[0]->threads.add(&pool);
+
+		for (int i = 0; i < HISE_NUM_STREAMING_VOLUMES; i++)
+		{
+			auto q = queues.add(new Queue(HISE_NUM_STREAMING_THREADS_PER_VOLUME));
+
+			for (int j = 0; j < HISE_NUM_STREAMING_THREADS_PER_VOLUME; j++)
+			{
+				workers.add(new Worker(*this, queues.size() - 1, j));
+				q->threads.add(workers.getLast());
+			}
+		}
+	};
 
 	~Pimpl()
 	{
-		if (Job* currentJob = currentlyExecutedJob.load())
+		for (auto q : queues)
+			q->signalCurrentJobsShouldExit();
+
+		for (auto w : workers)
+			w->stopThread(300);
+	}
+
+	int getQueueIndex(Job* j)
+	{
+		const int currentIndex = j->queueIndex.load();
+
+		// A queued job must stay in its queue or it might be executed by two threads at once
+		if (j->isQueued() && currentIndex != -1)
+			return currentIndex;
+
+		const int64 volumeId = j->getVolumeId();
+
+		if (volumeId == 0)
+			return 0;
+
+		int slot = -1;
+
+		for (int i = 0; i < HISE_NUM_STREAMING_VOLUMES; i++)
 		{
-			currentJob->signalJobShouldExit();
+			int64 existing = volumeIds[i].load();
+
+			if (existing == volumeId)
+			{
+				slot = i;
+				break;
+			}
+
+			if (existing == 0 && volumeIds[i].compare_exchange_strong(existing, volumeId))
+			{
+				slot = i;
+				break;
+			}
+
+			// Another thread might have claimed this slot with the same volume in the meantime
+			if (existing == volumeId)
+			{
+				slot = i;
+				break;
+			}
 		}
+
+		// More volumes than slots, so they need to share the workers
+		if (slot == -1)
+			slot = (int)((uint64)volumeId % (uint64)HISE_NUM_STREAMING_VOLUMES);
+
+		return 1 + slot;
 	}
 
 	Atomic<int> counter;
 
-	std::atomic<double> diskUsage;
-
-	int64 startTime, endTime;
+	std::atomic<int64> volumeIds[HISE_NUM_STREAMING_VOLUMES];
 
-	moodycamel::ReaderWriterQueue<WeakReference<Job>> jobQueue;
+	OwnedArray<Queue> queues;
 
-	std::atomic<Job*> currentlyExecutedJob;
+	OwnedArray<Worker> workers;
 
 	static const String errorMessage;
 };
 
 SampleThreadPool::SampleThreadPool() :
 	Thread("Sample Loading Thread"),
-	pimpl(new Pimpl())
+	pimpl(new Pimpl(*this))
 {
-
 	startThread(9);
+
+	for (auto w : pimpl->workers)
+		w->startThread(9);
 }
 
 SampleThreadPool::~SampleThreadPool()
 {
-	pimpl = nullptr;
+	signalThreadShouldExit();
+
+	pimpl->queues[0]->signalCurrentJobsShouldExit();
 
 	stopThread(300);
+
+	pimpl = nullptr;
 }
 
 double SampleThreadPool::getDiskUsage() const noexcept
 {
-	return pimpl->diskUsage.load();
+	double usage = 0.0;
+
+	for (auto q : pimpl->queues)
+	{
+		for (auto s : q->slots)
+			usage = jmax<double>(usage, s->diskUsage.load());
+	}
+
+	return usage;
 }
 
 void SampleThreadPool::addJob(Job* jobToAdd, bool unused)
@@ -97,74 +435,90 @@ void SampleThreadPool::addJob(Job* jobToAdd, bool unused)
 	}
 #endif
 
+	const int queueIndex = pimpl->getQueueIndex(jobToAdd);
 
+	jobToAdd->queueIndex.store(queueIndex);
 	jobToAdd->queued.store(true);
-	pimpl->jobQueue.enqueue(jobToAdd);
+	jobToAdd->pool.store(this);
 
+	{
+		SpinLock::ScopedLockType sl(pimpl->queues[queueIndex]->enqueueLock);
+		pimpl->queues[queueIndex]->jobQueue.enqueue(jobToAdd);
+	}
 
-	notify();
+	pimpl->queues[queueIndex]->notify();
 }
 
 void SampleThreadPool::run()
 {
 	while (!threadShouldExit())
 	{
-		if (WeakReference<Job>* next = pimpl->jobQueue.peek())
+		if (!pimpl->queues[0]->runNextJob(this, 0, *pimpl))
 		{
-			Job* j = next->get();
-
-#if ENABLE_CPU_MEASUREMENT
-
-			const int64 lastEndTime = pimpl->endTime;
-			pimpl->startTime = Time::getHighResolutionTicks();
-#endif
-
-			if (j != nullptr)
-			{
-				pimpl->currentlyExecutedJob.store(j);
-
-				j->currentThread.store(this);
+			wait(500);
+		}
+	}
+}
 
-				j->running.store(true);
-				
-				Job::JobStatus status = j->runJob();
+int SampleThreadPool::getNumThreads() const noexcept
+{
+	return 1 + pimpl->workers.size();
+}
 
-				j->running.store(false);
+int64 SampleThreadPool::getVolumeIdForFile(const File& f)
+{
+	File fileToCheck = f;
 
-				if (status == Job::jobHasFinished)
-				{
-					pimpl->jobQueue.pop();
-					j->queued.store(false);
-					--pimpl->counter;
-				}
+	// Walk up until we find something that exists (the file might not be created yet)
+	while (!fileToCheck.exists() && fileToCheck.getParentDirectory() != fileToCheck)
+		fileToCheck = fileToCheck.getParentDirectory();
 
-				pimpl->currentlyExecutedJob.store(nullptr);
-			}
+#if JUCE_WINDOWS
+	const int64 serialNumber = (int64)(uint32)fileToCheck.getVolumeSerialNumber();
 
+	if (serialNumber != 0)
+		return serialNumber;
 
-#if ENABLE_CPU_MEASUREMENT
-			pimpl->endTime = Time::getHighResolutionTicks();
+	return jmax<int64>(1, fileToCheck.getFullPathName().substring(0, 2).toUpperCase().hashCode64() & 0x7FFFFFFFFFFFFFFF);
+#else
+	struct stat info;
 
-			const int64 idleTime = pimpl->startTime - lastEndTime;
-			const int64 busyTime = pimpl->endTime - pimpl->startTime;
+	if (stat(fileToCheck.getFullPathName().toRawUTF8(), &info) == 0)
+		return (int64)info.st_dev + 1;
 
-			pimpl->diskUsage.store((double)busyTime / (double)(idleTime + busyTime));
+	return 1;
 #endif
-		}
+}
 
-#if 0 // Set this to true to enable defective threading (for debugging purposes)
-		wait(500);
-#else
-		else
-		{
-			wait(500);
-		}
-#endif
+int64 SampleThreadPool::getDeadlineFromNow(double secondsFromNow) noexcept
+{
+	return Time::getHighResolutionTicks() + Time::secondsToHighResolutionTicks(secondsFromNow);
+}
 
+SampleThreadPool::Job::~Job()
+{
+	if (auto p = pool.load())
+	{
+		Pimpl::ScopedAllQueuesLock sl(*p->pimpl);
+		masterReference.clear();
+	}
+	else
+		masterReference.clear();
+}
 
+void SampleThreadPool::Job::signalJobShouldExit()
+{
+	// A worker that picks this job under the lock of its queue will either see the flag and skip it
+	// or has already reset notRunning, so waitForJobToFinish() will block until it's done.
+	if (auto p = pool.load())
+	{
+		Pimpl::ScopedAllQueuesLock sl(*p->pimpl);
+		shouldStop.store(true);
 	}
+	else
+		shouldStop.store(true);
 }
 
 const String SampleThreadPool::Pimpl::errorMessage("HDD overflow");
 
-} // namespace hise
\ No newline at end of file
+} // namespace hise
@@ -35,6 +35,41 @@
 
 namespace hise { using namespace juce;
 
+/** The amount of physical volumes that get their own set of streaming threads.
+*
+*	If the samples are spread across more volumes, they will share the worker threads.
+*/
+#ifndef HISE_NUM_STREAMING_VOLUMES
+#if HISE_IOS
+#define HISE_NUM_STREAMING_VOLUMES 1
+#else
+#define HISE_NUM_STREAMING_VOLUMES 4
+#endif
+#endif
+
+/** The amount of worker threads that stream samples from a single volume.
+*
+*	The workers of a volume share one job queue, so a fast disk (eg. an NVMe SSD) can serve multiple reads at once.
+*/
+#ifndef HISE_NUM_STREAMING_THREADS_PER_VOLUME
+#if HISE_IOS
+#define HISE_NUM_STREAMING_THREADS_PER_VOLUME 1
+#else
+#define HISE_NUM_STREAMING_THREADS_PER_VOLUME 2
+#endif
+#endif
+
+/** The background thread pool that handles the disk streaming and other sample related tasks.
+*
+*	The pool's own thread executes every job that is not associated with a file (preloading, 
+*	the pending functions of the KillStateHandler). Jobs that read from a file will be dispatched
+*	to the queue of the physical volume of the file so that a slow disk can't block the streaming 
+*	of another disk. Every volume queue is processed by HISE_NUM_STREAMING_THREADS_PER_VOLUME threads.
+*
+*	Every job has a deadline and the worker threads will always execute the job with the 
+*	earliest deadline first, so a voice that is about to run dry will be refilled before a
+*	voice that has still enough samples in its buffer.
+*/
 class SampleThreadPool : public Thread
 {
 public:
@@ -52,10 +87,15 @@ public:
 			name(name_),
 			queued(false),
 			running(false),
-			shouldStop(false)
-		{};
+			shouldStop(false),
+			deadline(0),
+			queueIndex(-1),
+			pool(nullptr)
+		{
+			notRunning.signal();
+		};
         
-        virtual ~Job() { masterReference.clear(); }
+        virtual ~Job();
 
 		enum JobStatus
 		{
@@ -65,12 +105,45 @@ public:
 
 		virtual JobStatus runJob() = 0;
 
+		/** Override this and return the volume ID of the file that this job will read.
+		*
+		*	Use SampleThreadPool::getVolumeIdForFile() to calculate it. If this returns zero, the job
+		*	will be executed by the pool's own thread.
+		*/
+		virtual int64 getVolumeId() const noexcept { return 0; }
+
+		/** Override this and return a hash value for the file that this job will read.
+		*
+		*	Two jobs with the same file key will never be executed by the workers of a volume at the same time.
+		*	Return zero if the reader of the file can be used by multiple threads at once. Jobs of the pool's 
+		*	own thread (eg. preloading) might still read the same file at the same time, so readers that are 
+		*	shared between sounds must serialise their access.
+		*/
+		virtual int64 getFileKey() const noexcept { return 0; }
+
+		/** Sets the time (in high resolution ticks) when this job must be finished.
+		*
+		*	Jobs with an earlier deadline will be executed first. Call this before adding the job to the pool. 
+		*/
+		void setDeadline(int64 newDeadline) noexcept { deadline.store(newDeadline); }
+
+		/** Returns the deadline of this job in high resolution ticks. */
+		int64 getDeadline() const noexcept { return deadline.load(); }
+
 		bool shouldExit() const noexcept{ return shouldStop.load(); }
 
-		void signalJobShouldExit() { shouldStop.store(true); }
+		/** Tells the job to return early. A job that should exit will not be started by the pool anymore.
+		*
+		*	Call this (and waitForJobToFinish()) in the destructor of your subclass, so that the pool doesn't start
+		*	the job while it is being destroyed.
+		*/
+		void signalJobShouldExit();
 
 		bool isRunning() const noexcept{ return running.load(); };
 
+		/** Blocks until the pool has finished running this job. Call signalJobShouldExit() before this so that a running job returns early. */
+		bool waitForJobToFinish(int timeoutMilliseconds = -1) const { return notRunning.wait(timeoutMilliseconds); }
+
 		bool isQueued() const noexcept{ return queued.load(); };
 
 	protected:
@@ -88,19 +161,43 @@ public:
 
 		std::atomic<bool> running;
 
+		// Signaled when the pool doesn't access the job anymore
+		WaitableEvent notRunning { true };
+
 		std::atomic<bool> shouldStop;
 
 		std::atomic<Thread*> currentThread;
 
+		std::atomic<int64> deadline;
+
+		std::atomic<int> queueIndex;
+
+		// The pool that this job was added to (set by addJob())
+		std::atomic<SampleThreadPool*> pool;
+
 		const String name;
 	};
 
+	/** Returns the highest disk usage of all worker threads. */
 	double getDiskUsage() const noexcept;
 
 	void addJob(Job* jobToAdd, bool unused);
 
 	void run() override;
 
+	/** Returns the number of threads (including the pool's own thread). */
+	int getNumThreads() const noexcept;
+
+	/** Returns an identifier for the volume that contains the given file.
+	*
+	*	The result will never be zero, so you can use it directly in Job::getVolumeId(). This calls
+	*	the file system, so don't call this in the audio thread.
+	*/
+	static int64 getVolumeIdForFile(const File& f);
+
+	/** Creates a deadline for a job that must be finished in the given amount of seconds. */
+	static int64 getDeadlineFromNow(double secondsFromNow) noexcept;
+
 	struct Pimpl;
 
 	ScopedPointer<Pimpl> pimpl;
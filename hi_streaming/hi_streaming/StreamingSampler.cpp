@@ -62,6 +62,91 @@ bool StreamingHelpers::preloadSample(StreamingSamplerSound * s, const int preloa
 	}
 }
 
+StreamingStatistics::StreamingStatistics()
+{
+	reset();
+}
+
+void StreamingStatistics::addJobLatency(double milliSeconds) noexcept
+{
+	int binIndex = 0;
+
+	while (binIndex < numLatencyBins - 1 && milliSeconds > getLatencyBinLimit(binIndex))
+		binIndex++;
+
+	latencyHistogram[binIndex].fetch_add(1);
+	numJobs.fetch_add(1);
+
+	double currentMax = maxLatency.load();
+
+	while (milliSeconds > currentMax && !maxLatency.compare_exchange_weak(currentMax, milliSeconds))
+		;
+}
+
+void StreamingStatistics::addHeadroom(int numSamples) noexcept
+{
+	int currentMin = minHeadroom.load();
+
+	while (numSamples < currentMin && !minHeadroom.compare_exchange_weak(currentMin, numSamples))
+		;
+}
+
+void StreamingStatistics::addStatistics(const StreamingStatistics& other) noexcept
+{
+	for (int i = 0; i < numLatencyBins; i++)
+		latencyHistogram[i].fetch_add(other.latencyHistogram[i].load());
+
+	numJobs.fetch_add(other.numJobs.load());
+	numUnderruns.fetch_add(other.numUnderruns.load());
+
+	addHeadroom(other.minHeadroom.load());
+
+	const double otherMax = other.maxLatency.load();
+	double currentMax = maxLatency.load();
+
+	while (otherMax > currentMax && !maxLatency.compare_exchange_weak(currentMax, otherMax))
+		;
+}
+
+void StreamingStatistics::reset() noexcept
+{
+	for (int i = 0; i < numLatencyBins; i++)
+		latencyHistogram[i].store(0);
+
+	minHeadroom.store(std::numeric_limits<int>::max());
+	numUnderruns.store(0);
+	numJobs.store(0);
+	maxLatency.store(0.0);
+}
+
+var StreamingStatistics::toJSON() const
+{
+	DynamicObject::Ptr obj = new DynamicObject();
+
+	Array<var> limits;
+	Array<var> counts;
+
+	for (int i = 0; i < numLatencyBins; i++)
+	{
+		// The last bin collects everything above the second last limit
+		limits.add(i == numLatencyBins - 1 ? var(-1.0) : var(getLatencyBinLimit(i)));
+		counts.add(latencyHistogram[i].load());
+	}
+
+	const int headroom = minHeadroom.load();
+
+	obj->setProperty("NumJobs", numJobs.load());
+	obj->setProperty("LatencyBinLimits", limits);
+	obj->setProperty("LatencyHistogram", counts);
+	obj->setProperty("MaxLatency", maxLatency.load());
+	if (headroom != std::numeric_limits<int>::max())
+		obj->setProperty("MinHeadroom", headroom);
+
+	obj->setProperty("NumUnderruns", numUnderruns.load());
+
+	return var(obj);
+}
+
 hise::StreamingHelpers::BasicMappingData StreamingHelpers::getBasicMappingDataFromSample(const ValueTree& sampleData)
 {
 	BasicMappingData data;
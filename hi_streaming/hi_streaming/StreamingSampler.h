@@ -63,6 +63,67 @@ struct StreamingHelpers
 
 
 
+/** A lock free collection of timing information about the disk streaming.
+*
+*	Every SampleLoader owns one of these and updates it from the audio thread and the streaming thread.
+*	You can merge the statistics of multiple loaders into one object with addStatistics() and create
+*	a JSON object from it for displaying / dumping.
+*/
+struct StreamingStatistics
+{
+	enum
+	{
+		numLatencyBins = 12
+	};
+
+	StreamingStatistics();
+
+	/** Returns the upper limit of the latency histogram bin in milliseconds. The last bin has no upper limit. */
+	static double getLatencyBinLimit(int binIndex) noexcept { return 0.0625 * (double)(1 << binIndex); }
+
+	/** Adds the time between the request and the completion of a streaming job. */
+	void addJobLatency(double milliSeconds) noexcept;
+
+	/** Adds the amount of samples that were left in the read buffer when the streaming job was finished. 
+	*
+	*	A negative value means that the voice already played the samples before they were loaded. 
+	*/
+	void addHeadroom(int numSamples) noexcept;
+
+	/** Call this when the loader needs new data but the inactive buffer is not yet filled. */
+	void addUnderrun() noexcept { numUnderruns.fetch_add(1); }
+
+	/** Adds the values of the other statistics to this object. */
+	void addStatistics(const StreamingStatistics& other) noexcept;
+
+	/** Clears all values. */
+	void reset() noexcept;
+
+	/** Returns the smallest headroom in samples or std::numeric_limits<int>::max() if there was no job yet. */
+	int getMinHeadroom() const noexcept { return minHeadroom.load(); }
+
+	int getNumUnderruns() const noexcept { return numUnderruns.load(); }
+
+	int getNumJobs() const noexcept { return numJobs.load(); }
+
+	double getMaxLatency() const noexcept { return maxLatency.load(); }
+
+	int getLatencyCount(int binIndex) const noexcept { return latencyHistogram[binIndex].load(); }
+
+	/** Creates a JSON object with all values. */
+	var toJSON() const;
+
+private:
+
+	std::atomic<int> latencyHistogram[numLatencyBins];
+	std::atomic<int> minHeadroom;
+	std::atomic<int> numUnderruns;
+	std::atomic<int> numJobs;
+	std::atomic<double> maxLatency;
+
+	JUCE_DECLARE_NON_COPYABLE(StreamingStatistics);
+};
+
 class StreamingSamplerSoundPool
 {
 public:
@@ -149,6 +210,42 @@ struct StereoChannelData
 // If the streaming background thread is blocked, it will kill the voice to exit gracefully.
 #define KILL_VOICES_WHEN_STREAMING_IS_BLOCKED 1
 
+// Voices that play uncompressed mono monoliths read the samples directly from the memory mapped file. The background thread
+// then only prefetches the pages of the next streaming buffer instead of copying the samples.
+#ifndef USE_MAPPED_MONOLITH_PLAYBACK
+#define USE_MAPPED_MONOLITH_PLAYBACK 1
+#endif
+
+// Set this to 1 to lock the preload region of memory mapped monoliths into physical memory so that it can't be paged out.
+// This is limited by the amount of lockable memory of the process (and does nothing on Windows).
+#ifndef HISE_LOCK_MAPPED_PRELOAD_PAGES
+#define HISE_LOCK_MAPPED_PRELOAD_PAGES 0
+#endif
+
+// If a sampler uses lazy preloading, only this amount of samples (plus the sample start modulation range) is loaded for every sound
+// when the sample map is loaded. The rest of the preload buffer is loaded in the background when the sound is played for the first time.
+// Voices that start before that will play the head and stream the rest from disk. If this is 0, the sound stays silent until its
+// preload buffer is loaded.
+#ifndef HISE_LAZY_PRELOAD_HEAD_SIZE
+#define HISE_LAZY_PRELOAD_HEAD_SIZE 2048
+#endif
+
+// The lazy preloading will also load the sounds that are mapped to the notes within this range around a played note...
+#ifndef HISE_LAZY_PRELOAD_KEY_RANGE
+#define HISE_LAZY_PRELOAD_KEY_RANGE 2
+#endif
+
+// ... and to the velocities within this range around the played velocity.
+#ifndef HISE_LAZY_PRELOAD_VELOCITY_RANGE
+#define HISE_LAZY_PRELOAD_VELOCITY_RANGE 16
+#endif
+
+// The default memory limit in bytes for the lazily loaded preload buffers of a sampler. If it's exceeded, the buffers of the sounds
+// that were not played for the longest time will be unloaded.
+#ifndef HISE_LAZY_PRELOAD_MEMORY_LIMIT
+#define HISE_LAZY_PRELOAD_MEMORY_LIMIT (512 * 1024 * 1024)
+#endif
+
 // By default, every voice adds its output to the supplied buffer. Depending on your architecture, it could be more practical to
 // set (overwrite) the buffer. In this case, set this to 1.
 #if STANDALONE
@@ -135,12 +135,15 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 
 	const bool sampleDeactivated = !hasActiveState() || newPreloadSize == 0;
 
-
+	// The preload region changes, so the lazily loaded buffer must be read again
+	unloadLazyPreloadBuffer();
+	lazyPreloadBufferIsValid = false;
 
 	if (sampleDeactivated)
 	{
 		internalPreloadSize = 0;
 		preloadSize = 0;
+		lazyPreloadSize = 0;
 
 		preloadBuffer = hlac::HiseSampleBuffer(!fileReader.isMonolithic(), fileReader.isStereo() ? 2 : 1, 0);
 
@@ -162,6 +165,20 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 
 	internalPreloadSize = jmax(preloadSize, internalPreloadSize, 2048);
 
+	lazyPreloadSize = 0;
+
+	// Only load the head now, the rest will be loaded with loadLazyPreloadBuffer()
+	const int lazyPreloadHeadSize = HISE_LAZY_PRELOAD_HEAD_SIZE + sampleStartMod;
+
+	if (lazyPreload && newPreloadSize != -1 && internalPreloadSize > lazyPreloadHeadSize)
+	{
+		lazyPreloadSize = internalPreloadSize;
+		lazyPreloadContainsEntireSample = entireSampleLoaded;
+
+		internalPreloadSize = lazyPreloadHeadSize;
+		entireSampleLoaded = false;
+	}
+
 	fileReader.openFileHandles();
 
 	preloadBuffer = hlac::HiseSampleBuffer(!fileReader.isMonolithic(), fileReader.isStereo() ? 2 : 1, 0);
@@ -170,20 +187,14 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 	{
 		preloadBuffer.setSize(fileReader.isStereo() ? 2 : 1, internalPreloadSize);
 	}
-	catch (std::exception e)
+	catch (const std::exception& e)
 	{
 		preloadBuffer.setSize(fileReader.isStereo() ? 2 : 1, 0);
 
 		throw StreamingSamplerSound::LoadingError(getFileName(), "Preload error (max memory exceeded).");
 	}
 
-	if (preloadBuffer.getNumSamples() == 0)
-	{
-		return;
-	}
-
-	preloadBuffer.clear();
-
+	// The metadata is needed even if there's no head to preload
 	if (sampleRate <= 0.0)
 	{
 		if (AudioFormatReader *reader = fileReader.getReader())
@@ -195,12 +206,28 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 		}
 	}
 
-	if (loopEnabled && (loopEnd - loopStart > 0) && sampleLength < internalPreloadSize)
+	if (preloadBuffer.getNumSamples() == 0)
 	{
-		int samplesToFill = internalPreloadSize;
+		return;
+	}
+
+	preloadBuffer.clear();
+
+	fillPreloadBuffer(preloadBuffer, internalPreloadSize);
+
+	// The voices read the preload region directly from the mapped file, so make sure it doesn't get paged out
+	if (getMappedSampleData() != nullptr)
+		fileReader.prefetch(sampleStart + monolithOffset, internalPreloadSize, HISE_LOCK_MAPPED_PRELOAD_PAGES != 0);
+}
+
+void StreamingSamplerSound::fillPreloadBuffer(hlac::HiseSampleBuffer &buffer, int numSamples)
+{
+	if (loopEnabled && (loopEnd - loopStart > 0) && sampleLength < numSamples)
+	{
+		int samplesToFill = numSamples;
 		int offsetInPreloadBuffer = 0;
 
-		fileReader.readFromDisk(preloadBuffer, 0, sampleLength, sampleStart + monolithOffset, true);
+		fileReader.readFromDisk(buffer, 0, sampleLength, sampleStart + monolithOffset, true);
 
 		const int samplesPerFillOp = (loopEnd - loopStart);
 
@@ -213,7 +240,7 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 			{
 				const int samplesThisTime = jmin<int>(samplesToFill, samplesPerFillOp);
 
-				fileReader.readFromDisk(preloadBuffer, offsetInPreloadBuffer, samplesThisTime, loopStart, true);
+				fileReader.readFromDisk(buffer, offsetInPreloadBuffer, samplesThisTime, loopStart, true);
 
 				offsetInPreloadBuffer += samplesThisTime;
 				samplesToFill -= samplesThisTime;
@@ -228,20 +255,151 @@ void StreamingSamplerSound::setPreloadSize(int newPreloadSize, bool forceReload)
 	}
 	else
 	{
-		auto samplesToRead = jmin<int>(sampleLength, internalPreloadSize);
+		auto samplesToRead = jmin<int>(sampleLength, numSamples);
 
 		if(samplesToRead > 0)
-			fileReader.readFromDisk(preloadBuffer, 0, samplesToRead, sampleStart + monolithOffset, true);
+			fileReader.readFromDisk(buffer, 0, samplesToRead, sampleStart + monolithOffset, true);
 	}
 }
 
+bool StreamingSamplerSound::needsLazyPreload() const noexcept
+{
+	return lazyPreloadSize > 0 && !lazyPreloadLoaded.load() && hasActiveState();
+}
+
+bool StreamingSamplerSound::loadLazyPreloadBuffer()
+{
+	if (!needsLazyPreload())
+		return false;
+
+	ScopedLock sl(getSampleLock());
+
+	// A voice that has started before the buffer was unloaded still reads from it
+	if (!needsLazyPreload() || numLazyPreloadReaders.load() != 0)
+		return false;
+
+	// If the buffer couldn't be freed, we can just use it again
+	if (!lazyPreloadBufferIsValid)
+	{
+		const int numChannels = fileReader.isStereo() ? 2 : 1;
+
+		hlac::HiseSampleBuffer newBuffer(!fileReader.isMonolithic(), numChannels, 0);
+
+		try
+		{
+			newBuffer.setSize(numChannels, lazyPreloadSize);
+		}
+		catch (const std::exception& e)
+		{
+			return false;
+		}
+
+		newBuffer.clear();
+
+		fillPreloadBuffer(newBuffer, lazyPreloadSize);
+
+		if (getMappedSampleData() != nullptr)
+			fileReader.prefetch(sampleStart + monolithOffset, lazyPreloadSize, HISE_LOCK_MAPPED_PRELOAD_PAGES != 0);
+
+		fileReader.closeFileHandles();
+
+		lazyPreloadBuffer = std::move(newBuffer);
+		lazyPreloadBufferIsValid = true;
+
+		const size_t bytesPerSample = fileReader.isMonolithic() ? sizeof(int16) : sizeof(float);
+		lazyPreloadMemory.store((size_t)lazyPreloadSize * (size_t)numChannels * bytesPerSample);
+	}
+
+	lazyPreloadLoaded.store(true);
+
+	return true;
+}
+
+bool StreamingSamplerSound::unloadLazyPreloadBuffer()
+{
+	ScopedLock sl(getSampleLock());
+
+	lazyPreloadLoaded.store(false);
+
+	// The readers check the flag after they increased the counter, so no voice can start reading from now on
+	if (numLazyPreloadReaders.load() != 0)
+		return false;
+
+	if (lazyPreloadBuffer.getNumSamples() != 0)
+	{
+		lazyPreloadBuffer = hlac::HiseSampleBuffer(!fileReader.isMonolithic(), fileReader.isStereo() ? 2 : 1, 0);
+		lazyPreloadBufferIsValid = false;
+		lazyPreloadMemory.store(0);
+	}
+
+	return true;
+}
+
+bool StreamingSamplerSound::hasPreloadData() const noexcept
+{
+	return preloadBuffer.getNumSamples() != 0 || lazyPreloadLoaded.load();
+}
+
+const hlac::HiseSampleBuffer* StreamingSamplerSound::acquirePreloadBuffer(bool& containsEntireSample) const noexcept
+{
+	lastPlayedTime.store(Time::getMillisecondCounter());
+
+	++numLazyPreloadReaders;
+
+	if (lazyPreloadLoaded.load())
+	{
+		containsEntireSample = lazyPreloadContainsEntireSample;
+		return &lazyPreloadBuffer;
+	}
+
+	--numLazyPreloadReaders;
+
+	containsEntireSample = entireSampleLoaded;
+	return &preloadBuffer;
+}
+
+void StreamingSamplerSound::releasePreloadBuffer(const hlac::HiseSampleBuffer* buffer) const noexcept
+{
+	if (buffer == &lazyPreloadBuffer)
+	{
+		jassert(numLazyPreloadReaders.load() > 0);
+		--numLazyPreloadReaders;
+	}
+}
+
+bool StreamingSamplerSound::copyFromLazyPreloadBuffer(hlac::HiseSampleBuffer &sampleBuffer, int samplesToCopy, int uptime, int offsetInBuffer) const
+{
+	if (uptime + samplesToCopy >= lazyPreloadSize)
+		return false;
+
+	bool containsEntireSample;
+	auto buffer = acquirePreloadBuffer(containsEntireSample);
+
+	bool ok = false;
+
+	if (buffer == &lazyPreloadBuffer)
+	{
+		const int indexInPreloadBuffer = uptime - (int)sampleStart;
+
+		if (indexInPreloadBuffer >= 0 && indexInPreloadBuffer + samplesToCopy < buffer->getNumSamples())
+		{
+			hlac::HiseSampleBuffer::copy(sampleBuffer, *buffer, offsetInBuffer, indexInPreloadBuffer, samplesToCopy);
+			ok = true;
+		}
+	}
+
+	releasePreloadBuffer(buffer);
+
+	return ok;
+}
+
 
 
 size_t StreamingSamplerSound::getActualPreloadSize() const
 {
 	auto bytesPerSample = fileReader.isMonolithic() ? sizeof(int16) : sizeof(float);
 
-	return hasActiveState() ? (size_t)(internalPreloadSize *preloadBuffer.getNumChannels()) * bytesPerSample + (size_t)(loopBuffer.getNumSamples() *loopBuffer.getNumChannels()) * bytesPerSample : 0;
+	return hasActiveState() ? (size_t)(internalPreloadSize *preloadBuffer.getNumChannels()) * bytesPerSample + (size_t)(loopBuffer.getNumSamples() *loopBuffer.getNumChannels()) * bytesPerSample + getLazyPreloadMemory() : 0;
 }
 
 void StreamingSamplerSound::loadEntireSample() { setPreloadSize(-1); }
@@ -507,6 +665,19 @@ float StreamingSamplerSound::calculatePeakValue()
 	return fileReader.calculatePeakValue();
 }
 
+const int16* StreamingSamplerSound::getMappedSampleData() const noexcept
+{
+	if (loopEnabled || reversed)
+		return nullptr;
+
+	return fileReader.getMappedData(sampleStart + monolithOffset);
+}
+
+void StreamingSamplerSound::prefetchMappedSampleData(int uptime, int numSamples) const
+{
+	fileReader.prefetch(uptime + sampleStart + monolithOffset, numSamples, false);
+}
+
 void StreamingSamplerSound::fillSampleBuffer(hlac::HiseSampleBuffer &sampleBuffer, int samplesToCopy, int uptime) const
 {
 	ScopedLock sl(getSampleLock());
@@ -653,6 +824,12 @@ void StreamingSamplerSound::fillInternal(hlac::HiseSampleBuffer &sampleBuffer, i
 		}
 	}
 
+	// The samples are in the lazily loaded preload buffer
+	else if (copyFromLazyPreloadBuffer(sampleBuffer, samplesToCopy, uptime, offsetInBuffer))
+	{
+		return;
+	}
+
 	// Read all samples from disk
 	else
 	{
@@ -676,6 +853,7 @@ StreamingSamplerSound::FileReader::~FileReader()
 {
 	ScopedWriteLock sl(fileAccessLock);
 
+	mappedData = nullptr;
 	memoryReader = nullptr;
 	normalReader = nullptr;
 }
@@ -693,11 +871,17 @@ void StreamingSamplerSound::FileReader::setFile(const String &fileName)
 		fileFormatSupportsMemoryReading = fileExtension.contains("wav") || fileExtension.contains("aif");// || fileExtension.contains("hlac");
 
 		hashCode = loadedFile.hashCode64();
+
+		volumeId = SampleThreadPool::getVolumeIdForFile(loadedFile);
+		streamingFileKey = hashCode;
 	}
 	else
 	{
 		faultyFileName = fileName;
 		loadedFile = File();
+
+		volumeId = 0;
+		streamingFileKey = 0;
 	}
 }
 
@@ -787,6 +971,7 @@ void StreamingSamplerSound::FileReader::openFileHandles(NotificationType notifyP
 
 		memoryReader = nullptr;
 		normalReader = nullptr;
+		mappedData = nullptr;
 
 		if (monolithicInfo != nullptr)
 		{
@@ -799,6 +984,12 @@ void StreamingSamplerSound::FileReader::openFileHandles(NotificationType notifyP
 			if (normalReader != nullptr)
 				stereo = normalReader->numChannels > 1;
 
+#if USE_MAPPED_MONOLITH_PLAYBACK
+			// Stereo monoliths are interleaved, so only mono files can be passed to the interpolators directly
+			if (auto subSectionReader = dynamic_cast<hlac::HlacSubSectionReader*>(normalReader.get()))
+				mappedData = stereo ? nullptr : subSectionReader->getMappedData(0);
+#endif
+
 			sampleLength = getMonolithLength();
 
 		}
@@ -857,6 +1048,7 @@ void StreamingSamplerSound::FileReader::closeFileHandles(NotificationType notify
 
 		memoryReader = nullptr;
 		normalReader = nullptr;
+		mappedData = nullptr;
 
 		if (monolithicInfo == nullptr && notifyPool == sendNotification) pool->decreaseNumOpenFileHandles();
 	}
@@ -945,6 +1137,27 @@ float StreamingSamplerSound::FileReader::calculatePeakValue()
 }
 
 
+const int16* StreamingSamplerSound::FileReader::getMappedData(int64 readerPosition) const noexcept
+{
+	auto data = mappedData.load();
+
+	if (data != nullptr && isPositiveAndBelow(readerPosition, sampleLength))
+		return data + readerPosition;
+
+	return nullptr;
+}
+
+void StreamingSamplerSound::FileReader::prefetch(int64 readerPosition, int numSamples, bool lockPages)
+{
+	if (mappedData == nullptr)
+		return;
+
+	ScopedReadLock sl(fileAccessLock);
+
+	if (auto subSectionReader = dynamic_cast<hlac::HlacSubSectionReader*>(normalReader.get()))
+		subSectionReader->prefetch(readerPosition, numSamples, lockPages);
+}
+
 AudioFormatReader* StreamingSamplerSound::FileReader::createMonolithicReaderForPreview()
 {
 	if (monolithicInfo != nullptr)
@@ -967,6 +1180,11 @@ void StreamingSamplerSound::FileReader::setMonolithicInfo(MonolithInfoToUse* inf
 	hashCode = monolithicName.hashCode64();
 
 	monolithicChannelIndex = channelIndex;
+
+	const File monolithFile = info->getMonolithicFile(channelIndex);
+
+	volumeId = SampleThreadPool::getVolumeIdForFile(monolithFile);
+	streamingFileKey = 0;
 }
 
 } // namespace hise
\ No newline at end of file
@@ -188,6 +188,44 @@ public:
 	*/
 	void loadEntireSample();
 
+	// ==============================================================================================================================================
+
+	/** Enables the lazy preloading for this sound.
+	*
+	*	If enabled, setPreloadSize() will only load the first HISE_LAZY_PRELOAD_HEAD_SIZE samples and the rest of the
+	*	preload buffer must be loaded with loadLazyPreloadBuffer() before the sound is played. The new mode will be used
+	*	at the next call to setPreloadSize().
+	*/
+	void setLazyPreload(bool shouldLoadLazily) noexcept { lazyPreload = shouldLoadLazily; }
+
+	/** Checks if the sound uses lazy preloading. */
+	bool isUsingLazyPreload() const noexcept { return lazyPreload; }
+
+	/** Returns true if the sound uses lazy preloading and the full preload buffer is not loaded. */
+	bool needsLazyPreload() const noexcept;
+
+	/** Loads the full preload buffer of a sound that uses lazy preloading.
+	*
+	*	Call this from a background thread. Returns true if the buffer was loaded.
+	*/
+	bool loadLazyPreloadBuffer();
+
+	/** Unloads the full preload buffer of a sound that uses lazy preloading.
+	*
+	*	Voices that start after this call will play the head of the sample again. If a voice still reads from the buffer,
+	*	it will not be freed and this returns false, so you need to call it again later.
+	*/
+	bool unloadLazyPreloadBuffer();
+
+	/** Returns the amount of bytes that are used by the lazily loaded preload buffer. */
+	size_t getLazyPreloadMemory() const noexcept { return lazyPreloadMemory.load(); }
+
+	/** Returns the value of Time::getMillisecondCounter() when a voice has used the preload buffer of this sound the last time. */
+	uint32 getLastPlayedTime() const noexcept { return lastPlayedTime.load(); }
+
+	/** Checks if the sound has any preloaded samples that a voice can start with. */
+	bool hasPreloadData() const noexcept;
+
 	/** increases the voice counter. */
 	void increaseVoiceCount() const;
 
@@ -201,6 +239,12 @@ public:
 	bool isMonolithic() const;
 	AudioFormatReader* createReaderForPreview();
 
+	/** Returns the volume ID of the sample file (see SampleThreadPool::getVolumeIdForFile()). */
+	int64 getVolumeId() const noexcept { return fileReader.getVolumeId(); }
+
+	/** Returns a hash value for the file that the streaming thread reads from. */
+	int64 getStreamingFileKey() const noexcept { return fileReader.getStreamingFileKey(); }
+
 	AudioFormatReader* createReaderForAnalysis();
 
 	int64 getMonolithOffset() const { return fileReader.getMonolithOffset(); }
@@ -256,6 +300,28 @@ public:
 		return preloadBuffer;
 	}
 
+	/** Returns the buffer that a voice should start reading from.
+	*
+	*	This is the lazily loaded preload buffer if it is available or the normal preload buffer. If the returned buffer 
+	*	contains the whole sample, containsEntireSample will be set to true. 
+	*	You must call releasePreloadBuffer() when you stop reading from the buffer. This is lock free, so you can call it 
+	*	in the audio thread.
+	*/
+	const hlac::HiseSampleBuffer* acquirePreloadBuffer(bool& containsEntireSample) const noexcept;
+
+	/** Releases the buffer that was returned by acquirePreloadBuffer(). */
+	void releasePreloadBuffer(const hlac::HiseSampleBuffer* buffer) const noexcept;
+
+	/** Returns a pointer to the sample start if the voices can read the sample data directly from the memory mapped file.
+	*
+	*	This is only possible for uncompressed mono monoliths without loop and reverse playback. In all other cases it returns
+	*	nullptr and the samples must be streamed into the buffers of the SampleLoader.
+	*/
+	const int16* getMappedSampleData() const noexcept;
+
+	/** Makes sure that the given range of the memory mapped sample data is in physical memory. Only call this from the background thread. */
+	void prefetchMappedSampleData(int uptime, int numSamples) const;
+
 	// ==============================================================================================================================================
 
 	/** Scans the file for the max level. */
@@ -264,6 +330,12 @@ public:
 	void setPurged(bool shouldBePurged) { purged = shouldBePurged; };
 	bool isPurged() const noexcept { return purged; }
 
+	/** Returns the amount of bytes that were streamed from disk since the last call to resetNumStreamedBytes(). */
+	int64 getNumStreamedBytes() const noexcept { return numStreamedBytes.load(); }
+
+	/** Resets the streamed bytes counter and returns the old value. */
+	int64 resetNumStreamedBytes() noexcept { return numStreamedBytes.exchange(0); }
+
 	// ==============================================================================================================================================
 
 	typedef ReferenceCountedObjectPtr<StreamingSamplerSound> Ptr;
@@ -354,6 +426,16 @@ private:
 			return sampleLength;
 		}
 
+		/** Returns the volume ID of the file that is used for streaming. */
+		int64 getVolumeId() const noexcept { return volumeId; }
+
+		/** Returns a hash value for the file that is used for streaming.
+		*
+		*	For monoliths, this is zero: the shared monolith reader serialises its reads itself (and the mapped data
+		*	can be read from multiple threads), so the samples of one monolith can be streamed by multiple workers at once.
+		*/
+		int64 getStreamingFileKey() const noexcept { return streamingFileKey; }
+
 		double getMonolithSampleRate() const
 		{
 			if (monolithicInfo != nullptr)
@@ -372,6 +454,12 @@ private:
 
 		AudioFormatReader* createMonolithicReaderForPreview();
 
+		/** Returns the memory mapped data at the given reader position or nullptr if the file can't be read without copying. */
+		const int16* getMappedData(int64 readerPosition) const noexcept;
+
+		/** Prefetches the given range of a memory mapped monolith (see hlac::HlacSubSectionReader::prefetch()). */
+		void prefetch(int64 readerPosition, int numSamples, bool lockPages);
+
 		// ==============================================================================================================================================
 
 	private:
@@ -399,12 +487,18 @@ private:
 
 		int64 hashCode;
 
+		int64 volumeId = 0;
+		int64 streamingFileKey = 0;
+
 		StreamingSamplerSound *sound;
 
 		ScopedPointer<MemoryMappedAudioFormatReader> memoryReader;
 		ScopedPointer<AudioFormatReader> normalReader;
 		bool fileHandlesOpen;
 
+		// the first sample of the monolith if it is mapped and can be played without copying (the voices fetch it for every block)
+		std::atomic<const int16*> mappedData { nullptr };
+
 		Atomic<int> voiceCount;
 
 		bool fileFormatSupportsMemoryReading;
@@ -430,6 +524,12 @@ private:
 	// used to wrap the read process for looping
 	void fillInternal(hlac::HiseSampleBuffer &sampleBuffer, int samplesToCopy, int uptime, int offsetInBuffer = 0) const;
 
+	/** Reads the preload region from disk into the given buffer. */
+	void fillPreloadBuffer(hlac::HiseSampleBuffer &buffer, int numSamples);
+
+	/** Copies the samples from the lazily loaded preload buffer. Returns false if it's not loaded or too small. */
+	bool copyFromLazyPreloadBuffer(hlac::HiseSampleBuffer &sampleBuffer, int samplesToCopy, int uptime, int offsetInBuffer) const;
+
 
 	// ==============================================================================================================================================
 
@@ -438,6 +538,9 @@ private:
 
 	mutable FileReader fileReader;
 
+	// updated by the streaming thread
+	mutable std::atomic<int64> numStreamedBytes { 0 };
+
 	bool purged;
 
 	friend class SampleLoader;
@@ -457,6 +560,19 @@ private:
 
 	bool entireSampleLoaded;
 
+	// the full preload buffer that is loaded in the background if lazy preloading is enabled
+	bool lazyPreload = false;
+	hlac::HiseSampleBuffer lazyPreloadBuffer;
+	int lazyPreloadSize = 0;
+	bool lazyPreloadContainsEntireSample = false;
+	bool lazyPreloadBufferIsValid = false;
+
+	std::atomic<bool> lazyPreloadLoaded { false };
+	mutable std::atomic<int> numLazyPreloadReaders { 0 };
+	std::atomic<size_t> lazyPreloadMemory { 0 };
+
+	mutable std::atomic<uint32> lastPlayedTime { 0 };
+
 	int sampleStart;
 	int sampleEnd;
 	int sampleLength;
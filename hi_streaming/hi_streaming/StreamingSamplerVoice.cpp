@@ -51,15 +51,26 @@ SampleLoader::SampleLoader(SampleThreadPool *pool_) :
 	diskUsage(0.0),
 	lastCallToRequestData(0.0),
 	b1(true, 2, 0),
-	b2(true, 2, 0)
+	b2(true, 2, 0),
+	history(true, 2, 0)
 {
 	unmapper.setLoader(this);
 
+	history.setSize(2, SampleInterpolator::NumMarginSamples);
+	history.clear();
+
 	setBufferSize(BUFFER_SIZE_FOR_STREAM_BUFFERS);
 }
 
 SampleLoader::~SampleLoader()
 {
+	// Make sure that no streaming thread still uses this loader
+	unmapper.signalJobShouldExit();
+	unmapper.waitForJobToFinish();
+
+	signalJobShouldExit();
+	waitForJobToFinish();
+
 	b1.setSize(2, 0);
 	b2.setSize(2, 0);
 }
@@ -93,21 +104,31 @@ void SampleLoader::startNote(StreamingSamplerSound const *s, int startTime)
 {
 	diskUsage = 0.0;
 
+	// the voice might be restarted without a reset
+	releasePreloadBuffer();
+
 	sound = s;
 
 	s->wakeSound();
 
 	sampleStartModValue = (int)startTime;
 
-	auto localReadBuffer = &s->getPreloadBuffer();
+	bool containsEntireSample = false;
+
+	auto localReadBuffer = s->acquirePreloadBuffer(containsEntireSample);
 	auto localWriteBuffer = &b1;
 
+	acquiredPreloadBuffer = localReadBuffer;
+
 	// the read pointer will be pointing directly to the preload buffer of the sample sound
 	readBuffer = localReadBuffer;
 	writeBuffer = localWriteBuffer;
 
 	lastSwapPosition = 0.0;
 
+	// There are no samples before the preload buffer
+	history.clear();
+
 	readIndex = startTime;
 	readIndexDouble = (double)startTime;
 
@@ -118,7 +139,15 @@ void SampleLoader::startNote(StreamingSamplerSound const *s, int startTime)
 
 	voiceCounterWasIncreased = false;
 
-	entireSampleIsLoaded = s->isEntireSampleLoaded();
+	entireSampleIsLoaded = containsEntireSample;
+
+	// Uncompressed monoliths don't need to be copied into the streaming buffers
+	isMappedPlayback = !entireSampleIsLoaded && !b1.isFloatingPoint() && s->getMappedSampleData() != nullptr;
+	mappedLength = s->getSampleLength();
+
+	// Without streaming buffers there's nothing to stream into, so the voice just plays the preload buffer
+	if (!useStreamingBuffers && !isMappedPlayback)
+		entireSampleIsLoaded = true;
 
 	if (!entireSampleIsLoaded)
 	{
@@ -147,6 +176,9 @@ void SampleLoader::reset()
 
 			unmapper.setSoundToUnmap(currentSound);
 
+			// Closing the file is not urgent, but it must not be starved by the streaming jobs
+			unmapper.setDeadline(Time::getHighResolutionTicks());
+
 			backgroundPool->addJob(&unmapper, false);
 
 			clearLoader();
@@ -156,7 +188,10 @@ void SampleLoader::reset()
 
 void SampleLoader::clearLoader()
 {
+	releasePreloadBuffer();
+
 	sound = nullptr;
+	isMappedPlayback = false;
 	diskUsage = 0.0f;
 	cancelled = false;
 }
@@ -175,36 +210,72 @@ void SampleLoader::setStreamingBufferDataType(bool shouldBeFloat)
 	b1 = hlac::HiseSampleBuffer(shouldBeFloat, 2, 0);
 	b2 = hlac::HiseSampleBuffer(shouldBeFloat, 2, 0);
 
+	history = hlac::HiseSampleBuffer(shouldBeFloat, 2, 0);
+	history.setSize(2, SampleInterpolator::NumMarginSamples);
+	history.clear();
+
 	refreshBufferSizes();
 }
 
+void SampleLoader::setUseStreamingBuffers(bool shouldUseStreamingBuffers)
+{
+	ScopedLock sl(getLock());
+
+	if (useStreamingBuffers != shouldUseStreamingBuffers)
+	{
+		useStreamingBuffers = shouldUseStreamingBuffers;
+
+		refreshBufferSizes();
+	}
+}
+
 StereoChannelData SampleLoader::fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuffer, double numSamples) const
 {
+	if (isMappedPlayback)
+		return getMappedVoiceData(voiceBuffer, numSamples);
+
 	auto localReadBuffer = readBuffer.get();
 	auto localWriteBuffer = writeBuffer.get();
 
+	// The interpolators need a few samples before and after the read position
+	const int margin = SampleInterpolator::NumMarginSamples;
+
 	const int numSamplesInBuffer = localReadBuffer->getNumSamples();
-	const int maxSampleIndexForFillOperation = (int)(readIndexDouble + numSamples) + 1; // Round up the samples
+	const int maxSampleIndexForFillOperation = (int)(readIndexDouble + numSamples) + 1 + margin; // Round up the samples
 
-	if (maxSampleIndexForFillOperation >= numSamplesInBuffer) // Check because of preloadbuffer style
+	if (maxSampleIndexForFillOperation >= numSamplesInBuffer || (int)readIndexDouble < margin) // Check because of preloadbuffer style
 	{
-		const int indexBeforeWrap = jmax<int>(0, (int)(readIndexDouble));
-		const int numSamplesInFirstBuffer = localReadBuffer->getNumSamples() - indexBeforeWrap;
+		const int indexBeforeWrap = jlimit<int>(0, numSamplesInBuffer, (int)(readIndexDouble));
 
-		jassert(numSamplesInFirstBuffer >= 0);
+		// The samples before the read index are taken from the end of the last buffer if they are not in this buffer
+		const int numSamplesBeforeIndex = jmin<int>(margin, indexBeforeWrap);
+		const int numSamplesFromHistory = margin - numSamplesBeforeIndex;
 
-		if (numSamplesInFirstBuffer > 0)
+		if (numSamplesFromHistory > 0)
+		{
+			hlac::HiseSampleBuffer::copy(voiceBuffer, history, 0, margin - numSamplesFromHistory, numSamplesFromHistory);
+		}
+
+		if (numSamplesBeforeIndex > 0)
 		{
-			hlac::HiseSampleBuffer::copy(voiceBuffer, *localReadBuffer, 0, indexBeforeWrap, numSamplesInFirstBuffer);
+			hlac::HiseSampleBuffer::copy(voiceBuffer, *localReadBuffer, numSamplesFromHistory, indexBeforeWrap - numSamplesBeforeIndex, numSamplesBeforeIndex);
 		}
 
-		const int offset = numSamplesInFirstBuffer;
-		const int numSamplesAvailableInSecondBuffer = localWriteBuffer->getNumSamples() - offset;
+		const int numSamplesInFirstBuffer = jmin<int>(numSamplesInBuffer - indexBeforeWrap, voiceBuffer.getNumSamples() - margin);
 
-		if ((numSamplesAvailableInSecondBuffer > 0) && (numSamplesAvailableInSecondBuffer <= localWriteBuffer->getNumSamples()))
+		if (numSamplesInFirstBuffer > 0)
 		{
-			const int numSamplesToCopyFromSecondBuffer = jmin<int>(numSamplesAvailableInSecondBuffer, voiceBuffer.getNumSamples() - offset);
+			hlac::HiseSampleBuffer::copy(voiceBuffer, *localReadBuffer, margin, indexBeforeWrap, numSamplesInFirstBuffer);
+		}
+
+		const int offset = margin + numSamplesInFirstBuffer;
+		const int numSamplesToCopyFromSecondBuffer = jmin<int>(localWriteBuffer->getNumSamples(), voiceBuffer.getNumSamples() - offset);
 
+		// The streaming buffers must be greater than the block size!
+		jassert(entireSampleIsLoaded || localWriteBuffer->getNumSamples() >= maxSampleIndexForFillOperation - numSamplesInBuffer);
+
+		if (numSamplesToCopyFromSecondBuffer > 0)
+		{
 			if (writeBufferIsBeingFilled || entireSampleIsLoaded)
 			{
 				voiceBuffer.clear(offset, numSamplesToCopyFromSecondBuffer);
@@ -214,19 +285,12 @@ StereoChannelData SampleLoader::fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuf
 				hlac::HiseSampleBuffer::copy(voiceBuffer, *localWriteBuffer, offset, 0, numSamplesToCopyFromSecondBuffer);
 			}
 		}
-		else
-		{
-			// The streaming buffers must be greater than the block size!
-			jassertfalse;
-
-			voiceBuffer.clear();
-		}
 
 		StereoChannelData returnData;
 
 		returnData.isFloatingPoint = localReadBuffer->isFloatingPoint();
-		returnData.leftChannel = voiceBuffer.getReadPointer(0);
-		returnData.rightChannel = voiceBuffer.getReadPointer(1);
+		returnData.leftChannel = voiceBuffer.getReadPointer(0, margin);
+		returnData.rightChannel = voiceBuffer.getReadPointer(1, margin);
 
 #if USE_SAMPLE_DEBUG_COUNTER
 
@@ -264,9 +328,55 @@ StereoChannelData SampleLoader::fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuf
 	}
 }
 
+StereoChannelData SampleLoader::getMappedVoiceData(hlac::HiseSampleBuffer &voiceBuffer, double numSamples) const
+{
+	// Fetch the mapping for every block so that a released mapping can't be read
+	auto localSound = sound.get();
+	const int16* data = localSound != nullptr ? localSound->getMappedSampleData() : nullptr;
+	const int margin = SampleInterpolator::NumMarginSamples;
+
+	// The read index is relative to the last buffer swap
+	const double uptime = lastSwapPosition + readIndexDouble;
+	const int index = (int)uptime;
+	const int maxSampleIndexForFillOperation = (int)(uptime + numSamples) + 1 + margin;
+
+	StereoChannelData returnData;
+	returnData.isFloatingPoint = false;
+
+	if (data != nullptr && index >= margin && maxSampleIndexForFillOperation < mappedLength)
+	{
+		returnData.leftChannel = data + index;
+		returnData.rightChannel = data + index;
+
+		return returnData;
+	}
+
+	// The margin exceeds the sample range, so we copy the available samples and pad them with zeros
+	const int firstIndex = index - margin;
+	const auto validRange = Range<int>(0, mappedLength).getIntersectionWith({ firstIndex, firstIndex + voiceBuffer.getNumSamples() });
+
+	voiceBuffer.clear();
+
+	if (data != nullptr && !validRange.isEmpty())
+	{
+		const int offset = validRange.getStart() - firstIndex;
+		const size_t numBytes = sizeof(int16) * (size_t)validRange.getLength();
+
+		memcpy(voiceBuffer.getWritePointer(0, offset), data + validRange.getStart(), numBytes);
+
+		if (voiceBuffer.getNumChannels() > 1)
+			memcpy(voiceBuffer.getWritePointer(1, offset), data + validRange.getStart(), numBytes);
+	}
+
+	returnData.leftChannel = voiceBuffer.getReadPointer(0, margin);
+	returnData.rightChannel = voiceBuffer.getReadPointer(voiceBuffer.getNumChannels() > 1 ? 1 : 0, margin);
+
+	return returnData;
+}
+
 bool SampleLoader::advanceReadIndex(double uptime)
 {
-	const int numSamplesInBuffer = readBuffer.get()->getNumSamples();
+	const int numSamplesInBuffer = getNumSamplesInReadBuffer();
 	readIndexDouble = uptime - lastSwapPosition;
 
 	if (readIndexDouble >= numSamplesInBuffer)
@@ -281,7 +391,13 @@ bool SampleLoader::advanceReadIndex(double uptime)
 			positionInSampleFile += getNumSamplesForStreamingBuffers();
 			readIndexDouble = uptime - lastSwapPosition;
 
+			storeHistory();
 			swapBuffers();
+
+			// The buffer that we've just swapped in is not yet filled
+			if (isQueued())
+				statistics.addUnderrun();
+
 			const bool queueIsFree = requestNewData();
 
 			return queueIsFree;
@@ -297,11 +413,31 @@ int SampleLoader::getNumSamplesForStreamingBuffers() const
 {
 	jassert(b1.getNumSamples() == b2.getNumSamples());
 
-	return b1.getNumSamples();
+	return numSamplesForStreamingBuffers;
+}
+
+int SampleLoader::getNumSamplesInReadBuffer() const
+{
+	// The streaming buffers of a mapped voice are never filled (and might not be allocated at all)
+	if (isMappedPlayback && !isReadingFromPreloadBuffer)
+		return getNumSamplesForStreamingBuffers();
+
+	return readBuffer.get()->getNumSamples();
 }
 
 bool SampleLoader::requestNewData()
 {
+	// The deadline is the time when the voice will run out of samples in the current read buffer
+	const double samplesLeft = jmax<double>(0.0, (double)getNumSamplesInReadBuffer() - readIndexDouble);
+	const double secondsLeft = playbackSpeed > 0.0 ? samplesLeft / playbackSpeed : 0.0;
+
+	const int64 now = Time::getHighResolutionTicks();
+
+	setDeadline(now + Time::secondsToHighResolutionTicks(secondsLeft));
+
+	requestTime.store(now);
+	samplesLeftAtRequest.store(samplesLeft);
+
 #if KILL_VOICES_WHEN_STREAMING_IS_BLOCKED
 	if (this->isQueued())
 	{
@@ -359,9 +495,30 @@ SampleThreadPoolJob::JobStatus SampleLoader::runJob()
 	diskUsage = diskUsageThisTime;
 	lastCallToRequestData = readStart;
 
+	const double latency = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - requestTime.load());
+
+	statistics.addJobLatency(latency * 1000.0);
+	statistics.addHeadroom((int)(samplesLeftAtRequest.load() - latency * playbackSpeed));
+
 	return SampleThreadPoolJob::JobStatus::jobHasFinished;
 }
 
+int64 SampleLoader::getVolumeId() const noexcept
+{
+	if (auto s = sound.get())
+		return s->getVolumeId();
+
+	return 0;
+}
+
+int64 SampleLoader::getFileKey() const noexcept
+{
+	if (auto s = sound.get())
+		return s->getStreamingFileKey();
+
+	return 0;
+}
+
 size_t SampleLoader::getActualStreamingBufferSize() const
 {
 	return b1.getNumSamples() * 2 * 2;
@@ -373,11 +530,27 @@ void SampleLoader::fillInactiveBuffer()
 
 	if (localSound == nullptr) return;
 
+	if (isMappedPlayback)
+	{
+		// The voice reads the mapped file directly, so we just need to make sure the next buffer is in memory
+		const int numSamplesToPrefetch = jmin<int>(getNumSamplesForStreamingBuffers(), localSound->getSampleLength() - positionInSampleFile);
+
+		if (numSamplesToPrefetch > 0)
+		{
+			localSound->prefetchMappedSampleData(positionInSampleFile, numSamplesToPrefetch);
+			localSound->numStreamedBytes.fetch_add((int64)numSamplesToPrefetch * (int64)sizeof(int16));
+		}
+
+		return;
+	}
+
 	if (localSound != nullptr)
 	{
 		if (localSound->hasEnoughSamplesForBlock(positionInSampleFile + getNumSamplesForStreamingBuffers()))
 		{
 			localSound->fillSampleBuffer(*writeBuffer.get(), getNumSamplesForStreamingBuffers(), (int)positionInSampleFile);
+
+			localSound->numStreamedBytes.fetch_add(getNumBytesForSamples(getNumSamplesForStreamingBuffers()));
 		}
 		else if (localSound->hasEnoughSamplesForBlock(positionInSampleFile))
 		{
@@ -386,6 +559,8 @@ void SampleLoader::fillInactiveBuffer()
 
 			localSound->fillSampleBuffer(*writeBuffer.get(), numSamplesToFill, (int)positionInSampleFile);
 
+			localSound->numStreamedBytes.fetch_add(getNumBytesForSamples(numSamplesToFill));
+
 			writeBuffer.get()->clear(numSamplesToFill, numSamplesToClear);
 		}
 		else
@@ -423,11 +598,36 @@ void SampleLoader::fillInactiveBuffer()
 	}
 };
 
+int64 SampleLoader::getNumBytesForSamples(int numSamples) const
+{
+	const int64 bytesPerSample = writeBuffer.get()->isFloatingPoint() ? sizeof(float) : sizeof(int16);
+
+	return (int64)numSamples * (int64)writeBuffer.get()->getNumChannels() * bytesPerSample;
+}
+
 void SampleLoader::refreshBufferSizes()
 {
 	const int numSamplesToUse = jmax<int>(idealBufferSize, minimumBufferSizeForSamplesPerBlock);
 
-	if (getNumSamplesForStreamingBuffers() < numSamplesToUse)
+	if (!useStreamingBuffers)
+	{
+		numSamplesForStreamingBuffers = numSamplesToUse;
+
+		if (b1.getNumSamples() != 0)
+		{
+			b1 = hlac::HiseSampleBuffer(b1.isFloatingPoint(), 2, 0);
+			b2 = hlac::HiseSampleBuffer(b2.isFloatingPoint(), 2, 0);
+
+			readBuffer = &b1;
+			writeBuffer = &b2;
+
+			reset();
+		}
+
+		return;
+	}
+
+	if (b1.getNumSamples() < numSamplesToUse)
 	{
 		StreamingHelpers::increaseBufferIfNeeded(b1, numSamplesToUse);
 		StreamingHelpers::increaseBufferIfNeeded(b2, numSamplesToUse);
@@ -437,6 +637,26 @@ void SampleLoader::refreshBufferSizes()
 
 		reset();
 	}
+
+	numSamplesForStreamingBuffers = b1.getNumSamples();
+}
+
+void SampleLoader::storeHistory()
+{
+	auto localReadBuffer = readBuffer.get();
+
+	const int margin = history.getNumSamples();
+	const int numSamplesInBuffer = localReadBuffer->getNumSamples();
+	const int numToCopy = jmin<int>(margin, numSamplesInBuffer);
+
+	if (localReadBuffer->isFloatingPoint() != history.isFloatingPoint())
+	{
+		history.clear();
+		return;
+	}
+
+	history.clear(0, margin - numToCopy);
+	hlac::HiseSampleBuffer::copy(history, *localReadBuffer, margin - numToCopy, numSamplesInBuffer - numToCopy, numToCopy);
 }
 
 bool SampleLoader::swapBuffers()
@@ -457,9 +677,22 @@ bool SampleLoader::swapBuffers()
 	isReadingFromPreloadBuffer = false;
 	sampleStartModValue = 0;
 
+	releasePreloadBuffer();
+
 	return writeBufferIsBeingFilled == false;
 };
 
+void SampleLoader::releasePreloadBuffer()
+{
+	if (acquiredPreloadBuffer != nullptr)
+	{
+		if (auto s = sound.get())
+			s->releasePreloadBuffer(acquiredPreloadBuffer);
+
+		acquiredPreloadBuffer = nullptr;
+	}
+}
+
 // ==================================================================================================== StreamingSamplerVoice methods
 
 StreamingSamplerVoice::StreamingSamplerVoice(SampleThreadPool *pool) :
@@ -478,13 +711,6 @@ void StreamingSamplerVoice::startNote(int /*midiNoteNumber*/,
 
 	if (sound != nullptr && sound->getSampleLength() > 0)
 	{
-		loader.startNote(sound, sampleStartModValue);
-
-		jassert(sound != nullptr);
-		sound->wakeSound();
-
-		voiceUptime = (double)sampleStartModValue;
-
 		// You have to call setPitchFactor() before startNote().
 		jassert(uptimeDelta != 0.0);
 
@@ -494,6 +720,16 @@ void StreamingSamplerVoice::startNote(int /*midiNoteNumber*/,
 
 		constUptimeDelta = uptimeDelta;
 
+		// Set this before starting the loader so that the first request gets the right deadline
+		loader.setPlaybackSpeed(uptimeDelta * getSampleRate());
+
+		loader.startNote(sound, sampleStartModValue);
+
+		jassert(sound != nullptr);
+		sound->wakeSound();
+
+		voiceUptime = (double)sampleStartModValue;
+
 		isActive = true;
 
 	}
@@ -525,59 +761,6 @@ void StreamingSamplerVoice::setDebugLogger(DebugLogger* newLogger)
 	loader.setLogger(logger);
 }
 
-template <typename SignalType> void interpolateStereoSamples(const SignalType* inL, const SignalType* inR, const float* pitchData, float* outL, float* outR, int startSample, double indexInBuffer, double uptimeDelta, int numSamples, bool isFloat)
-{
-	const float gainFactor = isFloat ? 1.0f : (1.0f / (float)INT16_MAX);
-
-	if (pitchData != nullptr)
-	{
-		pitchData += startSample;
-
-		float indexInBufferFloat = (float)indexInBuffer;
-
-		for (int i = 0; i < numSamples; i++)
-		{
-			const int pos = int(indexInBufferFloat);
-			const float alpha = indexInBufferFloat - (float)pos;
-			const float invAlpha = 1.0f - alpha;
-
-			float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
-			float r = ((float)inR[pos] * invAlpha + (float)inR[pos + 1] * alpha);
-
-			outL[i] = l * gainFactor;
-			outR[i] = r * gainFactor;
-
-			jassert(*pitchData <= (float)MAX_SAMPLER_PITCH);
-
-			indexInBufferFloat += pitchData[i];
-		}
-	}
-	else
-	{
-
-		float indexInBufferFloat = (float)indexInBuffer;
-		const float uptimeDeltaFloat = (float)uptimeDelta;
-
-		while (numSamples > 0)
-		{
-			const int pos = int(indexInBufferFloat);
-			const float alpha = indexInBufferFloat - (float)pos;
-			const float invAlpha = 1.0f - alpha;
-
-			float l = ((float)inL[pos] * invAlpha + (float)inL[pos + 1] * alpha);
-			float r = ((float)inR[pos] * invAlpha + (float)inR[pos + 1] * alpha);
-
-			*outL++ = l * gainFactor;
-			*outR++ = r * gainFactor;
-
-			indexInBufferFloat += uptimeDeltaFloat;
-
-			numSamples--;
-		}
-	}
-}
-
-
 void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int startSample, int numSamples)
 {
 	const StreamingSamplerSound *sound = loader.getLoadedSound();
@@ -620,14 +803,14 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 			const float* const inL = static_cast<const float*>(data.leftChannel);
 			const float* const inR = static_cast<const float*>(data.rightChannel);
 
-			interpolateStereoSamples(inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, true);
+			SampleInterpolator::interpolate(interpolationMode, sincTable, inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples);
 		}
 		else
 		{
 			const int16* const inL = static_cast<const int16*>(data.leftChannel);
 			const int16* const inR = static_cast<const int16*>(data.rightChannel);
 
-			interpolateStereoSamples(inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples, false);
+			SampleInterpolator::interpolate(interpolationMode, sincTable, inL, inR, pitchData, outL, outR, startSample, indexInBuffer, uptimeDelta, numSamples);
 
 		}
 
@@ -732,9 +915,12 @@ void StreamingSamplerVoice::initTemporaryVoiceBuffer(hlac::HiseSampleBuffer* buf
 	// The channel amount must be set correctly in the constructor
 	jassert(bufferToUse->getNumChannels() > 0);
 
-	if (bufferToUse->getNumSamples() < samplesPerBlock*MAX_SAMPLER_PITCH)
+	// The interpolators need some samples before and after the resampled block
+	const int numSamplesToUse = samplesPerBlock * MAX_SAMPLER_PITCH + 2 * SampleInterpolator::NumMarginSamples;
+
+	if (bufferToUse->getNumSamples() < numSamplesToUse)
 	{
-		bufferToUse->setSize(bufferToUse->getNumChannels(), samplesPerBlock*MAX_SAMPLER_PITCH);
+		bufferToUse->setSize(bufferToUse->getNumChannels(), numSamplesToUse);
 		bufferToUse->clear();
 	}
 }
@@ -776,4 +962,15 @@ SampleThreadPool::Job::JobStatus SampleLoader::Unmapper::runJob()
 	return SampleThreadPoolJob::jobHasFinished;
 }
 
-} // namespace hise
\ No newline at end of file
+int64 SampleLoader::Unmapper::getVolumeId() const noexcept
+{
+	// Use the same queue and file key as the loader so that the file isn't closed while it's being read
+	return sound != nullptr ? sound->getVolumeId() : 0;
+}
+
+int64 SampleLoader::Unmapper::getFileKey() const noexcept
+{
+	return sound != nullptr ? sound->getStreamingFileKey() : 0;
+}
+
+} // namespace hise
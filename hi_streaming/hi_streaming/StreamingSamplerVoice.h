@@ -69,10 +69,31 @@ public:
 	*/
 	JobStatus runJob() override;
 
+	/** Returns the volume of the currently loaded sound so that the pool can dispatch it to the right worker thread. */
+	int64 getVolumeId() const noexcept override;
+
+	/** Returns the file key of the currently loaded sound. */
+	int64 getFileKey() const noexcept override;
+
+	/** Sets the amount of samples per second that are read from the sound.
+	*
+	*	This is used to calculate the deadline for the background thread (the smaller the remaining samples
+	*	in the read buffer, the earlier it will be executed).
+	*/
+	void setPlaybackSpeed(double samplesPerSecond) noexcept { playbackSpeed = samplesPerSecond; }
+
 	size_t getActualStreamingBufferSize() const;
 
 	void setStreamingBufferDataType(bool shouldBeFloat);
 
+	/** Disables the allocation of the streaming buffers.
+	*
+	*	Voices that only play sounds from the preload buffer or directly from the memory mapped monolith never copy
+	*	samples into the streaming buffers, so the sampler can skip allocating them. If such a loader gets a sound that
+	*	needs to be streamed anyway, it will only play its preload buffer.
+	*/
+	void setUseStreamingBuffers(bool shouldUseStreamingBuffers);
+
 	StereoChannelData fillVoiceBuffer(hlac::HiseSampleBuffer &voiceBuffer, double numSamples) const;
 
 	/** Advances the read index and returns `false` if the streaming thread is blocked. */
@@ -103,6 +124,9 @@ public:
 
 		JobStatus runJob() override;
 
+		int64 getVolumeId() const noexcept override;
+		int64 getFileKey() const noexcept override;
+
 	private:
 
 		StreamingSamplerSound *sound;
@@ -122,6 +146,9 @@ public:
 	double getDiskUsage() noexcept;;
 
 
+	/** Returns the streaming statistics of this loader. */
+	StreamingStatistics& getStatistics() noexcept { return statistics; }
+
 	void setLogger(DebugLogger* l) { logger = l; }
 	const CriticalSection &getLock() const { return lock; }
 
@@ -134,12 +161,26 @@ private:
 
 	int getNumSamplesForStreamingBuffers() const;
 
+	/** Returns the length of the current read buffer (mapped voices only advance the position after the preload buffer). */
+	int getNumSamplesInReadBuffer() const;
+
 	bool requestNewData();
 
+	/** Copies the last samples of the read buffer before it is swapped so that the interpolators can access them. */
+	void storeHistory();
+
+	/** Returns the voice data from the memory mapped file. It only copies the samples if the margin exceeds the sample range. */
+	StereoChannelData getMappedVoiceData(hlac::HiseSampleBuffer &voiceBuffer, double numSamples) const;
+
 	bool swapBuffers();
 
+	/** Releases the preload buffer of the sound after the voice has stopped reading from it. */
+	void releasePreloadBuffer();
+
 	void fillInactiveBuffer();
 	void refreshBufferSizes();
+
+	int64 getNumBytesForSamples(int numSamples) const;
 	// ============================================================================================ member variables
 
 	Unmapper unmapper;
@@ -165,6 +206,11 @@ private:
 	int idealBufferSize;
 	int minimumBufferSizeForSamplesPerBlock;
 
+	// the amount of samples that are read with every background job (this is also used if the buffers are not allocated)
+	int numSamplesForStreamingBuffers = 0;
+
+	bool useStreamingBuffers = true;
+
 	int positionInSampleFile;
 
 	bool isReadingFromPreloadBuffer;
@@ -180,11 +226,24 @@ private:
 	Atomic<hlac::HiseSampleBuffer const *> readBuffer;
 	Atomic<hlac::HiseSampleBuffer *> writeBuffer;
 
+	// the preload buffer that was acquired from the sound at the voice start (see StreamingSamplerSound::acquirePreloadBuffer())
+	hlac::HiseSampleBuffer const * acquiredPreloadBuffer = nullptr;
+
 	// variables for disk usage measurement
 
 	Atomic<float> diskUsage;
 	double lastCallToRequestData;
 
+	// the samples per second that are read from the sound (used for the deadline)
+	double playbackSpeed = 44100.0;
+
+	// variables for the streaming statistics
+
+	std::atomic<int64> requestTime { 0 };
+	std::atomic<double> samplesLeftAtRequest { 0.0 };
+
+	StreamingStatistics statistics;
+
 	// just a pointer to the used pool
 	SampleThreadPool *backgroundPool;
 
@@ -192,6 +251,14 @@ private:
 
 	hlac::HiseSampleBuffer b1, b2;
 
+	// the last samples of the previous read buffer
+	hlac::HiseSampleBuffer history;
+
+	// true if the sound is read directly from the memory mapped file. The mapping is fetched from the sound for every
+	// block, so the voice never uses a pointer to a mapping that was released in the meantime.
+	std::atomic<bool> isMappedPlayback { false };
+	int mappedLength = 0;
+
 	bool cancelled = false;
 };
 
@@ -239,6 +306,7 @@ public:
 	void setDynamicPitchFactor(double pitchMultiplier)
 	{
 		uptimeDelta = constUptimeDelta * pitchMultiplier;
+		loader.setPlaybackSpeed(uptimeDelta * getSampleRate());
 	}
 
 	/** You have to call this before startNote() to calculate the pitch factor.
@@ -253,6 +321,9 @@ public:
 	*/
 	double getDiskUsage() { return loader.getDiskUsage(); };
 
+	/** Returns the streaming statistics of the voice's loader. */
+	StreamingStatistics& getStreamingStatistics() noexcept { return loader.getStatistics(); }
+
 	/** Initializes its sampleBuffer. You have to call this manually, since there is no base class function. */
 	void prepareToPlay(double sampleRate, int samplesPerBlock);
 
@@ -285,8 +356,17 @@ public:
 	/** Set this to false if you're using HLAC compressed monoliths. */
 	void setStreamingBufferDataType(bool shouldBeFloat);
 
+	/** Sets the interpolation algorithm that is used for resampling. */
+	void setInterpolationMode(SampleInterpolator::InterpolationMode newMode) noexcept { interpolationMode = newMode; }
+
+	SampleInterpolator::InterpolationMode getInterpolationMode() const noexcept { return interpolationMode; }
+
 private:
 
+	SampleInterpolator::InterpolationMode interpolationMode = SampleInterpolator::Linear;
+
+	SharedResourcePointer<SampleInterpolator::SincTable> sincTable;
+
 	double pitchCounter = 0.0;
 
 	hlac::HiseSampleBuffer* tvb = nullptr;
@@ -127,6 +127,18 @@ public:
 		print("");
 		print("create-win-installer" );
 		print("Creates a template install script for Inno Setup for the project" );
+		print("");
+		print("benchmark FILE [OPTIONS]");
+		print("Renders the preset (.hip or .xml) without audio device and prints the CPU usage.");
+		print("-m:{PATH}  the MIDI file that is played (default: a generated chord pattern)");
+		print("-o:{PATH}  writes the rendered audio to this WAV file");
+		print("-j:{PATH}  writes the result to this JSON file");
+		print("-sr:{RATE} the sample rate (default: 44100)");
+		print("-bs:{SIZE} the block size (default: 512)");
+		print("-l:{TIME}  the length in seconds (default: MIDI file length + 2 seconds or 12 seconds)");
+		print("-w:{NUM}   renders the synths and voices in parallel on NUM worker threads (0 disables it, default: preset settings)");
+		print("-n:{NUM}   the number of notes per chord of the pattern (default: 8)");
+		print("-i:{TIME}  the time between two chords of the pattern in seconds (default: 0.125)");
 
 		exit(0);
 	}
@@ -429,6 +441,16 @@ public:
 			quit();
 			return;
 		}
+		else if (commandLine.startsWith("benchmark"))
+		{
+			const int result = hise::OfflineBenchmark::runFromCommandLine(commandLine);
+
+			if (result != 0)
+				exit(result);
+
+			quit();
+			return;
+		}
 		else if (commandLine.startsWith("--help"))
 		{
 			CommandLineActions::printHelp();
@@ -451,6 +473,14 @@ public:
 		}
 		else
 		{
+#if HI_RUN_UNIT_TESTS
+			// The tests create their own BackendProcessor instances, so they are started here and not by the MainController
+			UnitTestRunner runner;
+
+			runner.setAssertOnFailure(false);
+			runner.runAllTests();
+#endif
+
 			mainWindow = new MainWindow(commandLine);
 			mainWindow->setUsingNativeTitleBar(true);
 			mainWindow->toFront(true);
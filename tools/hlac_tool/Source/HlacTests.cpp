@@ -610,6 +610,15 @@ public:
 
 		testFixedSampleBuffer();
 
+#if JUCE_64BIT
+		testMappedMonolithData(1);
+		testMappedMonolithData(2);
+#endif
+
+		testBlockCache();
+
+		testSimdUnpacking();
+
 		runFormatTestWithOption(HlacEncoder::CompressorOptions::Presets::WholeBlock);
 		runFormatTestWithOption(HlacEncoder::CompressorOptions::Presets::Delta);
 		runFormatTestWithOption(HlacEncoder::CompressorOptions::Presets::Diff);
@@ -657,6 +666,15 @@ public:
 
 		testPadding(1);
         testPadding(2);
+
+		testCachedReading(1);
+		testCachedReading(2);
+
+		testParallelDecoding(1);
+		testParallelDecoding(2);
+
+		testParallelEncoding(1);
+		testParallelEncoding(2);
 	
 		for (int i = 0; i < 5; i++)
 		{
@@ -825,6 +843,423 @@ public:
 		return b2;
 	}
 
+	void testMappedMonolithData(int numChannels)
+	{
+		beginTest("Testing direct access to mapped monoliths with " + String(numChannels) + " channels");
+
+		const int numFrames = 20000;
+		const int subSectionStart = 3000;
+		const int subSectionLength = 12000;
+		const int numValues = numFrames * numChannels;
+
+		HeapBlock<int16> data;
+		data.malloc(numValues);
+
+		Random r;
+
+		for (int i = 0; i < numValues; i++)
+			data[i] = (int16)r.nextInt(Range<int>(-32767, 32767));
+
+		TemporaryFile tempFile;
+
+		File f = tempFile.getFile();
+
+		{
+			FileOutputStream fos(f);
+
+			// The uncompressed monolith header just stores the channel amount
+			fos.writeByte(numChannels == 2 ? 0 : 1);
+
+			for (int i = 0; i < numValues; i++)
+				fos.writeShort(data[i]);
+		}
+
+		HiseLosslessAudioFormat hlac;
+
+		ScopedPointer<MemoryMappedAudioFormatReader> memoryReader = hlac.createMemoryMappedReader(f);
+
+		memoryReader->mapEntireFile();
+
+		auto hlacReader = dynamic_cast<HlacMemoryMappedAudioFormatReader*>(memoryReader.get());
+
+		expect(hlacReader != nullptr, "HLAC reader");
+
+		const int16* mappedData = hlacReader->getMappedMonolithData(0);
+
+		expect(mappedData != nullptr, "Mapped data");
+		expect(memcmp(mappedData, data.get(), numValues * sizeof(int16)) == 0, "Mapped data equal");
+
+		HlacSubSectionReader subSectionReader(memoryReader, subSectionStart, subSectionLength);
+
+		expect(subSectionReader.getMappedData(0) == mappedData + subSectionStart * numChannels, "Sub section offset");
+		expect(subSectionReader.getMappedData(subSectionLength) == nullptr, "Position beyond sub section");
+
+		// The prefetch range will be clipped to the sub section
+		subSectionReader.prefetch(0, subSectionLength * 2, false);
+
+		expect(memcmp(mappedData, data.get(), numValues * sizeof(int16)) == 0, "Mapped data after prefetch");
+	}
+
+	void testSimdUnpacking()
+	{
+		typedef BitCompressors::SimdUnpacker SimdUnpacker;
+
+		const auto best = SimdUnpacker::getBestAvailableInstructionSet();
+		const auto previous = SimdUnpacker::getInstructionSet();
+
+		BitCompressors::Collection collection;
+		Random r;
+
+		for (int i = 1; i <= (int)best; i++)
+		{
+			const auto instructionSet = (SimdUnpacker::InstructionSet)i;
+
+			beginTest("Testing " + SimdUnpacker::getName(instructionSet) + " unpacking");
+
+			for (uint8 bitDepth = 1; bitDepth <= 16; bitDepth++)
+			{
+				auto compressor = collection.getSuitableCompressorForBitRate(bitDepth);
+
+				// Test all remainders for the chunk sizes of the kernels
+				for (int numValues = 4000; numValues < 4096; numValues += 7)
+				{
+					HeapBlock<int16> original, scalar, vectorised;
+					HeapBlock<uint8> packed;
+
+					original.malloc(numValues);
+					scalar.calloc(numValues);
+					vectorised.calloc(numValues);
+
+					const int maxValue = bitDepth == 1 ? 1 : (1 << (compressor->getAllowedBitRange() - 1)) - 1;
+					const int minValue = bitDepth == 1 ? 0 : -maxValue;
+
+					for (int j = 0; j < numValues; j++)
+						original[j] = (int16)r.nextInt(Range<int>(minValue, maxValue + 1));
+
+					packed.malloc(compressor->getByteAmount(numValues) + 2 * numValues);
+					compressor->compress(packed, original, numValues);
+
+					SimdUnpacker::setInstructionSet(SimdUnpacker::InstructionSet::None);
+					compressor->decompress(scalar, packed, numValues);
+
+					SimdUnpacker::setInstructionSet(instructionSet);
+					compressor->decompress(vectorised, packed, numValues);
+
+					const bool scalarMatches = memcmp(original, scalar, sizeof(int16) * numValues) == 0;
+					const bool vectorisedMatches = memcmp(original, vectorised, sizeof(int16) * numValues) == 0;
+
+					expect(scalarMatches, "Scalar mismatch with bit depth " + String(bitDepth) + ", size: " + String(numValues));
+					expect(vectorisedMatches, "Mismatch with bit depth " + String(bitDepth) + ", size: " + String(numValues));
+				}
+			}
+		}
+
+		SimdUnpacker::setInstructionSet(previous);
+	}
+
+	void testBlockCache()
+	{
+		beginTest("Testing decoded block cache");
+
+		const size_t blockSize = COMPRESSION_BLOCK_SIZE * sizeof(int16);
+
+		HlacBlockCache cache(blockSize * 64);
+
+		expectEquals<int>((int)cache.getMemoryLimit(), (int)(blockSize * 64), "Memory limit");
+
+		auto fileId = cache.createFileId();
+
+		HeapBlock<int16> source, destination;
+		source.malloc(COMPRESSION_BLOCK_SIZE);
+		destination.calloc(COMPRESSION_BLOCK_SIZE);
+
+		for (uint32 blockIndex = 0; blockIndex < 16; blockIndex++)
+		{
+			for (int i = 0; i < COMPRESSION_BLOCK_SIZE; i++)
+				source[i] = (int16)(blockIndex * 100 + i % 100);
+
+			cache.writeBlock(HlacBlockCache::createKey(fileId, 1, blockIndex), source);
+		}
+
+		expect(!cache.readBlock(HlacBlockCache::createKey(fileId, 0, 3), destination, 0, COMPRESSION_BLOCK_SIZE), "Other channel is not cached");
+		expect(cache.readBlock(HlacBlockCache::createKey(fileId, 1, 3), destination, 10, 20), "Cached block");
+
+		expectEquals<int>(destination[0], 310, "First sample");
+		expectEquals<int>(destination[19], 329, "Last sample");
+
+		expectEquals<double>(cache.getHitRate(), 0.5, "Hit rate");
+
+		// Writing more blocks than the cache can hold must not exceed the memory limit
+		for (uint32 blockIndex = 16; blockIndex < 1024; blockIndex++)
+			cache.writeBlock(HlacBlockCache::createKey(fileId, 1, blockIndex), source);
+
+		expect(cache.getMemoryUsage() <= cache.getMemoryLimit(), "Memory usage");
+
+		cache.setMemoryLimit(0);
+
+		expectEquals<int>((int)cache.getMemoryUsage(), 0, "Cleared");
+		expect(!cache.readBlock(HlacBlockCache::createKey(fileId, 1, 1020), destination, 0, 1), "Disabled cache");
+	}
+
+	void testCachedReading(int numChannels)
+	{
+		beginTest("Testing cached reading with " + String(numChannels) + " channels");
+
+		Array<AudioSampleBuffer> buffers;
+
+		buffers.add(createTestBuffer(numChannels, 200000));
+
+		auto mb = writeIntoMemory(buffers);
+
+		HlacBlockCache::Ptr cache = new HlacBlockCache();
+
+		auto fileId = cache->createFileId();
+
+		ScopedPointer<HiseLosslessAudioFormatReader> normalReader = new HiseLosslessAudioFormatReader(new MemoryInputStream(mb, false));
+		ScopedPointer<HiseLosslessAudioFormatReader> cachedReader1 = new HiseLosslessAudioFormatReader(new MemoryInputStream(mb, false));
+		ScopedPointer<HiseLosslessAudioFormatReader> cachedReader2 = new HiseLosslessAudioFormatReader(new MemoryInputStream(mb, false));
+
+		cachedReader1->setBlockCache(cache, fileId);
+		cachedReader2->setBlockCache(cache, fileId);
+
+		const int length = (int)normalReader->lengthInSamples;
+
+		HlacSubSectionReader normalSubReader(normalReader, 0, length);
+		HlacSubSectionReader cachedSubReader1(cachedReader1, 0, length);
+		HlacSubSectionReader cachedSubReader2(cachedReader2, 0, length);
+
+		const int numToRead = 8192;
+
+		HiseSampleBuffer expected(false, 2, numToRead);
+		HiseSampleBuffer actual1(false, 2, numToRead);
+		HiseSampleBuffer actual2(false, 2, numToRead);
+
+		Random r;
+		int position = 0;
+
+		for (int i = 0; i < 20; i++)
+		{
+			// Every other read continues where the last one stopped, the others seek to a random position
+			if (i % 2 == 0 || position + 2 * numToRead > length)
+				position = r.nextInt(length - numToRead);
+			else
+				position += numToRead;
+
+			normalSubReader.readIntoFixedBuffer(expected, 0, numToRead, position);
+			cachedSubReader1.readIntoFixedBuffer(actual1, 0, numToRead, position);
+			cachedSubReader2.readIntoFixedBuffer(actual2, 0, numToRead, position);
+
+			for (int c = 0; c < numChannels; c++)
+			{
+				const size_t numBytes = sizeof(int16) * numToRead;
+
+				expect(memcmp(expected.getReadPointer(c), actual1.getReadPointer(c), numBytes) == 0, "First reader at " + String(position));
+				expect(memcmp(expected.getReadPointer(c), actual2.getReadPointer(c), numBytes) == 0, "Second reader at " + String(position));
+			}
+		}
+
+		// The second reader should find every block that the first reader has decoded
+		if (currentOption.useCompression)
+			expect(cache->getNumHits() > 0 && cache->getNumHits() >= cache->getNumMisses(), "Hit rate: " + String(cache->getHitRate(), 2));
+		else
+			expectEquals<int>((int)cache->getNumMisses(), 0, "Uncompressed files bypass the cache");
+	}
+
+	void testParallelDecoding(int numChannels)
+	{
+		beginTest("Testing parallel decoding with " + String(numChannels) + " channels");
+
+		Array<AudioSampleBuffer> buffers;
+
+		buffers.add(createTestBuffer(numChannels, 44100 * 5));
+
+		auto mb = writeIntoMemory(buffers);
+
+		TemporaryFile tempFile;
+
+		tempFile.getFile().replaceWithData(mb.getData(), mb.getSize());
+
+		// The memory stream is decoded directly, the file stream will be copied into a temporary buffer
+		ScopedPointer<HiseLosslessAudioFormatReader> serialReader = new HiseLosslessAudioFormatReader(new MemoryInputStream(mb, false));
+		ScopedPointer<HiseLosslessAudioFormatReader> memoryReader = new HiseLosslessAudioFormatReader(new MemoryInputStream(mb, false));
+		ScopedPointer<HiseLosslessAudioFormatReader> fileReader = new HiseLosslessAudioFormatReader(new FileInputStream(tempFile.getFile()));
+
+		serialReader->setUseParallelDecoding(false);
+		memoryReader->setUseParallelDecoding(true);
+		fileReader->setUseParallelDecoding(true);
+
+		serialReader->setTargetAudioDataType(AudioDataConverters::DataFormat::float32BE);
+		memoryReader->setTargetAudioDataType(AudioDataConverters::DataFormat::float32BE);
+		fileReader->setTargetAudioDataType(AudioDataConverters::DataFormat::float32BE);
+
+		// Make sure that the reads are split even if there's only one CPU core
+		SharedResourcePointer<HlacDecodingThreadPool> threadPool;
+
+		const int numJobs = threadPool->getNumJobsToUse();
+		threadPool->setNumJobsToUse(jmax<int>(4, numJobs));
+
+		const int length = (int)serialReader->lengthInSamples;
+
+		HlacSubSectionReader serialSubReader(serialReader, 0, length);
+		HlacSubSectionReader memorySubReader(memoryReader, 0, length);
+		HlacSubSectionReader fileSubReader(fileReader, 0, length);
+
+		Random r;
+
+		int position = 0;
+
+		for (int i = 0; i < 24; i++)
+		{
+			const bool readSmallChunk = i % 3 == 2;
+			const int numToRead = readSmallChunk ? r.nextInt(Range<int>(100, 5000)) : r.nextInt(Range<int>(40000, 150000));
+
+			// Every third read continues where the last one stopped to check that the decoder position is correct
+			if (!readSmallChunk || position + numToRead > length)
+				position = r.nextInt(length - numToRead);
+
+			if (i % 2 == 0)
+			{
+				AudioSampleBuffer expected(numChannels, numToRead);
+				AudioSampleBuffer fromMemory(numChannels, numToRead);
+				AudioSampleBuffer fromFile(numChannels, numToRead);
+
+				serialReader->read(&expected, 0, numToRead, position, true, true);
+				memoryReader->read(&fromMemory, 0, numToRead, position, true, true);
+				fileReader->read(&fromFile, 0, numToRead, position, true, true);
+
+				for (int c = 0; c < numChannels; c++)
+				{
+					const size_t numBytes = sizeof(float) * numToRead;
+
+					expect(memcmp(expected.getReadPointer(c), fromMemory.getReadPointer(c), numBytes) == 0, "Memory stream at " + String(position));
+					expect(memcmp(expected.getReadPointer(c), fromFile.getReadPointer(c), numBytes) == 0, "File stream at " + String(position));
+				}
+			}
+			else
+			{
+				HiseSampleBuffer expected(false, 2, numToRead);
+				HiseSampleBuffer fromMemory(false, 2, numToRead);
+				HiseSampleBuffer fromFile(false, 2, numToRead);
+
+				serialSubReader.readIntoFixedBuffer(expected, 0, numToRead, position);
+				memorySubReader.readIntoFixedBuffer(fromMemory, 0, numToRead, position);
+				fileSubReader.readIntoFixedBuffer(fromFile, 0, numToRead, position);
+
+				for (int c = 0; c < numChannels; c++)
+				{
+					const size_t numBytes = sizeof(int16) * numToRead;
+
+					expect(memcmp(expected.getReadPointer(c), fromMemory.getReadPointer(c), numBytes) == 0, "Fixed memory stream at " + String(position));
+					expect(memcmp(expected.getReadPointer(c), fromFile.getReadPointer(c), numBytes) == 0, "Fixed file stream at " + String(position));
+				}
+			}
+
+			position += numToRead;
+		}
+
+		threadPool->setNumJobsToUse(numJobs);
+	}
+
+	void testParallelEncoding(int numChannels)
+	{
+		beginTest("Testing parallel encoding with " + String(numChannels) + " channels");
+
+		// The second buffer checks that the offsets continue correctly after a padded block
+		Array<AudioSampleBuffer> buffers;
+
+		buffers.add(createTestBuffer(numChannels, 44100 * 5));
+		buffers.add(createTestBuffer(numChannels, 44100 * 2));
+
+		// Make sure that the blocks are split even if there's only one CPU core
+		SharedResourcePointer<HlacEncodingThreadPool> threadPool;
+
+		const int numJobs = threadPool->getNumJobsToUse();
+		threadPool->setNumJobsToUse(jmax<int>(4, numJobs));
+
+		auto encode = [&](bool useParallelEncoding)
+		{
+			HiseLosslessAudioFormat hlac;
+			MemoryOutputStream* mos = new MemoryOutputStream();
+			StringPairArray empty;
+
+			ScopedPointer<HiseLosslessAudioFormatWriter> writer = dynamic_cast<HiseLosslessAudioFormatWriter*>(hlac.createWriterFor(mos, 44100.0, numChannels, 0, empty, 0));
+
+			writer->setOptions(currentOption);
+			writer->setUseParallelEncoding(useParallelEncoding);
+
+			for (int i = 0; i < buffers.size(); i++)
+				writer->writeFromAudioSampleBuffer(buffers[i], 0, buffers[i].getNumSamples());
+
+			writer->flush();
+
+			return MemoryBlock(mos->getData(), mos->getDataSize());
+		};
+
+		auto serialData = encode(false);
+		auto parallelData = encode(true);
+
+		threadPool->setNumJobsToUse(numJobs);
+
+		expectEquals<int>((int)parallelData.getSize(), (int)serialData.getSize(), "File size");
+
+		if (parallelData.getSize() != serialData.getSize())
+			return;
+
+		auto s = static_cast<const uint8*>(serialData.getData());
+		auto p = static_cast<const uint8*>(parallelData.getData());
+
+		int numDifferentBytes = 0;
+
+		for (size_t i = 0; i < serialData.getSize(); i++)
+			numDifferentBytes += s[i] != p[i] ? 1 : 0;
+
+		if (currentOption.useCompression)
+		{
+			MemoryInputStream serialStream(serialData, false);
+			MemoryInputStream parallelStream(parallelData, false);
+
+			HiseLosslessHeader serialHeader(&serialStream);
+			HiseLosslessHeader parallelHeader(&parallelStream);
+
+			const uint32 numBlocks = serialHeader.getBlockAmount();
+
+			expectEquals<int>((int)parallelHeader.getBlockAmount(), (int)numBlocks, "Block amount");
+
+			for (uint32 i = 0; i < numBlocks; i++)
+			{
+				const int64 position = (int64)i * COMPRESSION_BLOCK_SIZE;
+
+				expectEquals<int>((int)parallelHeader.getOffsetForReadPosition(position, true), (int)serialHeader.getOffsetForReadPosition(position, true), "Offset for block " + String(i));
+			}
+
+			// Only the random checksums of the header and each channel block may differ
+			expect(numDifferentBytes <= ((int)numBlocks * numChannels + 1) * 4, "Too many different bytes: " + String(numDifferentBytes));
+		}
+		else
+		{
+			expectEquals<int>(numDifferentBytes, 0, "Uncompressed data");
+		}
+
+		ScopedPointer<HiseLosslessAudioFormatReader> serialReader = new HiseLosslessAudioFormatReader(new MemoryInputStream(serialData, false));
+		ScopedPointer<HiseLosslessAudioFormatReader> parallelReader = new HiseLosslessAudioFormatReader(new MemoryInputStream(parallelData, false));
+
+		serialReader->setTargetAudioDataType(AudioDataConverters::DataFormat::float32BE);
+		parallelReader->setTargetAudioDataType(AudioDataConverters::DataFormat::float32BE);
+
+		const int length = (int)serialReader->lengthInSamples;
+
+		expectEquals<int>((int)parallelReader->lengthInSamples, length, "Length");
+
+		AudioSampleBuffer expected(numChannels, length);
+		AudioSampleBuffer actual(numChannels, length);
+
+		serialReader->read(&expected, 0, length, 0, true, true);
+		parallelReader->read(&actual, 0, length, 0, true, true);
+
+		for (int c = 0; c < numChannels; c++)
+			expect(memcmp(expected.getReadPointer(c), actual.getReadPointer(c), sizeof(float) * length) == 0, "Decoded data for channel " + String(c));
+	}
+
 	void testArchiver()
 	{
 		beginTest("Testing Archiver");
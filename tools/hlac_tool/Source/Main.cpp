@@ -37,7 +37,7 @@ void printHelp()
 	Logger::writeToLog("Usage: hlac_tool [MODE] [INPUT] [OUTPUT]");
 	Logger::writeToLog("");
 	Logger::writeToLog("modes: 'encode' / 'decode'");
-	Logger::writeToLog("test-modes: 'unit_test' / 'test_directory', 'memory_map_directory'");
+	Logger::writeToLog("test-modes: 'unit_test' / 'test_directory', 'memory_map_directory', 'decode_benchmark'");
 	Logger::writeToLog("(put '_' before filename to skip samples)");
 	Logger::setCurrentLogger(nullptr);
 }
@@ -65,7 +65,21 @@ int encode(File input, File output, HlacEncoder::CompressorOptions option)
 
 	writer->setOptions(option);
 
-	bool ok = writer->writeFromAudioReader(*reader, 0, reader->lengthInSamples);
+	// Read the file in big chunks so that the encoder can compress the blocks on multiple threads without loading the whole file.
+	// The chunk size must be a multiple of the block size because the last block of each write is padded.
+	const int numSamplesPerChunk = COMPRESSION_BLOCK_SIZE * 256;
+
+	AudioSampleBuffer chunk(reader->numChannels, numSamplesPerChunk);
+
+	bool ok = true;
+
+	for (int64 pos = 0; ok && pos < reader->lengthInSamples; pos += numSamplesPerChunk)
+	{
+		const int numThisTime = (int)jmin<int64>(numSamplesPerChunk, reader->lengthInSamples - pos);
+
+		reader->read(&chunk, 0, numThisTime, pos, true, true);
+		ok = writer->writeFromAudioSampleBuffer(chunk, 0, numThisTime);
+	}
 
 	if (ok)
 	{
@@ -159,6 +173,129 @@ int decode(File input, File output)
 	return 0;
 }
 
+int decodeBenchmark(File input)
+{
+	Array<File> files;
+
+	if (input.isDirectory())
+		input.findChildFiles(files, File::findFiles, true);
+	else
+		files.add(input);
+
+	AudioFormatManager afm;
+	afm.registerBasicFormats();
+
+	HiseLosslessAudioFormat hlac;
+
+	OwnedArray<MemoryBlock> encodedFiles;
+	OwnedArray<HiseSampleBuffer> decodedFiles;
+
+	int64 numCompressedBytes = 0;
+	int64 numDecodedBytes = 0;
+
+	for (auto f : files)
+	{
+		if (f.getFileName().startsWith("_") || f.isHidden())
+			continue;
+
+		auto mb = new MemoryBlock();
+
+		if (f.hasFileExtension("hlac"))
+		{
+			f.loadFileAsData(*mb);
+		}
+		else
+		{
+			// Encode other audio files into memory first
+			ScopedPointer<AudioFormatReader> reader = afm.createReaderFor(f);
+
+			if (reader == nullptr)
+			{
+				delete mb;
+				continue;
+			}
+
+			MemoryOutputStream* mos = new MemoryOutputStream(*mb, false);
+
+			StringPairArray empty;
+
+			ScopedPointer<HiseLosslessAudioFormatWriter> writer = dynamic_cast<HiseLosslessAudioFormatWriter*>(hlac.createWriterFor(mos, reader->sampleRate, reader->numChannels, 16, empty, 5));
+
+			auto options = HlacEncoder::CompressorOptions::getPreset(HlacEncoder::CompressorOptions::Presets::Diff);
+
+			writer->setOptions(options);
+			writer->writeFromAudioReader(*reader, 0, reader->lengthInSamples);
+			writer->flush();
+			writer = nullptr;
+		}
+
+		ScopedPointer<HiseLosslessAudioFormatReader> hlacReader = new HiseLosslessAudioFormatReader(new MemoryInputStream(*mb, false));
+
+		const int numChannels = (int)hlacReader->numChannels;
+		const int numSamples = (int)hlacReader->lengthInSamples;
+
+		encodedFiles.add(mb);
+		decodedFiles.add(new HiseSampleBuffer(false, numChannels, numSamples));
+
+		numCompressedBytes += (int64)mb->getSize();
+		numDecodedBytes += (int64)numSamples * numChannels * sizeof(int16);
+
+		Logger::writeToLog("Loaded " + f.getFileName());
+	}
+
+	if (encodedFiles.isEmpty())
+	{
+		ABORT_WITH_MESSAGE("No audio files found");
+	}
+
+	typedef BitCompressors::SimdUnpacker SimdUnpacker;
+
+	const auto best = SimdUnpacker::getBestAvailableInstructionSet();
+	const int numIterations = 10;
+
+	Logger::writeToLog("");
+	Logger::writeToLog("Decoding " + String(encodedFiles.size()) + " files, " + String((double)numDecodedBytes / 1024.0 / 1024.0, 1) + " MB (" + String(numIterations) + " iterations)");
+	Logger::writeToLog("--------------------------------------------------------------------");
+
+	for (int i = 0; i <= (int)best; i++)
+	{
+		SimdUnpacker::setInstructionSet((SimdUnpacker::InstructionSet)i);
+
+		for (int useThreads = 0; useThreads < 2; useThreads++)
+		{
+			const double start = Time::getMillisecondCounterHiRes();
+
+			for (int iteration = 0; iteration < numIterations; iteration++)
+			{
+				for (int fileIndex = 0; fileIndex < encodedFiles.size(); fileIndex++)
+				{
+					ScopedPointer<HiseLosslessAudioFormatReader> reader = new HiseLosslessAudioFormatReader(new MemoryInputStream(*encodedFiles[fileIndex], false));
+
+					reader->setUseParallelDecoding(useThreads == 1);
+
+					auto& destination = *decodedFiles[fileIndex];
+
+					HlacSubSectionReader subReader(reader, 0, reader->lengthInSamples);
+					subReader.readIntoFixedBuffer(destination, 0, destination.getNumSamples(), 0);
+				}
+			}
+
+			const double seconds = (Time::getMillisecondCounterHiRes() - start) / 1000.0;
+
+			const double decodedSpeed = (double)(numDecodedBytes * numIterations) / 1024.0 / 1024.0 / seconds;
+			const double compressedSpeed = (double)(numCompressedBytes * numIterations) / 1024.0 / 1024.0 / seconds;
+
+			Logger::writeToLog(SimdUnpacker::getName((SimdUnpacker::InstructionSet)i).paddedRight(' ', 8) + (useThreads == 1 ? "parallel" : "serial  ") +
+							   ": " + String(decodedSpeed, 1) + " MB/s decoded, " + String(compressedSpeed, 1) + " MB/s compressed");
+		}
+	}
+
+	SimdUnpacker::setInstructionSet(best);
+
+	Logger::setCurrentLogger(nullptr);
+	return 0;
+}
+
 int main(int argc, char **argv)
 {
 	ScopedPointer<Logger> l = new StdLogger();
@@ -246,6 +383,24 @@ int main(int argc, char **argv)
 	}
 
 
+	if (mode == "decode_benchmark")
+	{
+		if (argc < 3)
+		{
+			printHelp();
+			return 1;
+		}
+
+		File input(argv[2]);
+
+		if (!input.exists())
+		{
+			ABORT_WITH_MESSAGE("File " + String(argv[2]) + " does not exist");
+		}
+
+		return decodeBenchmark(input);
+	}
+
 	if (mode == "memory_map_directory")
 	{
 		File root(argv[2]);